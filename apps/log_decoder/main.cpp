@@ -0,0 +1,54 @@
+#include "logger/binary_log_reader.hpp"
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Offline decoder for BinaryLog segments
+ *
+ * Prints the messages of each segment given on the command line, in
+ * order, in the same line format Logger uses for text output:
+ *
+ *   log_decoder [--locations] trace.blog.0 trace.blog.1 ...
+ */
+int main(int argc, char* argv[]) {
+    using MathEngine::BinaryLogReader;
+
+    bool withLocation = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--locations") {
+            withLocation = true;
+        } else if (arg == "-h" || arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [--locations] SEGMENT...\n"
+                      << "Decode BinaryLog segments to text on stdout.\n";
+            return 0;
+        } else {
+            paths.emplace_back(arg);
+        }
+    }
+
+    if (paths.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--locations] SEGMENT...\n";
+        return 2;
+    }
+
+    int status = 0;
+    for (const std::string& path : paths) {
+        try {
+            BinaryLogReader reader(path);
+            BinaryLogReader::Entry entry;
+            while (reader.next(entry)) {
+                std::cout << BinaryLogReader::formatLine(entry, withLocation) << '\n';
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "log_decoder: " << path << ": " << e.what() << '\n';
+            status = 1;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,412 @@
+#include "batch_driver.hpp"
+#include "mapped_input.hpp"
+
+#include "math/calculator.hpp"
+#include "math/operand_store.hpp"
+#include "math/reduction.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace MathEngine::App {
+
+namespace {
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+/// One batch call over columns sharing one operation; returns divisions by zero
+std::size_t evaluateColumns(BatchOp op, std::span<const double> a, std::span<const double> b,
+                            std::span<double> out, OperandStore& store) {
+    switch (op) {
+        case BatchOp::Add:      Calculator::add(a, b, out); return 0;
+        case BatchOp::Subtract: Calculator::subtract(a, b, out); return 0;
+        case BatchOp::Multiply: Calculator::multiply(a, b, out); return 0;
+        case BatchOp::Divide:   return Calculator::divide(a, b, out).errorCount;
+        case BatchOp::Power:    break;
+    }
+
+    // Power takes one exponent per batch call: let the store group by it
+    const BatchOp ops[] = {op};
+    store.clear();
+    store.append(ops, a, b);
+    return Calculator::evaluate(store, out).errorCount;
+}
+
+// ============================================================================
+// Record Parsing
+// ============================================================================
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Incremental parser of "op,a,b" lines ('#' starts a comment line)
+ */
+class RecordParser {
+public:
+    explicit RecordParser(std::string_view text) : text_(text) {}
+
+    /// Bytes consumed so far
+    std::size_t offset() const { return offset_; }
+
+    /**
+     * @brief Append up to @p limit records; fewer means the input is exhausted
+     */
+    std::size_t parse(std::size_t limit, OperandStore& store) {
+        std::size_t parsed = 0;
+        while (parsed < limit && offset_ < text_.size()) {
+            const std::size_t newline = text_.find('\n', offset_);
+            const std::size_t end = newline == std::string_view::npos ? text_.size() : newline;
+            const std::string_view line = text_.substr(offset_, end - offset_);
+            offset_ = newline == std::string_view::npos ? text_.size() : newline + 1;
+            ++line_;
+
+            const char* at = line.data();
+            const char* last = line.data() + line.size();
+            skipBlanks(at, last);
+            if (at == last || *at == '#') {
+                continue;
+            }
+
+            const char* comma = std::find(at, last, ',');
+            std::string_view name(at, static_cast<std::size_t>(comma - at));
+            while (!name.empty() && isBlank(name.back())) {
+                name.remove_suffix(1);
+            }
+            const std::optional<BatchOp> op = parseBatchOp(name);
+            if (!op) {
+                fail("unknown operation '" + std::string(name) + "'");
+            }
+            at = comma;
+            const double lhs = field(at, last);
+            const double rhs = field(at, last);
+            skipBlanks(at, last);
+            if (at != last) {
+                fail("expected 'op,a,b'");
+            }
+            if (*op == BatchOp::Power && std::trunc(rhs) != rhs) {
+                fail("power exponent must be an integer");
+            }
+
+            store.push(*op, lhs, rhs);
+            ++parsed;
+        }
+        return parsed;
+    }
+
+private:
+    static void skipBlanks(const char*& at, const char* last) {
+        while (at != last && isBlank(*at)) {
+            ++at;
+        }
+    }
+
+    /// ",<number>" with optional blanks around the number
+    double field(const char*& at, const char* last) {
+        if (at == last || *at != ',') {
+            fail("expected 'op,a,b'");
+        }
+        ++at;
+        skipBlanks(at, last);
+        double value = 0.0;
+        const auto [next, error] = std::from_chars(at, last, value);
+        if (error != std::errc()) {
+            fail("invalid number");
+        }
+        at = next;
+        skipBlanks(at, last);
+        return value;
+    }
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("line " + std::to_string(line_) + ": " + what);
+    }
+
+    std::string_view text_;
+    std::size_t offset_ = 0;
+    std::size_t line_ = 0;
+};
+
+// ============================================================================
+// Output
+// ============================================================================
+
+/**
+ * @brief File (or stdout) that the results are streamed to
+ */
+class OutputFile {
+public:
+    OutputFile(const std::string& path, bool binary) {
+        if (path.empty() || path == "-") {
+            file_ = stdout;
+            return;
+        }
+        file_ = std::fopen(path.c_str(), binary ? "wb" : "w");
+        if (file_ == nullptr) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "cannot open '" + path + "' for writing");
+        }
+        owned_ = true;
+    }
+
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    ~OutputFile() {
+        if (owned_) {
+            std::fclose(file_);
+        }
+    }
+
+    void write(const void* data, std::size_t bytes) {
+        if (bytes != 0 && std::fwrite(data, 1, bytes, file_) != bytes) {
+            throw std::runtime_error("writing results failed");
+        }
+    }
+
+    void close() {
+        const bool ok = std::fflush(file_) == 0 && (!owned_ || std::fclose(file_) == 0);
+        owned_ = false;
+        if (!ok) {
+            throw std::runtime_error("writing results failed");
+        }
+    }
+
+private:
+    std::FILE* file_ = nullptr;
+    bool owned_ = false;
+};
+
+// ============================================================================
+// Drivers
+// ============================================================================
+
+/// Feeds the reducer, if any, and the sink
+class ChunkHandler {
+public:
+    ChunkHandler(const DriverOptions& options, const ResultSink& sink) : sink_(sink) {
+        if (options.reduce) {
+            reducer_.emplace(*options.reduce);
+        }
+    }
+
+    void operator()(std::span<const double> results) {
+        if (reducer_) {
+            reducer_->add(results);
+        }
+        sink_(results);
+    }
+
+    void finish(DriverStats& stats) {
+        if (reducer_) {
+            stats.partials = reducer_->finish();
+        }
+    }
+
+private:
+    const ResultSink& sink_;
+    std::optional<BlockReducer> reducer_;
+};
+
+DriverStats runRecords(const DriverOptions& options) {
+    MappedInput input(options.records);
+    OutputFile output(options.output, false);
+    std::string text;
+    DriverStats stats = streamRecords(input, 0, input.size(), options, [&](std::span<const double> results) {
+        text.clear();
+        appendResults(text, results);
+        output.write(text.data(), text.size());
+    });
+    output.close();
+    return stats;
+}
+
+DriverStats runColumns(const DriverOptions& options) {
+    MappedInput lhs(options.lhs);
+    MappedInput rhs(options.rhs);
+    OutputFile output(options.output, true);
+    DriverStats stats = streamColumns(lhs, rhs, 0, lhs.size() / sizeof(double), options,
+                                      [&](std::span<const double> results) {
+                                          output.write(results.data(), results.size_bytes());
+                                      });
+    output.close();
+    return stats;
+}
+
+} // namespace
+
+// ============================================================================
+// Shards
+// ============================================================================
+
+void BlockReducer::add(std::span<const double> results) {
+    constexpr std::size_t kBlock = Reduction::kBlockSize;
+    if (!pending_.empty()) {
+        const std::size_t take = std::min(kBlock - pending_.size(), results.size());
+        pending_.insert(pending_.end(), results.begin(), results.begin() + static_cast<std::ptrdiff_t>(take));
+        results = results.subspan(take);
+        if (pending_.size() < kBlock) {
+            return;
+        }
+        partials_.emplace_back();
+        Reduction::partials(op_, pending_, std::span<double>(&partials_.back(), 1));
+        pending_.clear();
+    }
+
+    // Whole blocks straight from the chunk, the rest waits for the next one
+    const std::size_t whole = results.size() / kBlock * kBlock;
+    if (whole != 0) {
+        partials_.resize(partials_.size() + whole / kBlock);
+        Reduction::partials(op_, results.first(whole),
+                            std::span<double>(partials_).last(whole / kBlock));
+    }
+    pending_.assign(results.begin() + static_cast<std::ptrdiff_t>(whole), results.end());
+}
+
+std::vector<double> BlockReducer::finish() {
+    if (!pending_.empty()) {
+        partials_.emplace_back();
+        Reduction::partials(op_, pending_, std::span<double>(&partials_.back(), 1));
+        pending_.clear();
+    }
+    return std::move(partials_);
+}
+
+DriverStats streamRecords(MappedInput& input, std::size_t begin, std::size_t end,
+                          const DriverOptions& options, const ResultSink& sink) {
+    if (begin > end || end > input.size()) {
+        throw std::invalid_argument("record range outside the input");
+    }
+    RecordParser parser(input.bytes().substr(begin, end - begin));
+    ChunkHandler handle(options, sink);
+
+    DriverStats stats;
+    stats.inputBytes = end - begin;
+    OperandStore store;
+    std::vector<double> out;
+    for (;;) {
+        store.clear();
+        const std::size_t count = parser.parse(options.chunkSize, store);
+        if (count == 0) {
+            break;
+        }
+        out.resize(count);
+        stats.divisionsByZero += Calculator::evaluate(store, out).errorCount;
+        stats.records += count;
+        handle(out);
+        input.release(begin + parser.offset());
+    }
+    handle.finish(stats);
+    return stats;
+}
+
+DriverStats streamColumns(MappedInput& lhs, MappedInput& rhs, std::size_t first, std::size_t count,
+                          const DriverOptions& options, const ResultSink& sink) {
+    if (lhs.size() != rhs.size()) {
+        throw std::runtime_error("the columns hold different numbers of values");
+    }
+    if (lhs.size() % sizeof(double) != 0) {
+        throw std::runtime_error("the input is not a column of doubles");
+    }
+    const std::size_t total = lhs.size() / sizeof(double);
+    if (first > total || count > total - first) {
+        throw std::invalid_argument("column range outside the input");
+    }
+
+    // Mappings are page-aligned, so the columns can be used in place
+    const std::span<const double> a =
+        std::span(reinterpret_cast<const double*>(lhs.bytes().data()), total).subspan(first, count);
+    const std::span<const double> b =
+        std::span(reinterpret_cast<const double*>(rhs.bytes().data()), total).subspan(first, count);
+    ChunkHandler handle(options, sink);
+    OperandStore store;
+
+    DriverStats stats;
+    stats.inputBytes = 2 * count * sizeof(double);
+    std::vector<double> out(std::min(options.chunkSize, count));
+    for (std::size_t begin = 0; begin < count; begin += out.size()) {
+        const std::size_t n = std::min(out.size(), count - begin);
+        const std::span<double> results(out.data(), n);
+        stats.divisionsByZero +=
+            evaluateColumns(options.op, a.subspan(begin, n), b.subspan(begin, n), results, store);
+        stats.records += n;
+        handle(results);
+
+        lhs.release((first + begin + n) * sizeof(double));
+        rhs.release((first + begin + n) * sizeof(double));
+    }
+    handle.finish(stats);
+    return stats;
+}
+
+void appendResults(std::string& text, std::span<const double> values) {
+    for (double value : values) {
+        char buffer[32];
+        const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        text.append(buffer, error == std::errc() ? end : buffer);
+        text.push_back('\n');
+    }
+}
+
+std::optional<BatchOp> parseBatchOp(std::string_view name) {
+    if (name == "add" || name == "+") {
+        return BatchOp::Add;
+    }
+    if (name == "sub" || name == "subtract" || name == "-") {
+        return BatchOp::Subtract;
+    }
+    if (name == "mul" || name == "multiply" || name == "*") {
+        return BatchOp::Multiply;
+    }
+    if (name == "div" || name == "divide" || name == "/") {
+        return BatchOp::Divide;
+    }
+    if (name == "pow" || name == "power" || name == "^") {
+        return BatchOp::Power;
+    }
+    return std::nullopt;
+}
+
+std::optional<ReductionOp> parseReductionOp(std::string_view name) {
+    if (name == "sum") {
+        return ReductionOp::Sum;
+    }
+    if (name == "product") {
+        return ReductionOp::Product;
+    }
+    if (name == "min") {
+        return ReductionOp::Min;
+    }
+    if (name == "max") {
+        return ReductionOp::Max;
+    }
+    return std::nullopt;
+}
+
+DriverStats runBatchDriver(const DriverOptions& options) {
+    if (options.chunkSize == 0) {
+        throw std::invalid_argument("chunk size must be positive");
+    }
+    const auto start = std::chrono::steady_clock::now();
+    DriverStats stats = options.records.empty() ? runColumns(options) : runRecords(options);
+    if (options.reduce) {
+        stats.reduction = Reduction::combine(*options.reduce, stats.partials);
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+} // namespace MathEngine::App
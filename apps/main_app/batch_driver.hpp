@@ -0,0 +1,130 @@
+#ifndef MAIN_APP_BATCH_DRIVER_HPP
+#define MAIN_APP_BATCH_DRIVER_HPP
+
+#include "math/operand_store.hpp"
+#include "math/reduction.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MathEngine::App {
+
+/**
+ * @brief Parse "add", "sub", "mul", "div", "pow" (long names and + - * / ^ too)
+ */
+std::optional<BatchOp> parseBatchOp(std::string_view name);
+
+/**
+ * @brief Parse "sum", "product", "min", "max"
+ */
+std::optional<ReductionOp> parseReductionOp(std::string_view name);
+
+/**
+ * @brief Name of a reduction as --reduce spells it
+ */
+constexpr std::string_view toString(ReductionOp op) {
+    switch (op) {
+        case ReductionOp::Sum: return "sum";
+        case ReductionOp::Product: return "product";
+        case ReductionOp::Min: return "min";
+        case ReductionOp::Max: return "max";
+    }
+    return "unknown";
+}
+
+class MappedInput;
+
+/**
+ * @brief Options of the streaming batch driver
+ *
+ * Exactly one input is given: a record file (one "op,a,b" line per
+ * operation), or a pair of columnar files of raw native-endian doubles
+ * combined element-wise with the same op.
+ */
+struct DriverOptions {
+    std::string records;            ///< Record (CSV) input
+    std::string lhs;                ///< Columnar input: left operands
+    std::string rhs;                ///< Columnar input: right operands
+    BatchOp op = BatchOp::Add;      ///< Columnar input: operation
+    std::string output;             ///< Results; empty writes to stdout
+    std::size_t chunkSize = 65536;  ///< Records evaluated per batch
+    std::optional<ReductionOp> reduce;  ///< Also reduce the results
+};
+
+/**
+ * @brief What a run processed
+ */
+struct DriverStats {
+    std::size_t records = 0;
+    std::size_t divisionsByZero = 0;  ///< Results that are NaN for it
+    std::size_t inputBytes = 0;
+    double seconds = 0.0;
+    std::vector<double> partials;      ///< Block partials of the reduction, if any
+    std::optional<double> reduction;   ///< Reduction of all results, if requested
+};
+
+/**
+ * @brief Block partials of a result stream fed chunk by chunk
+ *
+ * Gives the same partials as Reduction::partials() over the whole stream,
+ * whatever the chunk sizes, so the reduction does not depend on --chunk
+ * and shards starting at a block boundary merge exactly.
+ */
+class BlockReducer {
+public:
+    explicit BlockReducer(ReductionOp op) : op_(op) {}
+
+    void add(std::span<const double> results);
+
+    /// Partials of everything added (the last block may be short)
+    std::vector<double> finish();
+
+private:
+    ReductionOp op_;
+    std::vector<double> pending_;  ///< Start of the current block
+    std::vector<double> partials_;
+};
+
+/// Receives the results of each evaluated chunk, in input order
+using ResultSink = std::function<void(std::span<const double> results)>;
+
+/**
+ * @brief Evaluate the records in bytes [begin, end) of @p input
+ * @param begin Start of a line (or 0)
+ *
+ * Chunks of options.chunkSize records go to @p sink, and the stats carry
+ * the reduction partials when options.reduce is set. Line numbers in
+ * errors count from @p begin.
+ */
+DriverStats streamRecords(MappedInput& input, std::size_t begin, std::size_t end,
+                          const DriverOptions& options, const ResultSink& sink);
+
+/**
+ * @brief Evaluate elements [first, first + count) of two columnar inputs
+ */
+DriverStats streamColumns(MappedInput& lhs, MappedInput& rhs, std::size_t first, std::size_t count,
+                          const DriverOptions& options, const ResultSink& sink);
+
+/**
+ * @brief Stream the input of @p options through the Calculator
+ * @throws std::runtime_error on unreadable or malformed input
+ *
+ * Inputs are memory-mapped and processed chunkSize records at a time, so
+ * memory use is bounded by the chunk, not the file. Records are parsed
+ * straight into an OperandStore, which groups them by operation for the
+ * batch kernels. Record input writes one result per line; columnar input
+ * writes a column of doubles.
+ */
+DriverStats runBatchDriver(const DriverOptions& options);
+
+/// Shortest text that reads back as the same double, one per line
+void appendResults(std::string& text, std::span<const double> values);
+
+} // namespace MathEngine::App
+
+#endif // MAIN_APP_BATCH_DRIVER_HPP
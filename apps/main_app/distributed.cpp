@@ -0,0 +1,637 @@
+#include "distributed.hpp"
+#include "mapped_input.hpp"
+#include "socket.hpp"
+
+#include "logger/logger.hpp"
+#include "math/reduction.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace MathEngine::App {
+
+namespace {
+
+// ============================================================================
+// Protocol
+// ============================================================================
+// Every message is a frame: a FrameHeader, then size bytes of payload. The
+// coordinator sends one Job per shard; the worker answers with a Results
+// frame per evaluated chunk, then Done (or Error). Integers and doubles are
+// in the sender's native byte order: the magic rejects a peer of the other
+// order, and the version a peer of another protocol.
+// ============================================================================
+
+constexpr std::uint32_t kMagic = 0x4D454442;  // "MEDB"
+constexpr std::uint16_t kVersion = 1;
+
+enum class FrameType : std::uint16_t {
+    Job = 1,      ///< Coordinator: evaluate a shard
+    Results = 2,  ///< Worker: raw doubles, in input order
+    Done = 3,     ///< Worker: shard stats, then its reduction partials
+    Error = 4     ///< Worker: the job failed; payload is the message
+};
+
+struct FrameHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t type;
+    std::uint64_t size;
+};
+static_assert(sizeof(FrameHeader) == 16);
+
+/// Byte ranges of records or element ranges of columns
+struct Shard {
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+};
+
+void sendFrame(Socket& socket, FrameType type, const void* payload, std::size_t size) {
+    const FrameHeader header{kMagic, kVersion, static_cast<std::uint16_t>(type), size};
+    socket.sendAll(&header, sizeof(header));
+    socket.sendAll(payload, size);
+}
+
+/// Next frame header; false when the peer closed the connection between frames
+bool receiveHeader(Socket& socket, FrameHeader& header) {
+    if (!socket.receiveAll(&header, sizeof(header))) {
+        return false;
+    }
+    if (header.magic != kMagic) {
+        throw std::runtime_error("peer does not speak the main_app protocol (or uses another byte order)");
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("peer speaks protocol version " + std::to_string(header.version) +
+                                 ", not " + std::to_string(kVersion));
+    }
+    return true;
+}
+
+std::string receivePayload(Socket& socket, const FrameHeader& header) {
+    std::string payload(header.size, '\0');
+    if (!socket.receiveAll(payload.data(), payload.size()) && !payload.empty()) {
+        throw std::runtime_error("peer closed the connection mid-frame");
+    }
+    return payload;
+}
+
+/// Appends fixed-size fields and length-prefixed strings to a payload
+class PayloadWriter {
+public:
+    template <typename T>
+    PayloadWriter& put(const T& value) {
+        bytes_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        return *this;
+    }
+
+    PayloadWriter& put(const std::string& text) {
+        put(static_cast<std::uint32_t>(text.size()));
+        bytes_.append(text);
+        return *this;
+    }
+
+    const std::string& bytes() const { return bytes_; }
+
+private:
+    std::string bytes_;
+};
+
+/// Reads what PayloadWriter wrote, checking every length
+class PayloadReader {
+public:
+    explicit PayloadReader(std::string_view bytes) : bytes_(bytes) {}
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+
+    std::string getString() { return std::string(take(get<std::uint32_t>())); }
+
+    std::string_view rest() { return take(bytes_.size() - offset_); }
+
+private:
+    std::string_view take(std::size_t size) {
+        if (size > bytes_.size() - offset_) {
+            throw std::runtime_error("truncated frame");
+        }
+        const std::string_view field = bytes_.substr(offset_, size);
+        offset_ += size;
+        return field;
+    }
+
+    std::string_view bytes_;
+    std::size_t offset_ = 0;
+};
+
+constexpr std::uint8_t kNoReduction = 0xFF;
+
+std::string encodeJob(const DriverOptions& options, const Shard& shard) {
+    PayloadWriter job;
+    job.put(static_cast<std::uint8_t>(options.op))
+        .put(options.reduce ? static_cast<std::uint8_t>(*options.reduce) : kNoReduction)
+        .put(static_cast<std::uint64_t>(options.chunkSize))
+        .put(shard.begin)
+        .put(shard.end)
+        .put(options.records)
+        .put(options.lhs)
+        .put(options.rhs);
+    return job.bytes();
+}
+
+std::pair<DriverOptions, Shard> decodeJob(std::string_view payload) {
+    PayloadReader job(payload);
+    DriverOptions options;
+    const auto op = job.get<std::uint8_t>();
+    if (op > static_cast<std::uint8_t>(BatchOp::Power)) {
+        throw std::runtime_error("unknown operation in job");
+    }
+    options.op = static_cast<BatchOp>(op);
+    const auto reduce = job.get<std::uint8_t>();
+    if (reduce != kNoReduction) {
+        if (reduce > static_cast<std::uint8_t>(ReductionOp::Max)) {
+            throw std::runtime_error("unknown reduction in job");
+        }
+        options.reduce = static_cast<ReductionOp>(reduce);
+    }
+    options.chunkSize = static_cast<std::size_t>(job.get<std::uint64_t>());
+    Shard shard;
+    shard.begin = job.get<std::uint64_t>();
+    shard.end = job.get<std::uint64_t>();
+    options.records = job.getString();
+    options.lhs = job.getString();
+    options.rhs = job.getString();
+    if (options.chunkSize == 0 || shard.begin > shard.end) {
+        throw std::runtime_error("malformed job");
+    }
+    return {std::move(options), shard};
+}
+
+// ============================================================================
+// Worker
+// ============================================================================
+
+/// One coordinator connection; inputs stay mapped for the next shard
+class WorkerSession {
+public:
+    WorkerSession(Socket socket, const std::filesystem::path& root)
+        : socket_(std::move(socket)), root_(root) {}
+
+    void serve() {
+        FrameHeader header{};
+        while (receiveHeader(socket_, header)) {
+            const std::string payload = receivePayload(socket_, header);
+            if (header.type != static_cast<std::uint16_t>(FrameType::Job)) {
+                throw std::runtime_error("expected a job frame");
+            }
+
+            DriverStats stats;
+            try {
+                const auto [options, shard] = decodeJob(payload);
+                stats = run(options, shard);
+            } catch (const std::system_error& e) {
+                // A socket error ends the session; a file error is the job's
+                if (e.code() == std::errc::connection_reset || e.code() == std::errc::broken_pipe) {
+                    throw;
+                }
+                const std::string message = e.what();
+                sendFrame(socket_, FrameType::Error, message.data(), message.size());
+                continue;
+            } catch (const std::exception& e) {
+                const std::string message = e.what();
+                sendFrame(socket_, FrameType::Error, message.data(), message.size());
+                continue;
+            }
+
+            PayloadWriter done;
+            done.put(static_cast<std::uint64_t>(stats.records))
+                .put(static_cast<std::uint64_t>(stats.divisionsByZero))
+                .put(static_cast<std::uint64_t>(stats.inputBytes));
+            // The partials follow the counters, copied into a presized buffer
+            std::string bytes = done.bytes();
+            const std::size_t counters = bytes.size();
+            bytes.resize(counters + stats.partials.size() * sizeof(double));
+            if (!stats.partials.empty()) {
+                std::memcpy(bytes.data() + counters, stats.partials.data(), stats.partials.size() * sizeof(double));
+            }
+            sendFrame(socket_, FrameType::Done, bytes.data(), bytes.size());
+        }
+    }
+
+private:
+    DriverStats run(const DriverOptions& options, const Shard& shard) {
+        const auto sink = [this](std::span<const double> results) {
+            sendFrame(socket_, FrameType::Results, results.data(), results.size_bytes());
+        };
+        if (!options.records.empty()) {
+            return streamRecords(input(options.records), static_cast<std::size_t>(shard.begin),
+                                 static_cast<std::size_t>(shard.end), options, sink);
+        }
+        return streamColumns(input(options.lhs), input(options.rhs), static_cast<std::size_t>(shard.begin),
+                             static_cast<std::size_t>(shard.end - shard.begin), options, sink);
+    }
+
+    MappedInput& input(const std::string& path) {
+        auto& mapped = inputs_[path];
+        if (!mapped) {
+            if (root_.empty()) {
+                mapped = std::make_unique<MappedInput>(path);
+            } else {
+                // Map the path that was checked, not the name the coordinator sent
+                const std::filesystem::path resolved = std::filesystem::canonical(path);
+                if (!isUnder(resolved, root_)) {
+                    throw std::runtime_error("'" + path + "' is outside the worker's root");
+                }
+                mapped = std::make_unique<MappedInput>(resolved.string());
+            }
+        }
+        return *mapped;
+    }
+
+    /// Whether canonical @p path is @p root or inside it
+    static bool isUnder(const std::filesystem::path& path, const std::filesystem::path& root) {
+        return std::mismatch(root.begin(), root.end(), path.begin(), path.end()).first == root.end();
+    }
+
+    Socket socket_;
+    const std::filesystem::path& root_;
+    std::map<std::string, std::unique_ptr<MappedInput>> inputs_;
+};
+
+// ============================================================================
+// Coordinator
+// ============================================================================
+
+/// A worker reported that the job itself failed: retrying elsewhere won't help
+class JobError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Record shards: even byte ranges, each cut moved forward to a line start
+std::vector<Shard> recordShards(std::string_view text, std::size_t count) {
+    std::vector<Shard> shards;
+    std::size_t begin = 0;
+    for (std::size_t i = 1; i <= count; ++i) {
+        std::size_t end = i == count ? text.size() : std::max(begin, text.size() / count * i);
+        if (end > 0 && end < text.size()) {
+            const std::size_t newline = text.find('\n', end - 1);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        if (end > begin) {
+            shards.push_back({begin, end});
+            begin = end;
+        }
+    }
+    return shards;
+}
+
+/// Column shards: whole Deterministic blocks, so partials line up with one node
+std::vector<Shard> columnShards(std::size_t elements, std::size_t count) {
+    constexpr std::size_t kBlock = Reduction::kBlockSize;
+    const std::size_t blocks = (elements + kBlock - 1) / kBlock;
+    const std::size_t perShard = std::max<std::size_t>(1, (blocks + count - 1) / count) * kBlock;
+    std::vector<Shard> shards;
+    for (std::size_t begin = 0; begin < elements; begin += perShard) {
+        shards.push_back({begin, std::min(elements, begin + perShard)});
+    }
+    return shards;
+}
+
+/// Shards waiting for a worker; a failed shard goes back in
+class ShardQueue {
+public:
+    explicit ShardQueue(std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            pending_.push_back(i);
+        }
+    }
+
+    /// Next shard, or none once every shard is done (or the run failed)
+    std::optional<std::size_t> take() {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [&] { return !pending_.empty() || running_ == 0 || failed_; });
+        if (pending_.empty() || failed_) {
+            return std::nullopt;
+        }
+        ++running_;
+        const std::size_t shard = pending_.front();
+        pending_.pop_front();
+        return shard;
+    }
+
+    void done() {
+        std::lock_guard lock(mutex_);
+        --running_;
+        changed_.notify_all();
+    }
+
+    void retry(std::size_t shard) {
+        std::lock_guard lock(mutex_);
+        pending_.push_front(shard);
+        --running_;
+        changed_.notify_all();
+    }
+
+    void fail(std::exception_ptr error) {
+        std::lock_guard lock(mutex_);
+        if (!failed_) {
+            failed_ = std::move(error);
+        }
+        --running_;
+        changed_.notify_all();
+    }
+
+    /// The run's outcome once every worker thread has returned
+    void check() {
+        if (failed_) {
+            std::rethrow_exception(failed_);
+        }
+        if (!pending_.empty()) {
+            throw std::runtime_error("no worker left to run " + std::to_string(pending_.size()) + " shard(s)");
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<std::size_t> pending_;
+    std::size_t running_ = 0;
+    std::exception_ptr failed_;
+};
+
+std::string spoolPath(const std::string& output, std::size_t shard) {
+    return output + ".part" + std::to_string(shard);
+}
+
+/// Send one shard to a worker and spool what comes back
+DriverStats runShard(Socket& socket, const DriverOptions& options, const Shard& shard, const std::string& spool) {
+    const std::string job = encodeJob(options, shard);
+    sendFrame(socket, FrameType::Job, job.data(), job.size());
+
+    const bool binary = options.records.empty();
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(spool.c_str(), binary ? "wb" : "w"),
+                                                         &std::fclose);
+    if (!file) {
+        throw JobError("cannot open '" + spool + "' for writing");
+    }
+    std::vector<double> results;
+    std::string text;
+    FrameHeader header{};
+    for (;;) {
+        if (!receiveHeader(socket, header)) {
+            throw std::runtime_error("worker closed the connection");
+        }
+        if (header.type == static_cast<std::uint16_t>(FrameType::Results)) {
+            if (header.size % sizeof(double) != 0) {
+                throw std::runtime_error("truncated results frame");
+            }
+            results.resize(header.size / sizeof(double));
+            if (!socket.receiveAll(results.data(), header.size) && header.size != 0) {
+                throw std::runtime_error("worker closed the connection");
+            }
+            const void* bytes = results.data();
+            std::size_t size = header.size;
+            if (!binary) {
+                text.clear();
+                appendResults(text, results);
+                bytes = text.data();
+                size = text.size();
+            }
+            if (size != 0 && std::fwrite(bytes, 1, size, file.get()) != size) {
+                throw JobError("writing '" + spool + "' failed");
+            }
+            continue;
+        }
+
+        const std::string payload = receivePayload(socket, header);
+        if (header.type == static_cast<std::uint16_t>(FrameType::Error)) {
+            throw JobError(payload);
+        }
+        if (header.type != static_cast<std::uint16_t>(FrameType::Done)) {
+            throw std::runtime_error("unexpected frame from worker");
+        }
+        if (std::fclose(file.release()) != 0) {
+            throw JobError("writing '" + spool + "' failed");
+        }
+
+        PayloadReader done(payload);
+        DriverStats stats;
+        stats.records = static_cast<std::size_t>(done.get<std::uint64_t>());
+        stats.divisionsByZero = static_cast<std::size_t>(done.get<std::uint64_t>());
+        stats.inputBytes = static_cast<std::size_t>(done.get<std::uint64_t>());
+        const std::string_view partials = done.rest();
+        stats.partials.resize(partials.size() / sizeof(double));
+        std::memcpy(stats.partials.data(), partials.data(), stats.partials.size() * sizeof(double));
+        return stats;
+    }
+}
+
+/// Workers may still be starting: retry for a few seconds
+Socket connectWorker(const Endpoint& worker) {
+    for (int attempt = 1;; ++attempt) {
+        try {
+            return Socket::connect(worker.host, worker.port);
+        } catch (const std::system_error&) {
+            if (attempt == 50) {
+                throw;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+}
+
+/// Feed one worker from the queue until it is empty or the worker fails
+void serveWorker(const Endpoint& worker, const DriverOptions& options, const std::vector<Shard>& shards,
+                 std::vector<DriverStats>& results, ShardQueue& queue) {
+    Socket socket;
+    try {
+        socket = connectWorker(worker);
+    } catch (const std::exception& e) {
+        MATHENGINE_LOG_WARNING("Coordinator: worker {}:{} unavailable: {}", worker.host, worker.port, e.what());
+        return;
+    }
+
+    while (const auto shard = queue.take()) {
+        try {
+            results[*shard] = runShard(socket, options, shards[*shard], spoolPath(options.output, *shard));
+            queue.done();
+        } catch (const JobError&) {
+            queue.fail(std::current_exception());
+            return;
+        } catch (const std::exception& e) {
+            MATHENGINE_LOG_WARNING("Coordinator: worker {}:{} failed on shard {}: {}", worker.host, worker.port,
+                                   *shard, e.what());
+            queue.retry(*shard);
+            return;
+        }
+    }
+}
+
+/// Concatenate the spools into the output, removing them
+void joinSpools(const std::string& output, std::size_t count, bool binary) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(output.c_str(), binary ? "wb" : "w"),
+                                                         &std::fclose);
+    if (!file) {
+        throw std::system_error(errno, std::generic_category(), "cannot open '" + output + "' for writing");
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string spool = spoolPath(output, i);
+        {
+            MappedInput part(spool);
+            const std::string_view bytes = part.bytes();
+            if (!bytes.empty() && std::fwrite(bytes.data(), 1, bytes.size(), file.get()) != bytes.size()) {
+                throw std::runtime_error("writing results failed");
+            }
+        }
+        std::remove(spool.c_str());
+    }
+    if (std::fclose(file.release()) != 0) {
+        throw std::runtime_error("writing results failed");
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Endpoints
+// ============================================================================
+
+Endpoint parseEndpoint(std::string_view text) {
+    const std::size_t colon = text.rfind(':');
+    if (colon == std::string_view::npos || colon == 0 || colon + 1 == text.size()) {
+        throw std::invalid_argument("expected host:port, got '" + std::string(text) + "'");
+    }
+    std::string_view host = text.substr(0, colon);
+    if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+        host = host.substr(1, host.size() - 2);
+    }
+
+    unsigned port = 0;
+    const std::string_view digits = text.substr(colon + 1);
+    const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), port);
+    if (error != std::errc() || end != digits.data() + digits.size() || port == 0 || port > 65535) {
+        throw std::invalid_argument("invalid port in '" + std::string(text) + "'");
+    }
+    return {std::string(host), static_cast<std::uint16_t>(port)};
+}
+
+std::vector<Endpoint> parseEndpoints(std::string_view text) {
+    std::vector<Endpoint> endpoints;
+    while (!text.empty()) {
+        const std::size_t comma = text.find(',');
+        endpoints.push_back(parseEndpoint(text.substr(0, comma)));
+        text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+    }
+    return endpoints;
+}
+
+// ============================================================================
+// Runs
+// ============================================================================
+
+DriverStats runCoordinator(const DriverOptions& options, const CoordinatorOptions& coordinator) {
+    if (options.chunkSize == 0) {
+        throw std::invalid_argument("chunk size must be positive");
+    }
+    if (coordinator.workers.empty()) {
+        throw std::invalid_argument("no workers given");
+    }
+    if (options.output.empty() || options.output == "-") {
+        throw std::invalid_argument("the coordinator writes to a file: give --output");
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t count =
+        coordinator.shards != 0 ? coordinator.shards : 4 * coordinator.workers.size();
+
+    std::vector<Shard> shards;
+    if (!options.records.empty()) {
+        const MappedInput input(options.records);
+        shards = recordShards(input.bytes(), count);
+    } else {
+        const MappedInput lhs(options.lhs);
+        const MappedInput rhs(options.rhs);
+        if (lhs.size() != rhs.size()) {
+            throw std::runtime_error("the columns hold different numbers of values");
+        }
+        if (lhs.size() % sizeof(double) != 0) {
+            throw std::runtime_error("the input is not a column of doubles");
+        }
+        shards = columnShards(lhs.size() / sizeof(double), count);
+    }
+
+    std::vector<DriverStats> results(shards.size());
+    ShardQueue queue(shards.size());
+    {
+        std::vector<std::jthread> threads;
+        for (const Endpoint& worker : coordinator.workers) {
+            threads.emplace_back(serveWorker, std::cref(worker), std::cref(options), std::cref(shards),
+                                 std::ref(results), std::ref(queue));
+        }
+    }
+    try {
+        queue.check();
+    } catch (...) {
+        for (std::size_t i = 0; i < shards.size(); ++i) {
+            std::remove(spoolPath(options.output, i).c_str());
+        }
+        throw;
+    }
+    joinSpools(options.output, shards.size(), options.records.empty());
+
+    // Merge in shard order, whichever worker ran which shard
+    DriverStats stats;
+    for (DriverStats& shard : results) {
+        stats.records += shard.records;
+        stats.divisionsByZero += shard.divisionsByZero;
+        stats.inputBytes += shard.inputBytes;
+        stats.partials.insert(stats.partials.end(), shard.partials.begin(), shard.partials.end());
+    }
+    if (options.reduce) {
+        stats.reduction = Reduction::combine(*options.reduce, stats.partials);
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+void runWorker(const Endpoint& endpoint, const WorkerOptions& options) {
+    const std::filesystem::path root =
+        options.root.empty() ? std::filesystem::path() : std::filesystem::canonical(options.root);
+    Socket listener = Socket::listen(endpoint.host, endpoint.port);
+    MATHENGINE_LOG_INFO("Worker: listening on {}:{}", endpoint.host, endpoint.port);
+    if (root.empty()) {
+        MATHENGINE_LOG_WARNING("Worker: no --root, so any coordinator can read any file this user can");
+    } else {
+        MATHENGINE_LOG_INFO("Worker: serving inputs under {}", root.string());
+    }
+    do {
+        WorkerSession session(listener.accept(), root);
+        try {
+            session.serve();
+        } catch (const std::exception& e) {
+            MATHENGINE_LOG_WARNING("Worker: session ended: {}", e.what());
+        }
+    } while (!options.once);
+}
+
+} // namespace MathEngine::App
@@ -0,0 +1,91 @@
+#ifndef MAIN_APP_DISTRIBUTED_HPP
+#define MAIN_APP_DISTRIBUTED_HPP
+
+#include "batch_driver.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MathEngine::App {
+
+/**
+ * @brief host:port of a worker
+ */
+struct Endpoint {
+    std::string host;
+    std::uint16_t port = 0;
+};
+
+/**
+ * @brief Parse "host:port" ("[::1]:port" for IPv6 literals)
+ * @throws std::invalid_argument if it is not one
+ */
+Endpoint parseEndpoint(std::string_view text);
+
+/**
+ * @brief Parse a comma-separated list of endpoints
+ */
+std::vector<Endpoint> parseEndpoints(std::string_view text);
+
+/**
+ * @brief How the coordinator spreads a run over its workers
+ */
+struct CoordinatorOptions {
+    std::vector<Endpoint> workers;
+    std::size_t shards = 0;  ///< Shards of the input; 0 = four per worker
+};
+
+/**
+ * @brief Run the batch driver across workers
+ * @throws std::runtime_error if the input is malformed or no worker is left
+ *
+ * The coordinator maps the input only to cut it into shards: columnar input
+ * at multiples of Reduction::kBlockSize elements, record input by byte range
+ * moved forward to the next line. Workers map the same paths themselves, so
+ * every node must see the input under the same name (shared storage).
+ *
+ * Each worker connection takes shards from a common queue; a shard whose
+ * worker fails is handed to another. Results stream back into a spool file
+ * per shard next to options.output, and are joined in shard order once every
+ * shard is done, so the output is the single-node output byte for byte.
+ *
+ * With options.reduce, each worker returns the Deterministic block partials
+ * of its shards and the coordinator combines them in shard order. For
+ * columnar input the blocks line up with a single-node run, so the reduction
+ * is bit-identical to it on every kernel tier. Record shards start a new
+ * block, so their reduction depends on the shard count (and not on the
+ * workers or their timing); min and max are exact regardless.
+ */
+DriverStats runCoordinator(const DriverOptions& options, const CoordinatorOptions& coordinator);
+
+/**
+ * @brief How a worker serves coordinators
+ */
+struct WorkerOptions {
+    std::string root;   ///< Only map inputs under this directory; empty = anywhere
+    bool once = false;  ///< Return after the first coordinator disconnects
+};
+
+/**
+ * @brief Serve jobs from coordinators on @p endpoint
+ * @throws std::filesystem::filesystem_error if options.root does not exist
+ *
+ * Connections are served one after another. An error in a job (e.g. a
+ * malformed record) is reported to the coordinator, which fails the run;
+ * the worker keeps serving.
+ *
+ * Trust model: the protocol has no authentication and no encryption, so
+ * anyone who can connect can run jobs and read the results. A job names
+ * its input files by path. With options.root, the worker resolves each
+ * path, symlinks included, and refuses any that lands outside the root.
+ * Without it, every file the worker's user can read is exposed. Listen
+ * only on a trusted network.
+ */
+void runWorker(const Endpoint& endpoint, const WorkerOptions& options);
+
+} // namespace MathEngine::App
+
+#endif // MAIN_APP_DISTRIBUTED_HPP
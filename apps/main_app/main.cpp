@@ -1,7 +1,25 @@
+#include "batch_driver.hpp"
+#include "distributed.hpp"
+
+#include "logger/binary_log.hpp"
+#include "logger/logger.hpp"
+#include "logger/trace.hpp"
 #include "math/calculator.hpp"
+#include "math/executor.hpp"
+#include "math/metrics.hpp"
+#include "math/reduction.hpp"
 
+#include <charconv>
+#include <cstddef>
+#include <exception>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
 /**
  * @brief Main application demonstrating the MathEngine library
@@ -11,10 +29,216 @@
  * - We didn't need to include logger/logger.hpp explicitly
  * - The include paths are handled automatically via target properties
  * - Linking to MathEngine::math_engine gives us logger automatically
+ *
+ * Given an input it is a streaming batch driver instead of a demo:
+ *
+ *   main_app --input records.csv [--output results.txt] [--chunk N]
+ *   main_app --lhs a.f64 --rhs b.f64 --op div [--output out.f64] [--chunk N]
+ *
+ * --reduce sum|product|min|max also reduces the results (Deterministic
+ * mode) and prints the value. The same run spreads across nodes with
+ *
+ *   main_app --worker 0.0.0.0:7000 --root /data [--once]   (on each worker node)
+ *   main_app <input options> --output FILE --workers host1:7000,host2:7000 [--shards N]
+ *
+ * Throughput is reported on stderr; --threads, --log-file, --binary-log,
+ * --metrics and --trace apply in every mode. --help prints the usage.
  */
-int main() {
+namespace {
+
+constexpr const char* kUsage = R"(usage:
+  main_app                                   run the demo
+  main_app --input records.csv [--output results.txt] [--chunk N]
+  main_app --lhs a.f64 --rhs b.f64 --op add|sub|mul|div [--output out.f64] [--chunk N]
+      stream a batch; --reduce sum|product|min|max also reduces the results
+  main_app --worker HOST:PORT [--root DIR] [--once]
+      serve coordinators; --root DIR refuses inputs outside DIR
+  main_app <input options> --output FILE --workers HOST:PORT,... [--shards N]
+      spread a batch over workers
+
+  every mode: --threads N, --log-file FILE, --binary-log PATH, --metrics, --trace FILE
+
+Workers do not authenticate coordinators and do not encrypt traffic: anyone
+who can connect can run jobs on any file the worker may read (only under
+--root DIR when given). Listen on a trusted network only.
+)";
+
+/**
+ * @brief Parse a whole decimal count, e.g. the value of --threads
+ * @return nothing if @p text is not one (sign, trailing text, out of range)
+ */
+std::optional<std::size_t> parseCount(std::string_view text) {
+    std::size_t value = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size() || text.empty()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
     using namespace MathEngine;
 
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--help" || arg == "-h") {
+            std::cout << kUsage;
+            return 0;
+        }
+    }
+
+    // Opt in to the library's parallel paths: --threads N (0 = all cores)
+    std::unique_ptr<Executor> executor;
+    App::DriverOptions driver;
+    App::CoordinatorOptions coordinator;
+    std::optional<App::Endpoint> worker;
+    App::WorkerOptions workerOptions;
+    std::string tracePath;
+    for (int i = 1; i + 1 < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--input") {
+            driver.records = argv[i + 1];
+        } else if (arg == "--lhs") {
+            driver.lhs = argv[i + 1];
+        } else if (arg == "--rhs") {
+            driver.rhs = argv[i + 1];
+        } else if (arg == "--op") {
+            const auto op = App::parseBatchOp(argv[i + 1]);
+            if (!op) {
+                std::cerr << "main_app: unknown --op '" << argv[i + 1] << "'\n";
+                return 2;
+            }
+            driver.op = *op;
+        } else if (arg == "--reduce") {
+            driver.reduce = App::parseReductionOp(argv[i + 1]);
+            if (!driver.reduce) {
+                std::cerr << "main_app: unknown --reduce '" << argv[i + 1] << "'\n";
+                return 2;
+            }
+        } else if (arg == "--workers" || arg == "--worker") {
+            try {
+                if (arg == "--worker") {
+                    worker = App::parseEndpoint(argv[i + 1]);
+                } else {
+                    coordinator.workers = App::parseEndpoints(argv[i + 1]);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "main_app: " << arg << ": " << e.what() << "\n";
+                return 2;
+            }
+        } else if (arg == "--root") {
+            workerOptions.root = argv[i + 1];
+        } else if (arg == "--shards" || arg == "--chunk" || arg == "--threads") {
+            const auto count = parseCount(argv[i + 1]);
+            if (!count) {
+                std::cerr << "main_app: " << arg << " needs a whole number >= 0, not '" << argv[i + 1] << "'\n";
+                return 2;
+            }
+            if (arg == "--shards") {
+                coordinator.shards = *count;
+            } else if (arg == "--chunk") {
+                driver.chunkSize = *count;
+            } else if (*count != 1) {
+                ExecutorOptions options;
+                options.workers = *count > 1 ? *count - 1 : 0;
+                executor = std::make_unique<Executor>(options);
+                Executor::setGlobal(executor.get());
+            }
+        } else if (arg == "--output") {
+            driver.output = argv[i + 1];
+        } else if (arg == "--log-file") {
+            // Append plain log lines to a file instead of stderr
+            try {
+                Logger::setSink(std::make_shared<FileSink>(argv[i + 1]));
+            } catch (const std::exception& e) {
+                std::cerr << "main_app: " << e.what() << "\n";
+                return 2;
+            }
+        } else if (arg == "--trace") {
+            // Chrome trace JSON of the tracing zones, written at exit
+            tracePath = argv[i + 1];
+            if (!Trace::kCompiledIn) {
+                std::cerr << "main_app: --trace needs a MATHENGINE_ENABLE_TRACING build\n";
+            }
+        } else if (arg == "--binary-log") {
+            // Log to binary segments instead; decode them with log_decoder
+            BinaryLog::Options options;
+            options.path = argv[i + 1];
+            try {
+                BinaryLog::open(options);
+            } catch (const std::exception& e) {
+                std::cerr << "main_app: " << e.what() << "\n";
+                return 2;
+            }
+        }
+    }
+
+    // --metrics: print the operation counters in Prometheus format at exit
+    // --once: a worker exits after its first coordinator
+    bool printMetrics = false;
+    for (int i = 1; i < argc; ++i) {
+        printMetrics = printMetrics || std::string_view(argv[i]) == "--metrics";
+        workerOptions.once = workerOptions.once || std::string_view(argv[i]) == "--once";
+    }
+
+    // Written however main returns from here on, so every mode is covered
+    struct TraceWriter {
+        std::string path;
+        ~TraceWriter() {
+            if (!path.empty() && !Trace::writeChromeTrace(path)) {
+                std::cerr << "main_app: cannot write trace to '" << path << "'\n";
+            }
+        }
+    } traceWriter{tracePath};
+
+    if (worker) {
+        try {
+            App::runWorker(*worker, workerOptions);
+        } catch (const std::exception& e) {
+            std::cerr << "main_app: " << e.what() << "\n";
+            return 1;
+        }
+        if (printMetrics) {
+            std::cerr << Metrics::toPrometheus();
+        }
+        return 0;
+    }
+
+    if (!driver.records.empty() || !driver.lhs.empty() || !driver.rhs.empty()) {
+        if (driver.records.empty() == (driver.lhs.empty() || driver.rhs.empty())) {
+            std::cerr << "main_app: give either --input or both --lhs and --rhs\n";
+            return 2;
+        }
+        try {
+            const App::DriverStats stats = coordinator.workers.empty()
+                                               ? App::runBatchDriver(driver)
+                                               : App::runCoordinator(driver, coordinator);
+            const double seconds = stats.seconds > 0.0 ? stats.seconds : 1e-9;
+            std::cerr << std::fixed << std::setprecision(3)
+                      << "Processed " << stats.records << " records ("
+                      << static_cast<double>(stats.inputBytes) / (1024.0 * 1024.0) << " MiB) in "
+                      << stats.seconds << " s: "
+                      << static_cast<double>(stats.records) / seconds / 1e6 << " M records/s, "
+                      << static_cast<double>(stats.inputBytes) / (1024.0 * 1024.0) / seconds
+                      << " MiB/s, " << stats.divisionsByZero << " division(s) by zero\n";
+            if (stats.reduction) {
+                // Shortest round-trip text, so runs can be compared exactly
+                std::string value;
+                App::appendResults(value, std::span(&*stats.reduction, 1));
+                std::cerr << App::toString(*driver.reduce) << " of results: " << value;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "main_app: " << e.what() << "\n";
+            return 1;
+        }
+        if (printMetrics) {
+            std::cerr << Metrics::toPrometheus();
+        }
+        return 0;
+    }
+
     std::cout << "========================================\n";
     std::cout << "  Modern CMake Mastery Demo\n";
     std::cout << "========================================\n\n";
@@ -40,6 +264,29 @@ int main() {
     auto power = Calculator::power(2.0, 10);
     std::cout << "2.0^10 = " << power << "\n\n";
 
+    // Demonstrate batch operations over spans
+    std::cout << "--- Batch Operations ---\n";
+    const std::vector<double> lhs = {1.0, 2.0, 3.0, 4.0};
+    const std::vector<double> rhs = {4.0, 0.0, 2.0, 8.0};
+    std::vector<double> out(lhs.size());
+    Calculator::multiply(lhs, rhs, out);
+    std::cout << "[1 2 3 4] * [4 0 2 8] =";
+    for (double value : out) {
+        std::cout << " " << value;
+    }
+    std::cout << "\n";
+
+    auto status = Calculator::divide(lhs, rhs, out);
+    std::cout << "[1 2 3 4] / [4 0 2 8]: " << status.errorCount
+              << " zero denominator(s), first at index " << status.firstError << "\n\n";
+
+    // Demonstrate reductions (parallel when --threads is given)
+    std::cout << "--- Reductions ---\n";
+    const std::vector<double> series(1'000'000, 0.5);
+    std::cout << "Threads: " << (executor ? executor->concurrency() : 1) << "\n";
+    std::cout << "sum(1e6 x 0.5) = " << Reduction::sum(series) << "\n";
+    std::cout << "max([1 2 3 4]) = " << Reduction::max(lhs) << "\n\n";
+
     // Demonstrate getLastResult
     std::cout << "--- Last Result ---\n";
     std::cout << "Last result: " << Calculator::getLastResult() << "\n\n";
@@ -52,6 +299,10 @@ int main() {
         std::cout << "Caught exception: " << e.what() << "\n";
     }
 
+    if (printMetrics) {
+        std::cout << "\n--- Metrics ---\n" << Metrics::toPrometheus();
+    }
+
     std::cout << "\n========================================\n";
     std::cout << "  CMake Concepts Demonstrated:\n";
     std::cout << "========================================\n";
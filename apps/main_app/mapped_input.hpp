@@ -0,0 +1,145 @@
+#ifndef MAIN_APP_MAPPED_INPUT_HPP
+#define MAIN_APP_MAPPED_INPUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef NOGDI
+#define NOGDI  // wingdi.h's ERROR macro breaks Logger::Level::ERROR
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MathEngine::App {
+
+/**
+ * @brief Read-only mapping of a whole input file, read front to back
+ *
+ * The kernel reads ahead for us; release() hands pages that have been
+ * consumed back, so resident memory stays bounded however big the file is.
+ */
+class MappedInput {
+public:
+    explicit MappedInput(const std::string& path) {
+#if defined(_WIN32)
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            fail(path);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) {
+            CloseHandle(file_);
+            fail(path);
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ != 0) {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_ == nullptr) {
+                CloseHandle(file_);
+                fail(path);
+            }
+            data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, size_));
+            if (data_ == nullptr) {
+                CloseHandle(mapping_);
+                CloseHandle(file_);
+                fail(path);
+            }
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            fail(path);
+        }
+        struct stat info{};
+        if (::fstat(fd_, &info) != 0) {
+            ::close(fd_);
+            fail(path);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ != 0) {  // mmap rejects empty mappings
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd_);
+                fail(path);
+            }
+            data_ = static_cast<const char*>(data);
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+        }
+#endif
+    }
+
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+
+    ~MappedInput() {
+#if defined(_WIN32)
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+            CloseHandle(mapping_);
+        }
+        CloseHandle(file_);
+#else
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+        ::close(fd_);
+#endif
+    }
+
+    std::string_view bytes() const { return {data_, size_}; }
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Tell the kernel the first @p consumed bytes will not be read again
+     */
+    void release([[maybe_unused]] std::size_t consumed) {
+#if !defined(_WIN32)
+        const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t end = consumed / page * page;
+        if (end > released_) {
+            ::madvise(const_cast<char*>(data_) + released_, end - released_, MADV_DONTNEED);
+            released_ = end;
+        }
+#endif
+    }
+
+private:
+    [[noreturn]] static void fail(const std::string& path) {
+#if defined(_WIN32)
+        const int code = static_cast<int>(GetLastError());
+        throw std::system_error(code, std::system_category(), "cannot map '" + path + "'");
+#else
+        throw std::system_error(errno, std::generic_category(), "cannot map '" + path + "'");
+#endif
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+    std::size_t released_ = 0;
+#endif
+};
+
+} // namespace MathEngine::App
+
+#endif // MAIN_APP_MAPPED_INPUT_HPP
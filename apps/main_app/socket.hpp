@@ -0,0 +1,232 @@
+#ifndef MAIN_APP_SOCKET_HPP
+#define MAIN_APP_SOCKET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef NOGDI
+#define NOGDI  // wingdi.h's ERROR macro breaks Logger::Level::ERROR
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace MathEngine::App {
+
+/**
+ * @brief Blocking TCP stream socket, just what the distributed mode needs
+ *
+ * Writes never raise SIGPIPE: a peer that went away is reported as an
+ * exception like any other socket error. Nagle is off, since every frame
+ * is written whole and waited for.
+ */
+class Socket {
+public:
+#if defined(_WIN32)
+    using Handle = SOCKET;
+    static constexpr Handle kInvalid = INVALID_SOCKET;
+#else
+    using Handle = int;
+    static constexpr Handle kInvalid = -1;
+#endif
+
+    Socket() = default;
+
+    Socket(Socket&& other) noexcept : handle_(std::exchange(other.handle_, kInvalid)) {}
+
+    Socket& operator=(Socket&& other) noexcept {
+        if (this != &other) {
+            close();
+            handle_ = std::exchange(other.handle_, kInvalid);
+        }
+        return *this;
+    }
+
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    ~Socket() { close(); }
+
+    explicit operator bool() const { return handle_ != kInvalid; }
+
+    /**
+     * @brief Connect to host:port (a name or a numeric address)
+     * @throws std::system_error if no address of the host accepts
+     */
+    static Socket connect(const std::string& host, std::uint16_t port) {
+        return open(host, port, false);
+    }
+
+    /**
+     * @brief Listen on host:port ("0.0.0.0" or "::" for every interface)
+     */
+    static Socket listen(const std::string& host, std::uint16_t port) {
+        return open(host, port, true);
+    }
+
+    /// Next connection to a listening socket
+    Socket accept() {
+        Socket peer(::accept(handle_, nullptr, nullptr));
+        if (!peer) {
+            fail("accept");
+        }
+        peer.configure();
+        return peer;
+    }
+
+    void sendAll(const void* data, std::size_t bytes) {
+        const char* at = static_cast<const char*>(data);
+        while (bytes != 0) {
+#if defined(_WIN32)
+            const int sent = ::send(handle_, at, static_cast<int>(bytes < 1u << 30 ? bytes : 1u << 30), 0);
+#else
+            const ssize_t sent = ::send(handle_, at, bytes, kSendFlags);
+#endif
+            if (sent <= 0) {
+                fail("send");
+            }
+            at += sent;
+            bytes -= static_cast<std::size_t>(sent);
+        }
+    }
+
+    /**
+     * @brief Read exactly @p bytes
+     * @return false if the peer closed the connection before the first byte
+     * @throws std::system_error on an error, or a close part-way through
+     */
+    bool receiveAll(void* data, std::size_t bytes) {
+        char* at = static_cast<char*>(data);
+        const std::size_t wanted = bytes;
+        while (bytes != 0) {
+#if defined(_WIN32)
+            const int got = ::recv(handle_, at, static_cast<int>(bytes < 1u << 30 ? bytes : 1u << 30), 0);
+#else
+            const ssize_t got = ::recv(handle_, at, bytes, 0);
+#endif
+            if (got == 0 && bytes == wanted) {
+                return false;
+            }
+            if (got <= 0) {
+                if (got == 0) {
+                    throw std::system_error(std::make_error_code(std::errc::connection_reset),
+                                            "peer closed the connection mid-frame");
+                }
+                fail("recv");
+            }
+            at += got;
+            bytes -= static_cast<std::size_t>(got);
+        }
+        return true;
+    }
+
+private:
+#if defined(MSG_NOSIGNAL)
+    static constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+    static constexpr int kSendFlags = 0;
+#endif
+
+    explicit Socket(Handle handle) : handle_(handle) {}
+
+    static Socket open(const std::string& host, std::uint16_t port, bool passive) {
+        startup();
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = passive ? AI_PASSIVE : 0;
+        addrinfo* addresses = nullptr;
+        const std::string service = std::to_string(port);
+        if (const int error = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses); error != 0) {
+            throw std::system_error(std::make_error_code(std::errc::host_unreachable),
+                                    "cannot resolve '" + host + "'");
+        }
+
+        Socket socket;
+        for (addrinfo* address = addresses; address != nullptr && !socket; address = address->ai_next) {
+            Socket candidate(::socket(address->ai_family, address->ai_socktype, address->ai_protocol));
+            if (!candidate) {
+                continue;
+            }
+            if (passive) {
+                const int on = 1;
+                ::setsockopt(candidate.handle_, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on),
+                             sizeof(on));
+                if (::bind(candidate.handle_, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0 &&
+                    ::listen(candidate.handle_, SOMAXCONN) == 0) {
+                    socket = std::move(candidate);
+                }
+            } else if (::connect(candidate.handle_, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0) {
+                candidate.configure();
+                socket = std::move(candidate);
+            }
+        }
+        ::freeaddrinfo(addresses);
+        if (!socket) {
+            fail((passive ? "cannot listen on " : "cannot connect to ") + host + ":" + service);
+        }
+        return socket;
+    }
+
+    void configure() {
+        const int on = 1;
+        ::setsockopt(handle_, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+#if defined(SO_NOSIGPIPE)
+        ::setsockopt(handle_, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    }
+
+    void close() {
+        if (handle_ != kInvalid) {
+#if defined(_WIN32)
+            ::closesocket(handle_);
+#else
+            ::close(handle_);
+#endif
+            handle_ = kInvalid;
+        }
+    }
+
+    static void startup() {
+#if defined(_WIN32)
+        static const bool started = [] {
+            WSADATA data;
+            return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }();
+        if (!started) {
+            fail("WSAStartup");
+        }
+#endif
+    }
+
+    [[noreturn]] static void fail(const std::string& what) {
+#if defined(_WIN32)
+        throw std::system_error(WSAGetLastError(), std::system_category(), what);
+#else
+        throw std::system_error(errno, std::generic_category(), what);
+#endif
+    }
+
+    Handle handle_ = kInvalid;
+};
+
+} // namespace MathEngine::App
+
+#endif // MAIN_APP_SOCKET_HPP
@@ -0,0 +1,249 @@
+#include "bench_common.hpp"
+#include "math/calculator.hpp"
+#include "math/ct_calculator.hpp"
+#include "math/expression.hpp"
+#include "math/fixed_calculator.hpp"
+#include "math/kernel_dispatch.hpp"
+#include "math/operand_store.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+// ============================================================================
+// Batch Operations Across Input Sizes
+// ============================================================================
+// Sizes run from a handful of elements (call overhead dominates) to well
+// past L2 (memory bandwidth dominates). Logging is off at runtime so only
+// the kernels are measured.
+// ============================================================================
+
+template<typename T>
+T element(float value) {
+    if constexpr (requires { T::fromDouble(0.0); }) {
+        return T::fromDouble(value);
+    } else {
+        return T(value);
+    }
+}
+
+template<typename T = double>
+struct BatchInput {
+    explicit BatchInput(std::size_t n) : a(n), b(n), out(n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = element<T>(0.5f + static_cast<float>(i % 97));
+            b[i] = element<T>(1.25f + static_cast<float>(i % 89));
+        }
+    }
+
+    std::vector<T> a;
+    std::vector<T> b;
+    std::vector<T> out;
+};
+
+template<typename T = double, typename Op>
+void runBatch(benchmark::State& state, Op op) {
+    bench::SilencedCerr silenced;
+    bench::ScopedLogLevel level(Logger::Level::OFF);
+
+    BatchInput<T> input(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        op(input);
+        benchmark::DoNotOptimize(input.out.data());
+        benchmark::ClobberMemory();
+    }
+
+    const auto elements = state.iterations() * state.range(0);
+    state.SetItemsProcessed(elements);
+    // Two inputs read, one output written
+    state.SetBytesProcessed(elements * static_cast<int64_t>(3 * sizeof(T)));
+}
+
+// Baseline: the scalar API called once per element
+void BM_ScalarLoopAdd(benchmark::State& state) {
+    runBatch(state, [](auto& in) {
+        for (std::size_t i = 0; i < in.out.size(); ++i) {
+            in.out[i] = Calculator::add(in.a[i], in.b[i]);
+        }
+    });
+}
+
+void BM_BatchAdd(benchmark::State& state) {
+    runBatch(state, [](auto& in) { Calculator::add(in.a, in.b, in.out); });
+}
+
+// The same add over narrower elements: fewer bytes per element moved
+void BM_BatchAddFloat(benchmark::State& state) {
+    runBatch<float>(state, [](auto& in) { Calculator::add(in.a, in.b, in.out); });
+}
+
+void BM_BatchAddFloat16(benchmark::State& state) {
+    runBatch<Float16>(state, [](auto& in) { Calculator::add(in.a, in.b, in.out); });
+}
+
+void BM_BatchAddBFloat16(benchmark::State& state) {
+    runBatch<BFloat16>(state, [](auto& in) { Calculator::add(in.a, in.b, in.out); });
+}
+
+void BM_BatchMultiply(benchmark::State& state) {
+    runBatch(state, [](auto& in) { Calculator::multiply(in.a, in.b, in.out); });
+}
+
+void BM_BatchMultiplyScalar(benchmark::State& state) {
+    runBatch(state, [](auto& in) { Calculator::multiply(in.a, 1.5, in.out); });
+}
+
+void BM_BatchDivide(benchmark::State& state) {
+    runBatch(state, [](auto& in) {
+        benchmark::DoNotOptimize(Calculator::divide(in.a, in.b, in.out));
+    });
+}
+
+void BM_BatchPower(benchmark::State& state) {
+    runBatch(state, [](auto& in) { Calculator::power(in.a, 7, in.out); });
+}
+
+void BM_ExpressionEvaluate(benchmark::State& state) {
+    const Expression expression("(a + 1) * b ^ 2 - a / b");
+    runBatch(state, [&](auto& in) {
+        const std::span<const double> columns[] = {in.a, in.b};
+        benchmark::DoNotOptimize(expression.evaluate(columns, in.out));
+    });
+}
+
+// a * b + a as two library calls with a temporary pass over out ...
+void BM_BatchMultiplyAddChain(benchmark::State& state) {
+    runBatch(state, [](auto& in) {
+        Calculator::multiply(in.a, in.b, in.out);
+        Calculator::add(in.out, in.a, in.out);
+    });
+}
+
+// ... and as one inlined ct::Calculator loop (fused where FMA is available)
+void BM_CtMultiplyAdd(benchmark::State& state) {
+    using Ct = ct::Calculator;
+    runBatch(state, [](auto& in) {
+        Ct::evaluate(Ct::add(Ct::multiply(in.a, in.b), in.a), in.out);
+    });
+}
+
+// A four-step scalar chain as one batch call per step, each a full pass ...
+void BM_BatchScalarChain(benchmark::State& state) {
+    runBatch(state, [](auto& in) {
+        Calculator::add(in.a, 0.5, in.out);
+        Calculator::multiply(in.out, 1.25, in.out);
+        Calculator::subtract(in.out, 3.0, in.out);
+        Calculator::power(in.out, 2, in.out);
+    });
+}
+
+// ... and as one Calculator chain, all steps per L1-sized tile
+void BM_CalculatorChain(benchmark::State& state) {
+    Calculator chain;
+    chain.add(0.5).multiply(1.25).subtract(3.0).power(2);
+    runBatch(state, [&](auto& in) {
+        benchmark::DoNotOptimize(chain.evaluate(in.a, in.out));
+    });
+}
+
+// A mixed workload of {op, a, b} records (every op, three exponents) fed
+// one scalar call per record ...
+void BM_MixedRecordsScalar(benchmark::State& state) {
+    runBatch(state, [](auto& in) {
+        for (std::size_t i = 0; i < in.out.size(); ++i) {
+            switch (i % kBatchOpCount) {
+                case 0: in.out[i] = Calculator::add(in.a[i], in.b[i]); break;
+                case 1: in.out[i] = Calculator::subtract(in.a[i], in.b[i]); break;
+                case 2: in.out[i] = Calculator::multiply(in.a[i], in.b[i]); break;
+                case 3: in.out[i] = Calculator::divide(in.a[i], in.b[i]); break;
+                default: in.out[i] = Calculator::power(in.a[i], static_cast<std::int32_t>(i % 3) + 2); break;
+            }
+        }
+    });
+}
+
+// ... and pushed into an OperandStore, then run one opcode group at a time
+void BM_MixedRecordsStore(benchmark::State& state) {
+    OperandStore store;
+    runBatch(state, [&](auto& in) {
+        store.clear();
+        for (std::size_t i = 0; i < in.out.size(); ++i) {
+            const auto op = static_cast<BatchOp>(i % kBatchOpCount);
+            store.push(op, in.a[i], op == BatchOp::Power ? static_cast<double>(i % 3 + 2) : in.b[i]);
+        }
+        benchmark::DoNotOptimize(Calculator::evaluate(store, in.out));
+    });
+}
+
+// ============================================================================
+// Fixed Point
+// ============================================================================
+// Q16.16 rescales with a shift, the decimal format with a reciprocal of its
+// scale; dividing by one value uses that value's reciprocal.
+// ============================================================================
+
+using Q16 = FixedCalculator<QFormat<16>>;
+using Milli = FixedCalculator<DecimalFormat<3>>;
+
+void BM_FixedBatchAdd(benchmark::State& state) {
+    runBatch<Q16::Value>(state, [](auto& in) { benchmark::DoNotOptimize(Q16::add(in.a, in.b, in.out)); });
+}
+
+void BM_FixedBatchMultiply(benchmark::State& state) {
+    runBatch<Q16::Value>(state, [](auto& in) { benchmark::DoNotOptimize(Q16::multiply(in.a, in.b, in.out)); });
+}
+
+void BM_FixedBatchMultiplyDecimal(benchmark::State& state) {
+    runBatch<Milli::Value>(state, [](auto& in) {
+        benchmark::DoNotOptimize(Milli::multiply(in.a, in.b, in.out));
+    });
+}
+
+void BM_FixedBatchDivide(benchmark::State& state) {
+    runBatch<Q16::Value>(state, [](auto& in) { benchmark::DoNotOptimize(Q16::divide(in.a, in.b, in.out)); });
+}
+
+void BM_FixedBatchDivideScalar(benchmark::State& state) {
+    const auto divisor = Q16::Value::fromDouble(3.7);
+    runBatch<Q16::Value>(state, [&](auto& in) {
+        benchmark::DoNotOptimize(Q16::divide(in.a, divisor, in.out));
+    });
+}
+
+// Every report names the kernel tier it measured (see benchmark_tiers)
+const bool kTierContext = [] {
+    benchmark::AddCustomContext("kernel_tier", std::string(toString(KernelDispatch::active())));
+    return true;
+}();
+
+} // namespace
+
+BENCHMARK(BM_ScalarLoopAdd)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchAdd)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchAddFloat)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchAddFloat16)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchAddBFloat16)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchMultiply)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchMultiplyScalar)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchDivide)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchPower)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_ExpressionEvaluate)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchMultiplyAddChain)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_CtMultiplyAdd)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_BatchScalarChain)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_CalculatorChain)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_MixedRecordsScalar)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_MixedRecordsStore)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_FixedBatchAdd)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_FixedBatchMultiply)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_FixedBatchMultiplyDecimal)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_FixedBatchDivide)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK(BM_FixedBatchDivideScalar)->RangeMultiplier(8)->Range(8, 1 << 18);
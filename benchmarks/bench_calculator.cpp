@@ -0,0 +1,102 @@
+#include "bench_common.hpp"
+#include "math/calculator.hpp"
+#include "math/memo_cache.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace MathEngine;
+
+namespace {
+
+// ============================================================================
+// Scalar Operations
+// ============================================================================
+// Argument 0 runs with logging off at runtime (the level check only),
+// argument 1 with every level on and output discarded. The difference is
+// the per-call logging overhead.
+// ============================================================================
+
+template<typename Op>
+void runScalar(benchmark::State& state, Op op) {
+    bench::SilencedCerr silenced;
+    bench::ScopedLogLevel level(state.range(0) != 0 ? Logger::Level::DEBUG : Logger::Level::OFF);
+    state.SetLabel(state.range(0) != 0 ? "logging on" : "logging off");
+
+    double a = 1.5;
+    double b = 2.25;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        benchmark::DoNotOptimize(op(a, b));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Add(benchmark::State& state) {
+    runScalar(state, [](double a, double b) { return Calculator::add(a, b); });
+}
+
+void BM_Subtract(benchmark::State& state) {
+    runScalar(state, [](double a, double b) { return Calculator::subtract(a, b); });
+}
+
+void BM_Multiply(benchmark::State& state) {
+    runScalar(state, [](double a, double b) { return Calculator::multiply(a, b); });
+}
+
+void BM_Divide(benchmark::State& state) {
+    runScalar(state, [](double a, double b) { return Calculator::divide(a, b); });
+}
+
+void BM_Power(benchmark::State& state) {
+    runScalar(state, [](double a, double) { return Calculator::power(a, 13); });
+}
+
+// Argument 0 computes every call, argument 1 answers repeats from the
+// MemoCache (logging off in both): the exponent is large enough for
+// squaring to cost more than a thread-tier lookup.
+void BM_PowerMemoized(benchmark::State& state) {
+    bench::ScopedLogLevel level(Logger::Level::OFF);
+    MemoCacheOptions options;
+    options.enabled = state.range(0) != 0;
+    MemoCache::configure(options);
+    state.SetLabel(options.enabled ? "cached" : "computed");
+
+    double a = 1.0000001;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(Calculator::power(a, 1'000'003));
+    }
+    state.SetItemsProcessed(state.iterations());
+    MemoCache::configure(MemoCacheOptions{});
+}
+
+// Three dependent steps as static calls, then as one recorded chain
+void BM_StaticSteps(benchmark::State& state) {
+    runScalar(state, [](double a, double b) {
+        return Calculator::power(Calculator::multiply(Calculator::add(a, b), b), 2);
+    });
+}
+
+void BM_ChainedSteps(benchmark::State& state) {
+    runScalar(state, [](double a, double b) {
+        Calculator chain{a};
+        return chain.add(b).multiply(b).power(2).value();
+    });
+}
+
+void BM_GetLastResult(benchmark::State& state) {
+    runScalar(state, [](double, double) { return Calculator::getLastResult(); });
+}
+
+} // namespace
+
+BENCHMARK(BM_Add)->ArgName("logging")->Arg(0)->Arg(1);
+BENCHMARK(BM_Subtract)->ArgName("logging")->Arg(0)->Arg(1);
+BENCHMARK(BM_Multiply)->ArgName("logging")->Arg(0)->Arg(1);
+BENCHMARK(BM_Divide)->ArgName("logging")->Arg(0)->Arg(1);
+BENCHMARK(BM_Power)->ArgName("logging")->Arg(0)->Arg(1);
+BENCHMARK(BM_PowerMemoized)->ArgName("cache")->Arg(0)->Arg(1);
+BENCHMARK(BM_StaticSteps)->ArgName("logging")->Arg(0)->Arg(1);
+BENCHMARK(BM_ChainedSteps)->ArgName("logging")->Arg(0)->Arg(1);
+BENCHMARK(BM_GetLastResult)->ArgName("logging")->Arg(0)->Arg(1);
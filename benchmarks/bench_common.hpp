@@ -0,0 +1,77 @@
+#ifndef MATHENGINE_BENCH_COMMON_HPP
+#define MATHENGINE_BENCH_COMMON_HPP
+
+#include "logger/logger.hpp"
+#include "math/executor.hpp"
+
+#include <iostream>
+#include <streambuf>
+
+namespace MathEngine::bench {
+
+/**
+ * @brief Stream buffer that accepts and discards everything
+ *
+ * Benchmarks with logging enabled still pay for formatting and the write
+ * call, but not for a terminal scrolling through millions of lines.
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+/**
+ * @brief Sends std::cerr to a NullBuffer for the lifetime of the object
+ */
+class SilencedCerr {
+public:
+    SilencedCerr() : previous_(std::cerr.rdbuf(&buffer_)) {}
+    ~SilencedCerr() { std::cerr.rdbuf(previous_); }
+
+    SilencedCerr(const SilencedCerr&) = delete;
+    SilencedCerr& operator=(const SilencedCerr&) = delete;
+
+private:
+    NullBuffer buffer_;
+    std::streambuf* previous_;
+};
+
+/**
+ * @brief Sets the runtime log level for the lifetime of the object
+ */
+class ScopedLogLevel {
+public:
+    explicit ScopedLogLevel(Logger::Level level) : previous_(Logger::getLevel()) {
+        Logger::setLevel(level);
+    }
+    ~ScopedLogLevel() { Logger::setLevel(previous_); }
+
+    ScopedLogLevel(const ScopedLogLevel&) = delete;
+    ScopedLogLevel& operator=(const ScopedLogLevel&) = delete;
+
+private:
+    Logger::Level previous_;
+};
+
+/**
+ * @brief Installs one process-wide pool as Executor::global() for the
+ *        lifetime of the object
+ */
+class ScopedGlobalExecutor {
+public:
+    ScopedGlobalExecutor() { Executor::setGlobal(&pool()); }
+    ~ScopedGlobalExecutor() { Executor::setGlobal(nullptr); }
+
+    ScopedGlobalExecutor(const ScopedGlobalExecutor&) = delete;
+    ScopedGlobalExecutor& operator=(const ScopedGlobalExecutor&) = delete;
+
+    static Executor& pool() {
+        static Executor executor;
+        return executor;
+    }
+};
+
+} // namespace MathEngine::bench
+
+#endif // MATHENGINE_BENCH_COMMON_HPP
@@ -0,0 +1,170 @@
+#include "bench_common.hpp"
+#include "logger/binary_log.hpp"
+#include "logger/logger.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace MathEngine;
+
+namespace {
+
+// ============================================================================
+// Shared Setup
+// ============================================================================
+// Setup/Teardown run once per benchmark run, outside the timed threads, so
+// every thread logs into the same silenced stream and backend.
+// ============================================================================
+
+std::optional<bench::SilencedCerr> silenced;
+std::optional<bench::ScopedLogLevel> level;
+
+void setupSync(const benchmark::State&) {
+    silenced.emplace();
+    level.emplace(Logger::Level::DEBUG);
+}
+
+void setupAsync(const benchmark::State& state) {
+    setupSync(state);
+    Logger::enableAsync();
+}
+
+// NullSink: formatting and queueing cost without the stream behind it
+void setupNull(const benchmark::State& state) {
+    setupSync(state);
+    Logger::setSink(std::make_shared<NullSink>());
+}
+
+void setupAsyncNull(const benchmark::State& state) {
+    setupNull(state);
+    Logger::enableAsync();
+}
+
+// A rate limit that admits almost nothing: the cost of a suppressed call
+void setupRateLimited(const benchmark::State& state) {
+    setupSync(state);
+    Logger::setRateLimit(Logger::Level::INFO, {0.01, 1});
+}
+
+void setupFiltered(const benchmark::State&) {
+    silenced.emplace();
+    level.emplace(Logger::Level::ERROR);
+}
+
+void teardown(const benchmark::State&) {
+    Logger::shutdown();
+    Logger::setSink(nullptr);
+    Logger::setRateLimit(Logger::Level::INFO, {});
+    level.reset();
+    silenced.reset();
+}
+
+std::string binaryLogPath() {
+    return (std::filesystem::temp_directory_path() / "mathengine_bench.blog").string();
+}
+
+void setupBinary(const benchmark::State& state) {
+    setupSync(state);
+    BinaryLog::Options options;
+    options.path = binaryLogPath();
+    options.maxSegments = 2;
+    options.clock = BinaryLog::Clock::Tsc;
+    BinaryLog::open(options);
+}
+
+void teardownBinary(const benchmark::State& state) {
+    BinaryLog::close();
+    for (std::size_t i = 0; i < 1000; ++i) {
+        std::remove(BinaryLog::segmentPath(binaryLogPath(), i).c_str());
+    }
+    teardown(state);
+}
+
+// ============================================================================
+// Logger::log Throughput
+// ============================================================================
+
+void BM_LogPlain(benchmark::State& state) {
+    for (auto _ : state) {
+        Logger::log(Logger::Level::INFO, "Calculating: 1.5 + 2.25");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_LogFormatted(benchmark::State& state) {
+    double value = 1.5;
+    for (auto _ : state) {
+        Logger::log(Logger::Level::INFO, "Calculating: {} + {}", value, 2.25);
+        value += 1.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The macro path: text to the stream, or a binary record while BinaryLog is open
+void BM_LogMacro(benchmark::State& state) {
+    double value = 1.5;
+    for (auto _ : state) {
+        MATHENGINE_LOG_INFO("Calculating: {} + {}", value, 2.25);
+        value += 1.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// A call below the runtime level: the cost every disabled log site pays
+void BM_LogFiltered(benchmark::State& state) {
+    double value = 1.5;
+    for (auto _ : state) {
+        MATHENGINE_LOG_DEBUG("Result: {}", value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Suppressed sampled sites: per-thread counting, and a shared read for the bucket
+void BM_LogEveryN(benchmark::State& state) {
+    double value = 1.5;
+    for (auto _ : state) {
+        MATHENGINE_LOG_INFO_EVERY_N(1'000'000, "Calculating: {} + {}", value, 2.25);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_LogRateLimited(benchmark::State& state) {
+    double value = 1.5;
+    for (auto _ : state) {
+        MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {} + {}", value, 2.25);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(BM_LogPlain)->Name("BM_LogPlain/sync")
+    ->Setup(setupSync)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogPlain)->Name("BM_LogPlain/async")
+    ->Setup(setupAsync)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogPlain)->Name("BM_LogPlain/null")
+    ->Setup(setupNull)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogPlain)->Name("BM_LogPlain/async_null")
+    ->Setup(setupAsyncNull)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogFormatted)->Name("BM_LogFormatted/sync")
+    ->Setup(setupSync)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogFormatted)->Name("BM_LogFormatted/async")
+    ->Setup(setupAsync)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogMacro)->Name("BM_LogMacro/sync")
+    ->Setup(setupSync)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogMacro)->Name("BM_LogMacro/binary")
+    ->Setup(setupBinary)->Teardown(teardownBinary)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogFiltered)
+    ->Setup(setupFiltered)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogEveryN)
+    ->Setup(setupSync)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+BENCHMARK(BM_LogRateLimited)
+    ->Setup(setupRateLimited)->Teardown(teardown)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
@@ -0,0 +1,102 @@
+#include "bench_common.hpp"
+#include "math/reduction.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+// ============================================================================
+// Reductions Across Modes and Thread Counts
+// ============================================================================
+// Arguments: element count and thread limit (capped by the shared pool).
+// Small inputs never leave the calling thread; the largest show what the
+// thread split buys.
+// ============================================================================
+
+template<typename T = double, typename Reduce>
+void runReduction(benchmark::State& state, ReductionMode mode, Reduce reduce) {
+    bench::SilencedCerr silenced;
+    bench::ScopedLogLevel level(Logger::Level::OFF);
+    bench::ScopedGlobalExecutor executor;
+
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const std::vector<T> a(n, T(1.25f));
+    const std::vector<T> b(n, T(0.5f));
+
+    ReductionOptions options;
+    options.mode = mode;
+    options.maxThreads = static_cast<std::size_t>(state.range(1));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reduce(a, b, options));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(T)));
+}
+
+void BM_SumDeterministic(benchmark::State& state) {
+    runReduction(state, ReductionMode::Deterministic,
+                 [](const auto& a, const auto&, const auto& o) { return Reduction::sum(a, o); });
+}
+
+// Narrower elements, accumulated in float
+void BM_SumDeterministicFloat(benchmark::State& state) {
+    runReduction<float>(state, ReductionMode::Deterministic,
+                        [](const auto& a, const auto&, const auto& o) { return Reduction::sum(a, o); });
+}
+
+void BM_SumDeterministicFloat16(benchmark::State& state) {
+    runReduction<Float16>(state, ReductionMode::Deterministic,
+                          [](const auto& a, const auto&, const auto& o) { return Reduction::sum(a, o); });
+}
+
+void BM_SumFast(benchmark::State& state) {
+    runReduction(state, ReductionMode::Fast,
+                 [](const auto& a, const auto&, const auto& o) { return Reduction::sum(a, o); });
+}
+
+void BM_DotDeterministic(benchmark::State& state) {
+    runReduction(state, ReductionMode::Deterministic,
+                 [](const auto& a, const auto& b, const auto& o) { return Reduction::dot(a, b, o); });
+}
+
+void BM_DotDeterministicBFloat16(benchmark::State& state) {
+    runReduction<BFloat16>(state, ReductionMode::Deterministic,
+                           [](const auto& a, const auto& b, const auto& o) { return Reduction::dot(a, b, o); });
+}
+
+void BM_DotFast(benchmark::State& state) {
+    runReduction(state, ReductionMode::Fast,
+                 [](const auto& a, const auto& b, const auto& o) { return Reduction::dot(a, b, o); });
+}
+
+void BM_Min(benchmark::State& state) {
+    runReduction(state, ReductionMode::Deterministic,
+                 [](const auto& a, const auto&, const auto& o) { return Reduction::min(a, o); });
+}
+
+void reductionArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "threads"});
+    for (const int64_t n : {int64_t{1} << 12, int64_t{1} << 20, int64_t{1} << 24}) {
+        for (const int64_t threads : {1, 4, 16}) {
+            b->Args({n, threads});
+        }
+    }
+    b->UseRealTime();
+}
+
+} // namespace
+
+BENCHMARK(BM_SumDeterministic)->Apply(reductionArgs);
+BENCHMARK(BM_SumDeterministicFloat)->Apply(reductionArgs);
+BENCHMARK(BM_SumDeterministicFloat16)->Apply(reductionArgs);
+BENCHMARK(BM_SumFast)->Apply(reductionArgs);
+BENCHMARK(BM_DotDeterministic)->Apply(reductionArgs);
+BENCHMARK(BM_DotDeterministicBFloat16)->Apply(reductionArgs);
+BENCHMARK(BM_DotFast)->Apply(reductionArgs);
+BENCHMARK(BM_Min)->Apply(reductionArgs);
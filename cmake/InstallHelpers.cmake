@@ -47,28 +47,90 @@ function(setup_target_warnings)
     message(VERBOSE "Configured warnings for ${ARGS_TARGET}")
 endfunction()
 
+# ============================================================================
+# Function: setup_target_visibility
+# ============================================================================
+# Hides every symbol of a library target except those marked with its
+# export macro, and generates the header defining that macro. For a static
+# library the macro expands to nothing (<BASE_NAME>_STATIC_DEFINE is set
+# for the target and its consumers). The generated header contains only
+# preprocessor definitions, so C headers can include it too.
+#
+# Parameters:
+#   TARGET - The library target to configure
+#   BASE_NAME - Macro prefix (e.g. MYLIB gives MYLIB_STATIC_DEFINE)
+#   EXPORT_MACRO - Name of the export macro (e.g. MYLIB_API)
+#   EXPORT_HEADER - Path of the generated header
+#
+# Usage:
+#   setup_target_visibility(
+#       TARGET mylib
+#       BASE_NAME MYLIB
+#       EXPORT_MACRO MYLIB_API
+#       EXPORT_HEADER ${CMAKE_CURRENT_BINARY_DIR}/include/mylib/export.h
+#   )
+# ============================================================================
+
+function(setup_target_visibility)
+    cmake_parse_arguments(ARGS
+        ""
+        "TARGET;BASE_NAME;EXPORT_MACRO;EXPORT_HEADER"
+        ""
+        ${ARGN}
+    )
+
+    if(NOT ARGS_TARGET OR NOT ARGS_BASE_NAME OR NOT ARGS_EXPORT_MACRO OR NOT ARGS_EXPORT_HEADER)
+        message(FATAL_ERROR
+            "setup_target_visibility: TARGET, BASE_NAME, EXPORT_MACRO and EXPORT_HEADER are required")
+    endif()
+
+    include(GenerateExportHeader)
+    generate_export_header(${ARGS_TARGET}
+        BASE_NAME ${ARGS_BASE_NAME}
+        EXPORT_MACRO_NAME ${ARGS_EXPORT_MACRO}
+        EXPORT_FILE_NAME ${ARGS_EXPORT_HEADER}
+    )
+
+    set_target_properties(${ARGS_TARGET} PROPERTIES
+        CXX_VISIBILITY_PRESET hidden
+        VISIBILITY_INLINES_HIDDEN ON
+    )
+
+    get_target_property(target_type ${ARGS_TARGET} TYPE)
+    if(target_type STREQUAL "STATIC_LIBRARY")
+        target_compile_definitions(${ARGS_TARGET} PUBLIC ${ARGS_BASE_NAME}_STATIC_DEFINE)
+    endif()
+
+    message(VERBOSE "Configured ${target_type} visibility for ${ARGS_TARGET}")
+endfunction()
+
 # ============================================================================
 # Function: install_target_with_headers
 # ============================================================================
-# Installs a library target and its headers with proper export
+# Installs a library target and its headers with proper export. Shared
+# libraries are installed with their version symlinks (and DLLs to bin/).
 #
 # Parameters:
 #   TARGET - The target to install
 #   EXPORT_SET - The export set name
 #   HEADER_DIR - Directory containing headers (relative to CMAKE_CURRENT_SOURCE_DIR)
+#   GENERATED_HEADER_DIR - (Optional) Build-tree directory with generated
+#                          headers (e.g. from setup_target_visibility),
+#                          installed into the same include directory
 #
 # Usage:
 #   install_target_with_headers(
 #       TARGET mylib
 #       EXPORT_SET MyProjectTargets
 #       HEADER_DIR include
+#       GENERATED_HEADER_DIR ${CMAKE_CURRENT_BINARY_DIR}/include
 #   )
 # ============================================================================
 
 function(install_target_with_headers)
     cmake_parse_arguments(ARGS
         ""
-        "TARGET;EXPORT_SET;HEADER_DIR"
+        "TARGET;EXPORT_SET;HEADER_DIR;GENERATED_HEADER_DIR"
         ""
         ${ARGN}
     )
@@ -93,16 +155,16 @@ function(install_target_with_headers)
     )
 
     # Install headers if directory specified
-    if(ARGS_HEADER_DIR)
+    foreach(header_dir IN ITEMS ${ARGS_HEADER_DIR} ${ARGS_GENERATED_HEADER_DIR})
         install(
-            DIRECTORY ${ARGS_HEADER_DIR}/
+            DIRECTORY ${header_dir}/
             DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}
             FILES_MATCHING
                 PATTERN "*.hpp"
                 PATTERN "*.h"
                 PATTERN "*.hxx"
         )
-    endif()
+    endforeach()
 
     message(VERBOSE "Installed target ${ARGS_TARGET} with headers")
 endfunction()
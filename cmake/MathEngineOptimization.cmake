@@ -0,0 +1,172 @@
+# ============================================================================
+# MathEngineOptimization.cmake
+# ============================================================================
+# Opt-in optimized build profile: link-time optimization (IPO/LTO) and
+# profile-guided optimization (PGO) trained on the benchmark suite.
+#
+#   MATHENGINE_ENABLE_IPO=ON    Compile everything for LTO. math_engine's
+#                               installed target carries the LTO flags, so
+#                               consumers built with the same compiler
+#                               inline Calculator calls without extra flags
+#                               (static builds only: calls into a shared
+#                               library cannot be inlined). GCC and Clang
+#                               18+ (ELF) write fat objects, which also
+#                               link without LTO; older Clang archives are
+#                               bitcode only (a warning says so).
+#   MATHENGINE_PGO=GENERATE     Instrumented build; 'pgo_train' runs the
+#                               benchmarks and records profiles.
+#   MATHENGINE_PGO=USE          Optimize with the recorded profiles.
+#
+# Typical flow, all in one build directory (profiles are keyed by object path):
+#   cmake -B build-opt -DCMAKE_BUILD_TYPE=Release -DBUILD_BENCHMARKS=ON \
+#         -DMATHENGINE_ENABLE_IPO=ON -DMATHENGINE_PGO=GENERATE
+#   cmake --build build-opt --target pgo_train
+#   cmake -B build-opt -DMATHENGINE_PGO=USE
+#   cmake --build build-opt && cmake --install build-opt --prefix <prefix>
+#
+# Include before the targets are created: the settings apply to every
+# target defined afterwards (library, apps, tests and benchmarks alike).
+# ============================================================================
+
+option(MATHENGINE_ENABLE_IPO "Build with interprocedural (link-time) optimization" OFF)
+
+set(MATHENGINE_PGO "OFF" CACHE STRING
+    "Profile-guided optimization phase (OFF, GENERATE, USE)")
+set_property(CACHE MATHENGINE_PGO PROPERTY STRINGS OFF GENERATE USE)
+
+set(MATHENGINE_PGO_DIR "${CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH
+    "Directory the PGO training run writes profiles to")
+
+# Exported through MathEngineConfig.cmake; both stay empty without IPO
+set(MATHENGINE_IPO_COMPILE_FLAGS "")
+set(MATHENGINE_IPO_LINK_FLAGS "")
+
+# ============================================================================
+# Interprocedural Optimization
+# ============================================================================
+if(MATHENGINE_ENABLE_IPO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT MATHENGINE_IPO_SUPPORTED OUTPUT MATHENGINE_IPO_ERROR LANGUAGES CXX)
+
+    if(MATHENGINE_IPO_SUPPORTED)
+        set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+
+        if(BUILD_SHARED_LIBS)
+            # Nothing to export: consumers call into the shared library
+        elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            # Fat objects keep regular code next to the LTO bytecode, so the
+            # static archive also links into consumers that don't use LTO
+            add_compile_options(-ffat-lto-objects)
+            set(MATHENGINE_IPO_COMPILE_FLAGS -flto=auto)
+            set(MATHENGINE_IPO_LINK_FLAGS -flto=auto)
+        elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            # Same for Clang 18+ on ELF targets. Older Clang (and Apple's)
+            # can only write bitcode, which just LTO links with the same
+            # LLVM can read: say so rather than ship an archive that fails
+            # to link anywhere else.
+            if(CMAKE_CXX_COMPILER_ID STREQUAL "Clang" AND NOT APPLE AND NOT WIN32
+               AND CMAKE_CXX_COMPILER_VERSION VERSION_GREATER_EQUAL 18)
+                add_compile_options(-ffat-lto-objects)
+            else()
+                message(WARNING "MathEngine: ${CMAKE_CXX_COMPILER_ID} ${CMAKE_CXX_COMPILER_VERSION} "
+                                "cannot write fat LTO objects, so the static math_engine holds "
+                                "LLVM bitcode only. Consumers must link it with -flto and the same "
+                                "LLVM version; use BUILD_SHARED_LIBS=ON or leave IPO OFF for others.")
+            endif()
+            set(MATHENGINE_IPO_COMPILE_FLAGS -flto=thin)
+            set(MATHENGINE_IPO_LINK_FLAGS -flto=thin)
+        elseif(MSVC)
+            set(MATHENGINE_IPO_COMPILE_FLAGS /GL)
+            set(MATHENGINE_IPO_LINK_FLAGS /LTCG)
+        endif()
+    else()
+        message(WARNING "MathEngine: IPO not supported by this toolchain, building without it:\n"
+                        "${MATHENGINE_IPO_ERROR}")
+    endif()
+endif()
+
+# ============================================================================
+# Profile-Guided Optimization
+# ============================================================================
+if(NOT MATHENGINE_PGO MATCHES "^(OFF|GENERATE|USE)$")
+    message(FATAL_ERROR "Invalid MATHENGINE_PGO '${MATHENGINE_PGO}' (expected OFF, GENERATE or USE)")
+endif()
+
+set(MATHENGINE_PGO_PROFDATA "${MATHENGINE_PGO_DIR}/mathengine.profdata")
+
+if(NOT MATHENGINE_PGO STREQUAL "OFF")
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        if(MATHENGINE_PGO STREQUAL "GENERATE")
+            # Atomic counter updates: the benchmarks run the thread pool
+            add_compile_options(-fprofile-generate=${MATHENGINE_PGO_DIR} -fprofile-update=atomic)
+            add_link_options(-fprofile-generate=${MATHENGINE_PGO_DIR})
+        else()
+            # Code the training run never reached is optimized normally
+            add_compile_options(-fprofile-use=${MATHENGINE_PGO_DIR} -fprofile-partial-training
+                                -Wno-missing-profile)
+            add_link_options(-fprofile-use=${MATHENGINE_PGO_DIR})
+        endif()
+    elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        if(MATHENGINE_PGO STREQUAL "GENERATE")
+            add_compile_options(-fprofile-generate=${MATHENGINE_PGO_DIR})
+            add_link_options(-fprofile-generate=${MATHENGINE_PGO_DIR})
+        else()
+            if(NOT EXISTS "${MATHENGINE_PGO_PROFDATA}")
+                message(FATAL_ERROR "MathEngine: ${MATHENGINE_PGO_PROFDATA} not found - "
+                                    "build 'pgo_train' with MATHENGINE_PGO=GENERATE first")
+            endif()
+            add_compile_options(-fprofile-use=${MATHENGINE_PGO_PROFDATA} -Wno-profile-instr-unprofiled)
+            add_link_options(-fprofile-use=${MATHENGINE_PGO_PROFDATA})
+        endif()
+    else()
+        message(WARNING "MathEngine: PGO is only wired up for GCC and Clang, ignoring MATHENGINE_PGO")
+        set(MATHENGINE_PGO "OFF")
+    endif()
+
+    if(MATHENGINE_PGO STREQUAL "GENERATE" AND ENABLE_INSTALL)
+        message(STATUS "MathEngine: PGO GENERATE builds are instrumented - install the USE build")
+    endif()
+endif()
+
+# ============================================================================
+# Function: mathengine_add_pgo_training
+# ============================================================================
+# Adds the 'pgo_train' target: a fresh training run of TARGET (with ARGS)
+# that leaves its profiles in MATHENGINE_PGO_DIR, merged for Clang.
+# Only defined in GENERATE builds.
+#
+# Usage:
+#   mathengine_add_pgo_training(TARGET math_benchmarks ARGS --benchmark_min_time=0.05)
+# ============================================================================
+function(mathengine_add_pgo_training)
+    cmake_parse_arguments(ARGS "" "TARGET" "ARGS" ${ARGN})
+
+    if(NOT ARGS_TARGET)
+        message(FATAL_ERROR "mathengine_add_pgo_training: TARGET is required")
+    endif()
+    if(NOT MATHENGINE_PGO STREQUAL "GENERATE")
+        return()
+    endif()
+
+    set(merge_command "")
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        get_filename_component(compiler_dir "${CMAKE_CXX_COMPILER}" DIRECTORY)
+        find_program(LLVM_PROFDATA NAMES llvm-profdata HINTS "${compiler_dir}" REQUIRED)
+        set(merge_command
+            COMMAND ${CMAKE_COMMAND} -DPROFDATA=${LLVM_PROFDATA} -DDIR=${MATHENGINE_PGO_DIR}
+                    -DOUTPUT=${MATHENGINE_PGO_PROFDATA}
+                    -P ${PROJECT_SOURCE_DIR}/cmake/MergeProfiles.cmake)
+    endif()
+
+    add_custom_target(pgo_train
+        COMMAND ${CMAKE_COMMAND} -E rm -rf ${MATHENGINE_PGO_DIR}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${MATHENGINE_PGO_DIR}
+        COMMAND ${ARGS_TARGET} ${ARGS_ARGS}
+        ${merge_command}
+        DEPENDS ${ARGS_TARGET}
+        COMMENT "PGO training run: ${ARGS_TARGET} -> ${MATHENGINE_PGO_DIR}"
+        USES_TERMINAL
+        VERBATIM
+    )
+    set_target_properties(pgo_train PROPERTIES FOLDER "Benchmarks")
+endfunction()
@@ -0,0 +1,20 @@
+# ============================================================================
+# MergeProfiles.cmake
+# ============================================================================
+# Clang writes one raw profile per instrumented process; -fprofile-use
+# wants them merged. Run by the pgo_train target as:
+#   cmake -DPROFDATA=<llvm-profdata> -DDIR=<profile dir> -DOUTPUT=<file>
+#         -P MergeProfiles.cmake
+# ============================================================================
+file(GLOB raw_profiles "${DIR}/*.profraw")
+if(NOT raw_profiles)
+    message(FATAL_ERROR "No .profraw files in ${DIR} - did the training run crash?")
+endif()
+
+execute_process(
+    COMMAND ${PROFDATA} merge -output=${OUTPUT} ${raw_profiles}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "llvm-profdata merge failed (${result})")
+endif()
@@ -0,0 +1,732 @@
+#ifndef LOGGER_BINARY_LOG_HPP
+#define LOGGER_BINARY_LOG_HPP
+
+#include "logger/logger.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+// wingdi.h defines ERROR, which would turn Logger::Level::ERROR into a syntax error
+#ifndef NOGDI
+#define NOGDI
+#endif
+#include <windows.h>
+// ...and in case windows.h was already included without NOGDI
+#undef ERROR
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MATHENGINE_BINLOG_HAS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define MATHENGINE_BINLOG_HAS_TSC 0
+#endif
+
+namespace MathEngine {
+
+namespace detail {
+
+/**
+ * @brief Read-write shared mapping of a file created with a fixed size
+ */
+class MappedFile {
+public:
+    MappedFile(const std::string& path, std::size_t size) : size_(size) {
+#if defined(_WIN32)
+        file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            fail(path);
+        }
+        const auto high = static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32);
+        const auto low = static_cast<DWORD>(size & 0xFFFFFFFFu);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE, high, low, nullptr);
+        if (mapping_ == nullptr) {
+            CloseHandle(file_);
+            fail(path);
+        }
+        data_ = static_cast<std::byte*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size));
+        if (data_ == nullptr) {
+            CloseHandle(mapping_);
+            CloseHandle(file_);
+            fail(path);
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            fail(path);
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            ::close(fd_);
+            fail(path);
+        }
+        int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+        flags |= MAP_POPULATE;  // Take the page faults now, not on the logging path
+#endif
+        void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd_, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd_);
+            fail(path);
+        }
+        data_ = static_cast<std::byte*>(data);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Unmap and cut the file down to the @p used bytes actually written
+     */
+    ~MappedFile() {
+#if defined(_WIN32)
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(used_);
+        SetFilePointerEx(file_, end, nullptr, FILE_BEGIN);
+        SetEndOfFile(file_);
+        CloseHandle(file_);
+#else
+        ::munmap(data_, size_);
+        [[maybe_unused]] const int result = ::ftruncate(fd_, static_cast<off_t>(used_));
+        ::close(fd_);
+#endif
+    }
+
+    std::byte* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+    /// Bytes kept when the file is closed
+    void setUsed(std::size_t used) { used_ = used; }
+
+    void sync() const {
+#if defined(_WIN32)
+        FlushViewOfFile(data_, used_);
+#else
+        ::msync(data_, size_, MS_SYNC);
+#endif
+    }
+
+private:
+    [[noreturn]] static void fail(const std::string& path) {
+#if defined(_WIN32)
+        const int code = static_cast<int>(GetLastError());
+        throw std::system_error(code, std::system_category(), "BinaryLog: cannot map '" + path + "'");
+#else
+        throw std::system_error(errno, std::generic_category(), "BinaryLog: cannot map '" + path + "'");
+#endif
+    }
+
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t used_ = 0;
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+} // namespace detail
+
+/**
+ * @brief "Log fast, format later" sink writing binary records to mmap'd files
+ *
+ * While a binary log is open, the MATHENGINE_LOG_* macros stop formatting
+ * text. Each call instead copies a timestamp, its level, the ID of its call
+ * site and the raw bytes of its arguments into a memory-mapped file, which
+ * costs a few tens of nanoseconds. The log_decoder tool (or
+ * BinaryLogReader) turns the files into the usual text lines offline.
+ *
+ * Format strings are still checked against their arguments at compile
+ * time. Each call site gets its ID the first time it runs, and the format
+ * string, source location and argument types behind an ID are written to
+ * a segment before the first record that uses it, so every segment decodes
+ * on its own. Segments are written to "<path>.0", "<path>.1", ... and a new
+ * one is started whenever the current one is full; only the newest
+ * maxSegments are kept.
+ *
+ * Timestamps are steady_clock nanoseconds or, on x86, raw TSC ticks.
+ * Clock-sync records pairing them with system_clock let the decoder print
+ * wall-clock times.
+ *
+ * Like Logger::enableAsync(), open() and close() are meant for start-up
+ * and tear-down, not while other threads log.
+ */
+class LOGGER_API BinaryLog {
+public:
+    /**
+     * @brief Timestamp source for records
+     */
+    enum class Clock {
+        Steady,  ///< std::chrono::steady_clock, in nanoseconds
+        Tsc      ///< Time-stamp counter (x86 only; Steady elsewhere)
+    };
+
+    /**
+     * @brief Where and how the binary log is written
+     */
+    struct Options {
+        std::string path = "mathengine.blog";                ///< Segment files are path.0, path.1, ...
+        std::size_t segmentSize = std::size_t{64} << 20;     ///< Bytes per segment file
+        std::size_t maxSegments = 4;                         ///< Newest segments kept; 0 keeps all
+        Clock clock = Clock::Steady;
+    };
+
+    // ========================================================================
+    // File Format (native byte order)
+    // ========================================================================
+    // File:    16-byte header, then records up to the end of the file
+    // Header:  "MEBINLOG", u32 version, u32 reserved
+    // Record:  u32 size (whole record), u8 kind, u8 level, u16 reserved,
+    //          u32 format ID, u64 timestamp, then the payload
+    // Message: the arguments in order; strings are u32 length + bytes
+    // Format:  u32 line, u32 argument count, u32 file length,
+    //          u32 format length, argument types (u8 each), file, format
+    // Sync:    i64 system_clock nanoseconds, f64 timestamp ticks per ns
+    // ========================================================================
+
+    enum class RecordKind : std::uint8_t {
+        Message = 1,
+        Format = 2,
+        ClockSync = 3
+    };
+
+    enum class ArgType : std::uint8_t {
+        Bool = 1,
+        Char,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float32,
+        Float64,
+        String
+    };
+
+    static constexpr std::array<char, 8> kMagic{'M', 'E', 'B', 'I', 'N', 'L', 'O', 'G'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::size_t kFileHeaderSize = 16;
+    static constexpr std::size_t kRecordHeaderSize = 20;
+
+    /**
+     * @brief One logging call site; its ID is assigned on first use
+     *
+     * Declared as a function-local static by the macros. The constructor is
+     * constexpr, so the static needs no initialization guard.
+     */
+    class Site {
+    public:
+        constexpr Site(const char* file, int line) : file_(file), line_(line) {}
+
+    private:
+        friend class BinaryLog;
+
+        std::atomic<std::uint32_t> id_{0};
+        const char* file_;
+        int line_;
+    };
+
+    /**
+     * @brief Start writing records to the first segment of @p options.path
+     * @throws std::system_error if the segment cannot be created or mapped
+     *
+     * Replaces (and closes) a binary log that is already open. Existing
+     * segment files with the same names are overwritten.
+     */
+    static void open(const Options& options) {
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        closeLocked();
+        writerOwner_ = std::make_unique<Writer>(options);
+        writer_.store(writerOwner_.get(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Finish the current segment and return to text logging
+     *
+     * Also runs automatically at static destruction.
+     */
+    static void close() {
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        closeLocked();
+    }
+
+    /**
+     * @brief Whether the MATHENGINE_LOG_* macros currently write binary records
+     */
+    static bool isOpen() {
+        return writer_.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+     * @brief Block until the current segment has reached the disk
+     */
+    static void flush() {
+        if (Writer* writer = writer_.load(std::memory_order_acquire)) {
+            writer->flush();
+        }
+    }
+
+    /**
+     * @brief Records discarded because they were larger than a whole segment
+     *        or a new segment could not be created
+     */
+    static std::uint64_t droppedCount() {
+        return droppedRecords_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief File name of segment @p index of the binary log at @p path
+     */
+    static std::string segmentPath(const std::string& path, std::size_t index) {
+        return fmt::format("{}.{}", path, index);
+    }
+
+    /**
+     * @brief Record an fmt-style message without formatting it
+     */
+    template <typename... Args>
+        requires (sizeof...(Args) > 0)
+    static void write(Logger::Level level, Site& site, fmt::format_string<Args...> format,
+                      Args&&... args) {
+        Writer* writer = writer_.load(std::memory_order_acquire);
+        if (writer == nullptr || !Logger::isEnabled(level)) {
+            return;
+        }
+
+        static constexpr std::array<ArgType, sizeof...(Args)> types{
+            argType<Encoded<Args>>()...};
+        const fmt::string_view text(format);
+        const std::uint32_t id = siteId(site, std::string_view(text.data(), text.size()), types);
+        writer->append(level, id, encode(args)...);
+    }
+
+    /**
+     * @brief Record a pre-built message (stored as a single string argument)
+     */
+    static void write(Logger::Level level, Site& site, std::string_view message) {
+        Writer* writer = writer_.load(std::memory_order_acquire);
+        if (writer == nullptr || !Logger::isEnabled(level)) {
+            return;
+        }
+
+        static constexpr std::array<ArgType, 1> types{ArgType::String};
+        writer->append(level, siteId(site, "{}", types), message);
+    }
+
+    /**
+     * @brief Record a lazily built message; @p makeMessage runs only if
+     *        @p level is enabled
+     */
+    template <typename MakeMessage>
+        requires std::is_invocable_v<MakeMessage&>
+    static void write(Logger::Level level, Site& site, MakeMessage&& makeMessage) {
+        if (isOpen() && Logger::isEnabled(level)) {
+            write(level, site, std::string_view(makeMessage()));
+        }
+    }
+
+private:
+    /**
+     * @brief What an ID stands for, written into each segment that uses it
+     */
+    struct SiteInfo {
+        std::string_view file;
+        std::uint32_t line;
+        std::string_view format;
+        std::vector<ArgType> types;
+    };
+
+    // ------------------------------------------------------------------------
+    // Argument Encoding
+    // ------------------------------------------------------------------------
+    // Arguments are narrowed to a few fixed-size scalar types or a string.
+    // Types without a binary form are formatted with "{}" on the spot, so
+    // their format specs are applied to the resulting text when decoding.
+    // ------------------------------------------------------------------------
+
+    template <typename T>
+    static auto encode(const T& value) {
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char> ||
+                      std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            return value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<double>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            if constexpr (sizeof(T) <= 4) {
+                return static_cast<std::int32_t>(value);
+            } else {
+                return static_cast<std::int64_t>(value);
+            }
+        } else if constexpr (std::is_integral_v<T>) {
+            if constexpr (sizeof(T) <= 4) {
+                return static_cast<std::uint32_t>(value);
+            } else {
+                return static_cast<std::uint64_t>(value);
+            }
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return std::string_view(value);
+        } else {
+            return fmt::format("{}", value);
+        }
+    }
+
+    template <typename T>
+    using Encoded = decltype(encode(std::declval<const std::remove_cvref_t<T>&>()));
+
+    template <typename E>
+    static constexpr ArgType argType() {
+        if constexpr (std::is_same_v<E, bool>) {
+            return ArgType::Bool;
+        } else if constexpr (std::is_same_v<E, char>) {
+            return ArgType::Char;
+        } else if constexpr (std::is_same_v<E, std::int32_t>) {
+            return ArgType::Int32;
+        } else if constexpr (std::is_same_v<E, std::uint32_t>) {
+            return ArgType::UInt32;
+        } else if constexpr (std::is_same_v<E, std::int64_t>) {
+            return ArgType::Int64;
+        } else if constexpr (std::is_same_v<E, std::uint64_t>) {
+            return ArgType::UInt64;
+        } else if constexpr (std::is_same_v<E, float>) {
+            return ArgType::Float32;
+        } else if constexpr (std::is_same_v<E, double>) {
+            return ArgType::Float64;
+        } else {
+            return ArgType::String;
+        }
+    }
+
+    template <typename E>
+    static std::size_t encodedSize(const E& value) {
+        if constexpr (std::is_arithmetic_v<E>) {
+            return sizeof(E);
+        } else {
+            return sizeof(std::uint32_t) + std::string_view(value).size();
+        }
+    }
+
+    template <typename T>
+    static std::byte* put(std::byte* out, const T& value) {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+
+    static std::byte* put(std::byte* out, std::string_view text) {
+        out = put(out, static_cast<std::uint32_t>(text.size()));
+        std::memcpy(out, text.data(), text.size());
+        return out + text.size();
+    }
+
+    static std::byte* put(std::byte* out, const std::string& text) {
+        return put(out, std::string_view(text));
+    }
+
+    static std::byte* putHeader(std::byte* out, std::size_t size, RecordKind kind,
+                                Logger::Level level, std::uint32_t id, std::uint64_t ticks) {
+        out = put(out, static_cast<std::uint32_t>(size));
+        out = put(out, static_cast<std::uint8_t>(kind));
+        out = put(out, static_cast<std::uint8_t>(level));
+        out = put(out, std::uint16_t{0});
+        out = put(out, id);
+        return put(out, ticks);
+    }
+
+    // ------------------------------------------------------------------------
+    // Site Registry
+    // ------------------------------------------------------------------------
+
+    template <std::size_t N>
+    static std::uint32_t siteId(Site& site, std::string_view format,
+                                const std::array<ArgType, N>& types) {
+        const std::uint32_t id = site.id_.load(std::memory_order_acquire);
+        return id != 0 ? id : registerSite(site, format, types.data(), N);
+    }
+
+    static std::uint32_t registerSite(Site& site, std::string_view format, const ArgType* types,
+                                      std::size_t count) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        std::uint32_t id = site.id_.load(std::memory_order_relaxed);
+        if (id == 0) {
+            sites_.push_back({site.file_, static_cast<std::uint32_t>(site.line_), format,
+                              std::vector<ArgType>(types, types + count)});
+            id = static_cast<std::uint32_t>(sites_.size());
+            site.id_.store(id, std::memory_order_release);
+        }
+        return id;
+    }
+
+    static SiteInfo siteInfo(std::uint32_t id) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        return sites_[id - 1];
+    }
+
+    // ------------------------------------------------------------------------
+    // Writer
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Owns the current segment; one mutex serializes appends
+     *
+     * The critical section is a bounds check and a memcpy into the mapping,
+     * so it stays short even when several threads log at once.
+     */
+    class Writer {
+    public:
+        explicit Writer(const Options& options) : options_(options) {
+#if !MATHENGINE_BINLOG_HAS_TSC
+            options_.clock = Clock::Steady;
+#endif
+            originTicks_ = ticks();
+            originSteady_ = std::chrono::steady_clock::now();
+            if (options_.clock == Clock::Tsc) {
+                calibrateTsc();
+            }
+            startSegment();
+        }
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        ~Writer() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finishSegment();
+        }
+
+        template <typename... Encoded>
+        void append(Logger::Level level, std::uint32_t id, const Encoded&... values) {
+            const std::size_t size = kRecordHeaderSize + (std::size_t{0} + ... + encodedSize(values));
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::byte* out = reserve(size, id);
+            if (out == nullptr) {
+                droppedRecords_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            out = putHeader(out, size, RecordKind::Message, level, id, ticks());
+            ((out = put(out, values)), ...);
+        }
+
+        void flush() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (segment_) {
+                segment_->setUsed(offset_);
+                segment_->sync();
+            }
+        }
+
+    private:
+        /// Room always left at the end of a segment for its closing sync record
+        static constexpr std::size_t kSyncRecordSize = kRecordHeaderSize + 16;
+
+        std::uint64_t ticks() const {
+#if MATHENGINE_BINLOG_HAS_TSC && defined(_MSC_VER)
+            if (options_.clock == Clock::Tsc) {
+                return __rdtsc();
+            }
+#elif MATHENGINE_BINLOG_HAS_TSC
+            if (options_.clock == Clock::Tsc) {
+                return __builtin_ia32_rdtsc();
+            }
+#endif
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        void calibrateTsc() {
+            // A short busy wait gives the first segments a usable rate; later
+            // sync records refine it over the whole run
+            while (std::chrono::steady_clock::now() - originSteady_ < std::chrono::milliseconds(2)) {
+            }
+            updateTicksPerNs();
+        }
+
+        void updateTicksPerNs() {
+            if (options_.clock != Clock::Tsc) {
+                return;
+            }
+            const auto elapsed = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - originSteady_).count();
+            if (elapsed > 0) {
+                ticksPerNs_ = static_cast<double>(ticks() - originTicks_) / elapsed;
+            }
+        }
+
+        /**
+         * @brief Space for a @p size byte record using @p id, or nullptr
+         *
+         * Writes the definition of @p id first if this segment lacks it,
+         * and moves to a new segment when the current one is full.
+         */
+        std::byte* reserve(std::size_t size, std::uint32_t id) {
+            for (int attempt = 0; attempt < 2 && segment_; ++attempt) {
+                const bool defined = id < defined_.size() && defined_[id];
+                SiteInfo info;
+                std::size_t definitionSize = 0;
+                if (!defined) {
+                    info = siteInfo(id);
+                    definitionSize = kRecordHeaderSize + 4 * sizeof(std::uint32_t) +
+                                     info.types.size() + info.file.size() + info.format.size();
+                }
+
+                const std::size_t needed = definitionSize + size + kSyncRecordSize;
+                if (needed > segment_->size() - firstRecordOffset_) {
+                    return nullptr;  // Would not fit even in an empty segment
+                }
+                if (offset_ + needed > segment_->size()) {
+                    rotate();
+                    continue;
+                }
+
+                if (!defined) {
+                    writeDefinition(id, info, definitionSize);
+                }
+                std::byte* out = segment_->data() + offset_;
+                offset_ += size;
+                return out;
+            }
+            return nullptr;
+        }
+
+        void writeDefinition(std::uint32_t id, const SiteInfo& info, std::size_t size) {
+            std::byte* out = segment_->data() + offset_;
+            out = putHeader(out, size, RecordKind::Format, Logger::Level::OFF, id, 0);
+            out = put(out, info.line);
+            out = put(out, static_cast<std::uint32_t>(info.types.size()));
+            out = put(out, static_cast<std::uint32_t>(info.file.size()));
+            out = put(out, static_cast<std::uint32_t>(info.format.size()));
+            std::memcpy(out, info.types.data(), info.types.size());
+            out += info.types.size();
+            std::memcpy(out, info.file.data(), info.file.size());
+            out += info.file.size();
+            std::memcpy(out, info.format.data(), info.format.size());
+            offset_ += size;
+
+            if (defined_.size() <= id) {
+                defined_.resize(id + 1, false);
+            }
+            defined_[id] = true;
+        }
+
+        void writeSync() {
+            updateTicksPerNs();
+            const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            std::byte* out = segment_->data() + offset_;
+            out = putHeader(out, kSyncRecordSize, RecordKind::ClockSync, Logger::Level::OFF, 0, ticks());
+            out = put(out, static_cast<std::int64_t>(now));
+            put(out, ticksPerNs_);
+            offset_ += kSyncRecordSize;
+        }
+
+        void startSegment() {
+            segment_ = std::make_unique<detail::MappedFile>(
+                segmentPath(options_.path, index_), options_.segmentSize);
+
+            std::byte* out = segment_->data();
+            std::memcpy(out, kMagic.data(), kMagic.size());
+            out = put(out + kMagic.size(), kVersion);
+            put(out, std::uint32_t{0});
+            offset_ = kFileHeaderSize;
+            defined_.clear();
+
+            writeSync();
+            firstRecordOffset_ = offset_;
+            segment_->setUsed(offset_);
+        }
+
+        void finishSegment() {
+            if (segment_) {
+                writeSync();
+                segment_->setUsed(offset_);
+                segment_.reset();
+            }
+        }
+
+        void rotate() {
+            finishSegment();
+            ++index_;
+            if (options_.maxSegments != 0 && index_ >= options_.maxSegments) {
+                std::remove(segmentPath(options_.path, index_ - options_.maxSegments).c_str());
+            }
+            try {
+                startSegment();
+            } catch (const std::system_error&) {
+                // Nowhere to write any more: later records are dropped
+                segment_.reset();
+            }
+        }
+
+        Options options_;
+        std::mutex mutex_;
+        std::unique_ptr<detail::MappedFile> segment_;
+        std::size_t index_ = 0;
+        std::size_t offset_ = 0;
+        std::size_t firstRecordOffset_ = 0;
+        std::vector<bool> defined_;
+
+        std::uint64_t originTicks_ = 0;
+        std::chrono::steady_clock::time_point originSteady_;
+        double ticksPerNs_ = 1.0;
+    };
+
+    /**
+     * @brief Closes the binary log when static objects are destroyed
+     */
+    struct ShutdownGuard {
+        ~ShutdownGuard() { BinaryLog::close(); }
+    };
+
+    static void closeLocked() {
+        writer_.store(nullptr, std::memory_order_release);
+        writerOwner_.reset();
+    }
+
+    // Declaration order matters: the guard is destroyed first
+    static inline std::atomic<Writer*> writer_{nullptr};
+    static inline std::atomic<std::uint64_t> droppedRecords_{0};
+    static inline std::mutex controlMutex_;
+    static inline std::unique_ptr<Writer> writerOwner_;
+    static inline std::mutex registryMutex_;
+    static inline std::vector<SiteInfo> sites_;
+    static inline ShutdownGuard shutdownGuard_;
+};
+
+} // namespace MathEngine
+
+// Sampled sites write their summaries here too, so they come after BinaryLog
+#include "logger/log_sampler.hpp"
+
+#endif // LOGGER_BINARY_LOG_HPP
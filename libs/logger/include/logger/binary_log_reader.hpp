@@ -0,0 +1,265 @@
+#ifndef LOGGER_BINARY_LOG_READER_HPP
+#define LOGGER_BINARY_LOG_READER_HPP
+
+#include "logger/binary_log.hpp"
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MathEngine {
+
+/**
+ * @brief Decodes one segment written by BinaryLog back into messages
+ *
+ * The whole segment is read into memory; this is meant for offline use,
+ * e.g. by the log_decoder tool, not for the process that is logging.
+ */
+class BinaryLogReader {
+public:
+    /**
+     * @brief One decoded message
+     */
+    struct Entry {
+        Logger::Level level = Logger::Level::INFO;
+        std::int64_t timeNs = 0;    ///< system_clock nanoseconds since the epoch
+        std::string message;
+        std::string file;
+        std::uint32_t line = 0;
+    };
+
+    /**
+     * @brief Read the segment at @p path
+     * @throws std::runtime_error if it cannot be read or is not a binary log
+     */
+    explicit BinaryLogReader(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error(fmt::format("Cannot open binary log '{}'", path));
+        }
+        data_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        if (data_.size() < BinaryLog::kFileHeaderSize ||
+            std::memcmp(data_.data(), BinaryLog::kMagic.data(), BinaryLog::kMagic.size()) != 0) {
+            throw std::runtime_error(fmt::format("'{}' is not a binary log", path));
+        }
+        std::uint32_t version = 0;
+        std::memcpy(&version, data_.data() + BinaryLog::kMagic.size(), sizeof(version));
+        if (version != BinaryLog::kVersion) {
+            throw std::runtime_error(fmt::format("'{}' has unsupported version {}", path, version));
+        }
+        offset_ = BinaryLog::kFileHeaderSize;
+    }
+
+    /**
+     * @brief Decode the next message into @p entry
+     * @return false at the end of the segment
+     * @throws std::runtime_error on a truncated or malformed record
+     *
+     * A zero size field also ends the segment: that is what the unused tail
+     * of a segment looks like when the writer did not shut down cleanly.
+     */
+    bool next(Entry& entry) {
+        while (data_.size() - offset_ >= BinaryLog::kRecordHeaderSize) {
+            const char* record = data_.data() + offset_;
+            const auto size = read<std::uint32_t>(record);
+            if (size == 0) {
+                break;
+            }
+            if (size < BinaryLog::kRecordHeaderSize || size > data_.size() - offset_) {
+                throw std::runtime_error(fmt::format("Malformed record at offset {}", offset_));
+            }
+            offset_ += size;
+
+            const auto kind = static_cast<BinaryLog::RecordKind>(read<std::uint8_t>(record + 4));
+            const auto level = static_cast<Logger::Level>(read<std::uint8_t>(record + 5));
+            const auto id = read<std::uint32_t>(record + 8);
+            const auto ticks = read<std::uint64_t>(record + 12);
+            Cursor payload{record + BinaryLog::kRecordHeaderSize, record + size};
+
+            switch (kind) {
+                case BinaryLog::RecordKind::ClockSync:
+                    sync_.ticks = ticks;
+                    sync_.systemNs = payload.get<std::int64_t>();
+                    sync_.ticksPerNs = payload.get<double>();
+                    break;
+                case BinaryLog::RecordKind::Format:
+                    formats_[id] = readFormat(payload);
+                    break;
+                case BinaryLog::RecordKind::Message:
+                    entry.level = level;
+                    entry.timeNs = toSystemNs(ticks);
+                    decodeMessage(id, payload, entry);
+                    return true;
+                default:
+                    break;  // Unknown kinds are skipped, their size says how far
+            }
+        }
+        offset_ = data_.size();
+        return false;
+    }
+
+    /**
+     * @brief Render @p entry the way Logger writes text lines (without color)
+     */
+    static std::string formatLine(const Entry& entry, bool withLocation = false) {
+        const std::chrono::system_clock::time_point time{
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(entry.timeNs))};
+        const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+        const auto ms = (entry.timeNs / 1'000'000) % 1000;
+
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &seconds);
+#else
+        localtime_r(&seconds, &tm);
+#endif
+        std::string line = fmt::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:03} [{}] {}",
+            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+            static_cast<int>(ms < 0 ? ms + 1000 : ms), levelName(entry.level), entry.message);
+        if (withLocation && !entry.file.empty()) {
+            line += fmt::format(" ({}:{})", entry.file, entry.line);
+        }
+        return line;
+    }
+
+private:
+    struct Format {
+        std::uint32_t line = 0;
+        std::vector<BinaryLog::ArgType> types;
+        std::string_view file;
+        std::string_view format;
+    };
+
+    struct Sync {
+        std::uint64_t ticks = 0;
+        std::int64_t systemNs = 0;
+        double ticksPerNs = 1.0;
+    };
+
+    /**
+     * @brief Bounds-checked reads from one record's payload
+     */
+    struct Cursor {
+        const char* at;
+        const char* end;
+
+        template <typename T>
+        T get() {
+            if (static_cast<std::size_t>(end - at) < sizeof(T)) {
+                throw std::runtime_error("Truncated binary log record");
+            }
+            const T value = read<T>(at);
+            at += sizeof(T);
+            return value;
+        }
+
+        std::string_view bytes(std::size_t count) {
+            if (static_cast<std::size_t>(end - at) < count) {
+                throw std::runtime_error("Truncated binary log record");
+            }
+            const std::string_view view(at, count);
+            at += count;
+            return view;
+        }
+    };
+
+    template <typename T>
+    static T read(const char* at) {
+        T value;
+        std::memcpy(&value, at, sizeof(T));
+        return value;
+    }
+
+    static Format readFormat(Cursor& payload) {
+        Format format;
+        format.line = payload.get<std::uint32_t>();
+        const auto count = payload.get<std::uint32_t>();
+        const auto fileLength = payload.get<std::uint32_t>();
+        const auto formatLength = payload.get<std::uint32_t>();
+        const std::string_view types = payload.bytes(count);
+        for (char type : types) {
+            format.types.push_back(static_cast<BinaryLog::ArgType>(type));
+        }
+        format.file = payload.bytes(fileLength);
+        format.format = payload.bytes(formatLength);
+        return format;
+    }
+
+    std::int64_t toSystemNs(std::uint64_t ticks) const {
+        const auto delta = static_cast<double>(static_cast<std::int64_t>(ticks - sync_.ticks));
+        return sync_.systemNs + static_cast<std::int64_t>(delta / sync_.ticksPerNs);
+    }
+
+    void decodeMessage(std::uint32_t id, Cursor& payload, Entry& entry) const {
+        const auto it = formats_.find(id);
+        if (it == formats_.end()) {
+            entry.message = fmt::format("<unknown format id {}>", id);
+            entry.file.clear();
+            entry.line = 0;
+            return;
+        }
+        const Format& format = it->second;
+        entry.file = format.file;
+        entry.line = format.line;
+
+        fmt::dynamic_format_arg_store<fmt::format_context> args;
+        for (BinaryLog::ArgType type : format.types) {
+            switch (type) {
+                case BinaryLog::ArgType::Bool:    args.push_back(payload.get<bool>()); break;
+                case BinaryLog::ArgType::Char:    args.push_back(payload.get<char>()); break;
+                case BinaryLog::ArgType::Int32:   args.push_back(payload.get<std::int32_t>()); break;
+                case BinaryLog::ArgType::UInt32:  args.push_back(payload.get<std::uint32_t>()); break;
+                case BinaryLog::ArgType::Int64:   args.push_back(payload.get<std::int64_t>()); break;
+                case BinaryLog::ArgType::UInt64:  args.push_back(payload.get<std::uint64_t>()); break;
+                case BinaryLog::ArgType::Float32: args.push_back(payload.get<float>()); break;
+                case BinaryLog::ArgType::Float64: args.push_back(payload.get<double>()); break;
+                case BinaryLog::ArgType::String:
+                    args.push_back(std::string(payload.bytes(payload.get<std::uint32_t>())));
+                    break;
+                default:
+                    throw std::runtime_error(fmt::format("Unknown argument type {} in format {}",
+                                                         static_cast<int>(type), id));
+            }
+        }
+
+        try {
+            entry.message = fmt::vformat(fmt::string_view(format.format.data(), format.format.size()),
+                                         args);
+        } catch (const fmt::format_error& error) {
+            entry.message = fmt::format("<bad format '{}': {}>", format.format, error.what());
+        }
+    }
+
+    static const char* levelName(Logger::Level level) {
+        switch (level) {
+            case Logger::Level::DEBUG:   return "DEBUG";
+            case Logger::Level::INFO:    return "INFO";
+            case Logger::Level::WARNING: return "WARN";
+            case Logger::Level::ERROR:   return "ERROR";
+            default:                     return "UNKNOWN";
+        }
+    }
+
+    std::vector<char> data_;
+    std::size_t offset_ = 0;
+    std::unordered_map<std::uint32_t, Format> formats_;
+    Sync sync_;
+};
+
+} // namespace MathEngine
+
+#endif // LOGGER_BINARY_LOG_READER_HPP
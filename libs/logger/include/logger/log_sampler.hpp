@@ -0,0 +1,241 @@
+#ifndef LOGGER_LOG_SAMPLER_HPP
+#define LOGGER_LOG_SAMPLER_HPP
+
+#include "logger/binary_log.hpp"
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace MathEngine {
+
+/**
+ * @brief Decides which calls of one logging site are written
+ *
+ * Declared as a function-local static by the MATHENGINE_LOG_*_EVERY_N,
+ * _FIRST_N and _RATE_LIMITED macros. Calls are counted per thread and
+ * published in batches of kPublishInterval, so a hot site adds no shared
+ * cache-line traffic. Counts from threads that exit between batches are
+ * lost, so a summary may undercount by up to kPublishInterval - 1 calls
+ * per thread. A thread refused by the rate limit checks the bucket again
+ * only every kRateRecheckInterval calls, which keeps the clock read off
+ * most suppressed calls.
+ *
+ * Every summaryInterval() each site that suppressed something writes a
+ * line like "add:42 called 1,204,331 times, 1,000 logged" (function and
+ * line of the site) at its own level;
+ * reportAll() writes the outstanding ones immediately and runs at exit.
+ */
+class LogSampler {
+public:
+    enum class Policy : std::uint8_t {
+        EveryN,      ///< The first call and every Nth after it, per thread
+        FirstN,      ///< The first N calls across all threads, then only summaries
+        RateLimited  ///< Whatever Logger::setRateLimit() allows for the level
+    };
+
+    /**
+     * @brief Per-thread state of one site (trivial, so thread_local costs nothing)
+     */
+    struct Local {
+        std::uint32_t pending = 0;    ///< Calls not yet added to the site's count
+        std::uint32_t countdown = 0;  ///< Calls to skip before the next line (EveryN) or bucket check
+    };
+
+    static constexpr std::uint32_t kPublishInterval = 256;
+
+    /// RateLimited: calls per thread between bucket checks once one is refused
+    static constexpr std::uint32_t kRateRecheckInterval = 16;
+
+    constexpr LogSampler(const char* name, int line, Logger::Level level, Policy policy, std::uint64_t n)
+        : name_(name), line_(line), level_(level), policy_(policy), n_(n == 0 ? 1 : n) {}
+
+    LogSampler(const LogSampler&) = delete;
+    LogSampler& operator=(const LogSampler&) = delete;
+
+    /**
+     * @brief Count one call and decide whether it is written
+     */
+    bool admit(Local& local) {
+        bool admitted = false;
+        switch (policy_) {
+            case Policy::EveryN:
+                admitted = local.countdown == 0;
+                local.countdown = admitted ? static_cast<std::uint32_t>(n_ - 1) : local.countdown - 1;
+                break;
+            case Policy::FirstN:
+                admitted = !exhausted_.load(std::memory_order_relaxed) && takeFirst();
+                break;
+            case Policy::RateLimited:
+                // After a refusal, skip the bucket (and its clock read) for a few calls
+                if (local.countdown != 0) {
+                    --local.countdown;
+                } else {
+                    admitted = Logger::acquireRateToken(level_);
+                    local.countdown = admitted ? 0 : kRateRecheckInterval - 1;
+                }
+                break;
+        }
+
+        if (++local.pending == kPublishInterval || admitted) {
+            publish(local, admitted);
+        }
+        return admitted;
+    }
+
+    /// Calls published so far
+    std::uint64_t calls() const {
+        return calls_.load(std::memory_order_relaxed);
+    }
+
+    /// Calls that were written so far
+    std::uint64_t logged() const {
+        return logged_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief How often a site with suppressed calls writes a summary (0 = only at reportAll())
+     */
+    static void setSummaryInterval(std::chrono::milliseconds interval) {
+        summaryInterval_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count(),
+                               std::memory_order_relaxed);
+    }
+
+    static std::chrono::milliseconds summaryInterval() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::nanoseconds(summaryInterval_.load(std::memory_order_relaxed)));
+    }
+
+    /**
+     * @brief Write the summary of every site that suppressed calls since its last one
+     */
+    static void reportAll() {
+        for (LogSampler* site = head_.load(std::memory_order_acquire); site != nullptr; site = site->next_) {
+            site->summarize(now());
+        }
+    }
+
+private:
+    /**
+     * @brief Runs reportAll() when static objects are destroyed
+     *
+     * Defined after Logger's own guard, so it runs first and the summaries
+     * still reach an async backend before it drains.
+     */
+    struct ReportGuard {
+        ~ReportGuard() { LogSampler::reportAll(); }
+    };
+
+    static std::int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool takeFirst() {
+        if (taken_.fetch_add(1, std::memory_order_relaxed) < n_) {
+            return true;
+        }
+        exhausted_.store(true, std::memory_order_relaxed);
+        return false;
+    }
+
+    void publish(Local& local, bool admitted) {
+        calls_.fetch_add(local.pending, std::memory_order_relaxed);
+        local.pending = 0;
+        if (admitted) {
+            logged_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Load before exchanging, so later calls only read the flag's cache line
+        if (!registered_.load(std::memory_order_relaxed) &&
+            !registered_.exchange(true, std::memory_order_relaxed)) {
+            lastSummary_.store(now(), std::memory_order_relaxed);
+            next_ = head_.load(std::memory_order_relaxed);
+            while (!head_.compare_exchange_weak(next_, this, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+            }
+            return;
+        }
+
+        const std::int64_t interval = summaryInterval_.load(std::memory_order_relaxed);
+        if (interval > 0) {
+            const std::int64_t time = now();
+            if (time - lastSummary_.load(std::memory_order_relaxed) >= interval) {
+                summarize(time);
+            }
+        }
+    }
+
+    void summarize(std::int64_t time) {
+        if (summarizing_.exchange(true, std::memory_order_acquire)) {
+            return;  // Another thread is writing this site's summary
+        }
+
+        const std::uint64_t calls = calls_.load(std::memory_order_relaxed);
+        const std::uint64_t logged = logged_.load(std::memory_order_relaxed);
+        const std::uint64_t newCalls = calls - reportedCalls_;
+        const std::uint64_t newLogged = logged - reportedLogged_;
+        reportedCalls_ = calls;
+        reportedLogged_ = logged;
+        lastSummary_.store(time, std::memory_order_relaxed);
+
+        if (newCalls > newLogged) {
+            const std::string callText = withSeparators(newCalls);
+            const std::string loggedText = withSeparators(newLogged);
+            if (BinaryLog::isOpen()) {
+                static BinaryLog::Site site{__FILE__, __LINE__};
+                BinaryLog::write(level_, site, "{}:{} called {} times, {} logged", name_, line_, callText,
+                                 loggedText);
+            } else {
+                Logger::log(level_, "{}:{} called {} times, {} logged", name_, line_, callText, loggedText);
+            }
+        }
+        summarizing_.store(false, std::memory_order_release);
+    }
+
+    /// 1204331 -> "1,204,331"
+    static std::string withSeparators(std::uint64_t value) {
+        const std::string digits = fmt::format("{}", value);
+        std::string out;
+        out.reserve(digits.size() + digits.size() / 3);
+        for (std::size_t i = 0; i < digits.size(); ++i) {
+            if (i != 0 && (digits.size() - i) % 3 == 0) {
+                out.push_back(',');
+            }
+            out.push_back(digits[i]);
+        }
+        return out;
+    }
+
+    const char* name_;
+    int line_;
+    Logger::Level level_;
+    Policy policy_;
+    std::uint64_t n_;
+
+    std::atomic<std::uint64_t> calls_{0};
+    std::atomic<std::uint64_t> logged_{0};
+    std::atomic<std::uint64_t> taken_{0};
+    std::atomic<bool> exhausted_{false};
+
+    // Summary state; reported* are only touched while summarizing_ is held
+    std::atomic<bool> summarizing_{false};
+    std::atomic<std::int64_t> lastSummary_{0};
+    std::uint64_t reportedCalls_ = 0;
+    std::uint64_t reportedLogged_ = 0;
+
+    // Intrusive list of sites that have been used, for reportAll()
+    std::atomic<bool> registered_{false};
+    LogSampler* next_ = nullptr;
+
+    static inline std::atomic<LogSampler*> head_{nullptr};
+    static inline std::atomic<std::int64_t> summaryInterval_{10'000'000'000};
+    static inline ReportGuard reportGuard_;
+};
+
+} // namespace MathEngine
+
+#endif // LOGGER_LOG_SAMPLER_HPP
@@ -0,0 +1,153 @@
+#ifndef LOGGER_LOG_SINK_HPP
+#define LOGGER_LOG_SINK_HPP
+
+#include "logger/visibility.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MathEngine {
+
+/**
+ * @brief Destination for formatted log lines
+ *
+ * Logger hands a sink complete lines, each terminated by '\n', either one
+ * at a time (synchronous mode) or as a batch from the async collector
+ * thread. A sink must accept calls from several threads at once and must
+ * never split the text it is given. Select one at runtime with
+ * Logger::setSink().
+ */
+class LOGGER_API LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief Write one or more complete lines
+     * @param lines Text ending in '\n'; valid only for the duration of the call
+     */
+    virtual void write(std::string_view lines) = 0;
+
+    /**
+     * @brief Push buffered output to its destination
+     */
+    virtual void flush() {}
+
+    /**
+     * @brief Whether lines should carry terminal color codes
+     */
+    virtual bool colored() const { return false; }
+};
+
+/**
+ * @brief Writes to std::cerr with colors (the default sink)
+ *
+ * Each write() goes to the stream under a lock, so lines from different
+ * threads never interleave.
+ */
+class ConsoleSink final : public LogSink {
+public:
+    void write(std::string_view lines) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cerr.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        std::cerr.flush();
+    }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::cerr.flush();
+    }
+
+    bool colored() const override { return true; }
+
+private:
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Appends plain lines to a file
+ */
+class FileSink final : public LogSink {
+public:
+    /**
+     * @brief Open @p path for writing
+     * @param append Keep existing content instead of truncating the file
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit FileSink(const std::string& path, bool append = true)
+        : file_(std::fopen(path.c_str(), append ? "ab" : "wb")) {
+        if (file_ == nullptr) {
+            throw std::runtime_error("FileSink: cannot open '" + path + "'");
+        }
+    }
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    ~FileSink() override {
+        std::fclose(file_);
+    }
+
+    void write(std::string_view lines) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fwrite(lines.data(), 1, lines.size(), file_);
+    }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fflush(file_);
+    }
+
+private:
+    std::mutex mutex_;
+    std::FILE* file_;
+};
+
+/**
+ * @brief Discards everything (measures logging cost without any I/O)
+ */
+class NullSink final : public LogSink {
+public:
+    void write(std::string_view) override {}
+};
+
+/**
+ * @brief Keeps lines in memory, mainly for tests
+ */
+class MemorySink final : public LogSink {
+public:
+    void write(std::string_view lines) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!lines.empty()) {
+            const std::size_t end = lines.find('\n');
+            const std::size_t length = end == std::string_view::npos ? lines.size() : end;
+            lines_.emplace_back(lines.substr(0, length));
+            lines.remove_prefix(end == std::string_view::npos ? lines.size() : end + 1);
+        }
+    }
+
+    /**
+     * @brief Copy of the lines written so far, without their newlines
+     */
+    std::vector<std::string> lines() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lines_;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lines_.clear();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::string> lines_;
+};
+
+} // namespace MathEngine
+
+#endif // LOGGER_LOG_SINK_HPP
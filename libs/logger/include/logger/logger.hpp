@@ -1,11 +1,39 @@
 #ifndef LOGGER_LOGGER_HPP
 #define LOGGER_LOGGER_HPP
 
+#include "logger/log_sink.hpp"
+#include "logger/ring_buffer.hpp"
+#include "logger/trace.hpp"
+
+#include <fmt/format.h>
+
 #include <iostream>
 #include <string_view>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <ctime>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Lowest level compiled into the binary (0 = DEBUG ... 4 = OFF)
+ *
+ * Normally set by CMake through the MATHENGINE_LOG_LEVEL cache variable.
+ * Calls below this level are removed at compile time.
+ */
+#ifndef MATHENGINE_LOG_LEVEL
+#define MATHENGINE_LOG_LEVEL 0
+#endif
 
 namespace MathEngine {
 
@@ -16,50 +44,120 @@ namespace MathEngine {
  * - All implementation in the header
  * - No separate .cpp file needed
  * - Can be included anywhere without linking
+ *
+ * Lines go to a LogSink (std::cerr by default; see logger/log_sink.hpp),
+ * chosen at runtime with setSink(). By default every call formats its line
+ * on the caller's thread and hands it to the sink in a single write, so
+ * lines never interleave. Calling enableAsync() switches to a background
+ * collector: each thread copies its messages into its own lock-free ring
+ * buffer, and one thread merges the buffers in timestamp order, formats
+ * the lines and writes them in batches, so producers never contend with
+ * each other or with the sink. While a BinaryLog is open, the
+ * MATHENGINE_LOG_* macros write compact binary records there instead
+ * (see logger/binary_log.hpp). In a MATHENGINE_TRACING build the format,
+ * enqueue and write stages are tracing zones (see logger/trace.hpp).
+ *
+ * Messages are filtered twice: against the compile-time floor
+ * (MATHENGINE_LOG_LEVEL) and against a runtime minimum level read with a
+ * single relaxed atomic load. Use the MATHENGINE_LOG_* macros or the
+ * callable overloads so that filtered-out calls never build their message.
  */
-class Logger {
+class LOGGER_API Logger {
 public:
     enum class Level {
         DEBUG,
         INFO,
         WARNING,
-        ERROR
+        ERROR,
+        OFF      ///< Threshold only: disables all output
+    };
+
+    /// Levels below this are compiled out entirely
+    static constexpr Level kCompileTimeLevel = static_cast<Level>(MATHENGINE_LOG_LEVEL);
+
+    /**
+     * @brief What async callers do when the ring buffer is full
+     */
+    enum class OverflowPolicy {
+        Block,           ///< Wait until the background writer frees a slot
+        Drop,            ///< Discard the new message and count it
+        OverwriteOldest  ///< Discard the oldest queued message and count it
+    };
+
+    /**
+     * @brief Configuration for the asynchronous backend
+     */
+    struct AsyncOptions {
+        std::size_t capacity = 1024;                   ///< Queued messages per thread (rounded to a power of two)
+        OverflowPolicy overflow = OverflowPolicy::Block;
+        std::size_t batchSize = 256;                   ///< Max lines per write to the stream
+    };
+
+    /**
+     * @brief Token bucket shared by all rate-limited call sites of one level
+     */
+    struct RateLimit {
+        double perSecond = 0.0;   ///< Sustained lines per second; 0 means unlimited
+        std::uint32_t burst = 1;  ///< Lines allowed back to back before the rate applies
     };
 
+    /// Longest message kept by the async backend; longer ones are truncated
+    static constexpr std::size_t kMaxAsyncMessageSize = 232;
+
     /**
      * @brief Log a message with the specified level
      * @param level The severity level
      * @param message The message to log
      */
     static void log(Level level, std::string_view message) {
-        // Get current time
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()
-        ) % 1000;
+        if (!isEnabled(level)) {
+            return;
+        }
 
-        // Format timestamp
-        std::tm tm;
-#ifdef _WIN32
-        localtime_s(&tm, &time_t);
-#else
-        localtime_r(&time_t, &tm);
-#endif
+        const auto now = std::chrono::system_clock::now();
 
-        std::ostringstream oss;
-        oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S")
-            << '.' << std::setfill('0') << std::setw(3) << ms.count()
-            << " [" << levelToString(level) << "] "
-            << message;
+        if (AsyncBackend* backend = asyncBackend_.load(std::memory_order_acquire)) {
+            MATHENGINE_TRACE_ZONE("logger", "enqueue");
+            backend->push(now, level, message);
+            return;
+        }
 
-        // Colorize output (platform-specific)
-        const char* color = getColor(level);
-        if (color) {
-            std::cerr << color << oss.str() << "\033[0m" << std::endl;
-        } else {
-            std::cerr << oss.str() << std::endl;
+        LogSink& sink = currentSink();
+        auto& line = lineBuffer();
+        {
+            MATHENGINE_TRACE_ZONE("logger", "format");
+            line.clear();
+            formatLine(line, now, level, message, sink.colored());
+            line.push_back('\n');
         }
+        MATHENGINE_TRACE_ZONE("logger", "write");
+        sink.write(std::string_view(line.data(), line.size()));
+    }
+
+    /**
+     * @brief Log an fmt-style formatted message
+     * @param level The severity level
+     * @param format Format string, checked against @p args at compile time
+     * @param args Values substituted into @p format
+     *
+     * The message is formatted into a reused thread-local buffer, and only
+     * if @p level is enabled.
+     */
+    template <typename... Args>
+        requires (sizeof...(Args) > 0)
+    static void log(Level level, fmt::format_string<Args...> format, Args&&... args) {
+        if (!isEnabled(level)) {
+            return;
+        }
+
+        auto& buffer = messageBuffer();
+        {
+            MATHENGINE_TRACE_ZONE("logger", "format");
+            buffer.clear();
+            fmt::vformat_to(std::back_inserter(buffer), fmt::string_view(format),
+                            fmt::make_format_args(args...));
+        }
+        log(level, std::string_view(buffer.data(), buffer.size()));
     }
 
     /**
@@ -81,7 +179,646 @@ public:
         log(Level::ERROR, message);
     }
 
+    /**
+     * @brief fmt-style convenience methods, e.g. info("{} + {}", a, b)
+     */
+    template <typename... Args>
+        requires (sizeof...(Args) > 0)
+    static void debug(fmt::format_string<Args...> format, Args&&... args) {
+        if constexpr (Level::DEBUG >= kCompileTimeLevel) {
+            log(Level::DEBUG, format, std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename... Args>
+        requires (sizeof...(Args) > 0)
+    static void info(fmt::format_string<Args...> format, Args&&... args) {
+        if constexpr (Level::INFO >= kCompileTimeLevel) {
+            log(Level::INFO, format, std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename... Args>
+        requires (sizeof...(Args) > 0)
+    static void warning(fmt::format_string<Args...> format, Args&&... args) {
+        if constexpr (Level::WARNING >= kCompileTimeLevel) {
+            log(Level::WARNING, format, std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename... Args>
+        requires (sizeof...(Args) > 0)
+    static void error(fmt::format_string<Args...> format, Args&&... args) {
+        if constexpr (Level::ERROR >= kCompileTimeLevel) {
+            log(Level::ERROR, format, std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Log a lazily built message
+     * @param level The severity level
+     * @param makeMessage Callable returning the message; only invoked if
+     *        @p level passes both filters
+     */
+    template <typename MakeMessage>
+        requires std::is_invocable_v<MakeMessage&>
+    static void log(Level level, MakeMessage&& makeMessage) {
+        if (isEnabled(level)) {
+            log(level, std::string_view(makeMessage()));
+        }
+    }
+
+    template <typename MakeMessage>
+        requires std::is_invocable_v<MakeMessage&>
+    static void debug(MakeMessage&& makeMessage) {
+        if constexpr (Level::DEBUG >= kCompileTimeLevel) {
+            log(Level::DEBUG, makeMessage);
+        }
+    }
+
+    template <typename MakeMessage>
+        requires std::is_invocable_v<MakeMessage&>
+    static void info(MakeMessage&& makeMessage) {
+        if constexpr (Level::INFO >= kCompileTimeLevel) {
+            log(Level::INFO, makeMessage);
+        }
+    }
+
+    template <typename MakeMessage>
+        requires std::is_invocable_v<MakeMessage&>
+    static void warning(MakeMessage&& makeMessage) {
+        if constexpr (Level::WARNING >= kCompileTimeLevel) {
+            log(Level::WARNING, makeMessage);
+        }
+    }
+
+    template <typename MakeMessage>
+        requires std::is_invocable_v<MakeMessage&>
+    static void error(MakeMessage&& makeMessage) {
+        if constexpr (Level::ERROR >= kCompileTimeLevel) {
+            log(Level::ERROR, makeMessage);
+        }
+    }
+
+    /**
+     * @brief Set the runtime minimum level (messages below it are skipped)
+     */
+    static void setLevel(Level level) {
+        minLevel_.store(level, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the runtime minimum level
+     */
+    static Level getLevel() {
+        return minLevel_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Whether @p level survives the compile-time floor
+     */
+    static constexpr bool isCompiledIn(Level level) {
+        return level >= kCompileTimeLevel && level != Level::OFF;
+    }
+
+    /**
+     * @brief Whether a message at @p level would currently be written
+     *
+     * Costs one relaxed atomic load; constant-folds to false for levels
+     * below the compile-time floor.
+     */
+    static bool isEnabled(Level level) {
+        return isCompiledIn(level) && level >= minLevel_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Send all further lines to @p sink (nullptr restores std::cerr)
+     *
+     * A running async backend is drained first and restarted with the same
+     * options. Like enableAsync(), this is meant for start-up/tear-down, not
+     * while other threads log.
+     */
+    static void setSink(std::shared_ptr<LogSink> sink) {
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        const bool async = asyncOwner_ != nullptr;
+        const AsyncOptions options = async ? asyncOwner_->options() : AsyncOptions{};
+        stopAsyncLocked();
+        currentSink().flush();
+
+        sinkOwner_ = std::move(sink);
+        sink_.store(sinkOwner_.get(), std::memory_order_release);
+        if (async) {
+            startAsyncLocked(options);
+        }
+    }
+
+    /**
+     * @brief Route all further messages through a background collector thread
+     * @param options Queue capacity, overflow behavior and write batch size
+     *
+     * Replaces (and drains) any backend that is already running. Switching
+     * modes is meant for start-up/tear-down, not while other threads log.
+     */
+    static void enableAsync(const AsyncOptions& options) {
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        stopAsyncLocked();
+        startAsyncLocked(options);
+    }
+
+    static void enableAsync() {
+        enableAsync(AsyncOptions{});
+    }
+
+    /**
+     * @brief Drain the async backend, stop its thread and return to sync mode
+     *
+     * Also runs automatically at static destruction, so queued lines are not
+     * lost when the program exits without calling it.
+     */
+    static void shutdown() {
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        stopAsyncLocked();
+    }
+
+    /**
+     * @brief Block until every message logged before this call is written
+     */
+    static void flush() {
+        if (AsyncBackend* backend = asyncBackend_.load(std::memory_order_acquire)) {
+            backend->flush();
+        }
+        currentSink().flush();
+    }
+
+    /**
+     * @brief Whether the asynchronous backend is active
+     */
+    static bool isAsync() {
+        return asyncBackend_.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+     * @brief Messages discarded by the Drop/OverwriteOldest overflow policies
+     */
+    static std::uint64_t droppedCount() {
+        return droppedMessages_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Limit the MATHENGINE_LOG_*_RATE_LIMITED sites of @p level
+     *
+     * All such sites at one level draw from a single bucket. The default,
+     * perSecond = 0, lets every line through. OFF is ignored.
+     */
+    static void setRateLimit(Level level, RateLimit limit) {
+        if (level == Level::OFF) {
+            return;
+        }
+        RateBucket& bucket = rateBuckets_[static_cast<std::size_t>(level)];
+        const std::int64_t interval = limit.perSecond > 0.0
+            ? std::max<std::int64_t>(1, static_cast<std::int64_t>(1e9 / limit.perSecond))
+            : 0;
+        const std::uint32_t burst = std::max<std::uint32_t>(limit.burst, 1);
+        bucket.tolerance.store(interval * (burst - 1), std::memory_order_relaxed);
+        bucket.arrival.store(0, std::memory_order_relaxed);
+        bucket.interval.store(interval, std::memory_order_release);
+    }
+
+    static RateLimit getRateLimit(Level level) {
+        if (level == Level::OFF) {
+            return {};
+        }
+        const RateBucket& bucket = rateBuckets_[static_cast<std::size_t>(level)];
+        const std::int64_t interval = bucket.interval.load(std::memory_order_acquire);
+        if (interval == 0) {
+            return {};
+        }
+        return {1e9 / static_cast<double>(interval),
+                static_cast<std::uint32_t>(bucket.tolerance.load(std::memory_order_relaxed) / interval + 1)};
+    }
+
+    /**
+     * @brief Take one token from @p level's bucket
+     * @return false if the line should be suppressed
+     *
+     * A generic cell rate algorithm on one atomic: suppressed calls only
+     * read it, so a saturated bucket costs no cache-line transfers.
+     */
+    static bool acquireRateToken(Level level) {
+        RateBucket& bucket = rateBuckets_[static_cast<std::size_t>(level)];
+        const std::int64_t interval = bucket.interval.load(std::memory_order_acquire);
+        if (interval == 0) {
+            return true;
+        }
+
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        const std::int64_t tolerance = bucket.tolerance.load(std::memory_order_relaxed);
+        std::int64_t arrival = bucket.arrival.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::int64_t start = std::max(arrival, now);
+            if (start - now > tolerance) {
+                return false;
+            }
+            if (bucket.arrival.compare_exchange_weak(arrival, start + interval, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
 private:
+    using Clock = std::chrono::system_clock;
+
+    /**
+     * @brief Rate limiter state for one level (steady-clock nanoseconds)
+     */
+    struct alignas(64) RateBucket {
+        std::atomic<std::int64_t> interval;   ///< Nanoseconds per token; 0 = unlimited
+        std::atomic<std::int64_t> tolerance;  ///< Burst allowance
+        std::atomic<std::int64_t> arrival;    ///< When the bucket is next empty
+    };
+
+    /**
+     * @brief Fixed-size queue entry so enqueueing never allocates
+     */
+    struct Record {
+        Clock::time_point timestamp{};
+        Level level = Level::INFO;
+        std::uint16_t length = 0;
+        std::array<char, kMaxAsyncMessageSize> text{};
+
+        void assign(Clock::time_point ts, Level lvl, std::string_view message) {
+            timestamp = ts;
+            level = lvl;
+            const std::size_t count = std::min(message.size(), text.size());
+            std::copy_n(message.data(), count, text.data());
+            if (count < message.size()) {
+                std::fill_n(text.data() + count - 3, 3, '.');
+            }
+            length = static_cast<std::uint16_t>(count);
+        }
+
+        std::string_view view() const {
+            return {text.data(), length};
+        }
+    };
+
+    /**
+     * @brief One producer thread's queue, shared with the collector
+     */
+    struct ThreadQueue {
+        explicit ThreadQueue(std::size_t capacity) : records(capacity) {}
+
+        RingBuffer<Record> records;
+        std::atomic<std::size_t> written{0};  ///< Dequeued records whose lines reached the sink
+        std::atomic<bool> retired{false};     ///< The owning thread has exited
+    };
+
+    /**
+     * @brief Background collector merging per-thread ring buffers
+     *
+     * Each producing thread registers its own queue on first use (the only
+     * time it takes a lock), so producers never contend with each other.
+     * They only notify when their queue is full; otherwise the collector
+     * polls with a short timed wait when every queue is empty, so the hot
+     * path stays free of syscalls.
+     * Each round takes up to batchSize records from every queue and merges
+     * them by timestamp, keeping every thread's own order.
+     */
+    class AsyncBackend {
+    public:
+        explicit AsyncBackend(const AsyncOptions& options)
+            : options_(options),
+              id_(nextId_.fetch_add(1, std::memory_order_relaxed) + 1),
+              worker_([this] { run(); }) {}
+
+        AsyncBackend(const AsyncBackend&) = delete;
+        AsyncBackend& operator=(const AsyncBackend&) = delete;
+
+        ~AsyncBackend() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            wake_.notify_one();
+            if (worker_.joinable()) {
+                worker_.join();
+            }
+        }
+
+        const AsyncOptions& options() const {
+            return options_;
+        }
+
+        void push(Clock::time_point timestamp, Level level, std::string_view message) {
+            RingBuffer<Record>& queue = localQueue().records;
+            auto fill = [&](Record& record) { record.assign(timestamp, level, message); };
+            if (queue.tryPush(fill)) {
+                return;
+            }
+
+            switch (options_.overflow) {
+                case OverflowPolicy::Block:
+                    // Already the slow path: waking the collector beats waiting out its poll
+                    wakeCollector();
+                    while (!queue.tryPush(fill)) {
+                        std::this_thread::yield();
+                    }
+                    break;
+                case OverflowPolicy::Drop:
+                    droppedMessages_.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case OverflowPolicy::OverwriteOldest:
+                    do {
+                        if (queue.tryPop([](Record&) {})) {
+                            droppedMessages_.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    } while (!queue.tryPush(fill));
+                    break;
+            }
+        }
+
+        void flush() {
+            std::vector<std::pair<std::shared_ptr<ThreadQueue>, std::size_t>> targets;
+            {
+                std::lock_guard<std::mutex> lock(registryMutex_);
+                for (const auto& queue : queues_) {
+                    targets.emplace_back(queue, queue->records.enqueuedCount());
+                }
+            }
+
+            wakeCollector();
+            std::unique_lock<std::mutex> lock(mutex_);
+            drained_.wait(lock, [&] {
+                return std::all_of(targets.begin(), targets.end(), [](const auto& target) {
+                    return target.first->written.load(std::memory_order_acquire) >= target.second;
+                });
+            });
+        }
+
+    private:
+        /// Staged records [begin, end) taken from one queue, oldest first
+        struct Run {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        void wakeCollector() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                flushRequested_ = true;
+            }
+            wake_.notify_one();
+        }
+
+        /**
+         * @brief The calling thread's queue, registered on first use
+         */
+        ThreadQueue& localQueue() {
+            struct Local {
+                std::uint64_t backend = 0;
+                std::shared_ptr<ThreadQueue> queue;
+
+                ~Local() {
+                    if (queue) {
+                        queue->retired.store(true, std::memory_order_release);
+                    }
+                }
+            };
+            thread_local Local local;
+
+            if (local.backend != id_) {
+                local.queue = std::make_shared<ThreadQueue>(options_.capacity);
+                local.backend = id_;
+                std::lock_guard<std::mutex> lock(registryMutex_);
+                queues_.push_back(local.queue);
+                registryVersion_.fetch_add(1, std::memory_order_release);
+            }
+            return *local.queue;
+        }
+
+        void run() {
+            std::vector<std::shared_ptr<ThreadQueue>> queues;
+            std::uint64_t version = 0;
+            std::vector<Record> staged;
+            std::vector<Run> runs;
+            fmt::memory_buffer batch;
+            for (;;) {
+                refresh(queues, version);
+
+                staged.clear();
+                runs.clear();
+                for (const auto& queue : queues) {
+                    const std::size_t begin = staged.size();
+                    while (staged.size() - begin < options_.batchSize &&
+                           queue->records.tryPop([&](Record& record) { staged.push_back(record); })) {
+                    }
+                    if (staged.size() > begin) {
+                        runs.push_back({begin, staged.size()});
+                    }
+                }
+
+                if (!staged.empty()) {
+                    writeMerged(staged, runs, batch);
+                }
+                for (const auto& queue : queues) {
+                    queue->written.store(queue->records.dequeuedCount(), std::memory_order_release);
+                }
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                drained_.notify_all();
+                if (!staged.empty()) {
+                    continue;
+                }
+
+                // Nothing ready: everything consumed so far has been written
+                if (stopping_) {
+                    // Producers may still be filling claimed slots or registering
+                    const bool empty = std::all_of(queues.begin(), queues.end(), [](const auto& queue) {
+                        return queue->records.dequeuedCount() >= queue->records.enqueuedCount();
+                    });
+                    if (empty && registryVersion_.load(std::memory_order_acquire) == version) {
+                        return;
+                    }
+                    lock.unlock();
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                wake_.wait_for(lock, std::chrono::milliseconds(1),
+                    [&] { return stopping_ || flushRequested_; });
+                flushRequested_ = false;
+            }
+        }
+
+        /**
+         * @brief Pick up newly registered queues and drop drained ones of exited threads
+         */
+        void refresh(std::vector<std::shared_ptr<ThreadQueue>>& queues, std::uint64_t& version) {
+            auto finished = [](const std::shared_ptr<ThreadQueue>& queue) {
+                return queue->retired.load(std::memory_order_acquire) &&
+                       queue->written.load(std::memory_order_relaxed) >= queue->records.enqueuedCount();
+            };
+            const bool prune = std::any_of(queues.begin(), queues.end(), finished);
+            if (!prune && registryVersion_.load(std::memory_order_acquire) == version) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            if (prune) {
+                std::erase_if(queues_, finished);
+            }
+            queues = queues_;
+            version = registryVersion_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Format the staged runs in timestamp order and write them
+         */
+        void writeMerged(const std::vector<Record>& staged, std::vector<Run>& runs,
+                         fmt::memory_buffer& batch) {
+            LogSink& sink = currentSink();
+            const bool color = sink.colored();
+            batch.clear();
+            std::size_t lines = 0;
+            for (std::size_t remaining = staged.size(); remaining > 0; --remaining) {
+                Run* next = nullptr;
+                for (Run& run : runs) {
+                    if (run.begin != run.end &&
+                        (next == nullptr || staged[run.begin].timestamp < staged[next->begin].timestamp)) {
+                        next = &run;
+                    }
+                }
+
+                const Record& record = staged[next->begin++];
+                formatLine(batch, record.timestamp, record.level, record.view(), color);
+                batch.push_back('\n');
+                if (++lines == options_.batchSize) {
+                    MATHENGINE_TRACE_ZONE("logger", "write");
+                    sink.write(std::string_view(batch.data(), batch.size()));
+                    batch.clear();
+                    lines = 0;
+                }
+            }
+            if (lines > 0) {
+                MATHENGINE_TRACE_ZONE("logger", "write");
+                sink.write(std::string_view(batch.data(), batch.size()));
+            }
+        }
+
+        static inline std::atomic<std::uint64_t> nextId_{0};
+
+        const AsyncOptions options_;
+        const std::uint64_t id_;  ///< Tells a thread's cached queue apart from an older backend's
+
+        std::mutex registryMutex_;
+        std::vector<std::shared_ptr<ThreadQueue>> queues_;
+        std::atomic<std::uint64_t> registryVersion_{0};
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable drained_;
+        bool flushRequested_ = false;
+        bool stopping_ = false;
+
+        std::thread worker_;  // Last member: starts after everything above exists
+    };
+
+    /**
+     * @brief Stops the async backend when static objects are destroyed
+     *
+     * Constructing the default sink first makes it outlive the guard, so
+     * lines drained at exit still have somewhere to go.
+     */
+    struct ShutdownGuard {
+        ShutdownGuard() { defaultSink(); }
+        ~ShutdownGuard() { Logger::shutdown(); }
+    };
+
+    static void startAsyncLocked(const AsyncOptions& options) {
+        asyncOwner_ = std::make_unique<AsyncBackend>(options);
+        asyncBackend_.store(asyncOwner_.get(), std::memory_order_release);
+    }
+
+    static void stopAsyncLocked() {
+        asyncBackend_.store(nullptr, std::memory_order_release);
+        asyncOwner_.reset();
+    }
+
+    static LogSink& defaultSink() {
+        static ConsoleSink sink;
+        return sink;
+    }
+
+    static LogSink& currentSink() {
+        LogSink* sink = sink_.load(std::memory_order_acquire);
+        return sink != nullptr ? *sink : defaultSink();
+    }
+
+    /**
+     * @brief Append one formatted line (without newline) to @p out
+     * @param color Wrap the line in the level's terminal color codes
+     *
+     * The "YYYY-mm-dd HH:MM:SS" prefix is cached per thread and only
+     * re-rendered when the second changes, which keeps localtime_r off the
+     * per-line path.
+     */
+    static void formatLine(fmt::memory_buffer& out, Clock::time_point now, Level level,
+                           std::string_view message, bool color) {
+        struct TimestampCache {
+            std::time_t second = -1;
+            std::array<char, 32> text{};
+            std::size_t length = 0;
+        };
+        thread_local TimestampCache cache;
+
+        const auto time_t = Clock::to_time_t(now);
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now.time_since_epoch()
+        ) % 1000;
+
+        if (time_t != cache.second) {
+            std::tm tm;
+#ifdef _WIN32
+            localtime_s(&tm, &time_t);
+#else
+            localtime_r(&time_t, &tm);
+#endif
+            const auto result = fmt::format_to_n(cache.text.data(), cache.text.size(),
+                "{:04}-{:02}-{:02} {:02}:{:02}:{:02}",
+                tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                tm.tm_hour, tm.tm_min, tm.tm_sec);
+            cache.length = std::min(result.size, cache.text.size());
+            cache.second = time_t;
+        }
+
+        // Colorize output (platform-specific)
+        const char* colorCode = color ? getColor(level) : nullptr;
+        auto it = std::back_inserter(out);
+        if (colorCode) {
+            it = fmt::format_to(it, "{}", colorCode);
+        }
+        it = fmt::format_to(it, "{}.{:03} [{}] {}",
+            std::string_view(cache.text.data(), cache.length),
+            static_cast<int>(ms.count()), levelToString(level), message);
+        if (colorCode) {
+            fmt::format_to(it, "\033[0m");
+        }
+    }
+
+    /**
+     * @brief Per-thread scratch buffers, reused so logging does not allocate
+     */
+    static fmt::memory_buffer& messageBuffer() {
+        thread_local fmt::memory_buffer buffer;
+        return buffer;
+    }
+
+    static fmt::memory_buffer& lineBuffer() {
+        thread_local fmt::memory_buffer buffer;
+        return buffer;
+    }
+
     static const char* levelToString(Level level) {
         switch (level) {
             case Level::DEBUG:   return "DEBUG";
@@ -107,8 +844,101 @@ private:
         }
 #endif
     }
+
+    // Declaration order matters: the guard is destroyed first
+    static inline std::atomic<Level> minLevel_{Level::DEBUG};
+    static inline std::atomic<AsyncBackend*> asyncBackend_{nullptr};
+    static inline std::atomic<LogSink*> sink_{nullptr};  ///< nullptr: defaultSink()
+    static inline std::atomic<std::uint64_t> droppedMessages_{0};
+    static inline std::array<RateBucket, 4> rateBuckets_;  // Value-initialized: all unlimited
+    static inline std::mutex controlMutex_;
+    static inline std::shared_ptr<LogSink> sinkOwner_;
+    static inline std::unique_ptr<AsyncBackend> asyncOwner_;
+    static inline ShutdownGuard shutdownGuard_;
 };
 
 } // namespace MathEngine
 
+// The macros below route to BinaryLog while one is open (it also brings in
+// LogSampler for the sampled macros)
+#include "logger/binary_log.hpp"
+
+// ============================================================================
+// Logging Macros
+// ============================================================================
+// The arguments are only evaluated when the level is enabled, so building
+// the message costs nothing for filtered-out calls. Levels below
+// MATHENGINE_LOG_LEVEL generate no code at all. While BinaryLog is open,
+// each call site records its arguments there instead of formatting text.
+// ============================================================================
+
+#define MATHENGINE_LOG(level, ...)                                                  \
+    do {                                                                            \
+        if constexpr (::MathEngine::Logger::isCompiledIn(level)) {                  \
+            if (::MathEngine::Logger::isEnabled(level)) {                           \
+                if (::MathEngine::BinaryLog::isOpen()) {                            \
+                    static ::MathEngine::BinaryLog::Site mathengineLogSite_{        \
+                        __FILE__, __LINE__};                                        \
+                    ::MathEngine::BinaryLog::write(level, mathengineLogSite_,       \
+                                                   __VA_ARGS__);                    \
+                } else {                                                            \
+                    ::MathEngine::Logger::log(level, __VA_ARGS__);                  \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+    } while (false)
+
+#define MATHENGINE_LOG_DEBUG(...)   MATHENGINE_LOG(::MathEngine::Logger::Level::DEBUG, __VA_ARGS__)
+#define MATHENGINE_LOG_INFO(...)    MATHENGINE_LOG(::MathEngine::Logger::Level::INFO, __VA_ARGS__)
+#define MATHENGINE_LOG_WARNING(...) MATHENGINE_LOG(::MathEngine::Logger::Level::WARNING, __VA_ARGS__)
+#define MATHENGINE_LOG_ERROR(...)   MATHENGINE_LOG(::MathEngine::Logger::Level::ERROR, __VA_ARGS__)
+
+// ============================================================================
+// Sampled Logging Macros
+// ============================================================================
+// For sites too hot to log every call. Each site counts its calls and only
+// writes the ones its LogSampler admits: the first of every N per thread
+// (EVERY_N), the first N overall (FIRST_N), or what the level's
+// Logger::setRateLimit() bucket allows (RATE_LIMITED, unlimited by
+// default). Suppressed calls are reported in periodic summary lines named
+// after the enclosing function and the line of the site.
+// ============================================================================
+
+#define MATHENGINE_LOG_SAMPLED(level, policy, n, ...)                               \
+    do {                                                                            \
+        if constexpr (::MathEngine::Logger::isCompiledIn(level)) {                  \
+            if (::MathEngine::Logger::isEnabled(level)) {                           \
+                static ::MathEngine::LogSampler mathengineLogSampler_{              \
+                    __func__, __LINE__, level, policy, n};                          \
+                static thread_local ::MathEngine::LogSampler::Local                 \
+                    mathengineLogSamplerLocal_;                                     \
+                if (mathengineLogSampler_.admit(mathengineLogSamplerLocal_)) {      \
+                    MATHENGINE_LOG(level, __VA_ARGS__);                             \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+    } while (false)
+
+#define MATHENGINE_LOG_EVERY_N(level, n, ...) \
+    MATHENGINE_LOG_SAMPLED(level, ::MathEngine::LogSampler::Policy::EveryN, n, __VA_ARGS__)
+#define MATHENGINE_LOG_FIRST_N(level, n, ...) \
+    MATHENGINE_LOG_SAMPLED(level, ::MathEngine::LogSampler::Policy::FirstN, n, __VA_ARGS__)
+#define MATHENGINE_LOG_RATE_LIMITED(level, ...) \
+    MATHENGINE_LOG_SAMPLED(level, ::MathEngine::LogSampler::Policy::RateLimited, 1, __VA_ARGS__)
+
+#define MATHENGINE_LOG_DEBUG_EVERY_N(n, ...)   MATHENGINE_LOG_EVERY_N(::MathEngine::Logger::Level::DEBUG, n, __VA_ARGS__)
+#define MATHENGINE_LOG_INFO_EVERY_N(n, ...)    MATHENGINE_LOG_EVERY_N(::MathEngine::Logger::Level::INFO, n, __VA_ARGS__)
+#define MATHENGINE_LOG_WARNING_EVERY_N(n, ...) MATHENGINE_LOG_EVERY_N(::MathEngine::Logger::Level::WARNING, n, __VA_ARGS__)
+#define MATHENGINE_LOG_ERROR_EVERY_N(n, ...)   MATHENGINE_LOG_EVERY_N(::MathEngine::Logger::Level::ERROR, n, __VA_ARGS__)
+
+#define MATHENGINE_LOG_DEBUG_FIRST_N(n, ...)   MATHENGINE_LOG_FIRST_N(::MathEngine::Logger::Level::DEBUG, n, __VA_ARGS__)
+#define MATHENGINE_LOG_INFO_FIRST_N(n, ...)    MATHENGINE_LOG_FIRST_N(::MathEngine::Logger::Level::INFO, n, __VA_ARGS__)
+#define MATHENGINE_LOG_WARNING_FIRST_N(n, ...) MATHENGINE_LOG_FIRST_N(::MathEngine::Logger::Level::WARNING, n, __VA_ARGS__)
+#define MATHENGINE_LOG_ERROR_FIRST_N(n, ...)   MATHENGINE_LOG_FIRST_N(::MathEngine::Logger::Level::ERROR, n, __VA_ARGS__)
+
+#define MATHENGINE_LOG_DEBUG_RATE_LIMITED(...)   MATHENGINE_LOG_RATE_LIMITED(::MathEngine::Logger::Level::DEBUG, __VA_ARGS__)
+#define MATHENGINE_LOG_INFO_RATE_LIMITED(...)    MATHENGINE_LOG_RATE_LIMITED(::MathEngine::Logger::Level::INFO, __VA_ARGS__)
+#define MATHENGINE_LOG_WARNING_RATE_LIMITED(...) MATHENGINE_LOG_RATE_LIMITED(::MathEngine::Logger::Level::WARNING, __VA_ARGS__)
+#define MATHENGINE_LOG_ERROR_RATE_LIMITED(...)   MATHENGINE_LOG_RATE_LIMITED(::MathEngine::Logger::Level::ERROR, __VA_ARGS__)
+
 #endif // LOGGER_LOGGER_HPP
@@ -0,0 +1,136 @@
+#ifndef LOGGER_RING_BUFFER_HPP
+#define LOGGER_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace MathEngine {
+
+/**
+ * @brief Bounded lock-free ring buffer (Vyukov-style sequence cells)
+ *
+ * Any number of threads may push and pop concurrently. Each cell carries a
+ * sequence number that tells producers and consumers whether the slot is
+ * free or holds a published value, so no thread ever takes a lock.
+ *
+ * Values are written and read in place through callables, which lets large
+ * records live inside the buffer without extra copies or allocations.
+ *
+ * @tparam T Element type (must be default constructible)
+ */
+template <typename T>
+class RingBuffer {
+public:
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    /**
+     * @brief Create a buffer holding at least @p capacity elements
+     * @param capacity Requested capacity, rounded up to a power of two
+     */
+    explicit RingBuffer(std::size_t capacity)
+        : capacity_(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)),
+          mask_(capacity_ - 1),
+          cells_(std::make_unique<Cell[]>(capacity_)) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /**
+     * @brief Try to publish a value
+     * @param fill Callable invoked as fill(T&) to write the value in place
+     * @return false if the buffer is full
+     */
+    template <typename Fill>
+    bool tryPush(Fill&& fill) {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(cell.value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Try to take the oldest published value
+     * @param consume Callable invoked as consume(T&) before the slot is released
+     * @return false if no published value is available
+     */
+    template <typename Consume>
+    bool tryPop(Consume&& consume) {
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    consume(cell.value);
+                    cell.sequence.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Number of slots claimed by producers so far
+     */
+    std::size_t enqueuedCount() const {
+        return enqueuePos_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Number of slots claimed by consumers so far
+     */
+    std::size_t dequeuedCount() const {
+        return dequeuePos_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    // Producers and consumers each get their own cache line
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeuePos_{0};
+};
+
+} // namespace MathEngine
+
+#endif // LOGGER_RING_BUFFER_HPP
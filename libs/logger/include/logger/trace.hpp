@@ -0,0 +1,399 @@
+#ifndef LOGGER_TRACE_HPP
+#define LOGGER_TRACE_HPP
+
+#include "logger/visibility.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Whether the library's tracing zones are compiled in (1) or out (0)
+ *
+ * Normally set by CMake through the MATHENGINE_ENABLE_TRACING option. When
+ * 0, MATHENGINE_TRACE_ZONE expands to nothing, so the zones in the
+ * Calculator and the Logger cost nothing at all.
+ */
+#ifndef MATHENGINE_TRACING
+#define MATHENGINE_TRACING 0
+#endif
+
+namespace MathEngine {
+
+/**
+ * @brief Scoped timing zones, exported as a Chrome trace
+ *
+ * A Zone reads the CPU timestamp counter (TSC on x86, the virtual counter
+ * on AArch64, steady_clock elsewhere) when it opens and when it closes, and
+ * appends one event to its thread's buffer. Each thread writes only its own
+ * fixed-size buffer and publishes it with a release store, so recording
+ * takes no lock and never allocates after the thread's first zone. Events
+ * past a buffer's capacity are dropped and counted.
+ *
+ * A thread's buffer outlives it, so its zones are still exported, but not
+ * indefinitely: clear() frees the buffers of exited threads, a new thread
+ * reuses an exited thread's buffer once it is empty, and at most
+ * kRetainedExitedThreads exited threads keep a buffer. Past that, the
+ * oldest one is freed and its events counted as dropped, so threads that
+ * come and go (e.g. a resized Executor) cannot grow the memory unbounded.
+ *
+ * writeChromeTrace() converts the counter to microseconds and writes the
+ * Chrome trace event format: open it in chrome://tracing or Perfetto, or
+ * convert it for Tracy with its import-chrome tool. The TSC conversion
+ * assumes an invariant TSC, as on any x86-64 CPU of the last decade.
+ */
+class LOGGER_API Trace {
+public:
+    /// Whether the Calculator and Logger zones are compiled in
+    static constexpr bool kCompiledIn = MATHENGINE_TRACING != 0;
+
+    /// Events each thread keeps (32 bytes each)
+    static constexpr std::size_t kEventsPerThread = std::size_t{1} << 16;
+
+    /// Exited threads whose events are kept for export (2 MiB each)
+    static constexpr std::size_t kRetainedExitedThreads = 16;
+
+    /**
+     * @brief Counter ticks (see the class comment for the source)
+     */
+    static std::uint64_t now() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Times the enclosing scope, exceptions included
+     *
+     * @p category and @p name must outlive the export (string literals).
+     */
+    class Zone {
+    public:
+        Zone(const char* category, const char* name) noexcept
+            : category_(category), name_(name),
+              begin_(enabled_.load(std::memory_order_relaxed) ? now() : 0) {}
+
+        ~Zone() {
+            if (begin_ != 0) {
+                record(category_, name_, begin_, now());
+            }
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* category_;
+        const char* name_;
+        std::uint64_t begin_;
+    };
+
+    /**
+     * @brief Pause (false) or resume recording; on by default
+     */
+    static void setEnabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    static bool isEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Append a finished zone to the calling thread's buffer
+     */
+    static void record(const char* category, const char* name, std::uint64_t begin,
+                       std::uint64_t end) noexcept {
+        ThreadBuffer* buffer = threadBuffer();
+        if (buffer == nullptr) {
+            return;
+        }
+        const std::size_t count = buffer->count.load(std::memory_order_relaxed);
+        if (count == kEventsPerThread) {
+            buffer->dropped.store(buffer->dropped.load(std::memory_order_relaxed) + 1,
+                                  std::memory_order_relaxed);
+            return;
+        }
+        buffer->events[count] = Event{category, name, begin, end};
+        buffer->count.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Events recorded so far, over all threads
+     */
+    static std::size_t eventCount() {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        std::size_t total = 0;
+        for (const auto& buffer : registry().buffers) {
+            total += buffer->count.load(std::memory_order_acquire);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Events lost to full buffers or to freed exited threads
+     */
+    static std::size_t droppedCount() {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        std::size_t total = registry().retiredDropped;
+        for (const auto& buffer : registry().buffers) {
+            total += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Forget every event, e.g. to trace only a steady state
+     *
+     * Like Logger::setSink(), meant for quiet moments: a zone closing on
+     * another thread meanwhile may be lost.
+     */
+    static void clear() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        std::erase_if(reg.buffers, [](const auto& buffer) { return buffer->exited; });
+        for (const auto& buffer : reg.buffers) {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+        reg.retiredDropped = 0;
+    }
+
+    /**
+     * @brief Write everything recorded so far as Chrome trace JSON
+     *
+     * Safe while other threads record: each buffer is read up to what it
+     * had published. Zones become complete ("X") events with microsecond
+     * timestamps from the earliest event, one tid per recording thread.
+     */
+    static void writeChromeTrace(std::ostream& out) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        std::vector<std::size_t> counts;
+        std::uint64_t origin = UINT64_MAX;
+        for (const auto& buffer : reg.buffers) {
+            counts.push_back(buffer->count.load(std::memory_order_acquire));
+            for (std::size_t i = 0; i < counts.back(); ++i) {
+                origin = std::min(origin, buffer->events[i].begin);
+            }
+        }
+        const double ticksPerMicrosecond = reg.ticksPerMicrosecond();
+
+        const std::ios::fmtflags flags = out.flags();
+        const std::streamsize precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        const char* separator = "\n";
+        for (std::size_t b = 0; b < reg.buffers.size(); ++b) {
+            const ThreadBuffer& buffer = *reg.buffers[b];
+            out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.tid
+                << ",\"args\":{\"name\":\"thread " << buffer.tid << "\"}}";
+            separator = ",\n";
+            for (std::size_t i = 0; i < counts[b]; ++i) {
+                const Event& event = buffer.events[i];
+                out << separator << "{\"name\":\"";
+                writeEscaped(out, event.name);
+                out << "\",\"cat\":\"";
+                writeEscaped(out, event.category);
+                out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.tid
+                    << ",\"ts\":" << static_cast<double>(event.begin - origin) / ticksPerMicrosecond
+                    << ",\"dur\":" << static_cast<double>(event.end - event.begin) / ticksPerMicrosecond
+                    << "}";
+            }
+        }
+        out << "\n]}\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    /**
+     * @brief writeChromeTrace() to a file
+     * @return false if the file could not be written
+     */
+    static bool writeChromeTrace(const std::string& path) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        writeChromeTrace(file);
+        file.flush();
+        return static_cast<bool>(file);
+    }
+
+private:
+    struct Event {
+        const char* category;
+        const char* name;
+        std::uint64_t begin;
+        std::uint64_t end;
+    };
+
+    /**
+     * @brief One thread's events; written by that thread only
+     *
+     * Owned by the registry, not the thread, so a thread's zones are still
+     * exported after it exits.
+     */
+    struct alignas(64) ThreadBuffer {
+        explicit ThreadBuffer(std::uint32_t id) : events(new Event[kEventsPerThread]), tid(id) {}
+
+        std::unique_ptr<Event[]> events;
+        std::atomic<std::size_t> count{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::uint32_t tid;
+        bool exited = false;  ///< Guarded by the registry mutex
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;  ///< In registration order
+        std::uint32_t nextTid = 1;
+        std::size_t retiredDropped = 0;  ///< Events of freed exited threads
+
+        // Calibration start: a counter reading and the steady_clock time
+        const std::uint64_t startTicks = now();
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        double ticksPerMicrosecond() const {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+            // Measure against steady_clock over at least a few milliseconds
+            const auto minimum = startTime + std::chrono::milliseconds(5);
+            std::this_thread::sleep_until(minimum);
+            const std::uint64_t ticks = now() - startTicks;
+            const double elapsed =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+            return static_cast<double>(ticks) / elapsed;
+#elif defined(__aarch64__)
+            std::uint64_t frequency;
+            asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+            return static_cast<double>(frequency) / 1e6;
+#else
+            return 1000.0;  // steady_clock nanoseconds
+#endif
+        }
+    };
+
+    static Registry& registry() {
+        // Intentionally leaked: zones may still close on other threads during exit
+        static auto* instance = new Registry();
+        return *instance;
+    }
+
+    /**
+     * @brief Hands the thread's buffer back to the registry when it exits
+     */
+    struct ThreadExit {
+        ~ThreadExit() {
+            if (buffer_ == nullptr) {
+                return;
+            }
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            buffer_->exited = true;
+            buffer_ = nullptr;
+            exiting_ = true;
+
+            // Free the oldest exited threads' buffers beyond the retained ones
+            std::size_t exited = 0;
+            for (const auto& buffer : reg.buffers) {
+                exited += buffer->exited ? 1 : 0;
+            }
+            for (auto it = reg.buffers.begin(); exited > kRetainedExitedThreads;) {
+                if ((*it)->exited) {
+                    reg.retiredDropped += (*it)->count.load(std::memory_order_relaxed) +
+                                          (*it)->dropped.load(std::memory_order_relaxed);
+                    it = reg.buffers.erase(it);
+                    --exited;
+                } else {
+                    ++it;
+                }
+            }
+        }
+    };
+
+    /// The calling thread's buffer, registered on first use (nullptr if out
+    /// of memory, or once the thread is exiting)
+    static ThreadBuffer* threadBuffer() noexcept {
+        if (buffer_ == nullptr && !exiting_) {
+            try {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                // Reuse an exited thread's emptied buffer, moved to the back
+                const auto reusable = std::find_if(reg.buffers.begin(), reg.buffers.end(), [](const auto& buffer) {
+                    return buffer->exited && buffer->count.load(std::memory_order_relaxed) == 0;
+                });
+                if (reusable == reg.buffers.end()) {
+                    reg.buffers.push_back(std::make_unique<ThreadBuffer>(reg.nextTid));
+                } else {
+                    std::rotate(reusable, reusable + 1, reg.buffers.end());
+                    ThreadBuffer& buffer = *reg.buffers.back();
+                    buffer.tid = reg.nextTid;
+                    buffer.dropped.store(0, std::memory_order_relaxed);
+                    buffer.exited = false;
+                }
+                ++reg.nextTid;
+                buffer_ = reg.buffers.back().get();
+                static thread_local ThreadExit threadExit;
+                static_cast<void>(threadExit);
+            } catch (...) {
+                return nullptr;
+            }
+        }
+        return buffer_;
+    }
+
+    static void writeEscaped(std::ostream& out, const char* text) {
+        for (; *text != '\0'; ++text) {
+            if (*text == '"' || *text == '\\') {
+                out << '\\';
+            }
+            out << *text;
+        }
+    }
+
+    static inline std::atomic<bool> enabled_{true};
+    static inline thread_local ThreadBuffer* buffer_ = nullptr;
+    static inline thread_local bool exiting_ = false;
+};
+
+} // namespace MathEngine
+
+#define MATHENGINE_TRACE_CONCAT_INNER(a, b) a##b
+#define MATHENGINE_TRACE_CONCAT(a, b) MATHENGINE_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Time the rest of the enclosing scope as zone @p name of @p category
+ *
+ * Compiled out (no code at all) unless MATHENGINE_TRACING is 1.
+ */
+#if MATHENGINE_TRACING
+#define MATHENGINE_TRACE_ZONE(category, name) \
+    const ::MathEngine::Trace::Zone MATHENGINE_TRACE_CONCAT(mathengineTraceZone_, __LINE__)(category, name)
+#else
+#define MATHENGINE_TRACE_ZONE(category, name) static_cast<void>(0)
+#endif
+
+#endif // LOGGER_TRACE_HPP
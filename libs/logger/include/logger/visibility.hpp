@@ -0,0 +1,21 @@
+#ifndef LOGGER_VISIBILITY_HPP
+#define LOGGER_VISIBILITY_HPP
+
+/**
+ * @brief Visibility of the logger classes that hold process-wide state
+ *
+ * The logger is header-only, so its state (level, sink, async backend,
+ * binary log) lives in inline static members that every binary including
+ * it defines. A shared math_engine is built with hidden visibility; marking
+ * these classes default-visible lets the dynamic linker merge the copies,
+ * so the library and the program configure and write to one Logger.
+ * Windows DLLs cannot share header-only data this way: there, configure
+ * logging from a static build.
+ */
+#if defined(_WIN32) || !defined(__GNUC__)
+#define LOGGER_API
+#else
+#define LOGGER_API __attribute__((visibility("default")))
+#endif
+
+#endif // LOGGER_VISIBILITY_HPP
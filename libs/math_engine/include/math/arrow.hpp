@@ -0,0 +1,208 @@
+#ifndef MATH_ARROW_HPP
+#define MATH_ARROW_HPP
+
+#include "math/calculator.hpp"
+#include "math/export.h"
+#include "math/reduction.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+
+// ============================================================================
+// Arrow C Data Interface
+// ============================================================================
+// The ABI-stable structs of https://arrow.apache.org/docs/format/CDataInterface.html,
+// copied as the specification asks, so MathEngine exchanges Arrow arrays
+// with any Arrow implementation (Arrow C++, pyarrow, arrow-rs, ...) without
+// depending on one. The guard keeps a definition already included from
+// Arrow's own abi.h.
+// ============================================================================
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace MathEngine {
+
+/**
+ * @brief Borrowed view of an Arrow float64 array (format "g")
+ *
+ * Points into the producer's buffers: nothing is copied, and the array
+ * must stay alive (unreleased) while the view is used. Null slots hold
+ * unspecified values, which the operations never report or reduce.
+ */
+class MATHENGINE_API ArrowColumn {
+public:
+    /**
+     * @throws std::invalid_argument unless schema describes a float64 array
+     *         and array is a live, well-formed array of it
+     */
+    ArrowColumn(const ArrowArray& array, const ArrowSchema& schema);
+
+    std::size_t size() const { return values_.size(); }
+    std::size_t nullCount() const { return nullCount_; }
+
+    /// Every slot, null ones included
+    std::span<const double> values() const { return values_; }
+
+    /// Validity bitmap (LSB first) and the bit of slot 0; nullptr when no slot is null
+    const std::uint8_t* validity() const { return validity_; }
+    std::size_t validityOffset() const { return validityOffset_; }
+
+    bool isValid(std::size_t i) const {
+        const std::size_t bit = validityOffset_ + i;
+        return validity_ == nullptr || ((validity_[bit / 8] >> (bit % 8)) & 1) != 0;
+    }
+
+private:
+    std::span<const double> values_;
+    const std::uint8_t* validity_ = nullptr;
+    std::size_t validityOffset_ = 0;
+    std::size_t nullCount_ = 0;
+};
+
+/**
+ * @brief Arrow float64 array produced by ArrowCompute, owning its buffers
+ *
+ * The buffers (values 64-byte aligned, validity bitmap only when a slot is
+ * null) come from the memory resource passed to the operation, which must
+ * outlive the array. Hand the structs to an Arrow implementation, e.g.
+ * arrow::ImportArray(result.array(), result.schema()), which moves them
+ * out; whatever is still owned here is released by the destructor.
+ */
+class MATHENGINE_API ArrowResult {
+public:
+    ArrowResult();
+    ~ArrowResult();
+
+    ArrowResult(ArrowResult&& other) noexcept;
+    ArrowResult& operator=(ArrowResult&& other) noexcept;
+
+    ArrowResult(const ArrowResult&) = delete;
+    ArrowResult& operator=(const ArrowResult&) = delete;
+
+    ArrowArray* array() { return &array_; }
+    ArrowSchema* schema() { return &schema_; }
+
+    /// View of the result, e.g. as the input of a further operation
+    ArrowColumn column() const { return {array_, schema_}; }
+
+private:
+    ArrowArray array_;
+    ArrowSchema schema_;
+};
+
+/**
+ * @brief Batch operations and reductions straight on Arrow arrays
+ *
+ * The Calculator batch operations run on the Arrow values buffers in
+ * place, so a column is neither copied in nor copied out. The result's
+ * validity is the AND of the inputs' validity, and division follows the
+ * non-throwing batch policy through it: a zero denominator in a valid slot
+ * makes that slot null (rather than NaN) and is counted in the
+ * BatchStatus, which covers valid slots only. The underlying batch sees
+ * null slots as ordinary elements, so its log line and metrics may count
+ * zero denominators there too.
+ *
+ * Reductions skip null slots, as Arrow's compute functions do. An array
+ * without nulls is reduced in place; otherwise its valid values are first
+ * packed into the ReductionOptions::scratch resource (ScratchArena::local()
+ * by default).
+ *
+ * Results are allocated from @p memory (the default resource when null),
+ * e.g. a std::pmr adapter over the caller's arrow::MemoryPool.
+ * @throws std::invalid_argument on a length mismatch, besides the
+ *         ArrowColumn checks
+ */
+class MATHENGINE_API ArrowCompute {
+public:
+    using ResultType = Calculator::ResultType;
+
+    static ArrowResult add(const ArrowColumn& a, const ArrowColumn& b,
+                           std::pmr::memory_resource* memory = nullptr);
+    static ArrowResult add(const ArrowColumn& a, ResultType b, std::pmr::memory_resource* memory = nullptr);
+    static ArrowResult subtract(const ArrowColumn& a, const ArrowColumn& b,
+                                std::pmr::memory_resource* memory = nullptr);
+    static ArrowResult subtract(const ArrowColumn& a, ResultType b,
+                                std::pmr::memory_resource* memory = nullptr);
+    static ArrowResult multiply(const ArrowColumn& a, const ArrowColumn& b,
+                                std::pmr::memory_resource* memory = nullptr);
+    static ArrowResult multiply(const ArrowColumn& a, ResultType b,
+                                std::pmr::memory_resource* memory = nullptr);
+    static ArrowResult power(const ArrowColumn& base, std::int32_t exp,
+                             std::pmr::memory_resource* memory = nullptr);
+
+    /**
+     * @brief a / b with zero denominators as nulls
+     * @param status Zero denominators among the valid slots (optional)
+     */
+    static ArrowResult divide(const ArrowColumn& a, const ArrowColumn& b,
+                              Calculator::BatchStatus* status = nullptr,
+                              std::pmr::memory_resource* memory = nullptr);
+    static ArrowResult divide(const ArrowColumn& a, ResultType b, Calculator::BatchStatus* status = nullptr,
+                              std::pmr::memory_resource* memory = nullptr);
+
+    /// Sum of the valid slots (0 if there are none)
+    static ResultType sum(const ArrowColumn& values, const ReductionOptions& options = {});
+
+    /// Product of the valid slots (1 if there are none)
+    static ResultType product(const ArrowColumn& values, const ReductionOptions& options = {});
+
+    /// Sum of a[i] * b[i] over the slots valid in both
+    static ResultType dot(const ArrowColumn& a, const ArrowColumn& b, const ReductionOptions& options = {});
+
+    /**
+     * @brief Smallest / largest valid slot
+     * @throws std::invalid_argument if no slot is valid
+     */
+    static ResultType min(const ArrowColumn& values, const ReductionOptions& options = {});
+    static ResultType max(const ArrowColumn& values, const ReductionOptions& options = {});
+};
+
+} // namespace MathEngine
+
+#endif // MATH_ARROW_HPP
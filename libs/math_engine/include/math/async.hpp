@@ -0,0 +1,259 @@
+#ifndef MATH_ASYNC_HPP
+#define MATH_ASYNC_HPP
+
+#include "math/calculator.hpp"
+#include "math/expected.hpp"
+#include "math/export.h"
+#include "math/reduction.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stop_token>
+
+namespace MathEngine {
+
+class AsyncCalculator;
+class Executor;
+class Expression;
+
+/**
+ * @brief Construction options for AsyncCalculator
+ */
+struct AsyncOptions {
+    /// Pool the work runs on; nullptr uses Executor::global() at each co_await
+    Executor* executor = nullptr;
+
+    /// Operations running at once; further ones wait, suspended, for a slot (0: no limit)
+    std::size_t maxInFlight = 0;
+
+    /// Elements per chunk of a batch: the unit of work and of cancellation
+    std::size_t chunkSize = std::size_t{1} << 15;
+
+    /**
+     * Resumes an awaiting coroutine, e.g. by posting the handle to the
+     * caller's event loop. Empty: the coroutine resumes on the pool thread
+     * that finished the work.
+     */
+    std::function<void(std::coroutine_handle<>)> resume = {};
+};
+
+namespace detail {
+
+/**
+ * @brief What AsyncBatch and AsyncValue share: admission, chunks, resumption
+ */
+class MATHENGINE_API AsyncTask {
+public:
+    AsyncTask(const AsyncTask&) = delete;
+    AsyncTask& operator=(const AsyncTask&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> caller);
+
+protected:
+    AsyncTask(AsyncCalculator& engine, std::size_t size, std::size_t chunk, std::stop_token stop);
+    ~AsyncTask() = default;
+
+    /// Rethrows what the work threw; false if it was cancelled
+    bool completed() const;
+
+private:
+    friend class MathEngine::AsyncCalculator;
+
+    struct ChunkRunner {
+        AsyncTask* task;
+        void operator()(std::size_t first, std::size_t last) const;
+    };
+
+    struct Finisher {
+        AsyncTask* task;
+        void operator()(std::exception_ptr error) const;
+    };
+
+    virtual void runChunk(std::size_t begin, std::size_t end) = 0;
+
+    void start();
+    void finish(std::exception_ptr error);
+
+    AsyncCalculator& engine_;
+    std::size_t size_;
+    std::size_t chunk_;
+    std::stop_token stop_;
+    std::coroutine_handle<> caller_;
+    Executor* executor_ = nullptr;
+    std::atomic<bool> cancelled_{false};
+    std::exception_ptr error_;
+    ChunkRunner runner_{this};
+    Finisher finisher_{this};
+    AsyncTask* next_ = nullptr;  ///< Next in the engine's wait queue
+};
+
+} // namespace detail
+
+/**
+ * @brief Awaitable batch operation of an AsyncCalculator
+ *
+ * co_await yields the BatchStatus of the whole batch (indices over the
+ * whole span), MathError::Cancelled, or rethrows what the batch threw.
+ */
+class MATHENGINE_API AsyncBatch final : public detail::AsyncTask {
+public:
+    /// Runs elements [begin, end); the status indices are relative to begin
+    using Work = std::function<Calculator::BatchStatus(std::size_t begin, std::size_t end)>;
+
+    Expected<Calculator::BatchStatus, MathError> await_resume();
+
+private:
+    friend class AsyncCalculator;
+
+    AsyncBatch(AsyncCalculator& engine, std::size_t size, std::size_t chunk, std::stop_token stop,
+               Work work);
+
+    void runChunk(std::size_t begin, std::size_t end) override;
+
+    Work work_;
+    std::mutex statusMutex_;
+    Calculator::BatchStatus status_;
+};
+
+/**
+ * @brief Awaitable reduction of an AsyncCalculator
+ *
+ * co_await yields the reduced value, MathError::Cancelled, or rethrows
+ * what the reduction threw (e.g. std::invalid_argument for an empty span).
+ */
+class MATHENGINE_API AsyncValue final : public detail::AsyncTask {
+public:
+    using Work = std::function<Calculator::ResultType()>;
+
+    Expected<Calculator::ResultType, MathError> await_resume();
+
+private:
+    friend class AsyncCalculator;
+
+    AsyncValue(AsyncCalculator& engine, std::stop_token stop, Work work);
+
+    void runChunk(std::size_t begin, std::size_t end) override;
+
+    Work work_;
+    Calculator::ResultType value_ = 0;
+};
+
+/**
+ * @brief Awaitable forms of the batch, expression and reduction entry points
+ *
+ * For coroutine-based services whose I/O threads must not run a large
+ * batch themselves:
+ *
+ *     AsyncCalculator engine({.maxInFlight = 4});
+ *     auto status = co_await engine.add(a, b, out);
+ *
+ * co_await hands the work to the Executor and suspends the coroutine; it
+ * resumes once the work is done, on the pool thread that finished it or
+ * through AsyncOptions::resume. Batches and expressions are cut into
+ * chunks of AsyncOptions::chunkSize elements, each run as one call of the
+ * synchronous API, so chunks log and count metrics like any batch, and
+ * the caller's getLastResult() is not updated. A reduction runs as one
+ * task and is split by Reduction itself over the global Executor.
+ *
+ * Cancellation: every operation takes a std::stop_token. A stop requested
+ * before co_await suspends nothing; one requested later skips the chunks
+ * not yet started. Either way co_await yields MathError::Cancelled, and
+ * the chunks already run have written their part of the output.
+ *
+ * Back-pressure: with maxInFlight set, further operations wait suspended
+ * in FIFO order until a running one finishes, so a burst of requests
+ * queues on the engine instead of blocking threads or flooding the pool.
+ *
+ * Size mismatches throw std::invalid_argument from the call itself, as in
+ * Calculator. Every span must stay valid until the operation completes.
+ * Without an executor (or with one without workers) the work runs inline
+ * in co_await, without suspending. The engine must outlive its operations.
+ */
+class MATHENGINE_API AsyncCalculator {
+public:
+    using ResultType = Calculator::ResultType;
+
+    explicit AsyncCalculator(AsyncOptions options = {});
+
+    AsyncCalculator(const AsyncCalculator&) = delete;
+    AsyncCalculator& operator=(const AsyncCalculator&) = delete;
+
+    // ========================================================================
+    // Batch operations (see Calculator)
+    // ========================================================================
+
+    [[nodiscard]] AsyncBatch add(std::span<const ResultType> a, std::span<const ResultType> b,
+                                 std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch add(std::span<const ResultType> a, ResultType b,
+                                 std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch subtract(std::span<const ResultType> a, std::span<const ResultType> b,
+                                      std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch subtract(std::span<const ResultType> a, ResultType b,
+                                      std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch multiply(std::span<const ResultType> a, std::span<const ResultType> b,
+                                      std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch multiply(std::span<const ResultType> a, ResultType b,
+                                      std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch divide(std::span<const ResultType> a, std::span<const ResultType> b,
+                                    std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch divide(std::span<const ResultType> a, ResultType b,
+                                    std::span<ResultType> out, std::stop_token stop = {});
+    [[nodiscard]] AsyncBatch power(std::span<const ResultType> base, std::int32_t exp,
+                                   std::span<ResultType> out, std::stop_token stop = {});
+
+    /**
+     * @brief Columnar Expression::evaluate
+     * @throws std::invalid_argument on a column count or size mismatch
+     */
+    [[nodiscard]] AsyncBatch evaluate(const Expression& expression,
+                                      std::span<const std::span<const ResultType>> columns,
+                                      std::span<ResultType> out, std::stop_token stop = {});
+
+    // ========================================================================
+    // Reductions (see Reduction)
+    // ========================================================================
+
+    [[nodiscard]] AsyncValue sum(std::span<const ResultType> values,
+                                 const ReductionOptions& options = {}, std::stop_token stop = {});
+    [[nodiscard]] AsyncValue product(std::span<const ResultType> values,
+                                     const ReductionOptions& options = {}, std::stop_token stop = {});
+    [[nodiscard]] AsyncValue dot(std::span<const ResultType> a, std::span<const ResultType> b,
+                                 const ReductionOptions& options = {}, std::stop_token stop = {});
+    [[nodiscard]] AsyncValue min(std::span<const ResultType> values,
+                                 const ReductionOptions& options = {}, std::stop_token stop = {});
+    [[nodiscard]] AsyncValue max(std::span<const ResultType> values,
+                                 const ReductionOptions& options = {}, std::stop_token stop = {});
+
+    /// Operations holding a slot (running on the pool)
+    std::size_t inFlight() const;
+
+    /// Operations suspended until a slot frees up
+    std::size_t waiting() const;
+
+private:
+    friend class detail::AsyncTask;
+
+    AsyncBatch batch(std::size_t size, std::stop_token stop, AsyncBatch::Work work);
+
+    Executor* executor() const;
+    void submit(detail::AsyncTask& task);
+    void release();
+
+    AsyncOptions options_;
+    mutable std::mutex mutex_;
+    std::size_t inFlight_ = 0;
+    std::size_t waiting_ = 0;
+    detail::AsyncTask* waitHead_ = nullptr;
+    detail::AsyncTask* waitTail_ = nullptr;
+};
+
+} // namespace MathEngine
+
+#endif // MATH_ASYNC_HPP
@@ -0,0 +1,84 @@
+#ifndef MATH_C_API_H
+#define MATH_C_API_H
+
+/*
+ * C ABI of the batch operations and reductions
+ *
+ * For FFI consumers (Python ctypes/cffi, Rust, ...) that hold their data in
+ * NumPy arrays, Arrow buffers or any other contiguous doubles: every call
+ * takes raw pointers and an element count and works on the caller's memory
+ * directly, without copies. The functions are the C++ Calculator and
+ * Reduction entry points behind a boundary that never throws. Errors come
+ * back as a mathengine_status and mathengine_last_error() describes the last
+ * one on the calling thread.
+ *
+ * Pointers may be NULL only when n is 0. As in Calculator, out may be the
+ * same array as an input (in-place) but must not partially overlap one.
+ * This header is plain C99.
+ */
+
+#include "math/export.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Result of every call that can fail */
+typedef int32_t mathengine_status;
+
+#define MATHENGINE_OK 0
+#define MATHENGINE_ERROR_INVALID_ARGUMENT 1 /* NULL pointer, empty reduction, ... */
+#define MATHENGINE_ERROR_INTERNAL 2         /* Any other failure (e.g. out of memory) */
+
+/** Reduction modes, as MathEngine::ReductionMode */
+#define MATHENGINE_REDUCTION_DETERMINISTIC 0
+#define MATHENGINE_REDUCTION_FAST 1
+
+/** Zero denominators of a division (their elements are set to NaN) */
+typedef struct mathengine_batch_status {
+    size_t error_count;
+    size_t first_error; /* SIZE_MAX when error_count is 0 */
+} mathengine_batch_status;
+
+/** Library version, e.g. "1.0.0" */
+MATHENGINE_API const char* mathengine_version(void);
+
+/** SIMD kernel tier the batch operations run on, e.g. "avx2" */
+MATHENGINE_API const char* mathengine_kernel_tier(void);
+
+/** Message of the last failed call on this thread ("" if none) */
+MATHENGINE_API const char* mathengine_last_error(void);
+
+/* out[i] = a[i] op b[i] */
+MATHENGINE_API mathengine_status mathengine_add(const double* a, const double* b, double* out, size_t n);
+MATHENGINE_API mathengine_status mathengine_subtract(const double* a, const double* b, double* out, size_t n);
+MATHENGINE_API mathengine_status mathengine_multiply(const double* a, const double* b, double* out, size_t n);
+MATHENGINE_API mathengine_status mathengine_divide(const double* a, const double* b, double* out, size_t n,
+                                                   mathengine_batch_status* status);
+
+/* out[i] = a[i] op b; status may be NULL */
+MATHENGINE_API mathengine_status mathengine_add_scalar(const double* a, double b, double* out, size_t n);
+MATHENGINE_API mathengine_status mathengine_subtract_scalar(const double* a, double b, double* out, size_t n);
+MATHENGINE_API mathengine_status mathengine_multiply_scalar(const double* a, double b, double* out, size_t n);
+MATHENGINE_API mathengine_status mathengine_divide_scalar(const double* a, double b, double* out, size_t n,
+                                                          mathengine_batch_status* status);
+
+/* out[i] = base[i]^exp */
+MATHENGINE_API mathengine_status mathengine_power(const double* base, int32_t exp, double* out, size_t n);
+
+/* *result = reduction of values[0..n); mode is a MATHENGINE_REDUCTION_* value */
+MATHENGINE_API mathengine_status mathengine_sum(const double* values, size_t n, int32_t mode, double* result);
+MATHENGINE_API mathengine_status mathengine_product(const double* values, size_t n, int32_t mode, double* result);
+MATHENGINE_API mathengine_status mathengine_dot(const double* a, const double* b, size_t n, int32_t mode,
+                                                double* result);
+MATHENGINE_API mathengine_status mathengine_min(const double* values, size_t n, int32_t mode, double* result);
+MATHENGINE_API mathengine_status mathengine_max(const double* values, size_t n, int32_t mode, double* result);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* MATH_C_API_H */
@@ -1,11 +1,60 @@
 #ifndef MATH_CALCULATOR_HPP
 #define MATH_CALCULATOR_HPP
 
+#include "math/expected.hpp"
+#include "math/export.h"
+#include "math/float16.hpp"
+
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
 
 namespace MathEngine {
 
+class OperandStore;
+
+/**
+ * @brief Errors reported by the non-throwing Calculator API
+ */
+enum class MathError : std::uint8_t {
+    DivisionByZero,  ///< |denominator| < Calculator::kZeroThreshold
+    Overflow,        ///< Result outside the range of a FixedCalculator format
+    Cancelled        ///< An AsyncCalculator operation was stopped before it finished
+};
+
+/**
+ * @brief Human-readable description of a MathError
+ */
+constexpr std::string_view toString(MathError error) {
+    switch (error) {
+        case MathError::DivisionByZero: return "Cannot divide by zero";
+        case MathError::Overflow: return "Result out of range";
+        case MathError::Cancelled: return "Operation cancelled";
+    }
+    return "Unknown math error";
+}
+
+/**
+ * @brief What Calculator::divide does with a zero denominator
+ */
+enum class DivisionPolicy : std::uint8_t {
+    Throw,      ///< Throw std::invalid_argument (the classic divide)
+    ReturnNaN,  ///< Return quiet NaN
+    ReturnInf,  ///< Return +/-infinity by the signs of a and b (NaN for 0/0)
+    Saturate    ///< Return +/-max() by the signs of a and b (0 for 0/0)
+};
+
+/**
+ * @brief Whether a call may be answered by the MemoCache
+ */
+enum class CachePolicy : std::uint8_t {
+    Default,  ///< Use the cache when it is enabled (see MemoCache)
+    Bypass    ///< Always compute, e.g. where the inputs never repeat
+};
+
 /**
  * @brief Simple calculator class for demonstrating CMake concepts
  *
@@ -13,11 +62,36 @@ namespace MathEngine {
  * - Header declarations in include/
  * - Implementation in src/ (separate from public headers)
  * - Use of logger library in implementation
+ *
+ * Besides the scalar operations, every arithmetic operation has a batch
+ * form over std::span. Batches run SIMD kernels selected for the CPU at
+ * runtime and log once per batch instead of once per element. Large
+ * batches are split over the global Executor when one is installed.
+ * Calculator objects record chains of operations and run them in one pass
+ * (see Operation chains below).
  */
-class Calculator {
+class MATHENGINE_API Calculator {
 public:
     using ResultType = double;
 
+    /// Denominators with a magnitude below this are treated as zero
+    static constexpr ResultType kZeroThreshold = 1e-10;
+
+    /**
+     * @brief Outcome of a batch division
+     *
+     * Batch division never throws part-way through; elements with a zero
+     * denominator are set to quiet NaN and reported here instead.
+     */
+    struct BatchStatus {
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        std::size_t errorCount = 0;       ///< Number of zero denominators
+        std::size_t firstError = npos;    ///< Index of the first one, or npos
+
+        bool ok() const { return errorCount == 0; }
+    };
+
     /**
      * @brief Add two numbers
      * @param a First operand
@@ -51,22 +125,362 @@ public:
      */
     static ResultType divide(ResultType a, ResultType b);
 
+    /**
+     * @brief Divide two numbers without throwing
+     * @param a Numerator
+     * @param b Denominator
+     * @return Quotient of a and b, or MathError::DivisionByZero
+     *
+     * A failed division leaves getLastResult() unchanged.
+     */
+    static Expected<ResultType, MathError> tryDivide(ResultType a, ResultType b);
+
+    /**
+     * @brief Divide two numbers, handling a zero denominator per @p policy
+     * @param a Numerator
+     * @param b Denominator
+     * @param policy Result for a zero denominator (see DivisionPolicy)
+     * @throws std::invalid_argument if b is zero and policy is Throw
+     *
+     * The substituted value is stored as the last result like any other.
+     */
+    static ResultType divide(ResultType a, ResultType b, DivisionPolicy policy);
+
     /**
      * @brief Calculate power (base^exponent)
      * @param base Base number
-     * @param exp Exponent (non-negative integer)
+     * @param exp Exponent (negative values use the reciprocal)
+     * @param cache Whether the MemoCache may answer (when it is enabled)
      * @return base raised to the power of exp
+     *
+     * Uses exponentiation by squaring (see integerPower for accuracy).
+     * A cached result is bit-identical to a computed one, and the call
+     * still logs, counts and sets the last result.
+     */
+    static ResultType power(ResultType base, std::int32_t exp,
+                            CachePolicy cache = CachePolicy::Default);
+
+    /**
+     * @brief Compile-time exponent variant, e.g. Calculator::power<3>(x)
+     *
+     * Fully unrolled, usable in constant expressions and does not log.
+     * Gives bit-identical results to power(base, N).
      */
-    static ResultType power(ResultType base, std::int32_t exp);
+    template <std::int32_t N>
+    static constexpr ResultType power(ResultType base) {
+        if constexpr (N < 0) {
+            return ResultType{1} / unsignedPower<0u - static_cast<std::uint32_t>(N)>(base);
+        } else {
+            return unsignedPower<static_cast<std::uint32_t>(N)>(base);
+        }
+    }
 
     /**
-     * @brief Get the last calculated value
-     * @return Last result or NaN if no calculation performed
+     * @brief Exponentiation by squaring (no logging, no state)
+     *
+     * Walks the exponent bits from the most significant one down, so it
+     * performs the same multiplications, in the same order, as power<N>.
+     *
+     * Accuracy against std::pow: exact whenever the result is exactly
+     * representable (small integers, powers of two). Otherwise every
+     * multiplication rounds, and the error grows roughly linearly with
+     * |exp|: measured worst case about 0.75 * |exp| ulp (about 48 ulp, or
+     * 1e-14 relative, at |exp| = 64), where std::pow stays within 1 ulp.
+     * For negative exponents whose positive power overflows, the result is
+     * 0 instead of a subnormal.
+     */
+    static constexpr ResultType integerPower(ResultType base, std::int32_t exp) {
+        const std::uint32_t magnitude = exp < 0
+            ? 0u - static_cast<std::uint32_t>(exp)
+            : static_cast<std::uint32_t>(exp);
+
+        ResultType result{1};
+        for (std::uint32_t bit = highestBit(magnitude); bit != 0; bit >>= 1) {
+            result *= result;
+            if ((magnitude & bit) != 0) {
+                result *= base;
+            }
+        }
+        return exp < 0 ? ResultType{1} / result : result;
+    }
+
+    // ========================================================================
+    // Batch operations
+    // ========================================================================
+    // All spans must have the same size (std::invalid_argument otherwise).
+    // The output may be the same span as an input (in-place), but must not
+    // partially overlap one. getLastResult() reports the last element.
+    // ========================================================================
+
+    /**
+     * @brief Element-wise out[i] = a[i] + b[i]
+     */
+    static void add(std::span<const ResultType> a, std::span<const ResultType> b,
+                    std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = a[i] + b
+     */
+    static void add(std::span<const ResultType> a, ResultType b, std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = a[i] - b[i]
+     */
+    static void subtract(std::span<const ResultType> a, std::span<const ResultType> b,
+                         std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = a[i] - b
+     */
+    static void subtract(std::span<const ResultType> a, ResultType b, std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = a[i] * b[i]
+     */
+    static void multiply(std::span<const ResultType> a, std::span<const ResultType> b,
+                         std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = a[i] * b
+     */
+    static void multiply(std::span<const ResultType> a, ResultType b, std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = a[i] / b[i]
+     * @return Count and first index of zero denominators (output set to NaN)
+     */
+    static BatchStatus divide(std::span<const ResultType> a, std::span<const ResultType> b,
+                              std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = a[i] / b
+     * @return Every element flagged (and NaN) if b is zero
+     */
+    static BatchStatus divide(std::span<const ResultType> a, ResultType b,
+                              std::span<ResultType> out);
+
+    /**
+     * @brief Element-wise out[i] = base[i]^exp (exponentiation by squaring)
+     */
+    static void power(std::span<const ResultType> base, std::int32_t exp,
+                      std::span<ResultType> out);
+
+    /**
+     * @brief out[i] = the i-th record of @p operations, whatever its operation
+     * @return Count and first record index of zero denominators (output NaN)
+     * @throws std::invalid_argument if out.size() != operations.size()
+     *
+     * Runs each operation group of the store with the batch kernels, block
+     * by block, and counts each group as its batch operation. See
+     * math/operand_store.hpp.
+     */
+    static BatchStatus evaluate(const OperandStore& operations, std::span<ResultType> out);
+
+    // ========================================================================
+    // Reduced-precision batch operations
+    // ========================================================================
+    // The batch operations above over float, and over the 16-bit storage
+    // formats Float16 and BFloat16 (see math/float16.hpp), with the same
+    // rules. A float register holds twice as many elements as a double one,
+    // and every format moves fewer bytes, which is what bandwidth-bound
+    // batches are limited by. Float16 and BFloat16 are computed in float and
+    // rounded once on store. getLastResult() reports the last element as a
+    // double.
+    // ========================================================================
+
+    static void add(std::span<const float> a, std::span<const float> b, std::span<float> out);
+    static void add(std::span<const float> a, float b, std::span<float> out);
+    static void subtract(std::span<const float> a, std::span<const float> b, std::span<float> out);
+    static void subtract(std::span<const float> a, float b, std::span<float> out);
+    static void multiply(std::span<const float> a, std::span<const float> b, std::span<float> out);
+    static void multiply(std::span<const float> a, float b, std::span<float> out);
+    static BatchStatus divide(std::span<const float> a, std::span<const float> b, std::span<float> out);
+    static BatchStatus divide(std::span<const float> a, float b, std::span<float> out);
+    static void power(std::span<const float> base, std::int32_t exp, std::span<float> out);
+
+    static void add(std::span<const Float16> a, std::span<const Float16> b, std::span<Float16> out);
+    static void add(std::span<const Float16> a, float b, std::span<Float16> out);
+    static void subtract(std::span<const Float16> a, std::span<const Float16> b, std::span<Float16> out);
+    static void subtract(std::span<const Float16> a, float b, std::span<Float16> out);
+    static void multiply(std::span<const Float16> a, std::span<const Float16> b, std::span<Float16> out);
+    static void multiply(std::span<const Float16> a, float b, std::span<Float16> out);
+    static BatchStatus divide(std::span<const Float16> a, std::span<const Float16> b, std::span<Float16> out);
+    static BatchStatus divide(std::span<const Float16> a, float b, std::span<Float16> out);
+    static void power(std::span<const Float16> base, std::int32_t exp, std::span<Float16> out);
+
+    static void add(std::span<const BFloat16> a, std::span<const BFloat16> b, std::span<BFloat16> out);
+    static void add(std::span<const BFloat16> a, float b, std::span<BFloat16> out);
+    static void subtract(std::span<const BFloat16> a, std::span<const BFloat16> b, std::span<BFloat16> out);
+    static void subtract(std::span<const BFloat16> a, float b, std::span<BFloat16> out);
+    static void multiply(std::span<const BFloat16> a, std::span<const BFloat16> b, std::span<BFloat16> out);
+    static void multiply(std::span<const BFloat16> a, float b, std::span<BFloat16> out);
+    static BatchStatus divide(std::span<const BFloat16> a, std::span<const BFloat16> b, std::span<BFloat16> out);
+    static BatchStatus divide(std::span<const BFloat16> a, float b, std::span<BFloat16> out);
+    static void power(std::span<const BFloat16> base, std::int32_t exp, std::span<BFloat16> out);
+
+    // ========================================================================
+    // Operation chains
+    // ========================================================================
+    // A Calculator object is an accumulator with explicit state:
+    //
+    //   Calculator c{x};
+    //   c.add(y).multiply(z).power(2);
+    //   double r = c.value();
+    //
+    // The instance methods only record steps. value() runs the steps not yet
+    // run in one pass, straight from register to register, and
+    // evaluate(in, out) runs the whole chain once per element of a span,
+    // tile by tile in place in the output, with no intermediate arrays.
+    // Both give bit-identical results to calling the static operations one
+    // after another, but log and count once per pass instead of once per
+    // step, and never touch getLastResult(). The first kInlineSteps steps
+    // are stored in the object itself, so short chains never allocate. A
+    // Calculator object is not thread-safe; copies are independent.
+    // ========================================================================
+
+    /**
+     * @brief Accumulator starting at 0
+     */
+    Calculator() = default;
+
+    /**
+     * @brief Accumulator starting at @p initial
+     */
+    explicit Calculator(ResultType initial) : current_(initial) {}
+
+    /// Record accumulator + b
+    Calculator& add(ResultType b) { return record({Step::Op::Add, 0, b}); }
+
+    /// Record accumulator - b
+    Calculator& subtract(ResultType b) { return record({Step::Op::Subtract, 0, b}); }
+
+    /// Record accumulator * b
+    Calculator& multiply(ResultType b) { return record({Step::Op::Multiply, 0, b}); }
+
+    /// Record accumulator / b (checked when the chain runs)
+    Calculator& divide(ResultType b) { return record({Step::Op::Divide, 0, b}); }
+
+    /// Record accumulator^exp (exponentiation by squaring, never cached)
+    Calculator& power(std::int32_t exp);
+
+    /**
+     * @brief Value of the chain, running only the steps added since the last call
+     * @throws std::invalid_argument if a step divides by zero; the steps
+     *         before it are kept, so a later call throws again
+     */
+    ResultType value();
+
+    /**
+     * @brief value() without throwing
+     * @return The value, or MathError::DivisionByZero
+     */
+    Expected<ResultType, MathError> tryValue();
+
+    /**
+     * @brief out[i] = the whole chain run with in[i] as the initial value
+     * @param in Initial values (may be the same span as out)
+     * @param out One result per element
+     * @return Zero divisors met: every element of a chain that divides by
+     *         zero is NaN and counted once per such step, like Expression
+     * @throws std::invalid_argument if the sizes differ
+     */
+    BatchStatus evaluate(std::span<const ResultType> in, std::span<ResultType> out) const;
+
+    /// Number of recorded steps
+    std::size_t steps() const { return stepCount_; }
+
+    /**
+     * @brief Drop every step and start again from @p initial
+     */
+    void reset(ResultType initial = 0) {
+        spilledSteps_.clear();
+        stepCount_ = 0;
+        current_ = initial;
+        applied_ = 0;
+    }
+
+    /**
+     * @brief Get the last value calculated on the calling thread
+     * @return Last result or NaN if this thread performed no calculation
+     *
+     * The last result is kept per thread, in its own cache line, so
+     * concurrent callers neither race nor share a contended global.
      */
     static ResultType getLastResult();
 
+    /**
+     * @brief Snapshot of the last result of every live thread (opt-in view)
+     * @return One entry per thread that has used Calculator and not exited
+     *
+     * Only this call walks the per-thread slots; operations never pay for
+     * it beyond a relaxed store into their own slot.
+     */
+    static std::vector<ResultType> getLastResults();
+
 private:
-    static inline ResultType lastResult_ = std::numeric_limits<ResultType>::quiet_NaN();
+    /**
+     * @brief One recorded step of an operation chain
+     */
+    struct Step {
+        enum class Op : std::uint8_t { Add, Subtract, Multiply, Divide, Power };
+
+        Op op;
+        std::int32_t exponent;  ///< Power only
+        ResultType operand;     ///< Everything else
+    };
+
+    /// Steps stored in the object before the chain spills to the heap
+    static constexpr std::size_t kInlineSteps = 8;
+
+    Calculator& record(const Step& step) {
+        if (stepCount_ < kInlineSteps) {
+            inlineSteps_[stepCount_] = step;
+        } else {
+            spilledSteps_.push_back(step);
+        }
+        ++stepCount_;
+        return *this;
+    }
+
+    const Step& stepAt(std::size_t index) const {
+        return index < kInlineSteps ? inlineSteps_[index] : spilledSteps_[index - kInlineSteps];
+    }
+
+    std::array<Step, kInlineSteps> inlineSteps_{};
+    std::vector<Step> spilledSteps_;
+    std::size_t stepCount_ = 0;
+    ResultType current_ = 0;    ///< Value after the first applied_ steps
+    std::size_t applied_ = 0;
+
+    static constexpr std::uint32_t highestBit(std::uint32_t value) {
+        std::uint32_t bit = 0;
+        for (std::uint32_t probe = 1; probe != 0 && probe <= value; probe <<= 1) {
+            bit = probe;
+        }
+        return bit;
+    }
+
+    template <std::uint32_t N>
+    static constexpr ResultType unsignedPower(ResultType base) {
+        if constexpr (N == 0) {
+            return ResultType{1};
+        } else if constexpr (N == 1) {
+            return base;
+        } else {
+            const ResultType half = unsignedPower<N / 2>(base);
+            if constexpr (N % 2 == 0) {
+                return half * half;
+            } else {
+                return half * half * base;
+            }
+        }
+    }
+
+    static ResultType divisionByZeroResult(ResultType a, ResultType b, DivisionPolicy policy);
+
+    static void storeLastResult(ResultType value);
+    template <typename T>
+    static void storeLastResult(std::span<T> out);
 };
 
 } // namespace MathEngine
@@ -0,0 +1,342 @@
+#ifndef MATH_CT_CALCULATOR_HPP
+#define MATH_CT_CALCULATOR_HPP
+
+#include "math/calculator.hpp"
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Whether ct::Calculator fuses multiply-add chains into std::fma
+ *
+ * Only where the target has a hardware FMA; elsewhere std::fma would be a
+ * slow library call and the chain is evaluated as written.
+ */
+#ifndef MATHENGINE_CT_FMA
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA) || defined(__aarch64__) || \
+    (defined(_MSC_VER) && defined(__AVX2__))
+#define MATHENGINE_CT_FMA 1
+#else
+#define MATHENGINE_CT_FMA 0
+#endif
+#endif
+
+namespace MathEngine::ct {
+
+using ResultType = MathEngine::Calculator::ResultType;
+
+/// Extent of an expression made only of scalars
+inline constexpr std::size_t kScalarExtent = std::numeric_limits<std::size_t>::max();
+
+// ============================================================================
+// Expression Nodes
+// ============================================================================
+// An expression is a tree of small value types built by ct::Calculator.
+// at(i, zeros) evaluates row i; divisions by zero count into zeros and give
+// NaN, so whether and how to report them is decided once, at the top.
+// ============================================================================
+
+/**
+ * @brief A type that ct::Calculator built (or a leaf it wrapped)
+ */
+template <typename T>
+concept Node = requires(const T& node, std::size_t row, std::size_t& zeros) {
+    { node.at(row, zeros) } -> std::same_as<ResultType>;
+    { node.extent() } -> std::same_as<std::size_t>;
+};
+
+/**
+ * @brief A number, the same in every row
+ */
+struct Scalar {
+    ResultType value;
+
+    constexpr ResultType at(std::size_t, std::size_t&) const { return value; }
+    constexpr std::size_t extent() const { return kScalarExtent; }
+};
+
+/**
+ * @brief A column of numbers, one per row (the data is not copied)
+ */
+struct Column {
+    std::span<const ResultType> values;
+
+    constexpr ResultType at(std::size_t row, std::size_t&) const { return values[row]; }
+    constexpr std::size_t extent() const { return values.size(); }
+};
+
+namespace detail {
+
+/// Rows of an expression over two sub-expressions
+constexpr std::size_t combineExtents(std::size_t left, std::size_t right) {
+    if (left == kScalarExtent) {
+        return right;
+    }
+    if (right != kScalarExtent && right != left) {
+        throw std::invalid_argument("ct::Calculator: columns of different sizes");
+    }
+    return left;
+}
+
+struct AddOp {
+    static constexpr ResultType apply(ResultType a, ResultType b, std::size_t&) { return a + b; }
+};
+
+struct SubtractOp {
+    static constexpr ResultType apply(ResultType a, ResultType b, std::size_t&) { return a - b; }
+};
+
+struct MultiplyOp {
+    static constexpr ResultType apply(ResultType a, ResultType b, std::size_t&) { return a * b; }
+};
+
+struct DivideOp {
+    static constexpr ResultType apply(ResultType a, ResultType b, std::size_t& zeros) {
+        // Branch-free so that column loops still vectorize
+        const bool zero = (b < 0 ? -b : b) < MathEngine::Calculator::kZeroThreshold;
+        zeros += zero ? 1 : 0;
+        return zero ? std::numeric_limits<ResultType>::quiet_NaN() : a / b;
+    }
+};
+
+/// a * b + c, rounded once when the target has an FMA
+constexpr ResultType multiplyAdd(ResultType a, ResultType b, ResultType c) {
+#if MATHENGINE_CT_FMA
+    if (!std::is_constant_evaluated()) {
+        return std::fma(a, b, c);
+    }
+#endif
+    return a * b + c;
+}
+
+} // namespace detail
+
+/**
+ * @brief Binary operation of two sub-expressions
+ */
+template <typename Op, Node L, Node R>
+struct Binary {
+    L left;
+    R right;
+
+    constexpr ResultType at(std::size_t row, std::size_t& zeros) const {
+        return Op::apply(left.at(row, zeros), right.at(row, zeros), zeros);
+    }
+
+    constexpr std::size_t extent() const {
+        return detail::combineExtents(left.extent(), right.extent());
+    }
+};
+
+/**
+ * @brief add(multiply(a, b), c) and add(c, multiply(a, b)): one fused op
+ */
+template <Node A, Node B, Node C>
+struct Binary<detail::AddOp, Binary<detail::MultiplyOp, A, B>, C> {
+    Binary<detail::MultiplyOp, A, B> left;
+    C right;
+
+    constexpr ResultType at(std::size_t row, std::size_t& zeros) const {
+        const ResultType a = left.left.at(row, zeros);
+        const ResultType b = left.right.at(row, zeros);
+        return detail::multiplyAdd(a, b, right.at(row, zeros));
+    }
+
+    constexpr std::size_t extent() const {
+        return detail::combineExtents(left.extent(), right.extent());
+    }
+};
+
+namespace detail {
+
+template <typename T>
+inline constexpr bool kIsMultiply = false;
+
+template <Node A, Node B>
+inline constexpr bool kIsMultiply<Binary<MultiplyOp, A, B>> = true;
+
+} // namespace detail
+
+template <Node C, Node A, Node B>
+    requires (!detail::kIsMultiply<C>)  // multiply + multiply fuses the left one
+struct Binary<detail::AddOp, C, Binary<detail::MultiplyOp, A, B>> {
+    C left;
+    Binary<detail::MultiplyOp, A, B> right;
+
+    constexpr ResultType at(std::size_t row, std::size_t& zeros) const {
+        const ResultType c = left.at(row, zeros);
+        return detail::multiplyAdd(right.left.at(row, zeros), right.right.at(row, zeros), c);
+    }
+
+    constexpr std::size_t extent() const {
+        return detail::combineExtents(left.extent(), right.extent());
+    }
+};
+
+/**
+ * @brief Sub-expression raised to a constant exponent (like Calculator::power<N>)
+ */
+template <std::int32_t N, Node E>
+struct StaticPower {
+    E base;
+
+    constexpr ResultType at(std::size_t row, std::size_t& zeros) const {
+        return MathEngine::Calculator::power<N>(base.at(row, zeros));
+    }
+
+    constexpr std::size_t extent() const { return base.extent(); }
+};
+
+/**
+ * @brief Sub-expression raised to a runtime exponent (like Calculator::power)
+ */
+template <Node E>
+struct DynamicPower {
+    E base;
+    std::int32_t exponent;
+
+    constexpr ResultType at(std::size_t row, std::size_t& zeros) const {
+        return MathEngine::Calculator::integerPower(base.at(row, zeros), exponent);
+    }
+
+    constexpr std::size_t extent() const { return base.extent(); }
+};
+
+/**
+ * @brief What ct::Calculator accepts: expressions, numbers and columns
+ */
+template <typename T>
+concept Operand = Node<T> || std::is_arithmetic_v<T> ||
+                  std::convertible_to<const T&, std::span<const ResultType>>;
+
+/**
+ * @brief Wrap a number or a column as an expression leaf
+ */
+template <Operand T>
+constexpr auto operand(const T& value) {
+    if constexpr (Node<T>) {
+        return value;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        return Scalar{static_cast<ResultType>(value)};
+    } else {
+        return Column{std::span<const ResultType>(value)};
+    }
+}
+
+template <Operand T>
+using OperandNode = decltype(operand(std::declval<const T&>()));
+
+// ============================================================================
+// ct::Calculator
+// ============================================================================
+
+/**
+ * @brief Header-only, constexpr counterpart of Calculator for fixed op chains
+ *
+ * Each method returns an expression instead of a number, so a chain such as
+ *
+ *   auto e = ct::Calculator::add(ct::Calculator::multiply(x, y), z);
+ *
+ * is a single type the compiler sees through completely. Over columns,
+ * evaluate(e, out) is one loop computing the whole chain per element (no
+ * temporaries, no calls into the library); over numbers, evaluate(e) is
+ * the result, and a constant expression when the inputs are.
+ * add(multiply(a, b), c) is rounded once with std::fma where the target has
+ * an FMA (MATHENGINE_CT_FMA); constant evaluation always rounds twice, so
+ * results computed at compile time may differ from runtime ones in the
+ * last bit on such targets.
+ *
+ * Nothing here logs or touches getLastResult(): callers who want that use
+ * the out-of-line Calculator. Division follows Calculator's policy:
+ * evaluating numbers throws std::invalid_argument for a zero denominator
+ * (a compile error in a constant expression), columns get NaN in that row
+ * and evaluate() reports how many such divisions it met.
+ *
+ * Columns are referenced, not copied: an expression must not outlive them.
+ */
+struct Calculator {
+    template <Operand A, Operand B>
+    static constexpr auto add(const A& a, const B& b) {
+        return Binary<detail::AddOp, OperandNode<A>, OperandNode<B>>{operand(a), operand(b)};
+    }
+
+    template <Operand A, Operand B>
+    static constexpr auto subtract(const A& a, const B& b) {
+        return Binary<detail::SubtractOp, OperandNode<A>, OperandNode<B>>{operand(a), operand(b)};
+    }
+
+    template <Operand A, Operand B>
+    static constexpr auto multiply(const A& a, const B& b) {
+        return Binary<detail::MultiplyOp, OperandNode<A>, OperandNode<B>>{operand(a), operand(b)};
+    }
+
+    template <Operand A, Operand B>
+    static constexpr auto divide(const A& a, const B& b) {
+        return Binary<detail::DivideOp, OperandNode<A>, OperandNode<B>>{operand(a), operand(b)};
+    }
+
+    /**
+     * @brief base^N, unrolled at compile time like MathEngine::Calculator::power<N>
+     */
+    template <std::int32_t N, Operand E>
+    static constexpr auto power(const E& base) {
+        return StaticPower<N, OperandNode<E>>{operand(base)};
+    }
+
+    /**
+     * @brief base^exp, computed like MathEngine::Calculator::power
+     */
+    template <Operand E>
+    static constexpr auto power(const E& base, std::int32_t exp) {
+        return DynamicPower<OperandNode<E>>{operand(base), exp};
+    }
+
+    /**
+     * @brief Value of an expression over numbers only
+     * @throws std::invalid_argument on division by zero or if it has columns
+     */
+    template <Node E>
+    static constexpr ResultType evaluate(const E& expression) {
+        if (expression.extent() != kScalarExtent) {
+            throw std::invalid_argument("ct::Calculator: expression has columns, pass an output");
+        }
+        std::size_t zeros = 0;
+        const ResultType result = expression.at(0, zeros);
+        if (zeros != 0) {
+            throw std::invalid_argument(std::string(toString(MathError::DivisionByZero)));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Evaluate row by row into @p out, in one pass
+     * @return Divisions by zero met, over all rows: each one makes its row
+     *         NaN, and a row with several counts each of them
+     * @throws std::invalid_argument if a column's size differs from out's
+     *
+     * A scalar-only expression fills every row with its value.
+     */
+    template <Node E>
+    static constexpr std::size_t evaluate(const E& expression, std::span<ResultType> out) {
+        const std::size_t extent = expression.extent();
+        if (extent != kScalarExtent && extent != out.size()) {
+            throw std::invalid_argument("ct::Calculator: output size differs from the columns");
+        }
+        std::size_t zeros = 0;
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = expression.at(i, zeros);
+        }
+        return zeros;
+    }
+};
+
+} // namespace MathEngine::ct
+
+#endif // MATH_CT_CALCULATOR_HPP
@@ -0,0 +1,130 @@
+#ifndef MATH_EXECUTOR_HPP
+#define MATH_EXECUTOR_HPP
+
+#include "math/export.h"
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+namespace MathEngine {
+
+/**
+ * @brief Construction options for Executor
+ */
+struct ExecutorOptions {
+    /// Worker threads besides the caller; 0 uses hardware_concurrency() - 1
+    std::size_t workers = 0;
+
+    /**
+     * Pin worker i to the i-th CPU the process may run on (Linux only,
+     * ignored elsewhere). CPUs are taken in the order the OS numbers them,
+     * which on common layouts fills one NUMA node before the next.
+     */
+    bool pinThreads = false;
+};
+
+/**
+ * @brief Work-stealing thread pool for the library's parallel paths
+ *
+ * Every worker owns a deque: it pushes and pops work at the back, and idle
+ * workers steal from the front of the others. parallelFor() splits its
+ * range lazily in halves, so stolen work is always the largest pending
+ * piece and the grain adapts to how busy the pool is.
+ *
+ * Parallelism is opt-in: batch operations, reductions and expression
+ * evaluation only go parallel once the application installs a pool with
+ * setGlobal(). Without one they run on the calling thread.
+ */
+class MATHENGINE_API Executor {
+public:
+    explicit Executor(const ExecutorOptions& options = {});
+
+    /// Waits for running work, then joins the workers
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Threads that run a parallelFor: the workers plus the caller
+     */
+    std::size_t concurrency() const;
+
+    /**
+     * @brief Run body(begin, end) over sub-ranges covering [0, n)
+     * @param n Range size
+     * @param minGrain Smallest sub-range worth a task (at least 1)
+     * @param body Callable as body(std::size_t begin, std::size_t end)
+     *
+     * Blocks until the whole range is done; the calling thread works on it
+     * too, so nested calls from inside a body are fine. If a body throws,
+     * the remaining ranges still run and the first exception is rethrown.
+     */
+    template <typename Body>
+    void parallelFor(std::size_t n, std::size_t minGrain, Body&& body) {
+        using Fn = std::remove_reference_t<Body>;
+        run(n, minGrain,
+            [](void* context, std::size_t begin, std::size_t end) {
+                (*static_cast<Fn*>(context))(begin, end);
+            },
+            const_cast<void*>(static_cast<const void*>(&body)));
+    }
+
+    /**
+     * @brief Start body(begin, end) over [0, n) on the workers and return at once
+     * @param n Range size
+     * @param minGrain Smallest sub-range worth a task (at least 1)
+     * @param body Callable as body(std::size_t begin, std::size_t end)
+     * @param done Callable as done(std::exception_ptr), with the first
+     *        exception a body threw or nullptr
+     *
+     * done runs exactly once, on the thread that finishes the last
+     * sub-range, after every body call has returned. Both callables are
+     * referenced, not copied: keep them alive until done runs, and do not
+     * let done throw. A pool without workers runs everything, done
+     * included, before returning.
+     */
+    template <typename Body, typename Done>
+    void parallelForAsync(std::size_t n, std::size_t minGrain, Body& body, Done& done) {
+        runAsync(n, minGrain,
+                 [](void* context, std::size_t begin, std::size_t end) {
+                     (*static_cast<Body*>(context))(begin, end);
+                 },
+                 const_cast<void*>(static_cast<const void*>(&body)),
+                 [](void* context, std::exception_ptr error) {
+                     (*static_cast<Done*>(context))(std::move(error));
+                 },
+                 const_cast<void*>(static_cast<const void*>(&done)));
+    }
+
+    /**
+     * @brief Install the pool used by the library's parallel paths
+     * @param executor Pool to use, or nullptr to run everything inline
+     *
+     * The caller keeps ownership and must uninstall the pool (or keep it
+     * alive) for as long as library calls may use it.
+     */
+    static void setGlobal(Executor* executor);
+
+    /**
+     * @brief Pool installed with setGlobal(), or nullptr
+     */
+    static Executor* global();
+
+private:
+    using RangeFn = void (*)(void* context, std::size_t begin, std::size_t end);
+    using DoneFn = void (*)(void* context, std::exception_ptr error);
+
+    void run(std::size_t n, std::size_t minGrain, RangeFn fn, void* context);
+    void runAsync(std::size_t n, std::size_t minGrain, RangeFn fn, void* context, DoneFn done,
+                  void* doneContext);
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace MathEngine
+
+#endif // MATH_EXECUTOR_HPP
@@ -0,0 +1,112 @@
+#ifndef MATH_EXPECTED_HPP
+#define MATH_EXPECTED_HPP
+
+#include <version>
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#include <expected>
+#else
+#include <exception>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace MathEngine {
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+
+template <typename T, typename E>
+using Expected = std::expected<T, E>;
+
+template <typename E>
+using Unexpected = std::unexpected<E>;
+
+template <typename E>
+using BadExpectedAccess = std::bad_expected_access<E>;
+
+#else
+
+/**
+ * @brief Thrown by Expected::value() when it holds an error
+ */
+template <typename E>
+class BadExpectedAccess : public std::exception {
+public:
+    explicit BadExpectedAccess(E error) : error_(std::move(error)) {}
+
+    const char* what() const noexcept override { return "bad expected access"; }
+    const E& error() const noexcept { return error_; }
+
+private:
+    E error_;
+};
+
+/**
+ * @brief Error wrapper used to construct an Expected in the error state
+ */
+template <typename E>
+class Unexpected {
+public:
+    constexpr explicit Unexpected(E error) : error_(std::move(error)) {}
+
+    constexpr const E& error() const noexcept { return error_; }
+
+private:
+    E error_;
+};
+
+/**
+ * @brief Minimal stand-in for C++23 std::expected<T, E>
+ *
+ * Used when the standard library does not provide <expected>; with one
+ * that does, Expected is an alias for std::expected. Only the subset the
+ * library needs is provided (trivially copyable T and E, no monadic
+ * operations), with the same names and semantics as the standard type.
+ */
+template <typename T, typename E>
+class Expected {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E>,
+                  "Expected polyfill only supports trivially copyable types");
+
+public:
+    using value_type = T;
+    using error_type = E;
+
+    constexpr Expected() : hasValue_(true), value_() {}
+    constexpr Expected(T value) : hasValue_(true), value_(value) {}
+    constexpr Expected(const Unexpected<E>& unexpected)
+        : hasValue_(false), error_(unexpected.error()) {}
+
+    constexpr bool has_value() const noexcept { return hasValue_; }
+    constexpr explicit operator bool() const noexcept { return hasValue_; }
+
+    constexpr const T& value() const {
+        if (!hasValue_) {
+            throw BadExpectedAccess<E>(error_);
+        }
+        return value_;
+    }
+
+    constexpr const E& error() const noexcept { return error_; }
+
+    constexpr const T& operator*() const noexcept { return value_; }
+    constexpr const T* operator->() const noexcept { return &value_; }
+
+    template <typename U>
+    constexpr T value_or(U&& fallback) const {
+        return hasValue_ ? value_ : static_cast<T>(std::forward<U>(fallback));
+    }
+
+private:
+    bool hasValue_;
+    union {
+        T value_;
+        E error_;
+    };
+};
+
+#endif
+
+} // namespace MathEngine
+
+#endif // MATH_EXPECTED_HPP
@@ -0,0 +1,136 @@
+#ifndef MATH_EXPRESSION_HPP
+#define MATH_EXPRESSION_HPP
+
+#include "math/calculator.hpp"
+#include "math/export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MathEngine {
+
+/**
+ * @brief Arithmetic expression compiled once, evaluated many times
+ *
+ * The source is parsed into a flat postfix bytecode (8 bytes per
+ * instruction) with constant sub-expressions folded away. Supported syntax:
+ * numbers, variables ([A-Za-z_][A-Za-z0-9_]*), + - * /, unary minus,
+ * parentheses and ^ with an integer constant exponent (right-associative,
+ * computed like Calculator::power).
+ *
+ * Division follows Calculator's policy: evaluate() throws for a zero
+ * denominator like Calculator::divide, while the columnar overload flags
+ * the row with NaN and reports it, like the batch Calculator::divide.
+ *
+ * Only compilation logs; evaluation does not, and neither overload
+ * touches the heap once the scratch arena has warmed up. The columnar overload works in tiles of rows so that every
+ * instruction runs as one SIMD kernel over the tile, and spreads the tiles
+ * over the global Executor when one is installed.
+ */
+class MATHENGINE_API Expression {
+public:
+    using ResultType = Calculator::ResultType;
+
+    /// Deepest operand stack an expression may need
+    static constexpr std::size_t kMaxStackDepth = 32;
+
+    /// Rows evaluated per instruction in the columnar overload
+    static constexpr std::size_t kTileSize = 128;
+
+    /**
+     * @brief Compile an expression
+     * @param source Expression text, e.g. "(x + 1) * y ^ 2"
+     * @throws std::invalid_argument on syntax errors
+     */
+    explicit Expression(std::string_view source);
+
+    /**
+     * @brief Variable names, in order of first appearance
+     *
+     * This order defines the binding / column order of evaluate().
+     */
+    const std::vector<std::string>& variables() const { return variables_; }
+
+    /**
+     * @brief Position of @p name in variables()
+     * @throws std::invalid_argument if the expression has no such variable
+     */
+    std::size_t variableIndex(std::string_view name) const;
+
+    /**
+     * @brief Original expression text
+     */
+    const std::string& source() const { return source_; }
+
+    /**
+     * @brief Number of bytecode instructions after constant folding
+     */
+    std::size_t instructionCount() const { return code_.size(); }
+
+    /**
+     * @brief Evaluate for a single binding
+     * @param values One value per variable, in variables() order
+     * @param cache Whether the MemoCache may answer (when it is enabled);
+     *        only expressions of up to four variables are cached
+     * @throws std::invalid_argument on a size mismatch or division by zero
+     */
+    ResultType evaluate(std::span<const ResultType> values,
+                        CachePolicy cache = CachePolicy::Default) const;
+
+    /**
+     * @brief Evaluate over a columnar batch of bindings
+     * @param columns One column per variable, in variables() order, each
+     *        with out.size() rows
+     * @param out Result per row (must not alias a column)
+     * @param scratch Memory for intermediate tiles on the calling thread;
+     *        nullptr uses ScratchArena::local(). Tasks running on pool
+     *        workers always use the worker's own arena.
+     * @return Zero denominators met (one per division per row; such rows
+     *         are NaN) and the first affected row
+     * @throws std::invalid_argument on a column count or size mismatch
+     */
+    Calculator::BatchStatus evaluate(std::span<const std::span<const ResultType>> columns,
+                                     std::span<ResultType> out,
+                                     std::pmr::memory_resource* scratch = nullptr) const;
+
+private:
+    enum class OpCode : std::uint8_t {
+        PushConstant,  ///< operand: index into constants_
+        PushVariable,  ///< operand: index into variables_
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Negate,
+        Power          ///< operand: integer exponent
+    };
+
+    struct Instruction {
+        OpCode op;
+        std::int32_t operand;
+    };
+
+    class Parser;
+
+    ResultType interpret(std::span<const ResultType> values) const;
+
+    void evaluateTile(std::span<const std::span<const ResultType>> columns, std::size_t row,
+                      std::size_t count, ResultType* out, ResultType* scratch,
+                      Calculator::BatchStatus& status) const;
+
+    std::string source_;
+    std::vector<std::string> variables_;
+    std::vector<ResultType> constants_;
+    std::vector<Instruction> code_;
+    std::size_t maxDepth_ = 0;
+    std::uint64_t id_ = 0;  ///< MemoCache key; copies share it with the original
+};
+
+} // namespace MathEngine
+
+#endif // MATH_EXPRESSION_HPP
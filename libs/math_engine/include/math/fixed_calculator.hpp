@@ -0,0 +1,662 @@
+#ifndef MATH_FIXED_CALCULATOR_HPP
+#define MATH_FIXED_CALCULATOR_HPP
+
+#include "math/calculator.hpp"
+#include "math/expected.hpp"
+
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// The SIMD tiers inline FixedArithmetic and mulHigh from the baseline
+// definitions, so this header must never be compiled for a tier's
+// instruction set (see src/simd/batch_kernels_impl.hpp)
+#ifdef MATHENGINE_KERNEL_TARGET_END
+#error "math/fixed_calculator.hpp must be included before a kernel tier's target region"
+#endif
+
+/**
+ * @brief Whether the compiler has a 128-bit integer type
+ *
+ * 64-bit fixed-point formats need it for their products and scaled
+ * dividends; 32-bit formats work with any compiler.
+ */
+#ifndef MATHENGINE_FIXED_INT128
+#if defined(__SIZEOF_INT128__)
+#define MATHENGINE_FIXED_INT128 1
+#else
+#define MATHENGINE_FIXED_INT128 0
+#endif
+#endif
+
+namespace MathEngine {
+
+/**
+ * @brief What FixedCalculator does with a result outside its format's range
+ */
+enum class OverflowPolicy : std::uint8_t {
+    Saturate,  ///< Clamp to the nearest representable value
+    Throw      ///< Throw std::overflow_error
+};
+
+namespace detail {
+
+#if MATHENGINE_FIXED_INT128
+__extension__ typedef unsigned __int128 UInt128;
+#endif
+
+/// Raw integer types of the fixed-point formats
+template <typename Raw>
+concept FixedRaw = std::same_as<Raw, std::int32_t> ||
+                   (MATHENGINE_FIXED_INT128 != 0 && std::same_as<Raw, std::int64_t>);
+
+template <typename Raw>
+struct FixedWideOf;
+
+template <>
+struct FixedWideOf<std::int32_t> {
+    using type = std::uint64_t;
+};
+
+#if MATHENGINE_FIXED_INT128
+template <>
+struct FixedWideOf<std::int64_t> {
+    using type = UInt128;
+};
+#endif
+
+/// Unsigned type holding any product of two Raw magnitudes
+template <typename Raw>
+using FixedWide = typename FixedWideOf<Raw>::type;
+
+constexpr std::uint64_t mulHigh(std::uint64_t a, std::uint64_t b) {
+#if MATHENGINE_FIXED_INT128
+    return static_cast<std::uint64_t>((UInt128{a} * b) >> 64);
+#else
+    const std::uint64_t aLow = a & 0xffffffffu;
+    const std::uint64_t aHigh = a >> 32;
+    const std::uint64_t bLow = b & 0xffffffffu;
+    const std::uint64_t bHigh = b >> 32;
+    const std::uint64_t lowHigh = aLow * bHigh;
+    const std::uint64_t highLow = aHigh * bLow;
+    const std::uint64_t middle = ((aLow * bLow) >> 32) + (lowHigh & 0xffffffffu) + (highLow & 0xffffffffu);
+    return aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+}
+
+/**
+ * @brief Unsigned 64-bit division by an invariant divisor, as a multiply
+ *
+ * Granlund and Montgomery's method: every quotient is the high half of the
+ * dividend times a precomputed magic number, then at most an add and a
+ * shift. That is a few cycles where a hardware division takes tens, so it
+ * pays as soon as one divisor divides many values. Powers of two (the
+ * scales of the Q formats) are a plain shift.
+ */
+class Reciprocal {
+public:
+    /// Divides by one
+    constexpr Reciprocal() = default;
+
+    /// @p divisor must not be zero
+    constexpr explicit Reciprocal(std::uint64_t divisor)
+        : divisor_(divisor), shift_(static_cast<std::uint32_t>(63 - std::countl_zero(divisor))) {
+        if ((divisor & (divisor - 1)) == 0) {
+            return;
+        }
+        std::uint64_t remainder = 0;
+        std::uint64_t magic = divideHighPower(divisor, remainder);
+        if (divisor - remainder < (std::uint64_t{1} << shift_)) {
+            magic_ = magic + 1;
+            return;
+        }
+        // The exact magic needs 65 bits: keep the low 64 and add the
+        // dividend back in divide()
+        const std::uint64_t twiceRemainder = remainder + remainder;
+        magic += magic;
+        if (twiceRemainder >= divisor || twiceRemainder < remainder) {
+            magic += 1;
+        }
+        magic_ = magic + 1;
+        add_ = true;
+    }
+
+    constexpr std::uint64_t divide(std::uint64_t n) const {
+        if (magic_ == 0) {
+            return n >> shift_;
+        }
+        const std::uint64_t high = mulHigh(n, magic_);
+        if (!add_) {
+            return high >> shift_;
+        }
+        return (((n - high) >> 1) + high) >> shift_;
+    }
+
+    constexpr std::uint64_t divisor() const { return divisor_; }
+    constexpr bool isPowerOfTwo() const { return magic_ == 0; }
+    constexpr std::uint32_t shift() const { return shift_; }
+
+private:
+    /// floor(2^(64 + shift_) / divisor), which fits in 64 bits
+    constexpr std::uint64_t divideHighPower(std::uint64_t divisor, std::uint64_t& remainder) const {
+#if MATHENGINE_FIXED_INT128
+        const UInt128 power = UInt128{1} << (64 + shift_);
+        remainder = static_cast<std::uint64_t>(power % divisor);
+        return static_cast<std::uint64_t>(power / divisor);
+#else
+        // Long division, one bit at a time; 2^shift_ < divisor to start with
+        std::uint64_t rest = std::uint64_t{1} << shift_;
+        std::uint64_t quotient = 0;
+        for (int bit = 0; bit < 64; ++bit) {
+            const bool carry = (rest >> 63) != 0;
+            rest <<= 1;
+            quotient <<= 1;
+            if (carry || rest >= divisor) {
+                rest -= divisor;
+                quotient |= 1;
+            }
+        }
+        remainder = rest;
+        return quotient;
+#endif
+    }
+
+    std::uint64_t divisor_ = 1;
+    std::uint64_t magic_ = 0;  ///< 0 for powers of two
+    std::uint32_t shift_ = 0;
+    bool add_ = false;
+};
+
+/**
+ * @brief Division by a power of two as a shift, for loops that must vectorize
+ */
+struct PowerOfTwo {
+    std::uint32_t shift = 0;
+
+    constexpr std::uint64_t divisor() const { return std::uint64_t{1} << shift; }
+};
+
+/**
+ * @brief A raw result and whether it had to be saturated
+ */
+template <FixedRaw Raw>
+struct FixedOutcome {
+    Raw value;
+    std::uint8_t overflow;  ///< 0 or 1; a bool member keeps GCC from vectorizing the kernels
+};
+
+/**
+ * @brief Fixed-point arithmetic on raw integers, shared by the scalar
+ * operations and every batch kernel so that both round identically
+ *
+ * Branch-free where it matters, so that the batch loops vectorize.
+ * Products and quotients are rounded half away from zero.
+ */
+template <FixedRaw Raw>
+struct FixedArithmetic {
+    using Unsigned = std::make_unsigned_t<Raw>;
+    using Wide = FixedWide<Raw>;
+
+    static constexpr Raw kMin = std::numeric_limits<Raw>::min();
+    static constexpr Raw kMax = std::numeric_limits<Raw>::max();
+
+    static constexpr Unsigned magnitude(Raw value) {
+        const Unsigned bits = static_cast<Unsigned>(value);
+        return value < 0 ? Unsigned{0} - bits : bits;
+    }
+
+    /// kMin or kMax, computed rather than selected so that loops stay branch-free
+    static constexpr Raw saturated(bool negative) {
+        return static_cast<Raw>(static_cast<Unsigned>(kMax) + static_cast<Unsigned>(negative));
+    }
+
+    /// 1 if the product or quotient of a and b is negative, 0 otherwise
+    static constexpr Unsigned signOf(Raw a, Raw b) {
+        return (static_cast<Unsigned>(a) ^ static_cast<Unsigned>(b)) >> std::numeric_limits<Raw>::digits;
+    }
+
+    /// A magnitude with a sign bit (0 or 1), clamped to [kMin, kMax]. The
+    /// sign is arithmetic, not a bool, so that GCC keeps this vectorizable.
+    static constexpr FixedOutcome<Raw> withSign(Wide value, Unsigned sign) {
+        const Wide limit = Wide{static_cast<Unsigned>(kMax)} + sign;
+        const bool overflow = value > limit;
+        const Unsigned clamped = static_cast<Unsigned>(overflow ? limit : value);
+        const Unsigned mask = Unsigned{0} - sign;
+        return {static_cast<Raw>((clamped ^ mask) + sign), overflow};
+    }
+
+    static constexpr FixedOutcome<Raw> add(Raw a, Raw b) {
+        const Unsigned sum = static_cast<Unsigned>(a) + static_cast<Unsigned>(b);
+        const bool overflow =
+            static_cast<Raw>((static_cast<Unsigned>(a) ^ sum) & (static_cast<Unsigned>(b) ^ sum)) < 0;
+        return {overflow ? saturated(a < 0) : static_cast<Raw>(sum), overflow};
+    }
+
+    static constexpr FixedOutcome<Raw> subtract(Raw a, Raw b) {
+        const Unsigned difference = static_cast<Unsigned>(a) - static_cast<Unsigned>(b);
+        const bool overflow = static_cast<Raw>((static_cast<Unsigned>(a) ^ static_cast<Unsigned>(b)) &
+                                               (static_cast<Unsigned>(a) ^ difference)) < 0;
+        return {overflow ? saturated(a < 0) : static_cast<Raw>(difference), overflow};
+    }
+
+    static constexpr Wide quotient(Wide n, const PowerOfTwo& divisor) { return n >> divisor.shift; }
+
+    /// n / divisor, through the reciprocal whenever n fits in 64 bits
+    static constexpr Wide quotient(Wide n, const Reciprocal& divisor) {
+        if constexpr (std::is_same_v<Wide, std::uint64_t>) {
+            return divisor.divide(n);
+        } else {
+            return (n >> 64) == 0 ? Wide{divisor.divide(static_cast<std::uint64_t>(n))}
+                                  : n / divisor.divisor();
+        }
+    }
+
+    /// a * b / scale, for a Reciprocal or PowerOfTwo scale
+    template <typename Scale>
+    static constexpr FixedOutcome<Raw> multiply(Raw a, Raw b, const Scale& scale) {
+        const Wide product = Wide{magnitude(a)} * magnitude(b);
+        return withSign(quotient(product + scale.divisor() / 2, scale), signOf(a, b));
+    }
+
+    /// a * scale / b, for b != 0
+    static constexpr FixedOutcome<Raw> divide(Raw a, Raw b, const Reciprocal& scale) {
+        const Wide divisor = magnitude(b);
+        const Wide dividend = Wide{magnitude(a)} * scale.divisor() + divisor / 2;
+        return withSign(dividend / divisor, signOf(a, b));
+    }
+
+    /// divide() by a non-zero divisor of magnitude divisor.divisor()
+    static constexpr FixedOutcome<Raw> divide(Raw a, const Reciprocal& divisor, bool divisorNegative,
+                                              const Reciprocal& scale) {
+        const Wide dividend = Wide{magnitude(a)} * scale.divisor() + divisor.divisor() / 2;
+        return withSign(quotient(dividend, divisor), signOf(a, divisorNegative ? Raw{-1} : Raw{0}));
+    }
+
+    /**
+     * @brief base^exp by squaring, in the bit order of Calculator::integerPower
+     *
+     * Every step rounds like multiply(). Once a step overflows, the result
+     * saturates with the sign of the exact power.
+     */
+    static constexpr FixedOutcome<Raw> power(Raw base, std::int32_t exp, const Reciprocal& scale) {
+        const Raw one = static_cast<Raw>(scale.divisor());
+        if (exp < 0) {
+            if (base == 0) {
+                return {kMax, true};
+            }
+            const std::uint32_t magnitude = 0u - static_cast<std::uint32_t>(exp);
+            const FixedOutcome<Raw> positive = unsignedPower(base, magnitude, scale);
+            if (!positive.overflow && positive.value != 0) {
+                return divide(one, positive.value, scale);
+            }
+            // Too large to invert directly: invert first, then raise
+            return unsignedPower(divide(one, base, scale).value, magnitude, scale);
+        }
+        return unsignedPower(base, static_cast<std::uint32_t>(exp), scale);
+    }
+
+private:
+    static constexpr FixedOutcome<Raw> unsignedPower(Raw base, std::uint32_t exp, const Reciprocal& scale) {
+        Raw result = static_cast<Raw>(scale.divisor());
+        for (std::uint32_t bit = std::bit_floor(exp); bit != 0; bit >>= 1) {
+            FixedOutcome<Raw> step = multiply(result, result, scale);
+            if (!step.overflow && (exp & bit) != 0) {
+                step = multiply(step.value, base, scale);
+            }
+            if (step.overflow) {
+                return {saturated(base < 0 && (exp & 1u) != 0), true};
+            }
+            result = step.value;
+        }
+        return {result, false};
+    }
+};
+
+} // namespace detail
+
+// ============================================================================
+// Formats
+// ============================================================================
+// A format fixes the raw integer type and the scale: a value is raw / scale.
+// The scale must be representable, i.e. 1.0 must be a valid value.
+// ============================================================================
+
+/**
+ * @brief Binary fixed point with FractionBits fractional bits (Q format)
+ *
+ * QFormat<16> is the classic 16.16 format: 2^-16 resolution, range +/-32768.
+ * Products and quotients are rescaled with a shift.
+ */
+template <unsigned FractionBits, detail::FixedRaw Raw = std::int32_t>
+struct QFormat {
+    static_assert(FractionBits < static_cast<unsigned>(std::numeric_limits<Raw>::digits),
+                  "QFormat needs at least one integer bit");
+
+    using RawType = Raw;
+    static constexpr std::uint64_t scale = std::uint64_t{1} << FractionBits;
+};
+
+/**
+ * @brief Decimal fixed point with Digits fractional decimal digits
+ *
+ * DecimalFormat<2> counts cents: every decimal amount with at most two
+ * fractional digits is exact, which a double cannot guarantee.
+ * Products and quotients are rescaled with a precomputed reciprocal.
+ */
+template <unsigned Digits, detail::FixedRaw Raw = std::int32_t>
+struct DecimalFormat {
+    static_assert(Digits <= static_cast<unsigned>(std::numeric_limits<Raw>::digits10),
+                  "DecimalFormat scale does not fit the raw type");
+
+    using RawType = Raw;
+    static constexpr std::uint64_t scale = [] {
+        std::uint64_t power = 1;
+        for (unsigned i = 0; i < Digits; ++i) {
+            power *= 10;
+        }
+        return power;
+    }();
+};
+
+/**
+ * @brief A fixed-point value: raw / Format::scale
+ *
+ * A plain integer underneath. Equal values have equal raw bits, and every
+ * operation on them gives the same bits on every platform.
+ */
+template <typename Format>
+struct Fixed {
+    using RawType = typename Format::RawType;
+
+    RawType raw = 0;
+
+    static constexpr Fixed fromRaw(RawType value) {
+        Fixed result;
+        result.raw = value;
+        return result;
+    }
+
+    /// @p value as a fixed-point number, saturated to the format's range
+    static constexpr Fixed fromInteger(std::int64_t value) {
+        constexpr auto kScale = static_cast<std::int64_t>(Format::scale);
+        constexpr std::int64_t kLimit = std::numeric_limits<RawType>::max() / kScale;
+        if (value > kLimit) {
+            return fromRaw(std::numeric_limits<RawType>::max());
+        }
+        if (value < -kLimit) {
+            return fromRaw(std::numeric_limits<RawType>::min());
+        }
+        return fromRaw(static_cast<RawType>(value * kScale));
+    }
+
+    /// The nearest value to @p value (halfway cases away from zero),
+    /// saturated to the format's range; NaN becomes zero
+    static constexpr Fixed fromDouble(double value) {
+        constexpr double kBound = 2.0 * static_cast<double>(std::numeric_limits<RawType>::max() / 2 + 1);
+        const double scaled = value * static_cast<double>(Format::scale);
+        if (scaled != scaled) {
+            return Fixed{};
+        }
+        if (scaled >= kBound) {
+            return fromRaw(std::numeric_limits<RawType>::max());
+        }
+        if (scaled <= -kBound) {
+            return fromRaw(std::numeric_limits<RawType>::min());
+        }
+        auto rounded = static_cast<std::int64_t>(scaled);
+        const double fraction = scaled - static_cast<double>(rounded);
+        rounded += fraction >= 0.5 ? 1 : fraction <= -0.5 ? -1 : 0;
+        if (rounded > std::numeric_limits<RawType>::max()) {
+            return fromRaw(std::numeric_limits<RawType>::max());
+        }
+        return fromRaw(static_cast<RawType>(rounded));
+    }
+
+    constexpr double toDouble() const {
+        return static_cast<double>(raw) / static_cast<double>(Format::scale);
+    }
+
+    friend constexpr bool operator==(Fixed, Fixed) = default;
+    friend constexpr auto operator<=>(Fixed, Fixed) = default;
+};
+
+namespace detail {
+
+// ============================================================================
+// Batch Entry Points
+// ============================================================================
+// The batch bodies depend only on the raw type, so all formats share these
+// (src/fixed_calculator.cpp); FixedCalculator passes its scale along.
+// ============================================================================
+
+enum class FixedOperation : std::uint8_t { Add, Subtract, Multiply, Divide };
+
+MATHENGINE_API Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int32_t> a,
+                                   std::span<const std::int32_t> b, std::span<std::int32_t> out,
+                                   const Reciprocal& scale);
+MATHENGINE_API Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int32_t> a,
+                                   std::int32_t b, std::span<std::int32_t> out, const Reciprocal& scale);
+MATHENGINE_API Calculator::BatchStatus fixedPowerBatch(std::span<const std::int32_t> base, std::int32_t exp,
+                                        std::span<std::int32_t> out, const Reciprocal& scale);
+
+#if MATHENGINE_FIXED_INT128
+MATHENGINE_API Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int64_t> a,
+                                   std::span<const std::int64_t> b, std::span<std::int64_t> out,
+                                   const Reciprocal& scale);
+MATHENGINE_API Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int64_t> a,
+                                   std::int64_t b, std::span<std::int64_t> out, const Reciprocal& scale);
+MATHENGINE_API Calculator::BatchStatus fixedPowerBatch(std::span<const std::int64_t> base, std::int32_t exp,
+                                        std::span<std::int64_t> out, const Reciprocal& scale);
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Deterministic fixed-point counterpart of Calculator
+ *
+ * Integer arithmetic only, so results are bit-identical on every platform
+ * and compiler, and no operation pays for a floating-point division. The
+ * scalar operations are constexpr and, like ct::Calculator, neither log nor
+ * touch the last result. They share Calculator's error policy:
+ * DivisionPolicy for zero divisors and Expected<..., MathError> for the
+ * non-throwing try* forms, plus an OverflowPolicy for results out of range.
+ *
+ * @code
+ * using Money = FixedCalculator<DecimalFormat<2, std::int64_t>>;
+ * const auto total = Money::multiply(Money::Value::fromDouble(19.99), Money::Value::fromInteger(3));
+ * // total.raw == 5997 on every platform
+ * @endcode
+ */
+template <typename Format>
+class FixedCalculator {
+public:
+    using Value = Fixed<Format>;
+    using RawType = typename Format::RawType;
+    using BatchStatus = Calculator::BatchStatus;
+
+    static constexpr Value add(Value a, Value b, OverflowPolicy overflow = OverflowPolicy::Saturate) {
+        return settle(Arithmetic::add(a.raw, b.raw), overflow);
+    }
+
+    static constexpr Value subtract(Value a, Value b, OverflowPolicy overflow = OverflowPolicy::Saturate) {
+        return settle(Arithmetic::subtract(a.raw, b.raw), overflow);
+    }
+
+    /// Rounded half away from zero to the format's resolution
+    static constexpr Value multiply(Value a, Value b, OverflowPolicy overflow = OverflowPolicy::Saturate) {
+        return settle(Arithmetic::multiply(a.raw, b.raw, kScale), overflow);
+    }
+
+    /**
+     * @brief Divide, rounded half away from zero
+     * @throws std::invalid_argument if b is zero and @p division is Throw
+     *
+     * There is no NaN or infinity: every other DivisionPolicy saturates by
+     * the sign of a (0 for 0/0).
+     */
+    static constexpr Value divide(Value a, Value b, DivisionPolicy division = DivisionPolicy::Throw,
+                                  OverflowPolicy overflow = OverflowPolicy::Saturate) {
+        if (b.raw == 0) {
+            if (division == DivisionPolicy::Throw) {
+                throw std::invalid_argument(std::string(toString(MathError::DivisionByZero)));
+            }
+            return Value::fromRaw(a.raw == 0 ? 0 : Arithmetic::saturated(a.raw < 0));
+        }
+        return settle(Arithmetic::divide(a.raw, b.raw, kScale), overflow);
+    }
+
+    /**
+     * @brief base^exp by squaring; negative exponents divide one by the power
+     *
+     * A zero base with a negative exponent overflows.
+     */
+    static constexpr Value power(Value base, std::int32_t exp,
+                                 OverflowPolicy overflow = OverflowPolicy::Saturate) {
+        return settle(Arithmetic::power(base.raw, exp, kScale), overflow);
+    }
+
+    static constexpr Expected<Value, MathError> tryAdd(Value a, Value b) {
+        return check(Arithmetic::add(a.raw, b.raw));
+    }
+
+    static constexpr Expected<Value, MathError> trySubtract(Value a, Value b) {
+        return check(Arithmetic::subtract(a.raw, b.raw));
+    }
+
+    static constexpr Expected<Value, MathError> tryMultiply(Value a, Value b) {
+        return check(Arithmetic::multiply(a.raw, b.raw, kScale));
+    }
+
+    static constexpr Expected<Value, MathError> tryDivide(Value a, Value b) {
+        if (b.raw == 0) {
+            return Unexpected<MathError>(MathError::DivisionByZero);
+        }
+        return check(Arithmetic::divide(a.raw, b.raw, kScale));
+    }
+
+    static constexpr Expected<Value, MathError> tryPower(Value base, std::int32_t exp) {
+        return check(Arithmetic::power(base.raw, exp, kScale));
+    }
+
+    // ========================================================================
+    // Batch operations
+    // ========================================================================
+    // Same size rules as Calculator's (std::invalid_argument otherwise).
+    // Batches never throw part-way through: results out of range saturate,
+    // zero divisors saturate like DivisionPolicy::Saturate, and both are
+    // counted in the returned status. Add, subtract and Q-format multiply
+    // run vectorized kernels; divisions by one value use its reciprocal.
+    // Bit-identical to the scalar operations with OverflowPolicy::Saturate.
+    // ========================================================================
+
+    static BatchStatus add(std::span<const Value> a, std::span<const Value> b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Add, raw(a), raw(b), raw(out), kScale);
+    }
+
+    static BatchStatus add(std::span<const Value> a, Value b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Add, raw(a), b.raw, raw(out), kScale);
+    }
+
+    static BatchStatus subtract(std::span<const Value> a, std::span<const Value> b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Subtract, raw(a), raw(b), raw(out), kScale);
+    }
+
+    static BatchStatus subtract(std::span<const Value> a, Value b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Subtract, raw(a), b.raw, raw(out), kScale);
+    }
+
+    static BatchStatus multiply(std::span<const Value> a, std::span<const Value> b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Multiply, raw(a), raw(b), raw(out), kScale);
+    }
+
+    static BatchStatus multiply(std::span<const Value> a, Value b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Multiply, raw(a), b.raw, raw(out), kScale);
+    }
+
+    static BatchStatus divide(std::span<const Value> a, std::span<const Value> b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Divide, raw(a), raw(b), raw(out), kScale);
+    }
+
+    static BatchStatus divide(std::span<const Value> a, Value b, std::span<Value> out) {
+        return detail::fixedBatch(detail::FixedOperation::Divide, raw(a), b.raw, raw(out), kScale);
+    }
+
+    static BatchStatus power(std::span<const Value> base, std::int32_t exp, std::span<Value> out) {
+        return detail::fixedPowerBatch(raw(base), exp, raw(out), kScale);
+    }
+
+private:
+    using Arithmetic = detail::FixedArithmetic<RawType>;
+
+    static_assert(sizeof(Value) == sizeof(RawType) && std::is_standard_layout_v<Value>);
+
+    static constexpr detail::Reciprocal kScale{Format::scale};
+
+    static constexpr Value settle(detail::FixedOutcome<RawType> outcome, OverflowPolicy overflow) {
+        if (outcome.overflow && overflow == OverflowPolicy::Throw) {
+            throw std::overflow_error(std::string(toString(MathError::Overflow)));
+        }
+        return Value::fromRaw(outcome.value);
+    }
+
+    static constexpr Expected<Value, MathError> check(detail::FixedOutcome<RawType> outcome) {
+        if (outcome.overflow) {
+            return Unexpected<MathError>(MathError::Overflow);
+        }
+        return Value::fromRaw(outcome.value);
+    }
+
+    static std::span<const RawType> raw(std::span<const Value> values) {
+        return {reinterpret_cast<const RawType*>(values.data()), values.size()};
+    }
+
+    static std::span<RawType> raw(std::span<Value> values) {
+        return {reinterpret_cast<RawType*>(values.data()), values.size()};
+    }
+};
+
+/**
+ * @brief A divisor prepared once for dividing many values by it
+ *
+ * FixedCalculator::divide(a, divisor) with the hardware division replaced
+ * by a precomputed reciprocal; same results, saturating on overflow.
+ */
+template <typename Format>
+class FixedDivisor {
+public:
+    using Value = Fixed<Format>;
+
+    /// @throws std::invalid_argument if @p divisor is zero
+    constexpr explicit FixedDivisor(Value divisor)
+        : reciprocal_(checked(divisor)), negative_(divisor.raw < 0) {}
+
+    constexpr Value divide(Value a) const {
+        return Value::fromRaw(Arithmetic::divide(a.raw, reciprocal_, negative_, kScale).value);
+    }
+
+private:
+    using Arithmetic = detail::FixedArithmetic<typename Format::RawType>;
+
+    static constexpr detail::Reciprocal kScale{Format::scale};
+
+    static constexpr std::uint64_t checked(Value divisor) {
+        if (divisor.raw == 0) {
+            throw std::invalid_argument(std::string(toString(MathError::DivisionByZero)));
+        }
+        return Arithmetic::magnitude(divisor.raw);
+    }
+
+    detail::Reciprocal reciprocal_;
+    bool negative_;
+};
+
+} // namespace MathEngine
+
+#endif // MATH_FIXED_CALCULATOR_HPP
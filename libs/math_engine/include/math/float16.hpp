@@ -0,0 +1,133 @@
+#ifndef MATH_FLOAT16_HPP
+#define MATH_FLOAT16_HPP
+
+#include <bit>
+#include <cstdint>
+
+// The SIMD tiers inline these conversions from the baseline definitions, so
+// this header must never be compiled for a tier's instruction set (see
+// src/simd/batch_kernels_impl.hpp)
+#ifdef MATHENGINE_KERNEL_TARGET_END
+#error "math/float16.hpp must be included before a kernel tier's target region"
+#endif
+
+namespace MathEngine {
+
+namespace detail {
+
+// ============================================================================
+// Conversions
+// ============================================================================
+// Branch-free bit manipulation: every case is computed and one is selected,
+// so the batch kernels' conversion loops vectorize in every SIMD tier.
+// Rounding is to nearest, ties to even, like the hardware instructions.
+// ============================================================================
+
+constexpr float halfBitsToFloat(std::uint16_t half) {
+    constexpr std::uint32_t kExponentMask = std::uint32_t{0x7c00} << 13;
+    constexpr std::uint32_t kRebias = std::uint32_t{127 - 15} << 23;
+    const std::uint32_t sign = (std::uint32_t{half} & 0x8000u) << 16;
+    const std::uint32_t shifted = (std::uint32_t{half} & 0x7fffu) << 13;
+    const std::uint32_t exponent = shifted & kExponentMask;
+
+    const std::uint32_t normal = shifted + kRebias;
+    // Infinity / NaN keep their payload
+    const std::uint32_t special = normal + (std::uint32_t{128 - 16} << 23);
+    // Zero or subnormal: renormalize with one float subtraction
+    const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(
+        std::bit_cast<float>(normal + (std::uint32_t{1} << 23)) -
+        std::bit_cast<float>(std::uint32_t{113} << 23));
+
+    const std::uint32_t bits = exponent == kExponentMask ? special
+                             : exponent == 0             ? subnormal
+                                                         : normal;
+    return std::bit_cast<float>(bits | sign);
+}
+
+constexpr std::uint16_t floatToHalfBits(float value) {
+    constexpr std::uint32_t kInfinity = std::uint32_t{255} << 23;
+    constexpr std::uint32_t kOverflow = std::uint32_t{127 + 16} << 23;   // 2^16
+    constexpr std::uint32_t kMinNormal = std::uint32_t{127 - 14} << 23;  // 2^-14
+    constexpr std::uint32_t kDenormMagic = std::uint32_t{(127 - 15) + (23 - 10) + 1} << 23;
+
+    const std::uint32_t raw = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = raw & 0x80000000u;
+    const std::uint32_t bits = raw ^ sign;
+
+    const std::uint32_t special = bits > kInfinity ? 0x7e00u : 0x7c00u;  // NaN stays (quiet) NaN
+    // Subnormal or zero: the float addition does the rounding
+    const std::uint32_t subnormal = std::bit_cast<std::uint32_t>(
+        std::bit_cast<float>(bits) + std::bit_cast<float>(kDenormMagic)) - kDenormMagic;
+    // Rebias and round; may carry into infinity, as it should
+    const std::uint32_t odd = (bits >> 13) & 1u;
+    const std::uint32_t normal =
+        (bits + (std::uint32_t{15} << 23) - (std::uint32_t{127} << 23) + 0xfffu + odd) >> 13;
+
+    const std::uint32_t half = bits >= kOverflow ? special
+                             : bits < kMinNormal ? subnormal
+                                                 : normal;
+    return static_cast<std::uint16_t>(half | (sign >> 16));
+}
+
+constexpr float bfloat16BitsToFloat(std::uint16_t value) {
+    return std::bit_cast<float>(std::uint32_t{value} << 16);
+}
+
+constexpr std::uint16_t floatToBFloat16Bits(float value) {
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+        return static_cast<std::uint16_t>((bits >> 16) | 0x40u);  // Quiet NaN, never infinity
+    }
+    return static_cast<std::uint16_t>((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+}
+
+} // namespace detail
+
+/**
+ * @brief IEEE 754 binary16 value, stored for the batch and reduction APIs
+ *
+ * A storage format only: there is no Float16 arithmetic. Batches of it are
+ * computed in float and rounded back on store, and reductions over it
+ * accumulate in float. 11 significant bits, finite up to 65504.
+ */
+struct Float16 {
+    std::uint16_t bits = 0;
+
+    constexpr Float16() = default;
+    constexpr explicit Float16(float value) : bits(detail::floatToHalfBits(value)) {}
+
+    constexpr explicit operator float() const { return detail::halfBitsToFloat(bits); }
+
+    static constexpr Float16 fromBits(std::uint16_t raw) {
+        Float16 value;
+        value.bits = raw;
+        return value;
+    }
+};
+
+/**
+ * @brief bfloat16 value (the upper half of a float), stored like Float16
+ *
+ * Same range as float with 8 significant bits: suited to values whose
+ * magnitude varies widely but whose precision does not matter much.
+ */
+struct BFloat16 {
+    std::uint16_t bits = 0;
+
+    constexpr BFloat16() = default;
+    constexpr explicit BFloat16(float value) : bits(detail::floatToBFloat16Bits(value)) {}
+
+    constexpr explicit operator float() const { return detail::bfloat16BitsToFloat(bits); }
+
+    static constexpr BFloat16 fromBits(std::uint16_t raw) {
+        BFloat16 value;
+        value.bits = raw;
+        return value;
+    }
+};
+
+static_assert(sizeof(Float16) == 2 && sizeof(BFloat16) == 2);
+
+} // namespace MathEngine
+
+#endif // MATH_FLOAT16_HPP
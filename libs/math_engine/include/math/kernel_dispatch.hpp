@@ -0,0 +1,89 @@
+#ifndef MATH_KERNEL_DISPATCH_HPP
+#define MATH_KERNEL_DISPATCH_HPP
+
+#include "math/export.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace MathEngine {
+
+/**
+ * @brief Instruction-set tier of the batch, reduction and power kernels
+ */
+enum class KernelTier : std::uint8_t {
+    Scalar,  ///< Portable C++, every target
+    SSE2,    ///< x86-64 baseline
+    AVX2,    ///< x86-64 with AVX2 and FMA
+    AVX512,  ///< x86-64 with AVX-512 F and BW
+    NEON     ///< AArch64 baseline
+};
+
+/**
+ * @brief Name of a tier as the environment variable and logs spell it
+ */
+constexpr std::string_view toString(KernelTier tier) {
+    switch (tier) {
+        case KernelTier::Scalar: return "scalar";
+        case KernelTier::SSE2: return "sse2";
+        case KernelTier::AVX2: return "avx2";
+        case KernelTier::AVX512: return "avx512";
+        case KernelTier::NEON: return "neon";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Which kernel tier math_engine runs, and why
+ *
+ * math_engine is built with every tier of the target architecture, each in
+ * its own translation unit. When the library is loaded it detects the CPU
+ * features once and fills the dispatch table with the best tier the CPU
+ * runs, so one binary serves a mixed fleet at full speed.
+ *
+ * Setting MATHENGINE_KERNEL_TIER (e.g. to "sse2" or "scalar") selects that
+ * tier instead, to test or benchmark one tier on a machine that supports
+ * a better one. A name that is unknown, not built for this target or not
+ * supported by the CPU is ignored with a warning.
+ */
+class MATHENGINE_API KernelDispatch {
+public:
+    /// Environment variable read at load time
+    static constexpr const char* kEnvironmentVariable = "MATHENGINE_KERNEL_TIER";
+
+    /**
+     * @brief Tier every kernel call runs on
+     */
+    static KernelTier active();
+
+    /**
+     * @brief Best tier this CPU supports (what runs without the variable)
+     */
+    static KernelTier best();
+
+    /**
+     * @brief Tier named by MATHENGINE_KERNEL_TIER, whether honoured or not
+     */
+    static std::optional<KernelTier> requested();
+
+    /**
+     * @brief Tiers built into this library, in ascending order
+     */
+    static std::span<const KernelTier> compiled();
+
+    /**
+     * @brief Whether the tier is built and runs on this CPU
+     */
+    static bool supported(KernelTier tier);
+
+    /**
+     * @brief The tier of a toString() name, if there is one
+     */
+    static std::optional<KernelTier> parse(std::string_view name);
+};
+
+} // namespace MathEngine
+
+#endif // MATH_KERNEL_DISPATCH_HPP
@@ -0,0 +1,71 @@
+#ifndef MATH_MEMO_CACHE_HPP
+#define MATH_MEMO_CACHE_HPP
+
+#include "math/export.h"
+
+#include <cstddef>
+
+namespace MathEngine {
+
+/**
+ * @brief Sizes of the memoization cache tiers (see MemoCache)
+ */
+struct MemoCacheOptions {
+    bool enabled = false;              ///< Off by default: most inputs never repeat
+    std::size_t localEntries = 256;    ///< Per-thread tier, rounded up to a power of two
+    std::size_t sharedEntries = 4096;  ///< Shared tier, split evenly over the shards
+    std::size_t shards = 16;           ///< Independently locked parts of the shared tier
+};
+
+/**
+ * @brief Bounded memoization of Calculator::power and Expression::evaluate
+ *
+ * Results are keyed on the exact bit patterns of the inputs (so 0.0 and
+ * -0.0, or two NaNs with different payloads, are different keys) and returned
+ * bit-identical to a fresh computation. Lookups try a small direct-mapped
+ * table owned by the calling thread first, which takes no lock, then a
+ * shared table split into shards that each have their own mutex and evict
+ * with the CLOCK (second chance) policy. A shared hit is copied into the
+ * thread's table.
+ *
+ * Call sites whose inputs never repeat opt out with CachePolicy::Bypass.
+ * Hits and misses are counted as MetricEvents. Only scalar calls are
+ * memoized: batches over spans are already cheaper per element than a
+ * lookup.
+ */
+class MATHENGINE_API MemoCache {
+public:
+    /**
+     * @brief Replace the options and empty both tiers
+     *
+     * Safe to call while other threads use the cache; their tables are
+     * rebuilt on their next lookup.
+     */
+    static void configure(const MemoCacheOptions& options);
+
+    /**
+     * @brief The options last configured
+     */
+    static MemoCacheOptions options();
+
+    /**
+     * @brief Turn memoization on or off, keeping the cached entries
+     */
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled();
+
+    /**
+     * @brief Drop every cached entry, on all threads
+     */
+    static void clear();
+
+    /**
+     * @brief Entries currently held by the shared tier
+     */
+    static std::size_t sharedSize();
+};
+
+} // namespace MathEngine
+
+#endif // MATH_MEMO_CACHE_HPP
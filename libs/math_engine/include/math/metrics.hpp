@@ -0,0 +1,261 @@
+#ifndef MATH_METRICS_HPP
+#define MATH_METRICS_HPP
+
+#include "math/export.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Whether instrumentation is compiled in (1) or compiled out (0)
+ *
+ * Normally set by CMake through the MATHENGINE_ENABLE_METRICS option.
+ */
+#ifndef MATHENGINE_METRICS
+#define MATHENGINE_METRICS 1
+#endif
+
+namespace MathEngine {
+
+/**
+ * @brief Calculator operations that are counted and timed
+ */
+enum class Operation : std::uint8_t {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+    BatchAdd,
+    BatchSubtract,
+    BatchMultiply,
+    BatchDivide,
+    BatchPower,
+    Chain,       ///< Calculator::value() running recorded steps
+    BatchChain   ///< Calculator::evaluate() over a span
+};
+
+inline constexpr std::size_t kOperationCount = 12;
+
+/**
+ * @brief Noteworthy conditions and memoization cache outcomes, by count
+ */
+enum class MetricEvent : std::uint8_t {
+    DivisionByZero,       ///< Per zero denominator, including each batch element
+    NegativeExponent,     ///< Per power() call with a negative exponent
+    PowerCacheHit,        ///< power() answered by the MemoCache
+    PowerCacheMiss,       ///< power() computed and added to the MemoCache
+    ExpressionCacheHit,   ///< Expression::evaluate() answered by the MemoCache
+    ExpressionCacheMiss   ///< Expression::evaluate() computed and added to it
+};
+
+inline constexpr std::size_t kMetricEventCount = 6;
+
+/**
+ * @brief Metric label for an Operation, e.g. "batch_divide"
+ */
+constexpr std::string_view toString(Operation operation) {
+    switch (operation) {
+        case Operation::Add:           return "add";
+        case Operation::Subtract:      return "subtract";
+        case Operation::Multiply:      return "multiply";
+        case Operation::Divide:        return "divide";
+        case Operation::Power:         return "power";
+        case Operation::BatchAdd:      return "batch_add";
+        case Operation::BatchSubtract: return "batch_subtract";
+        case Operation::BatchMultiply: return "batch_multiply";
+        case Operation::BatchDivide:   return "batch_divide";
+        case Operation::BatchPower:    return "batch_power";
+        case Operation::Chain:         return "chain";
+        case Operation::BatchChain:    return "batch_chain";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Metric label for a MetricEvent, e.g. "division_by_zero"
+ */
+constexpr std::string_view toString(MetricEvent event) {
+    switch (event) {
+        case MetricEvent::DivisionByZero:      return "division_by_zero";
+        case MetricEvent::NegativeExponent:    return "negative_exponent";
+        case MetricEvent::PowerCacheHit:       return "power_cache_hit";
+        case MetricEvent::PowerCacheMiss:      return "power_cache_miss";
+        case MetricEvent::ExpressionCacheHit:  return "expression_cache_hit";
+        case MetricEvent::ExpressionCacheMiss: return "expression_cache_miss";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief HDR-style log-linear histogram of latencies in nanoseconds
+ *
+ * Every power of two is split into kSubBuckets equal buckets, so any
+ * recorded value is known to within 1/kSubBuckets (12.5%) of itself, from
+ * 1 ns up to 2^kMaxExponent ns (about 18 minutes; larger values land in the
+ * last bucket).
+ */
+struct MATHENGINE_API LatencyHistogram {
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr std::uint64_t kSubBuckets = std::uint64_t{1} << kSubBucketBits;
+    static constexpr unsigned kMaxExponent = 40;
+    static constexpr std::size_t kBucketCount =
+        (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+    std::array<std::uint64_t, kBucketCount> buckets{};
+    std::uint64_t count = 0;   ///< Recorded values
+    std::uint64_t sumNs = 0;   ///< Sum of the recorded values
+
+    /**
+     * @brief Bucket holding @p ns
+     */
+    static constexpr std::size_t bucketIndex(std::uint64_t ns) {
+        if (ns < kSubBuckets) {
+            return static_cast<std::size_t>(ns);
+        }
+        const unsigned exponent = static_cast<unsigned>(std::bit_width(ns)) - 1;
+        if (exponent >= kMaxExponent) {
+            return kBucketCount - 1;
+        }
+        const unsigned shift = exponent - kSubBucketBits;
+        return static_cast<std::size_t>((shift + 1) * kSubBuckets +
+                                        ((ns >> shift) & (kSubBuckets - 1)));
+    }
+
+    /**
+     * @brief Smallest value in bucket @p index
+     */
+    static constexpr std::uint64_t bucketLowerBound(std::size_t index) {
+        if (index < kSubBuckets) {
+            return index;
+        }
+        const auto shift = static_cast<unsigned>(index / kSubBuckets - 1);
+        return (kSubBuckets + index % kSubBuckets) << shift;
+    }
+
+    /**
+     * @brief Largest value in bucket @p index
+     */
+    static constexpr std::uint64_t bucketUpperBound(std::size_t index) {
+        if (index < kSubBuckets) {
+            return index;
+        }
+        const auto shift = static_cast<unsigned>(index / kSubBuckets - 1);
+        return bucketLowerBound(index) + (std::uint64_t{1} << shift) - 1;
+    }
+
+    void record(std::uint64_t ns, std::uint64_t times = 1) {
+        buckets[bucketIndex(ns)] += times;
+        count += times;
+        sumNs += ns * times;
+    }
+
+    /**
+     * @brief Value at or below which a fraction @p quantile of the recorded
+     *        values lie (upper bound of its bucket), 0 if empty
+     */
+    std::uint64_t percentile(double quantile) const;
+
+    /**
+     * @brief Upper bound of the highest non-empty bucket, 0 if empty
+     */
+    std::uint64_t max() const;
+
+    double meanNs() const {
+        return count == 0 ? 0.0 : static_cast<double>(sumNs) / static_cast<double>(count);
+    }
+};
+
+/**
+ * @brief Counters and latency of one Operation
+ */
+struct OperationStats {
+    std::uint64_t calls = 0;     ///< Calls, including ones that threw
+    std::uint64_t elements = 0;  ///< Values produced (1 per scalar call)
+    LatencyHistogram latency;    ///< Sampled calls only (see Metrics)
+};
+
+/**
+ * @brief Totals over all threads at one point in time
+ */
+struct MATHENGINE_API MetricsSnapshot {
+    std::array<OperationStats, kOperationCount> operations{};
+    std::array<std::uint64_t, kMetricEventCount> events{};
+
+    const OperationStats& operator[](Operation operation) const {
+        return operations[static_cast<std::size_t>(operation)];
+    }
+
+    std::uint64_t count(MetricEvent event) const {
+        return events[static_cast<std::size_t>(event)];
+    }
+
+    /**
+     * @brief The snapshot in the Prometheus text exposition format
+     *
+     * Latencies are exported as histograms in seconds with power-of-four
+     * bucket boundaries from 16 ns to about 4.3 s.
+     */
+    std::string toPrometheus() const;
+};
+
+/**
+ * @brief Per-operation counters and latency histograms for Calculator
+ *
+ * Every thread records into its own block of relaxed atomics that only it
+ * writes, so counting costs a few uncontended loads and stores and never
+ * bounces a cache line between threads. snapshot() merges the blocks of
+ * all threads, including ones that have exited, on demand.
+ *
+ * Counting is on by default. Timing a call costs two clock reads, so only
+ * one call in latencySampleRate() per operation and thread is timed; the
+ * histograms therefore describe a sample while the counters are exact.
+ *
+ * Compiling with MATHENGINE_METRICS=0 (CMake: MATHENGINE_ENABLE_METRICS=OFF)
+ * removes the recording code entirely; snapshots are then all zero.
+ */
+class MATHENGINE_API Metrics {
+public:
+    static constexpr bool kCompiledIn = MATHENGINE_METRICS != 0;
+
+    /// Default for latencySampleRate()
+    static constexpr std::uint32_t kDefaultLatencySampleRate = 64;
+
+    /**
+     * @brief Turn recording on or off at runtime
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * @brief Time one call in @p everyN per operation and thread (1 times
+     *        every call, 0 disables timing)
+     */
+    static void setLatencySampleRate(std::uint32_t everyN);
+    static std::uint32_t latencySampleRate();
+
+    /**
+     * @brief Totals since start-up or the last reset()
+     */
+    static MetricsSnapshot snapshot();
+
+    /**
+     * @brief Start counting from zero again
+     */
+    static void reset();
+
+    /**
+     * @brief snapshot() in the Prometheus text exposition format
+     */
+    static std::string toPrometheus() {
+        return snapshot().toPrometheus();
+    }
+};
+
+} // namespace MathEngine
+
+#endif // MATH_METRICS_HPP
@@ -0,0 +1,153 @@
+#ifndef MATH_OPERAND_STORE_HPP
+#define MATH_OPERAND_STORE_HPP
+
+#include "math/export.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace MathEngine {
+
+/**
+ * @brief Operation of one record of a mixed workload
+ */
+enum class BatchOp : std::uint8_t { Add, Subtract, Multiply, Divide, Power };
+
+inline constexpr std::size_t kBatchOpCount = 5;
+
+/**
+ * @brief Mixed {op, a, b} records stored column-wise, grouped by operation
+ *
+ * Instead of calling Calculator once per record, push the records here and
+ * run them all with Calculator::evaluate(store, out). Each record goes to
+ * the group of its operation (power records: of their exponent), and each
+ * group is a list of 64-byte-aligned blocks holding kBlockSize records as
+ * separate a, b and position columns. Evaluation runs every block with the
+ * batch kernels and writes each result back at the record's position, so
+ * a mixed stream runs at the speed of uniform batches.
+ *
+ * Power records get a group per exponent for the first kMaxPowerGroups
+ * exponents; the records of any further ones share a single group, run
+ * one record at a time, so a stream of ever new exponents cannot take a
+ * block per exponent.
+ *
+ * clear() keeps the blocks for the next records, so a store reused for
+ * chunk after chunk of a stream only allocates them while it grows.
+ * A store is not thread-safe.
+ */
+class MATHENGINE_API OperandStore {
+public:
+    /// Records per block: its columns and the result tile fit in L1 together
+    static constexpr std::size_t kBlockSize = 256;
+
+    /// Most records one store holds (positions are 32-bit)
+    static constexpr std::size_t kMaxSize = std::numeric_limits<std::uint32_t>::max();
+
+    /// Power exponents with a group of their own
+    static constexpr std::size_t kMaxPowerGroups = 32;
+
+    struct alignas(64) Block {
+        double a[kBlockSize];
+        double b[kBlockSize];                 ///< Exponent, as a double, in power groups
+        std::uint32_t position[kBlockSize];   ///< Record index, ascending within a group
+        std::size_t size;
+    };
+
+    /**
+     * @brief Records of one operation (and one exponent, for power)
+     */
+    struct Group {
+        BatchOp op;
+        std::int32_t exponent;     ///< Power groups only
+        bool mixedExponents;       ///< Power overflow group: each record's b is its exponent
+        std::size_t size;
+        std::vector<Block*> blocks;
+        Block* tail;               ///< blocks.back(), or nullptr
+    };
+
+    explicit OperandStore(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_(resource) {
+        groupIndex_.fill(kNoGroup);
+    }
+
+    ~OperandStore();
+
+    OperandStore(const OperandStore&) = delete;
+    OperandStore& operator=(const OperandStore&) = delete;
+
+    /**
+     * @brief Append one record; its result goes to out[size()] as it was before
+     * @throws std::invalid_argument if a power record's b is not a 32-bit integer
+     * @throws std::length_error past kMaxSize records
+     */
+    void push(BatchOp op, double a, double b) {
+        if (size_ == kMaxSize) {
+            throwFull();
+        }
+        Group& group = op == BatchOp::Power ? powerGroup(b) : groups_[operationGroup(op)];
+        Block* block = group.tail;
+        if (block == nullptr || block->size == kBlockSize) {
+            block = addBlock(group);
+        }
+        const std::size_t slot = block->size++;
+        block->a[slot] = a;
+        block->b[slot] = b;
+        block->position[slot] = static_cast<std::uint32_t>(size_);
+        ++group.size;
+        ++size_;
+    }
+
+    /**
+     * @brief Append records from columns
+     * @param ops One operation per record, or a single one for all of them
+     * @throws std::invalid_argument on a size mismatch, or as push()
+     */
+    void append(std::span<const BatchOp> ops, std::span<const double> a, std::span<const double> b);
+
+    /**
+     * @brief Drop every record (the blocks are kept for reuse)
+     */
+    void clear();
+
+    /// Records held
+    std::size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    /// Non-empty groups, in order of their first record
+    std::span<const Group> groups() const { return groups_; }
+
+private:
+    static constexpr std::size_t kNoGroup = static_cast<std::size_t>(-1);
+
+    std::size_t operationGroup(BatchOp op) {
+        std::size_t& index = groupIndex_[static_cast<std::size_t>(op)];
+        if (index == kNoGroup) {
+            index = addGroup(op, 0);
+        }
+        return index;
+    }
+
+    Group& powerGroup(double exponent);
+    std::size_t addGroup(BatchOp op, std::int32_t exponent);
+    Block* addBlock(Group& group);
+    [[noreturn]] static void throwFull();
+
+    std::pmr::memory_resource* resource_;
+    std::vector<Group> groups_;
+    std::array<std::size_t, kBatchOpCount> groupIndex_{};  ///< Power: the last one used
+    std::unordered_map<std::int32_t, std::size_t> powerGroups_;  ///< Exponent -> group
+    std::size_t mixedPowerGroup_ = kNoGroup;
+    std::vector<Block*> freeBlocks_;
+    std::size_t size_ = 0;
+};
+
+} // namespace MathEngine
+
+#endif // MATH_OPERAND_STORE_HPP
@@ -0,0 +1,168 @@
+#ifndef MATH_REDUCTION_HPP
+#define MATH_REDUCTION_HPP
+
+#include "math/calculator.hpp"
+#include "math/export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+
+namespace MathEngine {
+
+/**
+ * @brief Accumulation order of a reduction
+ */
+enum class ReductionMode : std::uint8_t {
+    /**
+     * Fixed blocks of Reduction::kBlockSize elements, each reduced in one
+     * 64-byte vector of fixed lanes (8 for double, 16 for float, Float16
+     * and BFloat16), with lanes and block results combined pairwise. The
+     * result is bit-identical for any thread count and SIMD tier, and
+     * pairwise summation keeps the error growth at O(log n).
+     */
+    Deterministic,
+
+    /**
+     * One chunk per thread, as many accumulators as suit the SIMD tier.
+     * Slightly faster; the last bits may change with the thread count and
+     * the SIMD tier.
+     */
+    Fast
+};
+
+/**
+ * @brief Single-input reduction, for Reduction::partials() and combine()
+ */
+enum class ReductionOp : std::uint8_t { Sum, Product, Min, Max };
+
+/**
+ * @brief Tuning knobs shared by all reductions
+ */
+struct ReductionOptions {
+    ReductionMode mode = ReductionMode::Deterministic;
+
+    /// Upper bound on threads taken from the global Executor; 0 means all
+    std::size_t maxThreads = 0;
+
+    /// Memory for per-block partial results; nullptr uses ScratchArena::local()
+    std::pmr::memory_resource* scratch = nullptr;
+};
+
+/**
+ * @brief Reductions over large spans: SIMD within a chunk, threads across
+ *
+ * Chunks run on the global Executor (see Executor::setGlobal) when one is
+ * installed, and on the calling thread otherwise. Spans shorter than
+ * kMinElementsPerThread per extra thread stay on the calling thread.
+ * Reductions log once per call and, unlike Calculator operations, do not
+ * update getLastResult().
+ */
+class MATHENGINE_API Reduction {
+public:
+    using ResultType = Calculator::ResultType;
+
+    /// Elements per block in ReductionMode::Deterministic
+    static constexpr std::size_t kBlockSize = 8192;
+
+    /// Smallest share of the input worth handing to another thread
+    static constexpr std::size_t kMinElementsPerThread = std::size_t{1} << 16;
+
+    /**
+     * @brief Sum of all elements (0 for an empty span)
+     */
+    static ResultType sum(std::span<const ResultType> values, const ReductionOptions& options = {});
+
+    /**
+     * @brief Product of all elements (1 for an empty span)
+     */
+    static ResultType product(std::span<const ResultType> values,
+                              const ReductionOptions& options = {});
+
+    /**
+     * @brief Sum of a[i] * b[i] (0 for empty spans)
+     * @throws std::invalid_argument if the spans differ in size
+     */
+    static ResultType dot(std::span<const ResultType> a, std::span<const ResultType> b,
+                          const ReductionOptions& options = {});
+
+    /**
+     * @brief Smallest element, skipping NaN (NaN if every element is NaN)
+     * @throws std::invalid_argument for an empty span
+     */
+    static ResultType min(std::span<const ResultType> values, const ReductionOptions& options = {});
+
+    /**
+     * @brief Largest element, skipping NaN (NaN if every element is NaN)
+     * @throws std::invalid_argument for an empty span
+     */
+    static ResultType max(std::span<const ResultType> values, const ReductionOptions& options = {});
+
+    // ========================================================================
+    // Reductions in pieces
+    // ========================================================================
+    // A Deterministic reduction is its kBlockSize blocks reduced one by one,
+    // then combined pairwise. partials() stops after the first step and
+    // combine() does the second, so the work can be split up, e.g. across
+    // processes or nodes. The partials of consecutive slices that each start
+    // at a multiple of kBlockSize of the whole input concatenate to the
+    // partials of the whole input. combine() over them gives the same bits
+    // as one call over the whole input, on any tier.
+    // ========================================================================
+
+    /// Partials of n elements: one per (possibly short) block
+    static constexpr std::size_t blockCount(std::size_t n) { return (n + kBlockSize - 1) / kBlockSize; }
+
+    /**
+     * @brief One Deterministic partial result per block of @p values
+     * @param out blockCount(values.size()) partials (NaN for an all-NaN
+     *        block of min / max)
+     * @throws std::invalid_argument if out has the wrong size
+     */
+    static void partials(ReductionOp op, std::span<const ResultType> values, std::span<ResultType> out,
+                         const ReductionOptions& options = {});
+
+    /**
+     * @brief Result of the reduction whose blocks reduced to @p partials
+     *
+     * The partials are combined in place. An empty span gives 0 for Sum
+     * and 1 for Product.
+     * @throws std::invalid_argument for an empty span with Min or Max
+     */
+    static ResultType combine(ReductionOp op, std::span<ResultType> partials);
+
+    // ========================================================================
+    // Reduced-precision inputs
+    // ========================================================================
+    // The same reductions over float, Float16 and BFloat16, accumulated in
+    // float: half or a quarter of the bytes of a double input, with the same
+    // modes and determinism guarantees. 16-bit inputs are widened into
+    // float tiles on the fly, never into a full-size copy.
+    // ========================================================================
+
+    static float sum(std::span<const float> values, const ReductionOptions& options = {});
+    static float product(std::span<const float> values, const ReductionOptions& options = {});
+    static float dot(std::span<const float> a, std::span<const float> b,
+                     const ReductionOptions& options = {});
+    static float min(std::span<const float> values, const ReductionOptions& options = {});
+    static float max(std::span<const float> values, const ReductionOptions& options = {});
+
+    static float sum(std::span<const Float16> values, const ReductionOptions& options = {});
+    static float product(std::span<const Float16> values, const ReductionOptions& options = {});
+    static float dot(std::span<const Float16> a, std::span<const Float16> b,
+                     const ReductionOptions& options = {});
+    static float min(std::span<const Float16> values, const ReductionOptions& options = {});
+    static float max(std::span<const Float16> values, const ReductionOptions& options = {});
+
+    static float sum(std::span<const BFloat16> values, const ReductionOptions& options = {});
+    static float product(std::span<const BFloat16> values, const ReductionOptions& options = {});
+    static float dot(std::span<const BFloat16> a, std::span<const BFloat16> b,
+                     const ReductionOptions& options = {});
+    static float min(std::span<const BFloat16> values, const ReductionOptions& options = {});
+    static float max(std::span<const BFloat16> values, const ReductionOptions& options = {});
+};
+
+} // namespace MathEngine
+
+#endif // MATH_REDUCTION_HPP
@@ -0,0 +1,106 @@
+#ifndef MATH_SCRATCH_ARENA_HPP
+#define MATH_SCRATCH_ARENA_HPP
+
+#include "math/export.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace MathEngine {
+
+/**
+ * @brief Bump allocator for short-lived scratch memory, rewound in bulk
+ *
+ * Unlike std::pmr::monotonic_buffer_resource, rewinding keeps every block
+ * obtained from upstream, so once an arena has grown to a workload's peak,
+ * later calls make no heap allocations at all. deallocate() is a no-op;
+ * memory comes back only through rewind() / reset() (see ScratchScope).
+ *
+ * An arena is not thread-safe: each thread uses its own, e.g. local().
+ */
+class MATHENGINE_API ScratchArena : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Position in the arena, for rewinding nested scopes
+     */
+    struct Mark {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+    };
+
+    /// Size of the first block obtained from upstream
+    static constexpr std::size_t kDefaultBlockSize = std::size_t{64} * 1024;
+
+    explicit ScratchArena(std::size_t firstBlockSize = kDefaultBlockSize,
+                          std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+    ~ScratchArena() override;
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     * @brief Current position, to pass to rewind() later
+     */
+    Mark mark() const { return {block_, offset_}; }
+
+    /**
+     * @brief Release everything allocated since @p mark (memory is kept)
+     */
+    void rewind(Mark mark) noexcept;
+
+    /**
+     * @brief Release everything (memory is kept)
+     */
+    void reset() noexcept { rewind({}); }
+
+    /**
+     * @brief Total bytes held from upstream
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief The calling thread's arena
+     */
+    static ScratchArena& local();
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Block {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t nextBlockSize_;
+    std::vector<Block> blocks_;
+    std::size_t block_ = 0;
+    std::size_t offset_ = 0;
+};
+
+/**
+ * @brief Rewinds an arena to where it was when the scope was entered
+ */
+class ScratchScope {
+public:
+    explicit ScratchScope(ScratchArena& arena = ScratchArena::local())
+        : arena_(arena), mark_(arena.mark()) {}
+    ~ScratchScope() { arena_.rewind(mark_); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    ScratchArena& arena() const { return arena_; }
+
+private:
+    ScratchArena& arena_;
+    ScratchArena::Mark mark_;
+};
+
+} // namespace MathEngine
+
+#endif // MATH_SCRATCH_ARENA_HPP
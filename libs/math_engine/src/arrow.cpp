@@ -0,0 +1,410 @@
+#include "math/arrow.hpp"
+#include "math/scratch_arena.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace MathEngine {
+
+namespace {
+
+// ============================================================================
+// Owned Buffers
+// ============================================================================
+
+/// Arrow's recommended alignment and padding of buffers
+constexpr std::size_t kArrowAlignment = 64;
+
+constexpr std::size_t padded(std::size_t bytes) {
+    return std::max(kArrowAlignment, (bytes + kArrowAlignment - 1) / kArrowAlignment * kArrowAlignment);
+}
+
+constexpr std::size_t bitmapBytes(std::size_t n) {
+    return padded((n + 7) / 8);
+}
+
+/**
+ * @brief private_data of an ArrowResult array: its buffers and their resource
+ */
+struct OwnedBuffers {
+    std::pmr::memory_resource* memory;
+    std::size_t size;
+    double* values = nullptr;
+    std::uint8_t* validity = nullptr;
+    const void* pointers[2] = {nullptr, nullptr};
+};
+
+void releaseArray(ArrowArray* array) {
+    auto* owned = static_cast<OwnedBuffers*>(array->private_data);
+    std::pmr::memory_resource* memory = owned->memory;
+    if (owned->values != nullptr) {
+        memory->deallocate(owned->values, padded(owned->size * sizeof(double)), kArrowAlignment);
+    }
+    if (owned->validity != nullptr) {
+        memory->deallocate(owned->validity, bitmapBytes(owned->size), kArrowAlignment);
+    }
+    std::pmr::polymorphic_allocator<OwnedBuffers>(memory).delete_object(owned);
+    array->release = nullptr;
+}
+
+void releaseSchema(ArrowSchema* schema) {
+    // format and name are string literals
+    schema->release = nullptr;
+}
+
+void markReleased(ArrowArray& array, ArrowSchema& schema) {
+    std::memset(&array, 0, sizeof(array));
+    std::memset(&schema, 0, sizeof(schema));
+}
+
+// ============================================================================
+// Validity Bitmaps
+// ============================================================================
+
+/// count (1..8) bits of bits starting at bit, as the low bits of a byte
+std::uint8_t loadBits(const std::uint8_t* bits, std::size_t bit, std::size_t count) {
+    const std::size_t byte = bit / 8;
+    const std::size_t shift = bit % 8;
+    unsigned value = static_cast<unsigned>(bits[byte]) >> shift;
+    if (shift != 0 && shift + count > 8) {
+        value |= static_cast<unsigned>(bits[byte + 1]) << (8 - shift);
+    }
+    return static_cast<std::uint8_t>(value & ((1u << count) - 1));
+}
+
+/// Validity byte i of column (bits 8i..8i+7), all set without a bitmap
+std::uint8_t validityByte(const ArrowColumn& column, std::size_t i) {
+    const std::size_t count = std::min<std::size_t>(8, column.size() - 8 * i);
+    if (column.validity() == nullptr) {
+        return static_cast<std::uint8_t>((1u << count) - 1);
+    }
+    return loadBits(column.validity(), column.validityOffset() + 8 * i, count);
+}
+
+std::size_t countValid(const std::uint8_t* bits, std::size_t bit, std::size_t n) {
+    std::size_t valid = 0;
+    for (std::size_t i = 0; i < n; i += 8) {
+        valid += static_cast<std::size_t>(std::popcount(loadBits(bits, bit + i, std::min<std::size_t>(8, n - i))));
+    }
+    return valid;
+}
+
+void requireSameLength(const ArrowColumn& a, const ArrowColumn& b) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("Arrow arrays must have the same length");
+    }
+}
+
+// ============================================================================
+// Result Construction
+// ============================================================================
+
+/**
+ * @brief A float64 ArrowResult of n slots, values allocated, all valid so far
+ */
+ArrowResult allocateResult(std::size_t n, std::pmr::memory_resource* memory) {
+    if (memory == nullptr) {
+        memory = std::pmr::get_default_resource();
+    }
+    ArrowResult result;
+    auto* owned = std::pmr::polymorphic_allocator<OwnedBuffers>(memory).new_object<OwnedBuffers>(
+        OwnedBuffers{memory, n});
+
+    // From here on a throw releases what is already allocated
+    ArrowArray& array = *result.array();
+    array.length = static_cast<std::int64_t>(n);
+    array.n_buffers = 2;
+    array.buffers = owned->pointers;
+    array.private_data = owned;
+    array.release = releaseArray;
+
+    ArrowSchema& schema = *result.schema();
+    schema.format = "g";
+    schema.name = "";
+    schema.flags = ARROW_FLAG_NULLABLE;
+    schema.release = releaseSchema;
+
+    owned->values = static_cast<double*>(memory->allocate(padded(n * sizeof(double)), kArrowAlignment));
+    owned->pointers[1] = owned->values;
+    return result;
+}
+
+OwnedBuffers& buffers(ArrowResult& result) {
+    return *static_cast<OwnedBuffers*>(result.array()->private_data);
+}
+
+std::span<double> outputValues(ArrowResult& result) {
+    OwnedBuffers& owned = buffers(result);
+    return {owned.values, owned.size};
+}
+
+/// The result's bitmap, allocated (all valid) on first use
+std::uint8_t* outputValidity(ArrowResult& result) {
+    OwnedBuffers& owned = buffers(result);
+    if (owned.validity == nullptr) {
+        const std::size_t bytes = bitmapBytes(owned.size);
+        owned.validity = static_cast<std::uint8_t*>(owned.memory->allocate(bytes, kArrowAlignment));
+        std::memset(owned.validity, 0xFF, bytes);
+    }
+    return owned.validity;
+}
+
+/// Sets the null count from the bitmap, dropping a bitmap without nulls
+void finishValidity(ArrowResult& result) {
+    OwnedBuffers& owned = buffers(result);
+    std::size_t nulls = 0;
+    if (owned.validity != nullptr) {
+        nulls = owned.size - countValid(owned.validity, 0, owned.size);
+    }
+    result.array()->null_count = static_cast<std::int64_t>(nulls);
+    owned.pointers[0] = nulls == 0 ? nullptr : owned.validity;
+}
+
+/// Result validity = AND of the inputs' validity
+void combineValidity(ArrowResult& result, const ArrowColumn& a, const ArrowColumn* b) {
+    if (a.nullCount() == 0 && (b == nullptr || b->nullCount() == 0)) {
+        return;
+    }
+    std::uint8_t* bits = outputValidity(result);
+    const std::size_t bytes = (a.size() + 7) / 8;
+    for (std::size_t i = 0; i < bytes; ++i) {
+        bits[i] = b == nullptr ? validityByte(a, i) : validityByte(a, i) & validityByte(*b, i);
+    }
+}
+
+bool isValid(const OwnedBuffers& owned, std::size_t i) {
+    return owned.validity == nullptr || ((owned.validity[i / 8] >> (i % 8)) & 1) != 0;
+}
+
+/// Nulls out the valid slots i with isZero(i), reporting them in status
+template <typename IsZero>
+void nullZeroDenominators(ArrowResult& result, IsZero isZero, Calculator::BatchStatus* status) {
+    Calculator::BatchStatus found;
+    OwnedBuffers& owned = buffers(result);
+    for (std::size_t i = 0; i < owned.size; ++i) {
+        if (isZero(i) && isValid(owned, i)) {
+            outputValidity(result)[i / 8] &= static_cast<std::uint8_t>(~(1u << (i % 8)));
+            found.firstError = std::min(found.firstError, i);
+            ++found.errorCount;
+        }
+    }
+    if (status != nullptr) {
+        *status = found;
+    }
+}
+
+template <typename Batch>
+ArrowResult binary(const ArrowColumn& a, const ArrowColumn& b, std::pmr::memory_resource* memory,
+                   Batch batch) {
+    requireSameLength(a, b);
+    ArrowResult result = allocateResult(a.size(), memory);
+    batch(a.values(), b.values(), outputValues(result));
+    combineValidity(result, a, &b);
+    finishValidity(result);
+    return result;
+}
+
+template <typename Batch>
+ArrowResult unary(const ArrowColumn& a, std::pmr::memory_resource* memory, Batch batch) {
+    ArrowResult result = allocateResult(a.size(), memory);
+    batch(a.values(), outputValues(result));
+    combineValidity(result, a, nullptr);
+    finishValidity(result);
+    return result;
+}
+
+// ============================================================================
+// Null-Skipping Reductions
+// ============================================================================
+
+template <typename Reduce>
+Calculator::ResultType reduceValid(const ArrowColumn& values, const ReductionOptions& options,
+                                   Reduce reduce) {
+    if (values.nullCount() == 0) {
+        return reduce(values.values());
+    }
+    // Also rewinds what the reduction itself takes from the local arena
+    std::optional<ScratchScope> scope;
+    if (options.scratch == nullptr) {
+        scope.emplace();
+    }
+    std::pmr::vector<double> packed(options.scratch != nullptr ? options.scratch : &scope->arena());
+    packed.reserve(values.size() - values.nullCount());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values.isValid(i)) {
+            packed.push_back(values.values()[i]);
+        }
+    }
+    return reduce(std::span<const double>(packed));
+}
+
+} // namespace
+
+// ============================================================================
+// ArrowColumn
+// ============================================================================
+
+ArrowColumn::ArrowColumn(const ArrowArray& array, const ArrowSchema& schema) {
+    if (schema.release == nullptr || array.release == nullptr) {
+        throw std::invalid_argument("Arrow array or schema already released");
+    }
+    if (schema.format == nullptr || std::strcmp(schema.format, "g") != 0) {
+        throw std::invalid_argument("Arrow array is not float64 (format \"g\")");
+    }
+    if (array.length < 0 || array.offset < 0 || array.n_buffers != 2 || array.buffers == nullptr ||
+        array.n_children != 0 || array.dictionary != nullptr) {
+        throw std::invalid_argument("Malformed Arrow float64 array");
+    }
+
+    const auto size = static_cast<std::size_t>(array.length);
+    const auto offset = static_cast<std::size_t>(array.offset);
+    const auto* data = static_cast<const double*>(array.buffers[1]);
+    if (data == nullptr && size != 0) {
+        throw std::invalid_argument("Arrow float64 array without a values buffer");
+    }
+    values_ = data == nullptr ? std::span<const double>{} : std::span<const double>(data + offset, size);
+
+    const auto* bits = static_cast<const std::uint8_t*>(array.buffers[0]);
+    if (bits != nullptr && array.null_count != 0) {
+        // null_count is -1 when the producer has not computed it
+        nullCount_ = array.null_count > 0 ? static_cast<std::size_t>(array.null_count)
+                                          : size - countValid(bits, offset, size);
+        if (nullCount_ != 0) {
+            validity_ = bits;
+            validityOffset_ = offset;
+        }
+    }
+}
+
+// ============================================================================
+// ArrowResult
+// ============================================================================
+
+ArrowResult::ArrowResult() {
+    markReleased(array_, schema_);
+}
+
+ArrowResult::~ArrowResult() {
+    if (array_.release != nullptr) {
+        array_.release(&array_);
+    }
+    if (schema_.release != nullptr) {
+        schema_.release(&schema_);
+    }
+}
+
+ArrowResult::ArrowResult(ArrowResult&& other) noexcept : array_(other.array_), schema_(other.schema_) {
+    markReleased(other.array_, other.schema_);
+}
+
+ArrowResult& ArrowResult::operator=(ArrowResult&& other) noexcept {
+    if (this != &other) {
+        ArrowResult old(std::move(*this));
+        array_ = other.array_;
+        schema_ = other.schema_;
+        markReleased(other.array_, other.schema_);
+    }
+    return *this;
+}
+
+// ============================================================================
+// ArrowCompute
+// ============================================================================
+
+ArrowResult ArrowCompute::add(const ArrowColumn& a, const ArrowColumn& b, std::pmr::memory_resource* memory) {
+    return binary(a, b, memory, [](auto x, auto y, auto out) { Calculator::add(x, y, out); });
+}
+
+ArrowResult ArrowCompute::add(const ArrowColumn& a, ResultType b, std::pmr::memory_resource* memory) {
+    return unary(a, memory, [b](auto x, auto out) { Calculator::add(x, b, out); });
+}
+
+ArrowResult ArrowCompute::subtract(const ArrowColumn& a, const ArrowColumn& b,
+                                   std::pmr::memory_resource* memory) {
+    return binary(a, b, memory, [](auto x, auto y, auto out) { Calculator::subtract(x, y, out); });
+}
+
+ArrowResult ArrowCompute::subtract(const ArrowColumn& a, ResultType b, std::pmr::memory_resource* memory) {
+    return unary(a, memory, [b](auto x, auto out) { Calculator::subtract(x, b, out); });
+}
+
+ArrowResult ArrowCompute::multiply(const ArrowColumn& a, const ArrowColumn& b,
+                                   std::pmr::memory_resource* memory) {
+    return binary(a, b, memory, [](auto x, auto y, auto out) { Calculator::multiply(x, y, out); });
+}
+
+ArrowResult ArrowCompute::multiply(const ArrowColumn& a, ResultType b, std::pmr::memory_resource* memory) {
+    return unary(a, memory, [b](auto x, auto out) { Calculator::multiply(x, b, out); });
+}
+
+ArrowResult ArrowCompute::power(const ArrowColumn& base, std::int32_t exp, std::pmr::memory_resource* memory) {
+    return unary(base, memory, [exp](auto x, auto out) { Calculator::power(x, exp, out); });
+}
+
+ArrowResult ArrowCompute::divide(const ArrowColumn& a, const ArrowColumn& b, Calculator::BatchStatus* status,
+                                 std::pmr::memory_resource* memory) {
+    ArrowResult result =
+        binary(a, b, memory, [](auto x, auto y, auto out) { Calculator::divide(x, y, out); });
+    const auto denominators = b.values();
+    nullZeroDenominators(
+        result, [&](std::size_t i) { return std::abs(denominators[i]) < Calculator::kZeroThreshold; },
+        status);
+    finishValidity(result);
+    return result;
+}
+
+ArrowResult ArrowCompute::divide(const ArrowColumn& a, ResultType b, Calculator::BatchStatus* status,
+                                 std::pmr::memory_resource* memory) {
+    ArrowResult result = unary(a, memory, [b](auto x, auto out) { Calculator::divide(x, b, out); });
+    const bool zero = std::abs(b) < Calculator::kZeroThreshold;
+    nullZeroDenominators(result, [zero](std::size_t) { return zero; }, status);
+    finishValidity(result);
+    return result;
+}
+
+Calculator::ResultType ArrowCompute::sum(const ArrowColumn& values, const ReductionOptions& options) {
+    return reduceValid(values, options, [&](std::span<const double> v) { return Reduction::sum(v, options); });
+}
+
+Calculator::ResultType ArrowCompute::product(const ArrowColumn& values, const ReductionOptions& options) {
+    return reduceValid(values, options,
+                       [&](std::span<const double> v) { return Reduction::product(v, options); });
+}
+
+Calculator::ResultType ArrowCompute::min(const ArrowColumn& values, const ReductionOptions& options) {
+    return reduceValid(values, options, [&](std::span<const double> v) { return Reduction::min(v, options); });
+}
+
+Calculator::ResultType ArrowCompute::max(const ArrowColumn& values, const ReductionOptions& options) {
+    return reduceValid(values, options, [&](std::span<const double> v) { return Reduction::max(v, options); });
+}
+
+Calculator::ResultType ArrowCompute::dot(const ArrowColumn& a, const ArrowColumn& b,
+                                         const ReductionOptions& options) {
+    requireSameLength(a, b);
+    if (a.nullCount() == 0 && b.nullCount() == 0) {
+        return Reduction::dot(a.values(), b.values(), options);
+    }
+    std::optional<ScratchScope> scope;
+    if (options.scratch == nullptr) {
+        scope.emplace();
+    }
+    std::pmr::memory_resource* memory = options.scratch != nullptr ? options.scratch : &scope->arena();
+    std::pmr::vector<double> packedA(memory);
+    std::pmr::vector<double> packedB(memory);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a.isValid(i) && b.isValid(i)) {
+            packedA.push_back(a.values()[i]);
+            packedB.push_back(b.values()[i]);
+        }
+    }
+    return Reduction::dot(packedA, packedB, options);
+}
+
+} // namespace MathEngine
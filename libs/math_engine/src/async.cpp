@@ -0,0 +1,334 @@
+#include "math/async.hpp"
+#include "math/executor.hpp"
+#include "math/expression.hpp"
+#include "logger/logger.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace MathEngine {
+
+namespace {
+
+void requireSameSize(std::size_t a, std::size_t b, std::size_t out) {
+    if (a != out || b != out) {
+        throw std::invalid_argument("Batch operands and output must have the same size");
+    }
+}
+
+template <typename T>
+std::span<T> slice(std::span<T> values, std::size_t begin, std::size_t end) {
+    return values.subspan(begin, end - begin);
+}
+
+} // namespace
+
+// ============================================================================
+// AsyncTask
+// ============================================================================
+// A task holds a slot of its engine from start() until finish(). The slot
+// is released before the caller is resumed, so a coroutine that destroys
+// the awaitable (or starts its next operation) never waits on itself.
+// ============================================================================
+
+namespace detail {
+
+AsyncTask::AsyncTask(AsyncCalculator& engine, std::size_t size, std::size_t chunk,
+                     std::stop_token stop)
+    : engine_(engine), size_(size), chunk_(std::max(chunk, std::size_t{1})), stop_(std::move(stop)) {}
+
+bool AsyncTask::await_suspend(std::coroutine_handle<> caller) {
+    caller_ = caller;
+    if (stop_.stop_requested()) {
+        cancelled_.store(true, std::memory_order_relaxed);
+        return false;
+    }
+
+    executor_ = engine_.executor();
+    if (size_ == 0 || executor_ == nullptr || executor_->concurrency() < 2) {
+        try {
+            runner_(0, (size_ + chunk_ - 1) / chunk_);
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+        return false;
+    }
+
+    // May run and resume the caller on another thread before returning:
+    // nothing of this task is touched afterwards
+    engine_.submit(*this);
+    return true;
+}
+
+bool AsyncTask::completed() const {
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    return !cancelled_.load(std::memory_order_relaxed);
+}
+
+void AsyncTask::start() {
+    executor_->parallelForAsync((size_ + chunk_ - 1) / chunk_, 1, runner_, finisher_);
+}
+
+void AsyncTask::finish(std::exception_ptr error) {
+    error_ = std::move(error);
+    const std::coroutine_handle<> caller = caller_;
+    // A copy: once released, the engine may go away with the caller
+    const std::function<void(std::coroutine_handle<>)> resume = engine_.options_.resume;
+    engine_.release();
+    if (resume) {
+        resume(caller);
+    } else {
+        caller.resume();
+    }
+}
+
+void AsyncTask::ChunkRunner::operator()(std::size_t first, std::size_t last) const {
+    for (std::size_t chunk = first; chunk < last; ++chunk) {
+        if (task->stop_.stop_requested()) {
+            task->cancelled_.store(true, std::memory_order_relaxed);
+            return;
+        }
+        const std::size_t begin = chunk * task->chunk_;
+        task->runChunk(begin, std::min(task->size_, begin + task->chunk_));
+    }
+}
+
+void AsyncTask::Finisher::operator()(std::exception_ptr error) const {
+    task->finish(std::move(error));
+}
+
+} // namespace detail
+
+// ============================================================================
+// AsyncBatch / AsyncValue
+// ============================================================================
+
+AsyncBatch::AsyncBatch(AsyncCalculator& engine, std::size_t size, std::size_t chunk,
+                       std::stop_token stop, Work work)
+    : AsyncTask(engine, size, chunk, std::move(stop)), work_(std::move(work)) {}
+
+void AsyncBatch::runChunk(std::size_t begin, std::size_t end) {
+    const Calculator::BatchStatus status = work_(begin, end);
+    if (status.ok()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    status_.errorCount += status.errorCount;
+    status_.firstError = std::min(status_.firstError, begin + status.firstError);
+}
+
+Expected<Calculator::BatchStatus, MathError> AsyncBatch::await_resume() {
+    if (!completed()) {
+        return Unexpected<MathError>(MathError::Cancelled);
+    }
+    return status_;
+}
+
+AsyncValue::AsyncValue(AsyncCalculator& engine, std::stop_token stop, Work work)
+    : AsyncTask(engine, 1, 1, std::move(stop)), work_(std::move(work)) {}
+
+void AsyncValue::runChunk(std::size_t, std::size_t) {
+    value_ = work_();
+}
+
+Expected<Calculator::ResultType, MathError> AsyncValue::await_resume() {
+    if (!completed()) {
+        return Unexpected<MathError>(MathError::Cancelled);
+    }
+    return value_;
+}
+
+// ============================================================================
+// AsyncCalculator - Admission
+// ============================================================================
+// Slots are handed over, not freed and retaken: release() starts the oldest
+// waiting task in the finished one's slot, so waiters run in FIFO order.
+// ============================================================================
+
+AsyncCalculator::AsyncCalculator(AsyncOptions options) : options_(std::move(options)) {}
+
+std::size_t AsyncCalculator::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inFlight_;
+}
+
+std::size_t AsyncCalculator::waiting() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiting_;
+}
+
+Executor* AsyncCalculator::executor() const {
+    return options_.executor != nullptr ? options_.executor : Executor::global();
+}
+
+void AsyncCalculator::submit(detail::AsyncTask& task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (options_.maxInFlight != 0 && inFlight_ >= options_.maxInFlight) {
+            (waitTail_ != nullptr ? waitTail_->next_ : waitHead_) = &task;
+            waitTail_ = &task;
+            ++waiting_;
+            MATHENGINE_LOG_DEBUG_RATE_LIMITED("Async: {} operations waiting for a slot", waiting_);
+            return;
+        }
+        ++inFlight_;
+    }
+    task.start();
+}
+
+void AsyncCalculator::release() {
+    detail::AsyncTask* next = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (waitHead_ == nullptr) {
+            --inFlight_;
+            return;
+        }
+        next = waitHead_;
+        waitHead_ = next->next_;
+        if (waitHead_ == nullptr) {
+            waitTail_ = nullptr;
+        }
+        --waiting_;
+    }
+    next->start();
+}
+
+// ============================================================================
+// AsyncCalculator - Operations
+// ============================================================================
+
+AsyncBatch AsyncCalculator::batch(std::size_t size, std::stop_token stop, AsyncBatch::Work work) {
+    return AsyncBatch(*this, size, options_.chunkSize, std::move(stop), std::move(work));
+}
+
+AsyncBatch AsyncCalculator::add(std::span<const ResultType> a, std::span<const ResultType> b,
+                                std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), b.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        Calculator::add(slice(a, begin, end), slice(b, begin, end), slice(out, begin, end));
+        return Calculator::BatchStatus{};
+    });
+}
+
+AsyncBatch AsyncCalculator::add(std::span<const ResultType> a, ResultType b,
+                                std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), out.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        Calculator::add(slice(a, begin, end), b, slice(out, begin, end));
+        return Calculator::BatchStatus{};
+    });
+}
+
+AsyncBatch AsyncCalculator::subtract(std::span<const ResultType> a, std::span<const ResultType> b,
+                                     std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), b.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        Calculator::subtract(slice(a, begin, end), slice(b, begin, end), slice(out, begin, end));
+        return Calculator::BatchStatus{};
+    });
+}
+
+AsyncBatch AsyncCalculator::subtract(std::span<const ResultType> a, ResultType b,
+                                     std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), out.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        Calculator::subtract(slice(a, begin, end), b, slice(out, begin, end));
+        return Calculator::BatchStatus{};
+    });
+}
+
+AsyncBatch AsyncCalculator::multiply(std::span<const ResultType> a, std::span<const ResultType> b,
+                                     std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), b.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        Calculator::multiply(slice(a, begin, end), slice(b, begin, end), slice(out, begin, end));
+        return Calculator::BatchStatus{};
+    });
+}
+
+AsyncBatch AsyncCalculator::multiply(std::span<const ResultType> a, ResultType b,
+                                     std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), out.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        Calculator::multiply(slice(a, begin, end), b, slice(out, begin, end));
+        return Calculator::BatchStatus{};
+    });
+}
+
+AsyncBatch AsyncCalculator::divide(std::span<const ResultType> a, std::span<const ResultType> b,
+                                   std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), b.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        return Calculator::divide(slice(a, begin, end), slice(b, begin, end), slice(out, begin, end));
+    });
+}
+
+AsyncBatch AsyncCalculator::divide(std::span<const ResultType> a, ResultType b,
+                                   std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(a.size(), out.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        return Calculator::divide(slice(a, begin, end), b, slice(out, begin, end));
+    });
+}
+
+AsyncBatch AsyncCalculator::power(std::span<const ResultType> base, std::int32_t exp,
+                                  std::span<ResultType> out, std::stop_token stop) {
+    requireSameSize(base.size(), out.size(), out.size());
+    return batch(out.size(), std::move(stop), [=](std::size_t begin, std::size_t end) {
+        Calculator::power(slice(base, begin, end), exp, slice(out, begin, end));
+        return Calculator::BatchStatus{};
+    });
+}
+
+AsyncBatch AsyncCalculator::evaluate(const Expression& expression,
+                                     std::span<const std::span<const ResultType>> columns,
+                                     std::span<ResultType> out, std::stop_token stop) {
+    if (columns.size() != expression.variables().size()) {
+        throw std::invalid_argument(fmt::format("Expected {} columns, got {}",
+                                                expression.variables().size(), columns.size()));
+    }
+    for (const auto& column : columns) {
+        if (column.size() != out.size()) {
+            throw std::invalid_argument("Expression columns and output must have the same size");
+        }
+    }
+    return batch(out.size(), std::move(stop), [&expression, columns, out](std::size_t begin, std::size_t end) {
+        std::vector<std::span<const ResultType>> slices(columns.size());
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            slices[i] = slice(columns[i], begin, end);
+        }
+        return expression.evaluate(slices, slice(out, begin, end));
+    });
+}
+
+AsyncValue AsyncCalculator::sum(std::span<const ResultType> values, const ReductionOptions& options,
+                                std::stop_token stop) {
+    return AsyncValue(*this, std::move(stop), [=] { return Reduction::sum(values, options); });
+}
+
+AsyncValue AsyncCalculator::product(std::span<const ResultType> values,
+                                    const ReductionOptions& options, std::stop_token stop) {
+    return AsyncValue(*this, std::move(stop), [=] { return Reduction::product(values, options); });
+}
+
+AsyncValue AsyncCalculator::dot(std::span<const ResultType> a, std::span<const ResultType> b,
+                                const ReductionOptions& options, std::stop_token stop) {
+    return AsyncValue(*this, std::move(stop), [=] { return Reduction::dot(a, b, options); });
+}
+
+AsyncValue AsyncCalculator::min(std::span<const ResultType> values, const ReductionOptions& options,
+                                std::stop_token stop) {
+    return AsyncValue(*this, std::move(stop), [=] { return Reduction::min(values, options); });
+}
+
+AsyncValue AsyncCalculator::max(std::span<const ResultType> values, const ReductionOptions& options,
+                                std::stop_token stop) {
+    return AsyncValue(*this, std::move(stop), [=] { return Reduction::max(values, options); });
+}
+
+} // namespace MathEngine
@@ -0,0 +1,155 @@
+#include "math/c_api.h"
+#include "math/calculator.hpp"
+#include "math/reduction.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// ============================================================================
+// C ABI
+// ============================================================================
+// Thin wrappers: spans over the caller's memory, the C++ call, and every
+// exception turned into a status with its message kept per thread.
+// ============================================================================
+
+namespace {
+
+using MathEngine::Calculator;
+using MathEngine::Reduction;
+using MathEngine::ReductionMode;
+using MathEngine::ReductionOptions;
+
+thread_local std::string lastError;
+
+mathengine_status fail(mathengine_status status, const char* message) {
+    lastError = message;
+    return status;
+}
+
+/// Run body, translating whatever it throws into a status
+template <typename Body>
+mathengine_status guarded(Body&& body) noexcept {
+    try {
+        body();
+        return MATHENGINE_OK;
+    } catch (const std::invalid_argument& error) {
+        return fail(MATHENGINE_ERROR_INVALID_ARGUMENT, error.what());
+    } catch (const std::exception& error) {
+        return fail(MATHENGINE_ERROR_INTERNAL, error.what());
+    } catch (...) {
+        return fail(MATHENGINE_ERROR_INTERNAL, "Unknown error");
+    }
+}
+
+/// A span over n elements at data, which may be NULL only when n is 0
+template <typename T>
+std::span<T> view(T* data, std::size_t n) {
+    if (data == nullptr && n != 0) {
+        throw std::invalid_argument("NULL pointer with a non-zero element count");
+    }
+    return {data, n};
+}
+
+ReductionOptions reductionOptions(std::int32_t mode) {
+    switch (mode) {
+        case MATHENGINE_REDUCTION_DETERMINISTIC: return {ReductionMode::Deterministic};
+        case MATHENGINE_REDUCTION_FAST:          return {ReductionMode::Fast};
+        default: throw std::invalid_argument("Unknown reduction mode");
+    }
+}
+
+void storeStatus(const Calculator::BatchStatus& status, mathengine_batch_status* out) {
+    if (out != nullptr) {
+        out->error_count = status.errorCount;
+        out->first_error = status.firstError;
+    }
+}
+
+template <typename Reduce>
+mathengine_status reduce(double* result, Reduce&& reduceFn) noexcept {
+    if (result == nullptr) {
+        return fail(MATHENGINE_ERROR_INVALID_ARGUMENT, "NULL result pointer");
+    }
+    return guarded([&] { *result = reduceFn(); });
+}
+
+} // namespace
+
+extern "C" {
+
+const char* mathengine_version(void) {
+    return MATHENGINE_VERSION_STRING;
+}
+
+const char* mathengine_kernel_tier(void) {
+    return MathEngine::detail::kernels().name;
+}
+
+const char* mathengine_last_error(void) {
+    return lastError.c_str();
+}
+
+mathengine_status mathengine_add(const double* a, const double* b, double* out, size_t n) {
+    return guarded([&] { Calculator::add(view(a, n), view(b, n), view(out, n)); });
+}
+
+mathengine_status mathengine_subtract(const double* a, const double* b, double* out, size_t n) {
+    return guarded([&] { Calculator::subtract(view(a, n), view(b, n), view(out, n)); });
+}
+
+mathengine_status mathengine_multiply(const double* a, const double* b, double* out, size_t n) {
+    return guarded([&] { Calculator::multiply(view(a, n), view(b, n), view(out, n)); });
+}
+
+mathengine_status mathengine_divide(const double* a, const double* b, double* out, size_t n,
+                                    mathengine_batch_status* status) {
+    return guarded([&] { storeStatus(Calculator::divide(view(a, n), view(b, n), view(out, n)), status); });
+}
+
+mathengine_status mathengine_add_scalar(const double* a, double b, double* out, size_t n) {
+    return guarded([&] { Calculator::add(view(a, n), b, view(out, n)); });
+}
+
+mathengine_status mathengine_subtract_scalar(const double* a, double b, double* out, size_t n) {
+    return guarded([&] { Calculator::subtract(view(a, n), b, view(out, n)); });
+}
+
+mathengine_status mathengine_multiply_scalar(const double* a, double b, double* out, size_t n) {
+    return guarded([&] { Calculator::multiply(view(a, n), b, view(out, n)); });
+}
+
+mathengine_status mathengine_divide_scalar(const double* a, double b, double* out, size_t n,
+                                           mathengine_batch_status* status) {
+    return guarded([&] { storeStatus(Calculator::divide(view(a, n), b, view(out, n)), status); });
+}
+
+mathengine_status mathengine_power(const double* base, int32_t exp, double* out, size_t n) {
+    return guarded([&] { Calculator::power(view(base, n), exp, view(out, n)); });
+}
+
+mathengine_status mathengine_sum(const double* values, size_t n, int32_t mode, double* result) {
+    return reduce(result, [&] { return Reduction::sum(view(values, n), reductionOptions(mode)); });
+}
+
+mathengine_status mathengine_product(const double* values, size_t n, int32_t mode, double* result) {
+    return reduce(result, [&] { return Reduction::product(view(values, n), reductionOptions(mode)); });
+}
+
+mathengine_status mathengine_dot(const double* a, const double* b, size_t n, int32_t mode, double* result) {
+    return reduce(result, [&] { return Reduction::dot(view(a, n), view(b, n), reductionOptions(mode)); });
+}
+
+mathengine_status mathengine_min(const double* values, size_t n, int32_t mode, double* result) {
+    return reduce(result, [&] { return Reduction::min(view(values, n), reductionOptions(mode)); });
+}
+
+mathengine_status mathengine_max(const double* values, size_t n, int32_t mode, double* result) {
+    return reduce(result, [&] { return Reduction::max(view(values, n), reductionOptions(mode)); });
+}
+
+} // extern "C"
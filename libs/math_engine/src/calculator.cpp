@@ -1,65 +1,214 @@
 #include "math/calculator.hpp"
 #include "logger/logger.hpp"
+#include "instrumentation.hpp"
+#include "memoization.hpp"
 
 #include <stdexcept>
 #include <cmath>
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
 
 namespace MathEngine {
 
+namespace {
+
+// ============================================================================
+// Per-thread last result
+// ============================================================================
+// Each thread owns one cache-line-sized slot, so operations on different
+// threads never write the same line. Slots register themselves so that
+// getLastResults() can offer an aggregated view on demand.
+// ============================================================================
+
+struct alignas(64) LastResultSlot {
+    std::atomic<Calculator::ResultType> value{
+        std::numeric_limits<Calculator::ResultType>::quiet_NaN()};
+};
+
+class LastResultRegistry {
+public:
+    static LastResultRegistry& instance() {
+        // Intentionally leaked: thread_local slots may unregister during exit
+        static auto* registry = new LastResultRegistry();
+        return *registry;
+    }
+
+    void add(const LastResultSlot* slot) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slots_.push_back(slot);
+    }
+
+    void remove(const LastResultSlot* slot) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slots_.erase(std::remove(slots_.begin(), slots_.end(), slot), slots_.end());
+    }
+
+    std::vector<Calculator::ResultType> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Calculator::ResultType> values;
+        values.reserve(slots_.size());
+        for (const LastResultSlot* slot : slots_) {
+            values.push_back(slot->value.load(std::memory_order_relaxed));
+        }
+        return values;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<const LastResultSlot*> slots_;
+};
+
+struct ThreadLastResult {
+    LastResultSlot slot;
+
+    ThreadLastResult() { LastResultRegistry::instance().add(&slot); }
+    ~ThreadLastResult() { LastResultRegistry::instance().remove(&slot); }
+
+    ThreadLastResult(const ThreadLastResult&) = delete;
+    ThreadLastResult& operator=(const ThreadLastResult&) = delete;
+};
+
+ThreadLastResult& threadLastResult() {
+    thread_local ThreadLastResult state;
+    return state;
+}
+
+} // namespace
+
+// Messages are formatted inside the MATHENGINE_LOG_* macros (fmt syntax) so
+// that nothing is built when the level is filtered out. These sites run once
+// per operation, so they are rate limited: Logger::setRateLimit() caps each
+// level in production and summary lines count what was suppressed.
+
 Calculator::ResultType Calculator::add(ResultType a, ResultType b) {
-    Logger::info("Calculating: " + std::to_string(a) + " + " + std::to_string(b));
-    lastResult_ = a + b;
-    Logger::debug("Result: " + std::to_string(lastResult_));
-    return lastResult_;
+    detail::OperationScope scope(Operation::Add);
+    MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {} + {}", a, b);
+    const ResultType result = a + b;
+    storeLastResult(result);
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Result: {}", result);
+    return result;
 }
 
 Calculator::ResultType Calculator::subtract(ResultType a, ResultType b) {
-    Logger::info("Calculating: " + std::to_string(a) + " - " + std::to_string(b));
-    lastResult_ = a - b;
-    Logger::debug("Result: " + std::to_string(lastResult_));
-    return lastResult_;
+    detail::OperationScope scope(Operation::Subtract);
+    MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {} - {}", a, b);
+    const ResultType result = a - b;
+    storeLastResult(result);
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Result: {}", result);
+    return result;
 }
 
 Calculator::ResultType Calculator::multiply(ResultType a, ResultType b) {
-    Logger::info("Calculating: " + std::to_string(a) + " * " + std::to_string(b));
-    lastResult_ = a * b;
-    Logger::debug("Result: " + std::to_string(lastResult_));
-    return lastResult_;
+    detail::OperationScope scope(Operation::Multiply);
+    MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {} * {}", a, b);
+    const ResultType result = a * b;
+    storeLastResult(result);
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Result: {}", result);
+    return result;
 }
 
 Calculator::ResultType Calculator::divide(ResultType a, ResultType b) {
-    std::ostringstream oss;
-    oss << "Calculating: " << a << " / " << b;
-    Logger::info(oss.str());
+    detail::OperationScope scope(Operation::Divide);
+    MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {} / {}", a, b);
 
-    if (std::abs(b) < 1e-10) {
-        Logger::error("Division by zero attempted!");
+    if (std::abs(b) < kZeroThreshold) {
+        detail::recordEvent(MetricEvent::DivisionByZero);
+        MATHENGINE_LOG_ERROR_RATE_LIMITED("Division by zero attempted!");
         throw std::invalid_argument("Cannot divide by zero");
     }
 
-    lastResult_ = a / b;
-    Logger::debug("Result: " + std::to_string(lastResult_));
-    return lastResult_;
+    const ResultType result = a / b;
+    storeLastResult(result);
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Result: {}", result);
+    return result;
 }
 
-Calculator::ResultType Calculator::power(ResultType base, std::int32_t exp) {
-    std::ostringstream oss;
-    oss << "Calculating: " << base << "^" << exp;
-    Logger::info(oss.str());
+Expected<Calculator::ResultType, MathError> Calculator::tryDivide(ResultType a, ResultType b) {
+    detail::OperationScope scope(Operation::Divide);
+    MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {} / {}", a, b);
+
+    if (std::abs(b) < kZeroThreshold) {
+        detail::recordEvent(MetricEvent::DivisionByZero);
+        // Expected in bulk data, so not worth more than a debug line
+        MATHENGINE_LOG_DEBUG_RATE_LIMITED("Division by zero reported to caller");
+        return Unexpected<MathError>(MathError::DivisionByZero);
+    }
+
+    const ResultType result = a / b;
+    storeLastResult(result);
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Result: {}", result);
+    return result;
+}
+
+Calculator::ResultType Calculator::divide(ResultType a, ResultType b, DivisionPolicy policy) {
+    if (policy == DivisionPolicy::Throw) {
+        return divide(a, b);
+    }
+
+    detail::OperationScope scope(Operation::Divide);
+    MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {} / {}", a, b);
+
+    const bool zero = std::abs(b) < kZeroThreshold;
+    if (zero) {
+        detail::recordEvent(MetricEvent::DivisionByZero);
+    }
+    const ResultType result = zero ? divisionByZeroResult(a, b, policy) : a / b;
+    storeLastResult(result);
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Result: {}", result);
+    return result;
+}
+
+Calculator::ResultType Calculator::divisionByZeroResult(ResultType a, ResultType b,
+                                                        DivisionPolicy policy) {
+    using Limits = std::numeric_limits<ResultType>;
+
+    // Sign of the quotient a / b, with b's sign taken from its (tiny) value
+    const ResultType sign = std::signbit(a) != std::signbit(b) ? -1.0 : 1.0;
+
+    switch (policy) {
+        case DivisionPolicy::ReturnInf:
+            return a == 0 ? Limits::quiet_NaN() : sign * Limits::infinity();
+        case DivisionPolicy::Saturate:
+            return a == 0 ? ResultType{0} : sign * Limits::max();
+        case DivisionPolicy::ReturnNaN:
+        case DivisionPolicy::Throw:
+            break;
+    }
+    return Limits::quiet_NaN();
+}
+
+Calculator::ResultType Calculator::power(ResultType base, std::int32_t exp, CachePolicy cache) {
+    detail::OperationScope scope(Operation::Power);
+    MATHENGINE_LOG_INFO_RATE_LIMITED("Calculating: {}^{}", base, exp);
 
     if (exp < 0) {
-        Logger::warning("Negative exponent - may lose precision");
+        detail::recordEvent(MetricEvent::NegativeExponent);
+        MATHENGINE_LOG_WARNING_RATE_LIMITED("Negative exponent - may lose precision");
     }
 
-    lastResult_ = std::pow(base, static_cast<double>(exp));
-    Logger::debug("Result: " + std::to_string(lastResult_));
-    return lastResult_;
+    const ResultType result =
+        detail::memoActive(cache)
+            ? detail::memoized(detail::MemoKey::power(base, exp), MetricEvent::PowerCacheHit,
+                               MetricEvent::PowerCacheMiss, [&] { return integerPower(base, exp); })
+            : integerPower(base, exp);
+    storeLastResult(result);
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Result: {}", result);
+    return result;
 }
 
 Calculator::ResultType Calculator::getLastResult() {
-    Logger::debug("Retrieving last result");
-    return lastResult_;
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Retrieving last result");
+    return threadLastResult().slot.value.load(std::memory_order_relaxed);
+}
+
+std::vector<Calculator::ResultType> Calculator::getLastResults() {
+    return LastResultRegistry::instance().snapshot();
+}
+
+void Calculator::storeLastResult(ResultType value) {
+    threadLastResult().slot.value.store(value, std::memory_order_relaxed);
 }
 
 } // namespace MathEngine
@@ -0,0 +1,309 @@
+#include "math/calculator.hpp"
+#include "logger/logger.hpp"
+#include "instrumentation.hpp"
+#include "parallel.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace MathEngine {
+
+namespace {
+
+void requireSameSize(std::size_t a, std::size_t b, std::size_t out) {
+    if (a != out || b != out) {
+        throw std::invalid_argument("Batch operands and output must have the same size");
+    }
+}
+
+void requireSameSize(std::size_t a, std::size_t out) {
+    requireSameSize(a, out, out);
+}
+
+using detail::ComputeType;
+using detail::kConvertTile;
+using detail::kElementName;
+
+/**
+ * @brief Runs kernel(a, b, out, count, offset) over [0, n) in the compute type
+ *
+ * 16-bit formats go through float tiles on the stack, so each element is
+ * rounded once. @p b may be nullptr (broadcasts); the kernel then gets nullptr.
+ */
+template <typename T, typename Kernel>
+void forTiles(const T* a, const T* b, T* out, std::size_t n, Kernel kernel) {
+    if constexpr (std::is_floating_point_v<T>) {
+        kernel(a, b, out, n, std::size_t{0});
+    } else {
+        float tileA[kConvertTile];
+        float tileB[kConvertTile];
+        float tileOut[kConvertTile];
+        for (std::size_t i = 0; i < n; i += kConvertTile) {
+            const std::size_t count = std::min(kConvertTile, n - i);
+            detail::widen(a + i, tileA, count);
+            if (b != nullptr) {
+                detail::widen(b + i, tileB, count);
+            }
+            kernel(tileA, b != nullptr ? tileB : nullptr, tileOut, count, i);
+            detail::narrow(tileOut, out + i, count);
+        }
+    }
+}
+
+template <typename T>
+T fromCompute(ComputeType<T> value) {
+    return static_cast<T>(value);
+}
+
+// ============================================================================
+// Generic Batch Operations
+// ============================================================================
+// select picks the kernel out of the tier's ElementKernels for the compute
+// type, so one body serves every element type.
+// ============================================================================
+
+template <typename T, typename Select>
+void binaryBatch(Operation operation, std::string_view name, std::span<const T> a,
+                 std::span<const T> b, std::span<T> out, Select select) {
+    requireSameSize(a.size(), b.size(), out.size());
+    detail::OperationScope scope(operation, out.size());
+    MATHENGINE_LOG_INFO("Batch {}: {} {} elements ({})", name, out.size(), kElementName<T>,
+                        detail::kernels().name);
+
+    const auto kernel = select(detail::elementKernels<ComputeType<T>>());
+    detail::parallelRange(out.size(), detail::kBatchGrain, [&](std::size_t begin, std::size_t end) {
+        forTiles(a.data() + begin, b.data() + begin, out.data() + begin, end - begin,
+                 [&](const auto* x, const auto* y, auto* o, std::size_t n, std::size_t) {
+                     kernel(x, y, o, n);
+                 });
+    });
+}
+
+template <typename T, typename Select>
+void broadcastBatch(Operation operation, std::string_view name, std::span<const T> a,
+                    ComputeType<T> b, std::span<T> out, Select select) {
+    requireSameSize(a.size(), out.size());
+    detail::OperationScope scope(operation, out.size());
+    MATHENGINE_LOG_INFO("Batch {}: {} {} elements with {} ({})", name, out.size(), kElementName<T>,
+                        b, detail::kernels().name);
+
+    const auto kernel = select(detail::elementKernels<ComputeType<T>>());
+    detail::parallelRange(out.size(), detail::kBatchGrain, [&](std::size_t begin, std::size_t end) {
+        forTiles(a.data() + begin, static_cast<const T*>(nullptr), out.data() + begin, end - begin,
+                 [&](const auto* x, const auto*, auto* o, std::size_t n, std::size_t) {
+                     kernel(x, b, o, n);
+                 });
+    });
+}
+
+template <typename T>
+Calculator::BatchStatus divideBatch(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    requireSameSize(a.size(), b.size(), out.size());
+    detail::OperationScope scope(Operation::BatchDivide, out.size());
+    MATHENGINE_LOG_INFO("Batch divide: {} {} elements ({})", out.size(), kElementName<T>,
+                        detail::kernels().name);
+
+    const auto kernel = detail::elementKernels<ComputeType<T>>().divide;
+    detail::SharedBatchStatus shared;
+    detail::parallelRange(out.size(), detail::kBatchGrain, [&](std::size_t begin, std::size_t end) {
+        forTiles(a.data() + begin, b.data() + begin, out.data() + begin, end - begin,
+                 [&](const auto* x, const auto* y, auto* o, std::size_t n, std::size_t offset) {
+                     std::size_t first = Calculator::BatchStatus::npos;
+                     const std::size_t errors = kernel(x, y, o, n, &first);
+                     shared.add(errors, begin + offset + first);
+                 });
+    });
+    const Calculator::BatchStatus status = shared.get();
+    detail::recordEvent(MetricEvent::DivisionByZero, status.errorCount);
+    if (!status.ok()) {
+        MATHENGINE_LOG_ERROR("Batch divide: {} zero denominators (first at index {})",
+                             status.errorCount, status.firstError);
+    }
+    return status;
+}
+
+template <typename T>
+Calculator::BatchStatus divideBatch(std::span<const T> a, ComputeType<T> b, std::span<T> out) {
+    requireSameSize(a.size(), out.size());
+    detail::OperationScope scope(Operation::BatchDivide, out.size());
+    MATHENGINE_LOG_INFO("Batch divide: {} {} elements / {} ({})", out.size(), kElementName<T>, b,
+                        detail::kernels().name);
+
+    Calculator::BatchStatus status;
+    if (std::abs(b) < Calculator::kZeroThreshold) {
+        detail::recordEvent(MetricEvent::DivisionByZero, out.size());
+        MATHENGINE_LOG_ERROR("Batch divide: division by zero for all {} elements", out.size());
+        std::fill(out.begin(), out.end(),
+                  fromCompute<T>(std::numeric_limits<ComputeType<T>>::quiet_NaN()));
+        status.errorCount = out.size();
+        status.firstError = out.empty() ? Calculator::BatchStatus::npos : 0;
+        return status;
+    }
+
+    const auto kernel = detail::elementKernels<ComputeType<T>>().divideScalar;
+    detail::parallelRange(out.size(), detail::kBatchGrain, [&](std::size_t begin, std::size_t end) {
+        forTiles(a.data() + begin, static_cast<const T*>(nullptr), out.data() + begin, end - begin,
+                 [&](const auto* x, const auto*, auto* o, std::size_t n, std::size_t) {
+                     kernel(x, b, o, n);
+                 });
+    });
+    return status;
+}
+
+template <typename T>
+void powerBatch(std::span<const T> base, std::int32_t exp, std::span<T> out) {
+    requireSameSize(base.size(), out.size());
+    detail::OperationScope scope(Operation::BatchPower, out.size());
+    MATHENGINE_LOG_INFO("Batch power: {} {} elements ^ {} ({})", out.size(), kElementName<T>, exp,
+                        detail::kernels().name);
+    if (exp < 0) {
+        detail::recordEvent(MetricEvent::NegativeExponent);
+        MATHENGINE_LOG_WARNING("Negative exponent - may lose precision");
+    }
+
+    const auto kernel = detail::elementKernels<ComputeType<T>>().power;
+    detail::parallelRange(out.size(), detail::kBatchGrain, [&](std::size_t begin, std::size_t end) {
+        forTiles(base.data() + begin, static_cast<const T*>(nullptr), out.data() + begin, end - begin,
+                 [&](const auto* x, const auto*, auto* o, std::size_t n, std::size_t) {
+                     kernel(x, exp, o, n);
+                 });
+    });
+}
+
+constexpr auto kAdd = [](const auto& k) { return k.add; };
+constexpr auto kSubtract = [](const auto& k) { return k.subtract; };
+constexpr auto kMultiply = [](const auto& k) { return k.multiply; };
+constexpr auto kAddScalar = [](const auto& k) { return k.addScalar; };
+constexpr auto kSubtractScalar = [](const auto& k) { return k.subtractScalar; };
+constexpr auto kMultiplyScalar = [](const auto& k) { return k.multiplyScalar; };
+
+} // namespace
+
+template <typename T>
+void Calculator::storeLastResult(std::span<T> out) {
+    if (!out.empty()) {
+        if constexpr (std::is_floating_point_v<T>) {
+            storeLastResult(static_cast<ResultType>(out.back()));
+        } else {
+            storeLastResult(static_cast<ResultType>(static_cast<float>(out.back())));
+        }
+    }
+}
+
+// ============================================================================
+// double
+// ============================================================================
+
+void Calculator::add(std::span<const ResultType> a, std::span<const ResultType> b,
+                     std::span<ResultType> out) {
+    binaryBatch(Operation::BatchAdd, "add", a, b, out, kAdd);
+    storeLastResult(out);
+}
+
+void Calculator::add(std::span<const ResultType> a, ResultType b, std::span<ResultType> out) {
+    broadcastBatch(Operation::BatchAdd, "add", a, b, out, kAddScalar);
+    storeLastResult(out);
+}
+
+void Calculator::subtract(std::span<const ResultType> a, std::span<const ResultType> b,
+                          std::span<ResultType> out) {
+    binaryBatch(Operation::BatchSubtract, "subtract", a, b, out, kSubtract);
+    storeLastResult(out);
+}
+
+void Calculator::subtract(std::span<const ResultType> a, ResultType b, std::span<ResultType> out) {
+    broadcastBatch(Operation::BatchSubtract, "subtract", a, b, out, kSubtractScalar);
+    storeLastResult(out);
+}
+
+void Calculator::multiply(std::span<const ResultType> a, std::span<const ResultType> b,
+                          std::span<ResultType> out) {
+    binaryBatch(Operation::BatchMultiply, "multiply", a, b, out, kMultiply);
+    storeLastResult(out);
+}
+
+void Calculator::multiply(std::span<const ResultType> a, ResultType b, std::span<ResultType> out) {
+    broadcastBatch(Operation::BatchMultiply, "multiply", a, b, out, kMultiplyScalar);
+    storeLastResult(out);
+}
+
+Calculator::BatchStatus Calculator::divide(std::span<const ResultType> a,
+                                           std::span<const ResultType> b,
+                                           std::span<ResultType> out) {
+    const BatchStatus status = divideBatch(a, b, out);
+    storeLastResult(out);
+    return status;
+}
+
+Calculator::BatchStatus Calculator::divide(std::span<const ResultType> a, ResultType b,
+                                           std::span<ResultType> out) {
+    const BatchStatus status = divideBatch(a, b, out);
+    storeLastResult(out);
+    return status;
+}
+
+void Calculator::power(std::span<const ResultType> base, std::int32_t exp,
+                       std::span<ResultType> out) {
+    powerBatch(base, exp, out);
+    storeLastResult(out);
+}
+
+// ============================================================================
+// float, Float16 and BFloat16
+// ============================================================================
+// Every reduced-precision overload is the same forwarding, written once.
+// ============================================================================
+
+#define MATHENGINE_DEFINE_BATCH_OPERATIONS(T)                                                       \
+    void Calculator::add(std::span<const T> a, std::span<const T> b, std::span<T> out) {           \
+        binaryBatch(Operation::BatchAdd, "add", a, b, out, kAdd);                                   \
+        storeLastResult(out);                                                                       \
+    }                                                                                               \
+    void Calculator::add(std::span<const T> a, float b, std::span<T> out) {                        \
+        broadcastBatch(Operation::BatchAdd, "add", a, b, out, kAddScalar);                          \
+        storeLastResult(out);                                                                       \
+    }                                                                                               \
+    void Calculator::subtract(std::span<const T> a, std::span<const T> b, std::span<T> out) {      \
+        binaryBatch(Operation::BatchSubtract, "subtract", a, b, out, kSubtract);                    \
+        storeLastResult(out);                                                                       \
+    }                                                                                               \
+    void Calculator::subtract(std::span<const T> a, float b, std::span<T> out) {                   \
+        broadcastBatch(Operation::BatchSubtract, "subtract", a, b, out, kSubtractScalar);           \
+        storeLastResult(out);                                                                       \
+    }                                                                                               \
+    void Calculator::multiply(std::span<const T> a, std::span<const T> b, std::span<T> out) {      \
+        binaryBatch(Operation::BatchMultiply, "multiply", a, b, out, kMultiply);                    \
+        storeLastResult(out);                                                                       \
+    }                                                                                               \
+    void Calculator::multiply(std::span<const T> a, float b, std::span<T> out) {                   \
+        broadcastBatch(Operation::BatchMultiply, "multiply", a, b, out, kMultiplyScalar);           \
+        storeLastResult(out);                                                                       \
+    }                                                                                               \
+    Calculator::BatchStatus Calculator::divide(std::span<const T> a, std::span<const T> b,         \
+                                               std::span<T> out) {                                  \
+        const BatchStatus status = divideBatch(a, b, out);                                          \
+        storeLastResult(out);                                                                       \
+        return status;                                                                              \
+    }                                                                                               \
+    Calculator::BatchStatus Calculator::divide(std::span<const T> a, float b, std::span<T> out) {  \
+        const BatchStatus status = divideBatch(a, b, out);                                          \
+        storeLastResult(out);                                                                       \
+        return status;                                                                              \
+    }                                                                                               \
+    void Calculator::power(std::span<const T> base, std::int32_t exp, std::span<T> out) {          \
+        powerBatch(base, exp, out);                                                                 \
+        storeLastResult(out);                                                                       \
+    }
+
+MATHENGINE_DEFINE_BATCH_OPERATIONS(float)
+MATHENGINE_DEFINE_BATCH_OPERATIONS(Float16)
+MATHENGINE_DEFINE_BATCH_OPERATIONS(BFloat16)
+
+#undef MATHENGINE_DEFINE_BATCH_OPERATIONS
+
+} // namespace MathEngine
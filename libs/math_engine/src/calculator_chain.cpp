@@ -0,0 +1,146 @@
+#include "math/calculator.hpp"
+#include "logger/logger.hpp"
+#include "instrumentation.hpp"
+#include "parallel.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace MathEngine {
+
+namespace {
+
+/// Elements per tile of evaluate(): small enough to stay in L1 across all steps
+constexpr std::size_t kChainTile = 1024;
+
+} // namespace
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+Calculator& Calculator::power(std::int32_t exp) {
+    if (exp < 0) {
+        detail::recordEvent(MetricEvent::NegativeExponent);
+        MATHENGINE_LOG_WARNING_RATE_LIMITED("Negative exponent - may lose precision");
+    }
+    return record({Step::Op::Power, exp, 0});
+}
+
+// ============================================================================
+// Scalar pass
+// ============================================================================
+// Runs the steps added since the last call on the cached value, so calling
+// value() after every step costs no more than calling it once at the end.
+// ============================================================================
+
+Calculator::ResultType Calculator::value() {
+    const Expected<ResultType, MathError> result = tryValue();
+    if (!result) {
+        MATHENGINE_LOG_ERROR_RATE_LIMITED("Division by zero attempted!");
+        throw std::invalid_argument(std::string(toString(result.error())));
+    }
+    return *result;
+}
+
+Expected<Calculator::ResultType, MathError> Calculator::tryValue() {
+    if (applied_ == stepCount_) {
+        return current_;
+    }
+
+    detail::OperationScope scope(Operation::Chain, stepCount_ - applied_);
+    ResultType value = current_;
+    std::size_t index = applied_;
+    for (; index < stepCount_; ++index) {
+        const Step& step = stepAt(index);
+        switch (step.op) {
+            case Step::Op::Add:      value = value + step.operand; break;
+            case Step::Op::Subtract: value = value - step.operand; break;
+            case Step::Op::Multiply: value = value * step.operand; break;
+            case Step::Op::Divide:
+                if (std::abs(step.operand) < kZeroThreshold) {
+                    // Keep the progress so far; this step fails again next time
+                    current_ = value;
+                    applied_ = index;
+                    detail::recordEvent(MetricEvent::DivisionByZero);
+                    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Division by zero in chain step {}", index);
+                    return Unexpected<MathError>(MathError::DivisionByZero);
+                }
+                value = value / step.operand;
+                break;
+            case Step::Op::Power:    value = integerPower(value, step.exponent); break;
+        }
+    }
+
+    current_ = value;
+    applied_ = index;
+    MATHENGINE_LOG_DEBUG_RATE_LIMITED("Chain result after {} steps: {}", applied_, value);
+    return value;
+}
+
+// ============================================================================
+// Span pass
+// ============================================================================
+// Each tile is read from the input once and then updated in place in the
+// output by one SIMD kernel per step, so the whole chain runs while the tile
+// is in L1 and nothing else is allocated or written.
+// ============================================================================
+
+Calculator::BatchStatus Calculator::evaluate(std::span<const ResultType> in,
+                                             std::span<ResultType> out) const {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("Batch operands and output must have the same size");
+    }
+    detail::OperationScope scope(Operation::BatchChain, out.size());
+    MATHENGINE_LOG_INFO("Batch chain: {} steps over {} elements ({})", stepCount_, out.size(),
+                        detail::kernels().name);
+
+    BatchStatus status;
+    std::size_t zeroDivisors = 0;
+    for (std::size_t index = 0; index < stepCount_; ++index) {
+        const Step& step = stepAt(index);
+        zeroDivisors += step.op == Step::Op::Divide && std::abs(step.operand) < kZeroThreshold ? 1 : 0;
+    }
+    if (zeroDivisors != 0) {
+        status.errorCount = zeroDivisors * out.size();
+        status.firstError = out.empty() ? BatchStatus::npos : 0;
+        detail::recordEvent(MetricEvent::DivisionByZero, status.errorCount);
+        MATHENGINE_LOG_ERROR("Batch chain: division by zero for all {} elements", out.size());
+        std::fill(out.begin(), out.end(), std::numeric_limits<ResultType>::quiet_NaN());
+        return status;
+    }
+
+    if (stepCount_ == 0) {
+        if (in.data() != out.data()) {
+            std::copy(in.begin(), in.end(), out.begin());
+        }
+        return status;
+    }
+
+    const detail::ElementKernels<ResultType>& kernels = detail::kernels().f64;
+    detail::parallelRange(out.size(), detail::kBatchGrain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t row = begin; row < end; row += kChainTile) {
+            const std::size_t count = std::min(kChainTile, end - row);
+            const ResultType* source = in.data() + row;
+            ResultType* tile = out.data() + row;
+            for (std::size_t index = 0; index < stepCount_; ++index) {
+                const Step& step = stepAt(index);
+                switch (step.op) {
+                    case Step::Op::Add:      kernels.addScalar(source, step.operand, tile, count); break;
+                    case Step::Op::Subtract: kernels.subtractScalar(source, step.operand, tile, count); break;
+                    case Step::Op::Multiply: kernels.multiplyScalar(source, step.operand, tile, count); break;
+                    case Step::Op::Divide:   kernels.divideScalar(source, step.operand, tile, count); break;
+                    case Step::Op::Power:    kernels.power(source, step.exponent, tile, count); break;
+                }
+                source = tile;
+            }
+        }
+    });
+    return status;
+}
+
+} // namespace MathEngine
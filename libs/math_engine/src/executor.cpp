@@ -0,0 +1,369 @@
+#include "math/executor.hpp"
+#include "logger/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace MathEngine {
+
+namespace {
+
+/// Tasks per thread a parallelFor is cut into at most: slack for stealing
+constexpr std::size_t kTasksPerThread = 8;
+
+/// Polls of the queues before an idle worker goes to sleep
+constexpr int kIdleSpins = 64;
+
+std::atomic<Executor*> globalExecutor{nullptr};
+
+#if defined(__linux__)
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+
+bool pinToCpu(std::thread::native_handle_type handle, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(handle, sizeof(set), &set) == 0;
+}
+#endif
+
+} // namespace
+
+// ============================================================================
+// Executor::Impl
+// ============================================================================
+// Queue i belongs to worker i; the last queue is shared by threads outside
+// the pool that call parallelFor. A parallelFor is one Job on the caller's
+// stack; its tasks are sub-ranges, and remaining_ counts the elements not
+// yet processed, so the caller can return as soon as it reaches zero.
+// A parallelForAsync is a Job on the heap with a done callback instead of
+// a waiting owner: whichever thread brings remaining_ to zero frees it.
+// ============================================================================
+
+class Executor::Impl {
+public:
+    struct Job {
+        RangeFn fn;
+        void* context;
+        std::size_t grain;
+        std::atomic<std::size_t> remaining;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        DoneFn done;          ///< parallelForAsync only
+        void* doneContext;
+    };
+
+    struct Task {
+        Job* job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /**
+     * @brief Deque on a vector: owners use the back, thieves advance head.
+     * Emptying it clears the vector but keeps its capacity, so a warmed-up
+     * pool queues tasks without allocating.
+     */
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::vector<Task> tasks;
+        std::size_t head = 0;
+
+        bool empty() const { return head == tasks.size(); }
+
+        void clearIfDrained() {
+            if (empty()) {
+                tasks.clear();
+                head = 0;
+            }
+        }
+    };
+
+    explicit Impl(const ExecutorOptions& options) {
+        std::size_t workers = options.workers;
+        if (workers == 0) {
+            const std::size_t hardware = std::thread::hardware_concurrency();
+            workers = hardware > 1 ? hardware - 1 : 0;
+        }
+
+        queues_ = std::vector<Queue>(workers + 1);
+        threads_.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            threads_.emplace_back([this, i] { workerLoop(i); });
+        }
+
+        if (options.pinThreads) {
+            pinWorkers();
+        }
+        MATHENGINE_LOG_INFO("Executor started with {} workers{}", workers,
+                            options.pinThreads ? " (pinned)" : "");
+    }
+
+    ~Impl() {
+        stop_.store(true);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    std::size_t concurrency() const { return threads_.size() + 1; }
+
+    void run(std::size_t n, std::size_t minGrain, RangeFn fn, void* context) {
+        if (n == 0) {
+            return;
+        }
+
+        const std::size_t grain = grainFor(n, minGrain);
+        if (n <= grain || concurrency() == 1) {
+            fn(context, 0, n);
+            return;
+        }
+
+        Job job{fn, context, grain, {n}, {}, {}, nullptr, nullptr};
+        const std::size_t self = selfQueue();
+        execute({&job, 0, n}, self);
+        while (job.remaining.load(std::memory_order_acquire) != 0) {
+            if (!runOne(self)) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+    void runAsync(std::size_t n, std::size_t minGrain, RangeFn fn, void* context, DoneFn done,
+                  void* doneContext) {
+        if (n == 0 || concurrency() == 1) {
+            std::exception_ptr error;
+            try {
+                if (n != 0) {
+                    fn(context, 0, n);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+            done(doneContext, error);
+            return;
+        }
+
+        // Queued whole: the caller does not take part, the first thief splits it
+        auto* job = new Job{fn, context, grainFor(n, minGrain), {n}, {}, {}, done, doneContext};
+        push(selfQueue(), {job, 0, n});
+    }
+
+private:
+    /// Never more than kTasksPerThread tasks per thread, never below minGrain
+    std::size_t grainFor(std::size_t n, std::size_t minGrain) const {
+        const std::size_t slices = concurrency() * kTasksPerThread;
+        return std::max({minGrain, std::size_t{1}, (n + slices - 1) / slices});
+    }
+
+    std::size_t selfQueue() const {
+        return currentOwner == this ? currentWorker : queues_.size() - 1;
+    }
+
+    void push(std::size_t queue, const Task& task) {
+        {
+            std::lock_guard<std::mutex> lock(queues_[queue].mutex);
+            queues_[queue].tasks.push_back(task);
+        }
+        pending_.fetch_add(1);
+        // Pairs with the sleepers_ increment in workerLoop (both seq_cst)
+        if (sleepers_.load() != 0) {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+            }
+            wake_.notify_one();
+        }
+    }
+
+    bool popOwn(std::size_t queue, Task& task) {
+        Queue& own = queues_[queue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.empty()) {
+            return false;
+        }
+        task = own.tasks.back();
+        own.tasks.pop_back();
+        own.clearIfDrained();
+        pending_.fetch_sub(1);
+        return true;
+    }
+
+    bool steal(std::size_t thief, Task& task) {
+        const std::size_t count = queues_.size();
+        for (std::size_t offset = 1; offset < count; ++offset) {
+            Queue& victim = queues_[(thief + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.empty()) {
+                task = victim.tasks[victim.head++];
+                victim.clearIfDrained();
+                pending_.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool runOne(std::size_t self) {
+        Task task;
+        if (popOwn(self, task) || steal(self, task)) {
+            execute(task, self);
+            return true;
+        }
+        return false;
+    }
+
+    void execute(Task task, std::size_t self) {
+        Job& job = *task.job;
+
+        // Split lazily: leave the upper half for thieves while it is worth it
+        while (task.end - task.begin > job.grain) {
+            const std::size_t mid = task.begin + (task.end - task.begin) / 2;
+            push(self, {&job, mid, task.end});
+            task.end = mid;
+        }
+
+        try {
+            job.fn(job.context, task.begin, task.end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.errorMutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+        }
+
+        // Last touch of the job: the owner may return once this hits zero.
+        // An async job has no owner, so the thread that zeroes it finishes it.
+        const DoneFn done = job.done;
+        const std::size_t size = task.end - task.begin;
+        if (job.remaining.fetch_sub(size, std::memory_order_acq_rel) == size && done != nullptr) {
+            void* doneContext = job.doneContext;
+            std::exception_ptr error = std::move(job.error);
+            delete &job;
+            done(doneContext, std::move(error));
+        }
+    }
+
+    void workerLoop(std::size_t index) {
+        currentOwner = this;
+        currentWorker = index;
+
+        for (;;) {
+            if (runOne(index)) {
+                continue;
+            }
+
+            bool found = false;
+            for (int spin = 0; spin < kIdleSpins && !found; ++spin) {
+                std::this_thread::yield();
+                found = pending_.load(std::memory_order_relaxed) != 0;
+            }
+            if (found) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepers_.fetch_add(1);
+            wake_.wait(lock, [this] { return stop_.load() || pending_.load() != 0; });
+            sleepers_.fetch_sub(1);
+            if (stop_.load() && pending_.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    void pinWorkers() {
+#if defined(__linux__)
+        const std::vector<int> cpus = allowedCpus();
+        if (cpus.empty()) {
+            return;
+        }
+        for (std::size_t i = 0; i < threads_.size(); ++i) {
+            if (!pinToCpu(threads_[i].native_handle(), cpus[i % cpus.size()])) {
+                MATHENGINE_LOG_WARNING("Executor: could not pin worker {} to CPU {}", i,
+                                       cpus[i % cpus.size()]);
+            }
+        }
+#else
+        MATHENGINE_LOG_WARNING("Executor: thread pinning is not supported on this platform");
+#endif
+    }
+
+    static thread_local const Impl* currentOwner;
+    static thread_local std::size_t currentWorker;
+
+    std::vector<Queue> queues_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> sleepers_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::vector<std::thread> threads_;
+};
+
+thread_local const Executor::Impl* Executor::Impl::currentOwner = nullptr;
+thread_local std::size_t Executor::Impl::currentWorker = 0;
+
+// ============================================================================
+// Executor
+// ============================================================================
+
+Executor::Executor(const ExecutorOptions& options) : impl_(std::make_unique<Impl>(options)) {}
+
+Executor::~Executor() {
+    // Uninstall a global pool that is going away rather than leave it dangling
+    Executor* self = this;
+    globalExecutor.compare_exchange_strong(self, nullptr);
+}
+
+std::size_t Executor::concurrency() const {
+    return impl_->concurrency();
+}
+
+void Executor::run(std::size_t n, std::size_t minGrain, RangeFn fn, void* context) {
+    impl_->run(n, minGrain, fn, context);
+}
+
+void Executor::runAsync(std::size_t n, std::size_t minGrain, RangeFn fn, void* context,
+                        DoneFn done, void* doneContext) {
+    impl_->runAsync(n, minGrain, fn, context, done, doneContext);
+}
+
+void Executor::setGlobal(Executor* executor) {
+    globalExecutor.store(executor, std::memory_order_release);
+}
+
+Executor* Executor::global() {
+    return globalExecutor.load(std::memory_order_acquire);
+}
+
+} // namespace MathEngine
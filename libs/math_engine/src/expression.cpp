@@ -0,0 +1,550 @@
+#include "math/expression.hpp"
+#include "math/scratch_arena.hpp"
+#include "logger/logger.hpp"
+#include "memoization.hpp"
+#include "parallel.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace MathEngine {
+
+// ============================================================================
+// Parser - recursive descent straight into postfix bytecode
+// ============================================================================
+// Grammar (lowest to highest precedence):
+//   expression := term (('+' | '-') term)*
+//   term       := unary (('*' | '/') unary)*
+//   unary      := ('-' | '+') unary | power
+//   power      := primary ('^' unary)?
+//   primary    := number | identifier | '(' expression ')'
+// ============================================================================
+
+class Expression::Parser {
+public:
+    Parser(Expression& expression, std::string_view text)
+        : expr_(expression), text_(text) {}
+
+    void parse() {
+        parseExpression();
+        skipSpace();
+        if (pos_ != text_.size()) {
+            fail("unexpected character");
+        }
+    }
+
+private:
+    static constexpr int kMaxNesting = 256;
+
+    [[noreturn]] void fail(std::string_view message) const {
+        throw std::invalid_argument(
+            fmt::format("Invalid expression at position {}: {}", pos_, message));
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void parseExpression() {
+        parseTerm();
+        for (;;) {
+            if (accept('+')) {
+                parseTerm();
+                emitBinary(OpCode::Add);
+            } else if (accept('-')) {
+                parseTerm();
+                emitBinary(OpCode::Subtract);
+            } else {
+                break;
+            }
+        }
+    }
+
+    void parseTerm() {
+        parseUnary();
+        for (;;) {
+            if (accept('*')) {
+                parseUnary();
+                emitBinary(OpCode::Multiply);
+            } else if (accept('/')) {
+                parseUnary();
+                emitBinary(OpCode::Divide);
+            } else {
+                break;
+            }
+        }
+    }
+
+    // Every recursion (parentheses, prefix signs, exponents) passes through
+    // here, so this one check bounds the stack depth
+    void parseUnary() {
+        if (++nesting_ > kMaxNesting) {
+            fail("expression is nested too deeply");
+        }
+        if (accept('-')) {
+            parseUnary();
+            emitNegate();
+        } else if (accept('+')) {
+            parseUnary();
+        } else {
+            parsePower();
+        }
+        --nesting_;
+    }
+
+    void parsePower() {
+        parsePrimary();
+        if (!accept('^')) {
+            return;
+        }
+
+        // The exponent must fold down to a single integer constant
+        const std::size_t mark = expr_.code_.size();
+        parseUnary();
+        if (expr_.code_.size() != mark + 1 || expr_.code_.back().op != OpCode::PushConstant) {
+            fail("exponent must be an integer constant");
+        }
+        const ResultType exponent = expr_.constants_[expr_.code_.back().operand];
+        if (exponent != std::trunc(exponent) ||
+            exponent < std::numeric_limits<std::int32_t>::min() ||
+            exponent > std::numeric_limits<std::int32_t>::max()) {
+            fail("exponent must be an integer constant");
+        }
+        expr_.code_.pop_back();
+        emitPower(static_cast<std::int32_t>(exponent));
+    }
+
+    void parsePrimary() {
+        skipSpace();
+        if (pos_ >= text_.size()) {
+            fail("unexpected end of expression");
+        }
+
+        const char c = text_[pos_];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            ResultType value = 0;
+            const auto result = std::from_chars(text_.data() + pos_, text_.data() + text_.size(), value);
+            if (result.ec != std::errc()) {
+                fail("invalid number");
+            }
+            pos_ = static_cast<std::size_t>(result.ptr - text_.data());
+            emitConstant(value);
+        } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            const std::size_t start = pos_;
+            while (pos_ < text_.size() &&
+                   (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) {
+                ++pos_;
+            }
+            emitVariable(text_.substr(start, pos_ - start));
+        } else if (accept('(')) {
+            parseExpression();
+            if (!accept(')')) {
+                fail("expected ')'");
+            }
+        } else {
+            fail("expected a number, variable or '('");
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Emission with constant folding
+    // ------------------------------------------------------------------------
+
+    bool isConstant(std::size_t fromEnd) const {
+        const auto& code = expr_.code_;
+        return code.size() >= fromEnd && code[code.size() - fromEnd].op == OpCode::PushConstant;
+    }
+
+    ResultType& constantAt(std::size_t fromEnd) {
+        const auto& code = expr_.code_;
+        return expr_.constants_[code[code.size() - fromEnd].operand];
+    }
+
+    void emitConstant(ResultType value) {
+        expr_.constants_.push_back(value);
+        expr_.code_.push_back({OpCode::PushConstant,
+                               static_cast<std::int32_t>(expr_.constants_.size() - 1)});
+    }
+
+    void emitVariable(std::string_view name) {
+        auto& variables = expr_.variables_;
+        auto it = std::find(variables.begin(), variables.end(), name);
+        if (it == variables.end()) {
+            variables.emplace_back(name);
+            it = variables.end() - 1;
+        }
+        expr_.code_.push_back({OpCode::PushVariable,
+                               static_cast<std::int32_t>(it - variables.begin())});
+    }
+
+    void emitBinary(OpCode op) {
+        // Two trailing pushes are exactly this operator's operands
+        if (isConstant(1) && isConstant(2)) {
+            const ResultType rhs = constantAt(1);
+            ResultType& lhs = constantAt(2);
+            // Leave division by a zero constant to run time, where it is reported
+            if (op != OpCode::Divide || std::abs(rhs) >= Calculator::kZeroThreshold) {
+                switch (op) {
+                    case OpCode::Add:      lhs = lhs + rhs; break;
+                    case OpCode::Subtract: lhs = lhs - rhs; break;
+                    case OpCode::Multiply: lhs = lhs * rhs; break;
+                    case OpCode::Divide:   lhs = lhs / rhs; break;
+                    default: break;
+                }
+                expr_.code_.pop_back();
+                return;
+            }
+        }
+        expr_.code_.push_back({op, 0});
+    }
+
+    void emitNegate() {
+        if (isConstant(1)) {
+            constantAt(1) = -constantAt(1);
+            return;
+        }
+        expr_.code_.push_back({OpCode::Negate, 0});
+    }
+
+    void emitPower(std::int32_t exponent) {
+        if (isConstant(1)) {
+            constantAt(1) = Calculator::integerPower(constantAt(1), exponent);
+            return;
+        }
+        expr_.code_.push_back({OpCode::Power, exponent});
+    }
+
+    Expression& expr_;
+    std::string_view text_;
+    std::size_t pos_ = 0;
+    int nesting_ = 0;
+};
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+namespace {
+
+std::atomic<std::uint64_t> nextExpressionId{1};
+
+} // namespace
+
+Expression::Expression(std::string_view source) : source_(source) {
+    Parser(*this, source_).parse();
+    id_ = nextExpressionId.fetch_add(1, std::memory_order_relaxed);
+
+    // Operand stack depth the bytecode needs
+    std::size_t depth = 0;
+    for (const Instruction& instruction : code_) {
+        switch (instruction.op) {
+            case OpCode::PushConstant:
+            case OpCode::PushVariable:
+                maxDepth_ = std::max(maxDepth_, ++depth);
+                break;
+            case OpCode::Negate:
+            case OpCode::Power:
+                break;
+            default:
+                --depth;
+                break;
+        }
+    }
+    if (maxDepth_ > kMaxStackDepth) {
+        throw std::invalid_argument("Invalid expression: needs more than " +
+                                    std::to_string(kMaxStackDepth) + " stack slots");
+    }
+
+    MATHENGINE_LOG_INFO("Compiled expression '{}' into {} instructions ({} variables)",
+                        source_, code_.size(), variables_.size());
+}
+
+std::size_t Expression::variableIndex(std::string_view name) const {
+    const auto it = std::find(variables_.begin(), variables_.end(), name);
+    if (it == variables_.end()) {
+        throw std::invalid_argument(fmt::format("Unknown variable '{}'", name));
+    }
+    return static_cast<std::size_t>(it - variables_.begin());
+}
+
+// ============================================================================
+// Single-binding evaluation
+// ============================================================================
+
+Expression::ResultType Expression::evaluate(std::span<const ResultType> values,
+                                            CachePolicy cache) const {
+    if (values.size() != variables_.size()) {
+        throw std::invalid_argument(fmt::format("Expected {} variable values, got {}",
+                                                variables_.size(), values.size()));
+    }
+
+    if (values.size() <= detail::MemoKey::kMaxValues && detail::memoActive(cache)) {
+        return detail::memoized(detail::MemoKey::expression(id_, values),
+                                MetricEvent::ExpressionCacheHit, MetricEvent::ExpressionCacheMiss,
+                                [&] { return interpret(values); });
+    }
+    return interpret(values);
+}
+
+Expression::ResultType Expression::interpret(std::span<const ResultType> values) const {
+    ResultType stack[kMaxStackDepth];
+    std::size_t top = 0;
+
+    for (const Instruction& instruction : code_) {
+        switch (instruction.op) {
+            case OpCode::PushConstant:
+                stack[top++] = constants_[static_cast<std::size_t>(instruction.operand)];
+                break;
+            case OpCode::PushVariable:
+                stack[top++] = values[static_cast<std::size_t>(instruction.operand)];
+                break;
+            case OpCode::Add:
+                --top;
+                stack[top - 1] = stack[top - 1] + stack[top];
+                break;
+            case OpCode::Subtract:
+                --top;
+                stack[top - 1] = stack[top - 1] - stack[top];
+                break;
+            case OpCode::Multiply:
+                --top;
+                stack[top - 1] = stack[top - 1] * stack[top];
+                break;
+            case OpCode::Divide:
+                --top;
+                if (std::abs(stack[top]) < Calculator::kZeroThreshold) {
+                    throw std::invalid_argument("Cannot divide by zero");
+                }
+                stack[top - 1] = stack[top - 1] / stack[top];
+                break;
+            case OpCode::Negate:
+                stack[top - 1] = -stack[top - 1];
+                break;
+            case OpCode::Power:
+                stack[top - 1] = Calculator::integerPower(stack[top - 1], instruction.operand);
+                break;
+        }
+    }
+
+    return stack[0];
+}
+
+// ============================================================================
+// Columnar evaluation
+// ============================================================================
+// Operands on the stack are either a pointer to kTileSize values (a column
+// slice or a scratch tile) or a broadcast scalar. Stack slot 0 writes
+// straight into the output, so most expressions never copy their result;
+// the other slots are scratch tiles of kTileSize values each.
+// ============================================================================
+
+Calculator::BatchStatus Expression::evaluate(std::span<const std::span<const ResultType>> columns,
+                                             std::span<ResultType> out,
+                                             std::pmr::memory_resource* scratch) const {
+    if (columns.size() != variables_.size()) {
+        throw std::invalid_argument(fmt::format("Expected {} columns, got {}",
+                                                variables_.size(), columns.size()));
+    }
+    for (const auto& column : columns) {
+        if (column.size() != out.size()) {
+            throw std::invalid_argument("Expression columns and output must have the same size");
+        }
+    }
+
+    // Tasks cover whole tiles; each takes its own scratch tiles, from the
+    // caller's resource on the calling thread, else from the thread's arena
+    const std::size_t scratchSize = (std::max<std::size_t>(maxDepth_, 1) - 1) * kTileSize;
+    const std::thread::id caller = std::this_thread::get_id();
+
+    detail::SharedBatchStatus shared;
+    const std::size_t tiles = (out.size() + kTileSize - 1) / kTileSize;
+    detail::parallelRange(tiles, detail::kBatchGrain / kTileSize,
+                          [&](std::size_t firstTile, std::size_t lastTile) {
+        std::optional<ScratchScope> scope;
+        std::pmr::memory_resource* resource = scratch;
+        if (resource == nullptr || std::this_thread::get_id() != caller) {
+            resource = &scope.emplace().arena();
+        }
+        auto* tileScratch = scratchSize == 0 ? nullptr : static_cast<ResultType*>(
+            resource->allocate(scratchSize * sizeof(ResultType), alignof(ResultType)));
+
+        Calculator::BatchStatus status;
+        for (std::size_t row = firstTile * kTileSize;
+             row < std::min(lastTile * kTileSize, out.size()); row += kTileSize) {
+            const std::size_t count = std::min(kTileSize, out.size() - row);
+            evaluateTile(columns, row, count, out.data() + row, tileScratch, status);
+        }
+        shared.add(status.errorCount, status.firstError);
+
+        if (tileScratch != nullptr) {
+            resource->deallocate(tileScratch, scratchSize * sizeof(ResultType), alignof(ResultType));
+        }
+    });
+    return shared.get();
+}
+
+void Expression::evaluateTile(std::span<const std::span<const ResultType>> columns,
+                              std::size_t row, std::size_t count, ResultType* out,
+                              ResultType* scratch, Calculator::BatchStatus& status) const {
+    struct Operand {
+        const ResultType* data;  // nullptr: broadcast scalar
+        ResultType value;
+    };
+
+    const detail::ElementKernels<ResultType>& kernels = detail::kernels().f64;
+    constexpr ResultType nan = std::numeric_limits<ResultType>::quiet_NaN();
+
+    auto slot = [&](std::size_t depth) {
+        return depth == 0 ? out : scratch + (depth - 1) * kTileSize;
+    };
+    auto broadcast = [&](ResultType* destination, ResultType value) {
+        std::fill_n(destination, count, value);
+        return destination;
+    };
+    auto reportErrors = [&](std::size_t errors, std::size_t firstInTile) {
+        if (errors != 0) {
+            status.errorCount += errors;
+            status.firstError = std::min(status.firstError, row + firstInTile);
+        }
+    };
+
+    Operand stack[kMaxStackDepth];
+    std::size_t top = 0;
+
+    for (const Instruction& instruction : code_) {
+        switch (instruction.op) {
+            case OpCode::PushConstant:
+                stack[top++] = {nullptr, constants_[static_cast<std::size_t>(instruction.operand)]};
+                continue;
+            case OpCode::PushVariable:
+                stack[top++] = {columns[static_cast<std::size_t>(instruction.operand)].data() + row, 0};
+                continue;
+            case OpCode::Negate: {
+                Operand& x = stack[top - 1];
+                if (x.data == nullptr) {
+                    x.value = -x.value;
+                } else {
+                    ResultType* destination = slot(top - 1);
+                    kernels.multiplyScalar(x.data, -1.0, destination, count);
+                    x.data = destination;
+                }
+                continue;
+            }
+            case OpCode::Power: {
+                Operand& x = stack[top - 1];
+                if (x.data == nullptr) {
+                    x.value = Calculator::integerPower(x.value, instruction.operand);
+                } else {
+                    ResultType* destination = slot(top - 1);
+                    kernels.power(x.data, instruction.operand, destination, count);
+                    x.data = destination;
+                }
+                continue;
+            }
+            default:
+                break;
+        }
+
+        // Binary operators
+        const Operand rhs = stack[--top];
+        Operand& lhs = stack[top - 1];
+        ResultType* destination = slot(top - 1);
+
+        if (lhs.data == nullptr && rhs.data == nullptr) {
+            switch (instruction.op) {
+                case OpCode::Add:      lhs.value = lhs.value + rhs.value; break;
+                case OpCode::Subtract: lhs.value = lhs.value - rhs.value; break;
+                case OpCode::Multiply: lhs.value = lhs.value * rhs.value; break;
+                case OpCode::Divide:
+                    if (std::abs(rhs.value) < Calculator::kZeroThreshold) {
+                        reportErrors(count, 0);
+                        lhs.value = nan;
+                    } else {
+                        lhs.value = lhs.value / rhs.value;
+                    }
+                    break;
+                default: break;
+            }
+            continue;
+        }
+
+        if (rhs.data == nullptr) {
+            switch (instruction.op) {
+                case OpCode::Add:      kernels.addScalar(lhs.data, rhs.value, destination, count); break;
+                case OpCode::Subtract: kernels.subtractScalar(lhs.data, rhs.value, destination, count); break;
+                case OpCode::Multiply: kernels.multiplyScalar(lhs.data, rhs.value, destination, count); break;
+                case OpCode::Divide:
+                    if (std::abs(rhs.value) < Calculator::kZeroThreshold) {
+                        reportErrors(count, 0);
+                        broadcast(destination, nan);
+                    } else {
+                        kernels.divideScalar(lhs.data, rhs.value, destination, count);
+                    }
+                    break;
+                default: break;
+            }
+            lhs.data = destination;
+            continue;
+        }
+
+        if (lhs.data == nullptr) {
+            // Commutative operators keep the scalar kernels; the others broadcast
+            if (instruction.op == OpCode::Add) {
+                kernels.addScalar(rhs.data, lhs.value, destination, count);
+                lhs.data = destination;
+                continue;
+            }
+            if (instruction.op == OpCode::Multiply) {
+                kernels.multiplyScalar(rhs.data, lhs.value, destination, count);
+                lhs.data = destination;
+                continue;
+            }
+            lhs.data = broadcast(destination, lhs.value);
+        }
+
+        switch (instruction.op) {
+            case OpCode::Add:      kernels.add(lhs.data, rhs.data, destination, count); break;
+            case OpCode::Subtract: kernels.subtract(lhs.data, rhs.data, destination, count); break;
+            case OpCode::Multiply: kernels.multiply(lhs.data, rhs.data, destination, count); break;
+            case OpCode::Divide: {
+                std::size_t first = Calculator::BatchStatus::npos;
+                const std::size_t errors = kernels.divide(lhs.data, rhs.data, destination, count, &first);
+                reportErrors(errors, first);
+                break;
+            }
+            default: break;
+        }
+        lhs.data = destination;
+    }
+
+    const Operand& result = stack[0];
+    if (result.data == nullptr) {
+        broadcast(out, result.value);
+    } else if (result.data != out) {
+        std::copy_n(result.data, count, out);
+    }
+}
+
+} // namespace MathEngine
@@ -0,0 +1,205 @@
+#include "math/fixed_calculator.hpp"
+#include "logger/logger.hpp"
+#include "parallel.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace MathEngine::detail {
+
+namespace {
+
+/// Elements per tile of overflow flags (on the stack)
+constexpr std::size_t kFlagTile = 512;
+
+void requireSameSize(std::size_t a, std::size_t b, std::size_t out) {
+    if (a != out || b != out) {
+        throw std::invalid_argument("Batch operands and output must have the same size");
+    }
+}
+
+template <typename R>
+const FixedKernels<R>& fixedKernels() {
+    if constexpr (std::is_same_v<R, std::int32_t>) {
+        return kernels().fixed32;
+    } else {
+        return kernels().fixed64;
+    }
+}
+
+template <typename R>
+constexpr std::string_view kRawName = std::is_same_v<R, std::int32_t> ? "int32" : "int64";
+
+constexpr std::string_view operationName(FixedOperation operation) {
+    switch (operation) {
+        case FixedOperation::Add: return "add";
+        case FixedOperation::Subtract: return "subtract";
+        case FixedOperation::Multiply: return "multiply";
+        case FixedOperation::Divide: return "divide";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Runs kernel(begin, count, flags) over [0, n) in flag tiles
+ *
+ * The kernel returns how many flags it set; only a tile with some is
+ * scanned for the first one.
+ */
+template <typename Kernel>
+Calculator::BatchStatus forFlagTiles(std::size_t n, Kernel kernel) {
+    SharedBatchStatus shared;
+    parallelRange(n, kBatchGrain, [&](std::size_t begin, std::size_t end) {
+        std::uint8_t flags[kFlagTile];
+        for (std::size_t i = begin; i < end; i += kFlagTile) {
+            const std::size_t count = std::min(kFlagTile, end - i);
+            const std::size_t errors = kernel(i, count, flags);
+            if (errors != 0) {
+                const auto first = static_cast<std::size_t>(std::find(flags, flags + count, 1) - flags);
+                shared.add(errors, i + first);
+            }
+        }
+    });
+    return shared.get();
+}
+
+void reportErrors(FixedOperation operation, const Calculator::BatchStatus& status) {
+    if (!status.ok()) {
+        MATHENGINE_LOG_WARNING("Fixed batch {}: {} elements saturated or divided by zero (first at index {})",
+                               operationName(operation), status.errorCount, status.firstError);
+    }
+}
+
+template <typename R>
+Calculator::BatchStatus elementwise(FixedOperation operation, std::span<const R> a, std::span<const R> b,
+                                    std::span<R> out, const Reciprocal& scale) {
+    requireSameSize(a.size(), b.size(), out.size());
+    MATHENGINE_LOG_INFO("Fixed batch {}: {} {} elements, scale {} ({})", operationName(operation),
+                        out.size(), kRawName<R>, scale.divisor(), kernels().name);
+
+    const FixedKernels<R>& k = fixedKernels<R>();
+    const Calculator::BatchStatus status =
+        forFlagTiles(out.size(), [&](std::size_t i, std::size_t n, std::uint8_t* flags) {
+            switch (operation) {
+                case FixedOperation::Add: return k.add(a.data() + i, b.data() + i, out.data() + i, n, flags);
+                case FixedOperation::Subtract:
+                    return k.subtract(a.data() + i, b.data() + i, out.data() + i, n, flags);
+                case FixedOperation::Multiply:
+                    return k.multiply(a.data() + i, b.data() + i, out.data() + i, n, scale, flags);
+                case FixedOperation::Divide:
+                    return k.divide(a.data() + i, b.data() + i, out.data() + i, n, scale, flags);
+            }
+            return std::size_t{0};
+        });
+    reportErrors(operation, status);
+    return status;
+}
+
+template <typename R>
+Calculator::BatchStatus broadcast(FixedOperation operation, std::span<const R> a, R b, std::span<R> out,
+                                  const Reciprocal& scale) {
+    requireSameSize(a.size(), out.size(), out.size());
+    MATHENGINE_LOG_INFO("Fixed batch {}: {} {} elements with raw {}, scale {} ({})", operationName(operation),
+                        out.size(), kRawName<R>, b, scale.divisor(), kernels().name);
+
+    using Arithmetic = FixedArithmetic<R>;
+    Calculator::BatchStatus status;
+    if (operation == FixedOperation::Divide && b == 0) {
+        std::transform(a.begin(), a.end(), out.begin(),
+                       [](R x) { return x == 0 ? R{0} : Arithmetic::saturated(x < 0); });
+        status.errorCount = out.size();
+        status.firstError = out.empty() ? Calculator::BatchStatus::npos : 0;
+        MATHENGINE_LOG_ERROR("Fixed batch divide: division by zero for all {} elements", out.size());
+        return status;
+    }
+
+    // One reciprocal serves the whole batch
+    const Reciprocal divisor(operation == FixedOperation::Divide ? Arithmetic::magnitude(b) : 1u);
+    const FixedKernels<R>& k = fixedKernels<R>();
+    status = forFlagTiles(out.size(), [&](std::size_t i, std::size_t n, std::uint8_t* flags) {
+        switch (operation) {
+            case FixedOperation::Add: return k.addScalar(a.data() + i, b, out.data() + i, n, flags);
+            case FixedOperation::Subtract: return k.subtractScalar(a.data() + i, b, out.data() + i, n, flags);
+            case FixedOperation::Multiply:
+                return k.multiplyScalar(a.data() + i, b, out.data() + i, n, scale, flags);
+            case FixedOperation::Divide:
+                return k.divideScalar(a.data() + i, divisor, b < 0, out.data() + i, n, scale, flags);
+        }
+        return std::size_t{0};
+    });
+    reportErrors(operation, status);
+    return status;
+}
+
+template <typename R>
+Calculator::BatchStatus power(std::span<const R> base, std::int32_t exp, std::span<R> out,
+                              const Reciprocal& scale) {
+    requireSameSize(base.size(), out.size(), out.size());
+    MATHENGINE_LOG_INFO("Fixed batch power: {} {} elements ^ {}, scale {}", out.size(), kRawName<R>, exp,
+                        scale.divisor());
+
+    // Data-dependent early exits: a plain loop, not a tier kernel
+    const Calculator::BatchStatus status =
+        forFlagTiles(out.size(), [&](std::size_t i, std::size_t n, std::uint8_t* flags) {
+            std::size_t errors = 0;
+            for (std::size_t j = 0; j < n; ++j) {
+                const FixedOutcome<R> result = FixedArithmetic<R>::power(base[i + j], exp, scale);
+                out[i + j] = result.value;
+                flags[j] = result.overflow;
+                errors += result.overflow;
+            }
+            return errors;
+        });
+    if (!status.ok()) {
+        MATHENGINE_LOG_WARNING("Fixed batch power: {} elements saturated (first at index {})",
+                               status.errorCount, status.firstError);
+    }
+    return status;
+}
+
+} // namespace
+
+// ============================================================================
+// Entry Points
+// ============================================================================
+
+Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int32_t> a,
+                                   std::span<const std::int32_t> b, std::span<std::int32_t> out,
+                                   const Reciprocal& scale) {
+    return elementwise(operation, a, b, out, scale);
+}
+
+Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int32_t> a,
+                                   std::int32_t b, std::span<std::int32_t> out, const Reciprocal& scale) {
+    return broadcast(operation, a, b, out, scale);
+}
+
+Calculator::BatchStatus fixedPowerBatch(std::span<const std::int32_t> base, std::int32_t exp,
+                                        std::span<std::int32_t> out, const Reciprocal& scale) {
+    return power(base, exp, out, scale);
+}
+
+#if MATHENGINE_FIXED_INT128
+
+Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int64_t> a,
+                                   std::span<const std::int64_t> b, std::span<std::int64_t> out,
+                                   const Reciprocal& scale) {
+    return elementwise(operation, a, b, out, scale);
+}
+
+Calculator::BatchStatus fixedBatch(FixedOperation operation, std::span<const std::int64_t> a,
+                                   std::int64_t b, std::span<std::int64_t> out, const Reciprocal& scale) {
+    return broadcast(operation, a, b, out, scale);
+}
+
+Calculator::BatchStatus fixedPowerBatch(std::span<const std::int64_t> base, std::int32_t exp,
+                                        std::span<std::int64_t> out, const Reciprocal& scale) {
+    return power(base, exp, out, scale);
+}
+
+#endif // MATHENGINE_FIXED_INT128
+
+} // namespace MathEngine::detail
@@ -0,0 +1,121 @@
+#ifndef MATH_INSTRUMENTATION_HPP
+#define MATH_INSTRUMENTATION_HPP
+
+#include "math/metrics.hpp"
+
+#include "logger/trace.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace MathEngine::detail {
+
+/**
+ * @brief Counters of one operation on one thread
+ *
+ * Only the owning thread writes; snapshot() reads concurrently, which is
+ * why the fields are atomics even though nothing uses read-modify-write.
+ */
+struct OperationCounters {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> elements{0};
+    std::atomic<std::uint64_t> samples{0};
+    std::atomic<std::uint64_t> sumNs{0};
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBucketCount> buckets{};
+    std::uint32_t sinceSample = 0;  ///< Owner only: calls since the last timed one
+};
+
+/**
+ * @brief Everything one thread records, registered for snapshot()
+ */
+struct alignas(64) ThreadMetrics {
+    std::array<OperationCounters, kOperationCount> operations{};
+    std::array<std::atomic<std::uint64_t>, kMetricEventCount> events{};
+};
+
+/// The calling thread's block (defined in metrics.cpp)
+ThreadMetrics& threadMetrics();
+
+/// Runtime switches (defined in metrics.cpp)
+extern std::atomic<bool> metricsEnabled;
+extern std::atomic<std::uint32_t> latencySampleRate;
+
+/// Single-writer increment: a relaxed load and store, no locked instruction
+inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Counts an operation for its whole scope and times sampled calls
+ *
+ * Calls that leave by an exception are counted and timed like any other.
+ * In a MATHENGINE_TRACING build the scope is also a "calculator" zone.
+ */
+class OperationScope {
+public:
+    explicit OperationScope([[maybe_unused]] Operation operation, [[maybe_unused]] std::size_t elements = 1)
+#if MATHENGINE_TRACING
+        : zone_("calculator", toString(operation).data())
+#endif
+    {
+#if MATHENGINE_METRICS
+        if (!metricsEnabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        counters_ = &threadMetrics().operations[static_cast<std::size_t>(operation)];
+        bump(counters_->calls);
+        bump(counters_->elements, elements);
+
+        const std::uint32_t rate = latencySampleRate.load(std::memory_order_relaxed);
+        if (rate != 0 && ++counters_->sinceSample >= rate) {
+            counters_->sinceSample = 0;
+            timed_ = true;
+            start_ = std::chrono::steady_clock::now();
+        }
+#endif
+    }
+
+#if MATHENGINE_METRICS
+    ~OperationScope() {
+        if (timed_) {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count();
+            const auto ns = static_cast<std::uint64_t>(elapsed < 0 ? 0 : elapsed);
+            bump(counters_->samples);
+            bump(counters_->sumNs, ns);
+            bump(counters_->buckets[LatencyHistogram::bucketIndex(ns)]);
+        }
+    }
+#endif
+
+    OperationScope(const OperationScope&) = delete;
+    OperationScope& operator=(const OperationScope&) = delete;
+
+private:
+#if MATHENGINE_TRACING
+    Trace::Zone zone_;  ///< toString() names are literals, so data() ends in '\0'
+#endif
+#if MATHENGINE_METRICS
+    OperationCounters* counters_ = nullptr;
+    bool timed_ = false;
+    std::chrono::steady_clock::time_point start_;
+#endif
+};
+
+/**
+ * @brief Count @p times occurrences of @p event
+ */
+inline void recordEvent([[maybe_unused]] MetricEvent event, [[maybe_unused]] std::uint64_t times = 1) {
+#if MATHENGINE_METRICS
+    if (times != 0 && metricsEnabled.load(std::memory_order_relaxed)) {
+        bump(threadMetrics().events[static_cast<std::size_t>(event)], times);
+    }
+#endif
+}
+
+} // namespace MathEngine::detail
+
+#endif // MATH_INSTRUMENTATION_HPP
@@ -0,0 +1,308 @@
+#include "math/memo_cache.hpp"
+#include "memoization.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MathEngine {
+
+namespace detail {
+
+std::atomic<bool> memoEnabled{false};
+
+} // namespace detail
+
+namespace {
+
+using detail::MemoKey;
+using ResultType = Calculator::ResultType;
+
+struct MemoKeyHash {
+    std::size_t operator()(const MemoKey& key) const { return static_cast<std::size_t>(key.hash()); }
+};
+
+// ============================================================================
+// Thread Tier
+// ============================================================================
+// A direct-mapped table per thread: one slot per hash, a colliding insert
+// overwrites. configure() and clear() bump the generation instead of
+// reaching into other threads' tables; each table notices on its next
+// lookup and starts over. An outdated entry is never wrong (results are
+// pure functions of their key), only kept longer than asked.
+// ============================================================================
+
+struct LocalEntry {
+    MemoKey key;
+    ResultType value = 0.0;
+};
+
+struct LocalTable {
+    std::uint64_t generation = 0;
+    std::vector<LocalEntry> entries;
+};
+
+std::atomic<std::uint64_t> generation{1};
+std::atomic<std::size_t> localCapacity{256};
+
+/// The calling thread's table, rebuilt if the configuration changed
+LocalTable& localTable() {
+    thread_local LocalTable table;
+    const std::uint64_t current = generation.load(std::memory_order_acquire);
+    if (table.generation != current) {
+        table.entries.assign(localCapacity.load(std::memory_order_relaxed), LocalEntry{});
+        table.generation = current;
+    }
+    return table;
+}
+
+LocalEntry* localSlot(LocalTable& table, std::uint64_t hash) {
+    if (table.entries.empty()) {
+        return nullptr;
+    }
+    return &table.entries[static_cast<std::size_t>(hash) & (table.entries.size() - 1)];
+}
+
+// ============================================================================
+// Shared Tier
+// ============================================================================
+// Shards each hold a fixed number of slots and an index into them. When a
+// shard is full, the CLOCK hand sweeps the slots: a slot hit since the hand
+// last passed gets a second chance, the first one that was not is evicted.
+// New entries start unreferenced, so one-off keys leave before reused ones.
+//
+// A lookup takes only its shard's mutex. The shards are reached through an
+// atomic pointer to the current ShardSet, which configure() replaces: the
+// old set is emptied and given capacity 0, but kept, so a thread still
+// holding its pointer finds nothing and inserts nothing rather than touching
+// freed memory. Only configure() calls accumulate retired sets.
+// ============================================================================
+
+struct Slot {
+    MemoKey key;
+    ResultType value = 0.0;
+    bool referenced = false;
+};
+
+struct alignas(64) Shard {
+    std::mutex mutex;
+    std::vector<Slot> slots;
+    std::unordered_map<MemoKey, std::size_t, MemoKeyHash> index;
+    std::size_t capacity = 0;
+    std::size_t hand = 0;
+
+    bool find(const MemoKey& key, ResultType& value) {
+        std::lock_guard lock(mutex);
+        const auto it = index.find(key);
+        if (it == index.end()) {
+            return false;
+        }
+        Slot& slot = slots[it->second];
+        slot.referenced = true;
+        value = slot.value;
+        return true;
+    }
+
+    void insert(const MemoKey& key, ResultType value) {
+        std::lock_guard lock(mutex);
+        if (capacity == 0 || index.contains(key)) {
+            return;  // Another thread computed the same value first
+        }
+        if (slots.size() < capacity) {
+            index.emplace(key, slots.size());
+            slots.push_back(Slot{key, value, false});
+            return;
+        }
+        while (slots[hand].referenced) {
+            slots[hand].referenced = false;
+            hand = (hand + 1) % capacity;
+        }
+        index.erase(slots[hand].key);
+        index.emplace(key, hand);
+        slots[hand] = Slot{key, value, false};
+        hand = (hand + 1) % capacity;
+    }
+
+    void clear() {
+        std::lock_guard lock(mutex);
+        slots.clear();
+        index.clear();
+        hand = 0;
+    }
+
+    /// Empty for good, releasing the memory (the set was replaced)
+    void retire() {
+        std::lock_guard lock(mutex);
+        std::vector<Slot>().swap(slots);
+        index = {};
+        capacity = 0;
+        hand = 0;
+    }
+
+    std::size_t size() {
+        std::lock_guard lock(mutex);
+        return slots.size();
+    }
+};
+
+/**
+ * @brief The shards of one configuration; never resized once published
+ */
+struct ShardSet {
+    explicit ShardSet(const MemoCacheOptions& configured)
+        : options(configured), shards(std::make_unique<Shard[]>(configured.shards)) {
+        // Round up so that a small non-zero size still caches something
+        const std::size_t perShard = (options.sharedEntries + options.shards - 1) / options.shards;
+        for (std::size_t i = 0; i < options.shards; ++i) {
+            shards[i].capacity = perShard;
+        }
+    }
+
+    Shard& shard(std::uint64_t hash) {
+        // High bits: the low ones already pick the thread-tier slot
+        return shards[static_cast<std::size_t>(hash >> 40) % options.shards];
+    }
+
+    const MemoCacheOptions options;
+    const std::unique_ptr<Shard[]> shards;
+};
+
+class SharedTier {
+public:
+    static SharedTier& instance() {
+        static SharedTier tier;
+        return tier;
+    }
+
+    void configure(const MemoCacheOptions& options) {
+        MemoCacheOptions normalized = options;
+        normalized.localEntries = options.localEntries == 0 ? 0 : std::bit_ceil(options.localEntries);
+        normalized.shards = std::max<std::size_t>(options.shards, 1);
+
+        std::lock_guard lock(configureMutex_);
+        ShardSet* retired = sets_.back().get();
+        sets_.push_back(std::make_unique<ShardSet>(normalized));
+        current_.store(sets_.back().get(), std::memory_order_release);
+        for (std::size_t i = 0; i < retired->options.shards; ++i) {
+            retired->shards[i].retire();
+        }
+        localCapacity.store(normalized.localEntries, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    MemoCacheOptions options() {
+        return current().options;
+    }
+
+    bool find(const MemoKey& key, std::uint64_t hash, ResultType& value) {
+        return current().shard(hash).find(key, value);
+    }
+
+    void insert(const MemoKey& key, std::uint64_t hash, ResultType value) {
+        current().shard(hash).insert(key, value);
+    }
+
+    void clear() {
+        std::lock_guard lock(configureMutex_);
+        ShardSet& set = current();
+        for (std::size_t i = 0; i < set.options.shards; ++i) {
+            set.shards[i].clear();
+        }
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    std::size_t size() {
+        ShardSet& set = current();
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < set.options.shards; ++i) {
+            total += set.shards[i].size();
+        }
+        return total;
+    }
+
+private:
+    SharedTier() {
+        sets_.push_back(std::make_unique<ShardSet>(MemoCacheOptions{}));
+        current_.store(sets_.back().get(), std::memory_order_release);
+    }
+
+    ShardSet& current() {
+        return *current_.load(std::memory_order_acquire);
+    }
+
+    std::atomic<ShardSet*> current_{nullptr};
+    std::mutex configureMutex_;                    ///< Serializes configure() and clear()
+    std::vector<std::unique_ptr<ShardSet>> sets_;  ///< The current one last
+};
+
+} // namespace
+
+// ============================================================================
+// Lookups
+// ============================================================================
+
+namespace detail {
+
+bool memoFind(const MemoKey& key, ResultType& value) {
+    const std::uint64_t hash = key.hash();
+    LocalTable& table = localTable();
+    LocalEntry* local = localSlot(table, hash);
+    if (local != nullptr && local->key == key) {
+        value = local->value;
+        return true;
+    }
+    if (!SharedTier::instance().find(key, hash, value)) {
+        return false;
+    }
+    if (local != nullptr) {
+        *local = LocalEntry{key, value};
+    }
+    return true;
+}
+
+void memoInsert(const MemoKey& key, ResultType value) {
+    const std::uint64_t hash = key.hash();
+    if (LocalEntry* local = localSlot(localTable(), hash)) {
+        *local = LocalEntry{key, value};
+    }
+    SharedTier::instance().insert(key, hash, value);
+}
+
+} // namespace detail
+
+// ============================================================================
+// MemoCache
+// ============================================================================
+
+void MemoCache::configure(const MemoCacheOptions& options) {
+    SharedTier::instance().configure(options);
+    detail::memoEnabled.store(options.enabled, std::memory_order_relaxed);
+}
+
+MemoCacheOptions MemoCache::options() {
+    MemoCacheOptions current = SharedTier::instance().options();
+    current.enabled = isEnabled();
+    return current;
+}
+
+void MemoCache::setEnabled(bool enabled) {
+    detail::memoEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MemoCache::isEnabled() {
+    return detail::memoEnabled.load(std::memory_order_relaxed);
+}
+
+void MemoCache::clear() {
+    SharedTier::instance().clear();
+}
+
+std::size_t MemoCache::sharedSize() {
+    return SharedTier::instance().size();
+}
+
+} // namespace MathEngine
@@ -0,0 +1,110 @@
+#ifndef MATH_MEMOIZATION_HPP
+#define MATH_MEMOIZATION_HPP
+
+#include "instrumentation.hpp"
+#include "math/calculator.hpp"
+#include "math/metrics.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace MathEngine::detail {
+
+/**
+ * @brief Exact identity of a memoized call: what was computed, on which bits
+ *
+ * The top byte of tag says what was computed; an all-zero key is never
+ * produced and marks an empty slot.
+ */
+struct MemoKey {
+    static constexpr std::size_t kMaxValues = 4;
+
+    std::uint64_t tag = 0;
+    std::uint32_t count = 0;
+    std::array<std::uint64_t, kMaxValues> bits{};
+
+    bool operator==(const MemoKey&) const = default;
+
+    bool empty() const { return tag == 0; }
+
+    std::uint64_t hash() const {
+        std::uint64_t h = mix(tag ^ (std::uint64_t{count} << 32));
+        for (std::uint32_t i = 0; i < count; ++i) {
+            h = mix(h ^ bits[i]);
+        }
+        return h;
+    }
+
+    static MemoKey power(Calculator::ResultType base, std::int32_t exp) {
+        MemoKey key;
+        key.tag = (std::uint64_t{1} << 56) | static_cast<std::uint32_t>(exp);
+        key.count = 1;
+        key.bits[0] = std::bit_cast<std::uint64_t>(base);
+        return key;
+    }
+
+    /// @p values must have at most kMaxValues entries
+    static MemoKey expression(std::uint64_t id, std::span<const Calculator::ResultType> values) {
+        MemoKey key;
+        key.tag = (std::uint64_t{2} << 56) | (id & ((std::uint64_t{1} << 56) - 1));
+        key.count = static_cast<std::uint32_t>(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            key.bits[i] = std::bit_cast<std::uint64_t>(values[i]);
+        }
+        return key;
+    }
+
+private:
+    /// Finalizer of MurmurHash3: every input bit affects every output bit
+    static std::uint64_t mix(std::uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+};
+
+/// Runtime switch (defined in memo_cache.cpp)
+extern std::atomic<bool> memoEnabled;
+
+/**
+ * @brief Whether a call made with @p policy goes through the cache
+ */
+inline bool memoActive(CachePolicy policy) {
+    return policy == CachePolicy::Default && memoEnabled.load(std::memory_order_relaxed);
+}
+
+/// Look @p key up in the calling thread's tier, then the shared one
+bool memoFind(const MemoKey& key, Calculator::ResultType& value);
+
+/// Add a freshly computed result to both tiers
+void memoInsert(const MemoKey& key, Calculator::ResultType value);
+
+/**
+ * @brief Cached value of @p key, or compute() stored under it
+ *
+ * Nothing is stored when compute() throws, so errors are raised every time.
+ */
+template <typename Compute>
+Calculator::ResultType memoized(const MemoKey& key, MetricEvent hit, MetricEvent miss,
+                                Compute&& compute) {
+    Calculator::ResultType value;
+    if (memoFind(key, value)) {
+        recordEvent(hit);
+        return value;
+    }
+    value = compute();
+    memoInsert(key, value);
+    recordEvent(miss);
+    return value;
+}
+
+} // namespace MathEngine::detail
+
+#endif // MATH_MEMOIZATION_HPP
@@ -0,0 +1,266 @@
+#include "math/metrics.hpp"
+#include "instrumentation.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+namespace MathEngine {
+
+namespace detail {
+
+std::atomic<bool> metricsEnabled{true};
+std::atomic<std::uint32_t> latencySampleRate{Metrics::kDefaultLatencySampleRate};
+
+} // namespace detail
+
+namespace {
+
+// ============================================================================
+// Thread Registry
+// ============================================================================
+// Live threads are read in place; a thread that exits folds its block into
+// retired_ first. reset() does not touch the blocks, which only their owners
+// write: it stores the current totals as a baseline subtracted later.
+// ============================================================================
+
+void addCounters(MetricsSnapshot& total, const detail::ThreadMetrics& block) {
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+        const detail::OperationCounters& counters = block.operations[op];
+        OperationStats& stats = total.operations[op];
+        stats.calls += counters.calls.load(std::memory_order_relaxed);
+        stats.elements += counters.elements.load(std::memory_order_relaxed);
+        stats.latency.count += counters.samples.load(std::memory_order_relaxed);
+        stats.latency.sumNs += counters.sumNs.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; b < LatencyHistogram::kBucketCount; ++b) {
+            stats.latency.buckets[b] += counters.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+    for (std::size_t e = 0; e < kMetricEventCount; ++e) {
+        total.events[e] += block.events[e].load(std::memory_order_relaxed);
+    }
+}
+
+void subtract(MetricsSnapshot& total, const MetricsSnapshot& baseline) {
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+        OperationStats& stats = total.operations[op];
+        const OperationStats& base = baseline.operations[op];
+        stats.calls -= base.calls;
+        stats.elements -= base.elements;
+        stats.latency.count -= base.latency.count;
+        stats.latency.sumNs -= base.latency.sumNs;
+        for (std::size_t b = 0; b < LatencyHistogram::kBucketCount; ++b) {
+            stats.latency.buckets[b] -= base.latency.buckets[b];
+        }
+    }
+    for (std::size_t e = 0; e < kMetricEventCount; ++e) {
+        total.events[e] -= baseline.events[e];
+    }
+}
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance() {
+        // Intentionally leaked: thread_local blocks may unregister during exit
+        static auto* registry = new MetricsRegistry();
+        return *registry;
+    }
+
+    void add(const detail::ThreadMetrics* block) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        blocks_.push_back(block);
+    }
+
+    void retire(const detail::ThreadMetrics* block) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        addCounters(retired_, *block);
+        blocks_.erase(std::remove(blocks_.begin(), blocks_.end(), block), blocks_.end());
+    }
+
+    MetricsSnapshot snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        MetricsSnapshot total = totalsLocked();
+        subtract(total, baseline_);
+        return total;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        baseline_ = totalsLocked();
+    }
+
+private:
+    MetricsSnapshot totalsLocked() const {
+        MetricsSnapshot total = retired_;
+        for (const detail::ThreadMetrics* block : blocks_) {
+            addCounters(total, *block);
+        }
+        return total;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<const detail::ThreadMetrics*> blocks_;
+    MetricsSnapshot retired_;
+    MetricsSnapshot baseline_;
+};
+
+struct RegisteredThreadMetrics {
+    detail::ThreadMetrics block;
+
+    RegisteredThreadMetrics() { MetricsRegistry::instance().add(&block); }
+    ~RegisteredThreadMetrics() { MetricsRegistry::instance().retire(&block); }
+
+    RegisteredThreadMetrics(const RegisteredThreadMetrics&) = delete;
+    RegisteredThreadMetrics& operator=(const RegisteredThreadMetrics&) = delete;
+};
+
+// ============================================================================
+// Prometheus Export
+// ============================================================================
+
+/// Histogram boundaries: every factor of four from 2^4 ns (16 ns) to 2^32 ns (about 4.3 s)
+constexpr unsigned kFirstBoundaryExponent = 4;
+constexpr unsigned kLastBoundaryExponent = 32;
+constexpr unsigned kBoundaryExponentStep = 2;
+
+/// Recorded values below 2^exponent ns (power-of-two bucket boundaries are exact)
+std::uint64_t countBelow(const LatencyHistogram& histogram, unsigned exponent) {
+    const std::size_t end = LatencyHistogram::bucketIndex(std::uint64_t{1} << exponent);
+    std::uint64_t total = 0;
+    for (std::size_t b = 0; b < end; ++b) {
+        total += histogram.buckets[b];
+    }
+    return total;
+}
+
+} // namespace
+
+namespace detail {
+
+ThreadMetrics& threadMetrics() {
+    thread_local RegisteredThreadMetrics metrics;
+    return metrics.block;
+}
+
+} // namespace detail
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+std::uint64_t LatencyHistogram::percentile(double quantile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const double clamped = std::clamp(quantile, 0.0, 1.0);
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kBucketCount; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return bucketUpperBound(b);
+        }
+    }
+    return max();
+}
+
+std::uint64_t LatencyHistogram::max() const {
+    for (std::size_t b = kBucketCount; b-- > 0;) {
+        if (buckets[b] != 0) {
+            return bucketUpperBound(b);
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// MetricsSnapshot
+// ============================================================================
+
+std::string MetricsSnapshot::toPrometheus() const {
+    fmt::memory_buffer out;
+    auto it = std::back_inserter(out);
+
+    it = fmt::format_to(it,
+        "# HELP mathengine_operations_total Calculator operations performed.\n"
+        "# TYPE mathengine_operations_total counter\n");
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+        it = fmt::format_to(it, "mathengine_operations_total{{op=\"{}\"}} {}\n",
+                            toString(static_cast<Operation>(op)), operations[op].calls);
+    }
+
+    it = fmt::format_to(it,
+        "# HELP mathengine_operation_elements_total Values produced by Calculator operations.\n"
+        "# TYPE mathengine_operation_elements_total counter\n");
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+        it = fmt::format_to(it, "mathengine_operation_elements_total{{op=\"{}\"}} {}\n",
+                            toString(static_cast<Operation>(op)), operations[op].elements);
+    }
+
+    it = fmt::format_to(it,
+        "# HELP mathengine_events_total Division-by-zero, negative-exponent and memo cache events.\n"
+        "# TYPE mathengine_events_total counter\n");
+    for (std::size_t e = 0; e < kMetricEventCount; ++e) {
+        it = fmt::format_to(it, "mathengine_events_total{{event=\"{}\"}} {}\n",
+                            toString(static_cast<MetricEvent>(e)), events[e]);
+    }
+
+    it = fmt::format_to(it,
+        "# HELP mathengine_operation_latency_seconds Latency of sampled Calculator operations.\n"
+        "# TYPE mathengine_operation_latency_seconds histogram\n");
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+        const std::string_view name = toString(static_cast<Operation>(op));
+        const LatencyHistogram& latency = operations[op].latency;
+        for (unsigned exponent = kFirstBoundaryExponent; exponent <= kLastBoundaryExponent;
+             exponent += kBoundaryExponentStep) {
+            it = fmt::format_to(it,
+                "mathengine_operation_latency_seconds_bucket{{op=\"{}\",le=\"{}\"}} {}\n",
+                name, static_cast<double>(std::uint64_t{1} << exponent) * 1e-9,
+                countBelow(latency, exponent));
+        }
+        it = fmt::format_to(it,
+            "mathengine_operation_latency_seconds_bucket{{op=\"{}\",le=\"+Inf\"}} {}\n"
+            "mathengine_operation_latency_seconds_sum{{op=\"{}\"}} {}\n"
+            "mathengine_operation_latency_seconds_count{{op=\"{}\"}} {}\n",
+            name, latency.count, name, static_cast<double>(latency.sumNs) * 1e-9,
+            name, latency.count);
+    }
+
+    return fmt::to_string(out);
+}
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+void Metrics::setEnabled(bool enabled) {
+    detail::metricsEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Metrics::isEnabled() {
+    return kCompiledIn && detail::metricsEnabled.load(std::memory_order_relaxed);
+}
+
+void Metrics::setLatencySampleRate(std::uint32_t everyN) {
+    detail::latencySampleRate.store(everyN, std::memory_order_relaxed);
+}
+
+std::uint32_t Metrics::latencySampleRate() {
+    return detail::latencySampleRate.load(std::memory_order_relaxed);
+}
+
+MetricsSnapshot Metrics::snapshot() {
+    return MetricsRegistry::instance().snapshot();
+}
+
+void Metrics::reset() {
+    MetricsRegistry::instance().reset();
+}
+
+} // namespace MathEngine
@@ -0,0 +1,196 @@
+#include "math/operand_store.hpp"
+#include "math/calculator.hpp"
+#include "logger/logger.hpp"
+#include "instrumentation.hpp"
+#include "parallel.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace MathEngine {
+
+// ============================================================================
+// OperandStore
+// ============================================================================
+
+OperandStore::~OperandStore() {
+    clear();
+    for (Block* block : freeBlocks_) {
+        resource_->deallocate(block, sizeof(Block), alignof(Block));
+    }
+}
+
+void OperandStore::append(std::span<const BatchOp> ops, std::span<const double> a,
+                          std::span<const double> b) {
+    if (a.size() != b.size() || (ops.size() != 1 && ops.size() != a.size())) {
+        throw std::invalid_argument("OperandStore: operation and operand columns differ in size");
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        push(ops.size() == 1 ? ops[0] : ops[i], a[i], b[i]);
+    }
+}
+
+void OperandStore::clear() {
+    for (Group& group : groups_) {
+        freeBlocks_.insert(freeBlocks_.end(), group.blocks.begin(), group.blocks.end());
+    }
+    groups_.clear();
+    groupIndex_.fill(kNoGroup);
+    powerGroups_.clear();
+    mixedPowerGroup_ = kNoGroup;
+    size_ = 0;
+}
+
+OperandStore::Group& OperandStore::powerGroup(double exponent) {
+    if (std::trunc(exponent) != exponent ||
+        exponent < static_cast<double>(std::numeric_limits<std::int32_t>::min()) ||
+        exponent > static_cast<double>(std::numeric_limits<std::int32_t>::max())) {
+        throw std::invalid_argument("power exponent must be a 32-bit integer");
+    }
+    const auto exp = static_cast<std::int32_t>(exponent);
+
+    // Runs of one exponent are common, so try the last power group first
+    std::size_t& last = groupIndex_[static_cast<std::size_t>(BatchOp::Power)];
+    if (last != kNoGroup && groups_[last].exponent == exp && !groups_[last].mixedExponents) {
+        return groups_[last];
+    }
+    if (const auto it = powerGroups_.find(exp); it != powerGroups_.end()) {
+        last = it->second;
+    } else if (powerGroups_.size() < kMaxPowerGroups) {
+        last = addGroup(BatchOp::Power, exp);
+        powerGroups_.emplace(exp, last);
+    } else {
+        if (mixedPowerGroup_ == kNoGroup) {
+            mixedPowerGroup_ = addGroup(BatchOp::Power, 0);
+            groups_[mixedPowerGroup_].mixedExponents = true;
+        }
+        last = mixedPowerGroup_;
+    }
+    return groups_[last];
+}
+
+std::size_t OperandStore::addGroup(BatchOp op, std::int32_t exponent) {
+    groups_.push_back({op, exponent, false, 0, {}, nullptr});
+    return groups_.size() - 1;
+}
+
+OperandStore::Block* OperandStore::addBlock(Group& group) {
+    Block* block = nullptr;
+    if (freeBlocks_.empty()) {
+        block = static_cast<Block*>(resource_->allocate(sizeof(Block), alignof(Block)));
+    } else {
+        block = freeBlocks_.back();
+        freeBlocks_.pop_back();
+    }
+    block->size = 0;
+    group.blocks.push_back(block);
+    group.tail = block;
+    return block;
+}
+
+void OperandStore::throwFull() {
+    throw std::length_error("OperandStore: more than 2^32 - 1 records");
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+// Groups run one after another, each counted as its batch operation; the
+// blocks of a group are split over the global Executor when it is large.
+// Every block is computed into a tile on the stack and scattered from
+// there, so each record's operands and result are touched once.
+// ============================================================================
+
+namespace {
+
+constexpr Operation batchOperation(BatchOp op) {
+    switch (op) {
+        case BatchOp::Add:      return Operation::BatchAdd;
+        case BatchOp::Subtract: return Operation::BatchSubtract;
+        case BatchOp::Multiply: return Operation::BatchMultiply;
+        case BatchOp::Divide:   return Operation::BatchDivide;
+        case BatchOp::Power:    return Operation::BatchPower;
+    }
+    return Operation::BatchAdd;
+}
+
+bool hasNegativeExponent(const OperandStore::Group& group) {
+    if (!group.mixedExponents) {
+        return group.exponent < 0;
+    }
+    return std::any_of(group.blocks.begin(), group.blocks.end(), [](const OperandStore::Block* block) {
+        return std::any_of(block->b, block->b + block->size, [](double exponent) { return exponent < 0.0; });
+    });
+}
+
+} // namespace
+
+Calculator::BatchStatus Calculator::evaluate(const OperandStore& operations,
+                                             std::span<ResultType> out) {
+    if (operations.size() != out.size()) {
+        throw std::invalid_argument("Batch operands and output must have the same size");
+    }
+    MATHENGINE_LOG_INFO("Batch operand store: {} records in {} groups ({})", operations.size(),
+                        operations.groups().size(), detail::kernels().name);
+
+    const detail::ElementKernels<ResultType>& kernels = detail::kernels().f64;
+    detail::SharedBatchStatus shared;
+    for (const OperandStore::Group& group : operations.groups()) {
+        detail::OperationScope scope(batchOperation(group.op), group.size);
+        if (group.op == BatchOp::Power && hasNegativeExponent(group)) {
+            detail::recordEvent(MetricEvent::NegativeExponent);
+        }
+
+        const std::span<OperandStore::Block* const> blocks(group.blocks);
+        detail::parallelRange(blocks.size(), detail::kBatchGrain / OperandStore::kBlockSize,
+                              [&](std::size_t begin, std::size_t end) {
+            alignas(64) ResultType results[OperandStore::kBlockSize];
+            for (std::size_t k = begin; k < end; ++k) {
+                const OperandStore::Block& block = *blocks[k];
+                const std::size_t n = block.size;
+                switch (group.op) {
+                    case BatchOp::Add:      kernels.add(block.a, block.b, results, n); break;
+                    case BatchOp::Subtract: kernels.subtract(block.a, block.b, results, n); break;
+                    case BatchOp::Multiply: kernels.multiply(block.a, block.b, results, n); break;
+                    case BatchOp::Divide: {
+                        // Positions ascend within a block, so its first error is its lowest
+                        std::size_t first = BatchStatus::npos;
+                        const std::size_t errors = kernels.divide(block.a, block.b, results, n, &first);
+                        if (errors != 0) {
+                            shared.add(errors, block.position[first]);
+                        }
+                        break;
+                    }
+                    case BatchOp::Power:
+                        if (!group.mixedExponents) {
+                            kernels.power(block.a, group.exponent, results, n);
+                            break;
+                        }
+                        for (std::size_t i = 0; i < n; ++i) {
+                            kernels.power(block.a + i, static_cast<std::int32_t>(block.b[i]), results + i, 1);
+                        }
+                        break;
+                }
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[block.position[i]] = results[i];
+                }
+            }
+        });
+    }
+
+    const BatchStatus status = shared.get();
+    detail::recordEvent(MetricEvent::DivisionByZero, status.errorCount);
+    if (!status.ok()) {
+        MATHENGINE_LOG_ERROR("Batch operand store: {} zero denominators (first at index {})",
+                             status.errorCount, status.firstError);
+    }
+    if (!out.empty()) {
+        storeLastResult(out.back());
+    }
+    return status;
+}
+
+} // namespace MathEngine
@@ -0,0 +1,63 @@
+#ifndef MATH_PARALLEL_HPP
+#define MATH_PARALLEL_HPP
+
+#include "math/calculator.hpp"
+#include "math/executor.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace MathEngine::detail {
+
+/// Elements per task for element-wise batch work (about 256 KiB of doubles)
+inline constexpr std::size_t kBatchGrain = std::size_t{1} << 15;
+
+/**
+ * @brief body(begin, end) over [0, n): on the global Executor when one is
+ *        installed and n spans at least two grains, inline otherwise
+ */
+template <typename Body>
+void parallelRange(std::size_t n, std::size_t grain, Body&& body) {
+    Executor* executor = Executor::global();
+    if (executor == nullptr || executor->concurrency() < 2 || n < 2 * grain) {
+        if (n != 0) {
+            body(std::size_t{0}, n);
+        }
+        return;
+    }
+    executor->parallelFor(n, grain, body);
+}
+
+/**
+ * @brief BatchStatus that concurrent sub-ranges can report into
+ */
+class SharedBatchStatus {
+public:
+    /// Record errors of a sub-range; @p firstError is an absolute index
+    void add(std::size_t errorCount, std::size_t firstError) {
+        if (errorCount == 0) {
+            return;
+        }
+        errorCount_.fetch_add(errorCount, std::memory_order_relaxed);
+        std::size_t current = firstError_.load(std::memory_order_relaxed);
+        while (firstError < current &&
+               !firstError_.compare_exchange_weak(current, firstError, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// Read once the parallel work has finished
+    Calculator::BatchStatus get() const {
+        Calculator::BatchStatus status;
+        status.errorCount = errorCount_.load(std::memory_order_relaxed);
+        status.firstError = firstError_.load(std::memory_order_relaxed);
+        return status;
+    }
+
+private:
+    std::atomic<std::size_t> errorCount_{0};
+    std::atomic<std::size_t> firstError_{Calculator::BatchStatus::npos};
+};
+
+} // namespace MathEngine::detail
+
+#endif // MATH_PARALLEL_HPP
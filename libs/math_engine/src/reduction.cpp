@@ -0,0 +1,381 @@
+#include "math/reduction.hpp"
+#include "math/scratch_arena.hpp"
+#include "logger/logger.hpp"
+#include "parallel.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MathEngine {
+
+namespace {
+
+const char* modeName(ReductionMode mode) {
+    return mode == ReductionMode::Deterministic ? "deterministic" : "fast";
+}
+
+std::size_t threadCount(std::size_t n, const ReductionOptions& options) {
+    const Executor* executor = Executor::global();
+    std::size_t limit = executor != nullptr ? executor->concurrency() : 1;
+    if (options.maxThreads != 0) {
+        limit = std::min(limit, options.maxThreads);
+    }
+    return std::clamp<std::size_t>(n / Reduction::kMinElementsPerThread, 1, limit);
+}
+
+/**
+ * @brief Runs task(i) for every i in [0, tasks) as at most @p threads
+ *        parallel pieces on the global Executor
+ */
+template <typename Task>
+void runParallel(std::size_t tasks, std::size_t threads, Task task) {
+    const std::size_t grain = (tasks + threads - 1) / threads;
+    detail::parallelRange(tasks, grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            task(i);
+        }
+    });
+}
+
+/**
+ * @brief Combine values[0, count) pairwise in a fixed order; count > 0
+ */
+template <typename A, typename Op>
+A combinePairwise(A* values, std::size_t count, Op op) {
+    for (std::size_t stride = 1; stride < count; stride *= 2) {
+        for (std::size_t i = 0; i + stride < count; i += 2 * stride) {
+            values[i] = op(values[i], values[i + stride]);
+        }
+    }
+    return values[0];
+}
+
+template <typename T>
+void logReduction(const char* name, std::size_t n, const ReductionOptions& options) {
+    MATHENGINE_LOG_INFO("Reduce {}: {} {} elements ({}, {}, {} threads)", name, n,
+                        detail::kElementName<T>, modeName(options.mode), detail::kernels().name,
+                        threadCount(n, options));
+}
+
+/**
+ * @brief Shared driver for all reductions
+ * @param deterministic Kernel reducing [begin, begin + count) in fixed lanes
+ * @param fast Kernel reducing [begin, begin + count) in any order
+ * @param op Combines two partial results
+ */
+template <typename A, typename DeterministicKernel, typename FastKernel, typename Op>
+A reduce(std::size_t n, A identity, const ReductionOptions& options,
+         DeterministicKernel deterministic, FastKernel fast, Op op) {
+    const std::size_t threads = threadCount(n, options);
+
+    std::optional<ScratchScope> scope;
+    std::pmr::memory_resource* scratch = options.scratch;
+    if (scratch == nullptr) {
+        scratch = &scope.emplace().arena();
+    }
+
+    if (options.mode == ReductionMode::Deterministic) {
+        // Block boundaries depend on n only, never on the thread count
+        constexpr std::size_t block = Reduction::kBlockSize;
+        const std::size_t blocks = (n + block - 1) / block;
+        if (blocks == 0) {
+            return identity;
+        }
+
+        std::pmr::vector<A> partials(blocks, scratch);
+        runParallel(blocks, threads, [&](std::size_t b) {
+            const std::size_t begin = b * block;
+            partials[b] = deterministic(begin, std::min(block, n - begin));
+        });
+
+        return combinePairwise(partials.data(), blocks, op);
+    }
+
+    std::pmr::vector<A> partials(threads, scratch);
+    runParallel(threads, threads, [&](std::size_t t) {
+        const std::size_t begin = n * t / threads;
+        partials[t] = fast(begin, n * (t + 1) / threads - begin);
+    });
+
+    A result = identity;
+    for (A partial : partials) {
+        result = op(result, partial);
+    }
+    return result;
+}
+
+/**
+ * @brief kernel(x, y, count) over a slice, in its compute type
+ *
+ * Floating-point slices are passed straight through. 16-bit slices are
+ * widened into float tiles whose results are combined pairwise when
+ * @p pairwise (a deterministic block, at most kBlockSize long) and in order
+ * otherwise. @p b may be nullptr for single-input reductions.
+ */
+template <typename T, typename Kernel, typename Op>
+detail::ComputeType<T> reduceSlice(const T* a, const T* b, std::size_t count,
+                                   detail::ComputeType<T> identity, bool pairwise,
+                                   Kernel kernel, Op op) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return kernel(a, b, count);
+    } else {
+        constexpr std::size_t kMaxTiles = Reduction::kBlockSize / detail::kConvertTile;
+        float tileA[detail::kConvertTile];
+        float tileB[detail::kConvertTile];
+        float partials[kMaxTiles];
+        std::size_t tiles = 0;
+        float result = identity;
+
+        for (std::size_t i = 0; i < count; i += detail::kConvertTile) {
+            const std::size_t n = std::min(detail::kConvertTile, count - i);
+            detail::widen(a + i, tileA, n);
+            if (b != nullptr) {
+                detail::widen(b + i, tileB, n);
+            }
+            const float partial = kernel(tileA, b != nullptr ? tileB : nullptr, n);
+            if (pairwise) {
+                partials[tiles++] = partial;
+            } else {
+                result = op(result, partial);
+            }
+        }
+        if (!pairwise) {
+            return result;
+        }
+        return tiles == 0 ? identity : combinePairwise(partials, tiles, op);
+    }
+}
+
+/**
+ * @brief A reduction over one or two inputs of any element type
+ * @param select Picks the {deterministic, fast} kernels out of ElementKernels
+ */
+template <typename T, typename Select, typename Op>
+detail::ComputeType<T> reduceValues(const char* name, const T* a, const T* b, std::size_t n,
+                                    detail::ComputeType<T> identity,
+                                    const ReductionOptions& options, Select select, Op op) {
+    logReduction<T>(name, n, options);
+    const auto kernels = select(detail::elementKernels<detail::ComputeType<T>>());
+    return reduce(n, identity, options,
+                  [&](std::size_t begin, std::size_t count) {
+                      return reduceSlice(a + begin, b != nullptr ? b + begin : nullptr, count,
+                                         identity, true, kernels.first, op);
+                  },
+                  [&](std::size_t begin, std::size_t count) {
+                      return reduceSlice(a + begin, b != nullptr ? b + begin : nullptr, count,
+                                         identity, false, kernels.second, op);
+                  },
+                  op);
+}
+
+template <typename T>
+void requireNonEmpty(std::span<const T> values) {
+    if (values.empty()) {
+        throw std::invalid_argument("Cannot reduce an empty span");
+    }
+}
+
+/// Single-input kernels take the second pointer too, and ignore it
+template <typename K>
+auto unary(K kernel) {
+    return [kernel](const auto* x, const auto*, std::size_t n) { return kernel(x, n); };
+}
+
+template <typename T>
+detail::ComputeType<T> sumOf(std::span<const T> values, const ReductionOptions& options) {
+    return reduceValues("sum", values.data(), static_cast<const T*>(nullptr), values.size(),
+                        detail::ComputeType<T>{0}, options,
+                        [](const auto& k) { return std::pair(unary(k.sum), unary(k.sumFast)); },
+                        [](auto x, auto y) { return x + y; });
+}
+
+template <typename T>
+detail::ComputeType<T> productOf(std::span<const T> values, const ReductionOptions& options) {
+    return reduceValues("product", values.data(), static_cast<const T*>(nullptr), values.size(),
+                        detail::ComputeType<T>{1}, options,
+                        [](const auto& k) { return std::pair(unary(k.product), unary(k.productFast)); },
+                        [](auto x, auto y) { return x * y; });
+}
+
+template <typename T>
+detail::ComputeType<T> dotOf(std::span<const T> a, std::span<const T> b,
+                             const ReductionOptions& options) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("Dot product operands must have the same size");
+    }
+    return reduceValues("dot", a.data(), b.data(), a.size(), detail::ComputeType<T>{0}, options,
+                        [](const auto& k) { return std::pair(k.dot, k.dotFast); },
+                        [](auto x, auto y) { return x + y; });
+}
+
+/// Minimum or maximum by @p minimum, skipping NaN (NaN if all are)
+template <typename T>
+detail::ComputeType<T> extremeOf(const char* name, std::span<const T> values,
+                                 const ReductionOptions& options, bool minimum) {
+    using A = detail::ComputeType<T>;
+    requireNonEmpty(values);
+    constexpr A inf = std::numeric_limits<A>::infinity();
+    const A identity = minimum ? inf : -inf;
+
+    const A result = minimum
+        ? reduceValues(name, values.data(), static_cast<const T*>(nullptr), values.size(), identity,
+                       options, [](const auto& k) { return std::pair(unary(k.min), unary(k.min)); },
+                       [](A x, A y) { return std::min(x, y); })
+        : reduceValues(name, values.data(), static_cast<const T*>(nullptr), values.size(), identity,
+                       options, [](const auto& k) { return std::pair(unary(k.max), unary(k.max)); },
+                       [](A x, A y) { return std::max(x, y); });
+
+    // The accumulator starts at +/-infinity, so only an all-NaN input keeps it
+    if (result == identity &&
+        std::none_of(values.begin(), values.end(),
+                     [&](T value) { return static_cast<A>(value) == identity; })) {
+        return std::numeric_limits<A>::quiet_NaN();
+    }
+    return result;
+}
+
+const char* opName(ReductionOp op) {
+    switch (op) {
+        case ReductionOp::Sum: return "sum";
+        case ReductionOp::Product: return "product";
+        case ReductionOp::Min: return "min";
+        case ReductionOp::Max: return "max";
+    }
+    return "unknown";
+}
+
+/// min / max that skip NaN, so an all-NaN block only wins against another
+template <typename A, typename Pick>
+A pickSkippingNaN(A x, A y, Pick pick) {
+    if (std::isnan(x)) {
+        return y;
+    }
+    return std::isnan(y) ? x : pick(x, y);
+}
+
+} // namespace
+
+// ============================================================================
+// double
+// ============================================================================
+
+Reduction::ResultType Reduction::sum(std::span<const ResultType> values,
+                                     const ReductionOptions& options) {
+    return sumOf(values, options);
+}
+
+Reduction::ResultType Reduction::product(std::span<const ResultType> values,
+                                         const ReductionOptions& options) {
+    return productOf(values, options);
+}
+
+Reduction::ResultType Reduction::dot(std::span<const ResultType> a, std::span<const ResultType> b,
+                                     const ReductionOptions& options) {
+    return dotOf(a, b, options);
+}
+
+Reduction::ResultType Reduction::min(std::span<const ResultType> values,
+                                     const ReductionOptions& options) {
+    return extremeOf("min", values, options, true);
+}
+
+Reduction::ResultType Reduction::max(std::span<const ResultType> values,
+                                     const ReductionOptions& options) {
+    return extremeOf("max", values, options, false);
+}
+
+void Reduction::partials(ReductionOp op, std::span<const ResultType> values, std::span<ResultType> out,
+                         const ReductionOptions& options) {
+    if (out.size() != blockCount(values.size())) {
+        throw std::invalid_argument("One partial per block expected");
+    }
+    ReductionOptions deterministic = options;
+    deterministic.mode = ReductionMode::Deterministic;
+    MATHENGINE_LOG_INFO("Reduce {} partials: {} double elements ({} blocks, {}, {} threads)", opName(op),
+                        values.size(), out.size(), detail::kernels().name,
+                        threadCount(values.size(), deterministic));
+
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    const auto& kernels = detail::elementKernels<double>();
+    runParallel(out.size(), threadCount(values.size(), deterministic), [&](std::size_t b) {
+        const std::span<const double> block =
+            values.subspan(b * kBlockSize, std::min(kBlockSize, values.size() - b * kBlockSize));
+        switch (op) {
+            case ReductionOp::Sum: out[b] = kernels.sum(block.data(), block.size()); break;
+            case ReductionOp::Product: out[b] = kernels.product(block.data(), block.size()); break;
+            case ReductionOp::Min:
+            case ReductionOp::Max: {
+                const bool minimum = op == ReductionOp::Min;
+                const double identity = minimum ? inf : -inf;
+                const double result = (minimum ? kernels.min : kernels.max)(block.data(), block.size());
+                // As in extremeOf: only an all-NaN block keeps the identity
+                const bool allNaN = result == identity &&
+                                    std::find(block.begin(), block.end(), identity) == block.end();
+                out[b] = allNaN ? std::numeric_limits<double>::quiet_NaN() : result;
+                break;
+            }
+        }
+    });
+}
+
+Reduction::ResultType Reduction::combine(ReductionOp op, std::span<ResultType> partials) {
+    switch (op) {
+        case ReductionOp::Sum:
+            return partials.empty() ? 0.0
+                                    : combinePairwise(partials.data(), partials.size(),
+                                                      [](double x, double y) { return x + y; });
+        case ReductionOp::Product:
+            return partials.empty() ? 1.0
+                                    : combinePairwise(partials.data(), partials.size(),
+                                                      [](double x, double y) { return x * y; });
+        case ReductionOp::Min:
+        case ReductionOp::Max:
+            break;
+    }
+    requireNonEmpty(std::span<const ResultType>(partials));
+    if (op == ReductionOp::Min) {
+        return combinePairwise(partials.data(), partials.size(), [](double x, double y) {
+            return pickSkippingNaN(x, y, [](double a, double b) { return std::min(a, b); });
+        });
+    }
+    return combinePairwise(partials.data(), partials.size(), [](double x, double y) {
+        return pickSkippingNaN(x, y, [](double a, double b) { return std::max(a, b); });
+    });
+}
+
+// ============================================================================
+// float, Float16 and BFloat16 (accumulated in float)
+// ============================================================================
+
+#define MATHENGINE_DEFINE_REDUCTIONS(T)                                                             \
+    float Reduction::sum(std::span<const T> values, const ReductionOptions& options) {             \
+        return sumOf(values, options);                                                              \
+    }                                                                                               \
+    float Reduction::product(std::span<const T> values, const ReductionOptions& options) {         \
+        return productOf(values, options);                                                          \
+    }                                                                                               \
+    float Reduction::dot(std::span<const T> a, std::span<const T> b,                               \
+                         const ReductionOptions& options) {                                         \
+        return dotOf(a, b, options);                                                                \
+    }                                                                                               \
+    float Reduction::min(std::span<const T> values, const ReductionOptions& options) {             \
+        return extremeOf("min", values, options, true);                                             \
+    }                                                                                               \
+    float Reduction::max(std::span<const T> values, const ReductionOptions& options) {             \
+        return extremeOf("max", values, options, false);                                            \
+    }
+
+MATHENGINE_DEFINE_REDUCTIONS(float)
+MATHENGINE_DEFINE_REDUCTIONS(Float16)
+MATHENGINE_DEFINE_REDUCTIONS(BFloat16)
+
+#undef MATHENGINE_DEFINE_REDUCTIONS
+
+} // namespace MathEngine
@@ -0,0 +1,69 @@
+#include "math/scratch_arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace MathEngine {
+
+namespace {
+
+constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+} // namespace
+
+ScratchArena::ScratchArena(std::size_t firstBlockSize, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), nextBlockSize_(std::max<std::size_t>(firstBlockSize, 256)) {}
+
+ScratchArena::~ScratchArena() {
+    for (const Block& block : blocks_) {
+        upstream_->deallocate(block.data, block.size, kBlockAlignment);
+    }
+}
+
+void ScratchArena::rewind(Mark mark) noexcept {
+    block_ = mark.block;
+    offset_ = mark.offset;
+}
+
+std::size_t ScratchArena::capacity() const {
+    std::size_t total = 0;
+    for (const Block& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+ScratchArena& ScratchArena::local() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+void* ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // Reuse blocks kept from before the last rewind, then grow
+    for (;; ++block_, offset_ = 0) {
+        if (block_ == blocks_.size()) {
+            const std::size_t size = std::max(nextBlockSize_, bytes + alignment);
+            blocks_.push_back({static_cast<std::byte*>(upstream_->allocate(size, kBlockAlignment)), size});
+            nextBlockSize_ = size * 2;
+        }
+
+        const Block& block = blocks_[block_];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data);
+        const auto aligned = (base + offset_ + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+        const std::size_t start = static_cast<std::size_t>(aligned - base);
+        if (start <= block.size && bytes <= block.size - start) {
+            offset_ = start + bytes;
+            return block.data + start;
+        }
+    }
+}
+
+void ScratchArena::do_deallocate(void*, std::size_t, std::size_t) {
+    // Memory is released in bulk by rewind()
+}
+
+bool ScratchArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace MathEngine
@@ -0,0 +1,200 @@
+#ifndef MATH_SIMD_BATCH_KERNELS_HPP
+#define MATH_SIMD_BATCH_KERNELS_HPP
+
+#include "math/fixed_calculator.hpp"
+#include "math/float16.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace MathEngine::detail {
+
+/**
+ * @brief Kernels of one instruction-set tier for one element type
+ *
+ * Outputs may alias an input exactly (in-place), but not partially.
+ */
+template <typename T>
+struct ElementKernels {
+    using Binary = void (*)(const T* a, const T* b, T* out, std::size_t n);
+    using BinaryScalar = void (*)(const T* a, T b, T* out, std::size_t n);
+
+    /**
+     * @brief Division that flags denominators below the zero threshold
+     * @return Number of flagged elements (their output is quiet NaN)
+     */
+    using CheckedDivide = std::size_t (*)(const T* a, const T* b, T* out,
+                                          std::size_t n, std::size_t* firstError);
+
+    /// Exponentiation by squaring with one shared integer exponent
+    using IntegerPower = void (*)(const T* base, std::int32_t exp, T* out, std::size_t n);
+
+    using Reduce = T (*)(const T* a, std::size_t n);
+    using Dot = T (*)(const T* a, const T* b, std::size_t n);
+
+    Binary add;
+    Binary subtract;
+    Binary multiply;
+    CheckedDivide divide;
+
+    BinaryScalar addScalar;
+    BinaryScalar subtractScalar;
+    BinaryScalar multiplyScalar;
+    BinaryScalar divideScalar;  ///< Caller has already rejected a zero divisor
+
+    IntegerPower power;
+
+    // Reductions. The plain ones accumulate into kReductionLanes<T> fixed
+    // lanes combined pairwise, so every tier returns bit-identical results;
+    // the *Fast ones use as many accumulators as suit the tier.
+    Reduce sum;
+    Reduce sumFast;
+    Reduce product;
+    Reduce productFast;
+    Dot dot;
+    Dot dotFast;
+    Reduce min;  ///< NaN elements are skipped; +infinity when all are NaN
+    Reduce max;  ///< NaN elements are skipped; -infinity when all are NaN
+};
+
+/**
+ * @brief Fixed-point kernels of one tier for one raw integer type
+ *
+ * Each element is computed by FixedArithmetic, exactly as the scalar
+ * FixedCalculator operations do. Results out of range saturate; overflow[i]
+ * is set to 1 for those (and for zero divisors), 0 otherwise, and the
+ * number of ones is returned.
+ */
+template <typename R>
+struct FixedKernels {
+    using Binary = std::size_t (*)(const R* a, const R* b, R* out, std::size_t n,
+                                   std::uint8_t* overflow);
+    using BinaryScalar = std::size_t (*)(const R* a, R b, R* out, std::size_t n,
+                                         std::uint8_t* overflow);
+    using Scaled = std::size_t (*)(const R* a, const R* b, R* out, std::size_t n,
+                                   const Reciprocal& scale, std::uint8_t* overflow);
+    using ScaledScalar = std::size_t (*)(const R* a, R b, R* out, std::size_t n,
+                                         const Reciprocal& scale, std::uint8_t* overflow);
+
+    /// Division by one non-zero divisor, given as the reciprocal of its magnitude
+    using DivideScalar = std::size_t (*)(const R* a, const Reciprocal& divisor, bool negative,
+                                         R* out, std::size_t n, const Reciprocal& scale,
+                                         std::uint8_t* overflow);
+
+    Binary add;
+    Binary subtract;
+    BinaryScalar addScalar;
+    BinaryScalar subtractScalar;
+    Scaled multiply;
+    ScaledScalar multiplyScalar;
+    Scaled divide;  ///< Zero divisors saturate by the sign of a (0 for 0/0)
+    DivideScalar divideScalar;
+};
+
+/**
+ * @brief Function table for one instruction-set tier of the batch kernels
+ *
+ * Each tier lives in its own translation unit compiled with the matching
+ * target flags; dispatch.cpp picks one table once, when the library is loaded.
+ */
+struct KernelTable {
+    /// 16-bit storage formats are computed in float (round to nearest even)
+    using WidenFloat16 = void (*)(const Float16* in, float* out, std::size_t n);
+    using NarrowFloat16 = void (*)(const float* in, Float16* out, std::size_t n);
+    using WidenBFloat16 = void (*)(const BFloat16* in, float* out, std::size_t n);
+    using NarrowBFloat16 = void (*)(const float* in, BFloat16* out, std::size_t n);
+
+    const char* name;
+
+    ElementKernels<double> f64;
+    ElementKernels<float> f32;
+
+    WidenFloat16 widenFloat16;
+    NarrowFloat16 narrowFloat16;
+    WidenBFloat16 widenBFloat16;
+    NarrowBFloat16 narrowBFloat16;
+
+    FixedKernels<std::int32_t> fixed32;
+#if MATHENGINE_FIXED_INT128
+    FixedKernels<std::int64_t> fixed64;
+#endif
+};
+
+/// Lane count of the deterministic reductions: one cache line of T, a
+/// multiple of every tier width
+template <typename T>
+inline constexpr std::size_t kReductionLanes = 64 / sizeof(T);
+
+// Tables provided by the tier translation units (only those built for the target)
+const KernelTable& scalarKernelTable();
+#if defined(MATHENGINE_SIMD_X86)
+const KernelTable& sse2KernelTable();
+const KernelTable& avx2KernelTable();
+const KernelTable& avx512KernelTable();
+#endif
+#if defined(MATHENGINE_SIMD_NEON)
+const KernelTable& neonKernelTable();
+#endif
+
+/**
+ * @brief Kernel table of the selected tier (see KernelDispatch)
+ */
+const KernelTable& kernels();
+
+/**
+ * @brief The selected tier's kernels for element type T (float or double)
+ */
+template <typename T>
+const ElementKernels<T>& elementKernels() {
+    if constexpr (std::is_same_v<T, float>) {
+        return kernels().f32;
+    } else {
+        return kernels().f64;
+    }
+}
+
+// ============================================================================
+// Element Types
+// ============================================================================
+// double and float run their own kernels. The 16-bit storage formats are
+// widened into float tiles of kConvertTile elements, computed with the float
+// kernels and, for element-wise results, rounded back once.
+// ============================================================================
+
+/// Type a batch of T is computed (and reduced) in
+template <typename T>
+using ComputeType = std::conditional_t<std::is_same_v<T, double>, double, float>;
+
+template <typename T>
+inline constexpr std::string_view kElementName = "double";
+template <>
+inline constexpr std::string_view kElementName<float> = "float";
+template <>
+inline constexpr std::string_view kElementName<Float16> = "float16";
+template <>
+inline constexpr std::string_view kElementName<BFloat16> = "bfloat16";
+
+/// 16-bit elements converted at a time (a few float tiles fit on the stack)
+inline constexpr std::size_t kConvertTile = 512;
+
+inline void widen(const Float16* in, float* out, std::size_t n) {
+    kernels().widenFloat16(in, out, n);
+}
+
+inline void widen(const BFloat16* in, float* out, std::size_t n) {
+    kernels().widenBFloat16(in, out, n);
+}
+
+inline void narrow(const float* in, Float16* out, std::size_t n) {
+    kernels().narrowFloat16(in, out, n);
+}
+
+inline void narrow(const float* in, BFloat16* out, std::size_t n) {
+    kernels().narrowBFloat16(in, out, n);
+}
+
+} // namespace MathEngine::detail
+
+#endif // MATH_SIMD_BATCH_KERNELS_HPP
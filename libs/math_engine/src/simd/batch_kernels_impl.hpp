@@ -0,0 +1,509 @@
+#ifndef MATH_SIMD_BATCH_KERNELS_IMPL_HPP
+#define MATH_SIMD_BATCH_KERNELS_IMPL_HPP
+
+#include "math/calculator.hpp"
+#include "simd/batch_kernels.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// ============================================================================
+// Shared kernel bodies, instantiated once per instruction-set tier
+// ============================================================================
+// Each tier translation unit defines a vector-traits type and includes this
+// header. Everything here has internal linkage on purpose: a tier built for
+// AVX2 must never hand the linker an out-of-line helper that a non-AVX code
+// path could end up calling.
+//
+// For the same reason a tier above the baseline is not compiled with -mavx2
+// and the like: the inline functions of the headers above (floatToHalfBits,
+// FixedArithmetic, ...) would then be emitted as VEX-encoded weak symbols,
+// and the linker may keep that copy for the whole library. Such a tier
+// instead defines MATHENGINE_KERNEL_TARGET (e.g. "avx2,fma") before including
+// this header and ends with MATHENGINE_KERNEL_TARGET_END. Only the functions
+// declared in between are compiled for the tier; the shared helpers keep the
+// baseline flags and are inlined into the kernels from there.
+// ============================================================================
+
+#define MATHENGINE_KERNEL_PRAGMA_TEXT(text) _Pragma(#text)
+#define MATHENGINE_KERNEL_PRAGMA(text) MATHENGINE_KERNEL_PRAGMA_TEXT(text)
+
+#if !defined(MATHENGINE_KERNEL_TARGET) || (defined(_MSC_VER) && !defined(__clang__))
+// Baseline tier, or MSVC: it accepts every intrinsic without /arch
+#define MATHENGINE_KERNEL_TARGET_END
+#elif defined(__clang__)
+MATHENGINE_KERNEL_PRAGMA(clang attribute push(__attribute__((target(MATHENGINE_KERNEL_TARGET))),
+                                              apply_to = function))
+#define MATHENGINE_KERNEL_TARGET_END MATHENGINE_KERNEL_PRAGMA(clang attribute pop)
+#else
+MATHENGINE_KERNEL_PRAGMA(GCC push_options)
+MATHENGINE_KERNEL_PRAGMA(GCC target(MATHENGINE_KERNEL_TARGET))
+#define MATHENGINE_KERNEL_TARGET_END MATHENGINE_KERNEL_PRAGMA(GCC pop_options)
+#endif
+
+namespace MathEngine::detail {
+namespace {
+
+constexpr std::size_t kNoError = static_cast<std::size_t>(-1);
+
+inline unsigned countMaskBits(unsigned bits) {
+    unsigned count = 0;
+    for (; bits != 0; bits &= bits - 1) {
+        ++count;
+    }
+    return count;
+}
+
+inline unsigned lowestMaskBit(unsigned bits) {
+    unsigned index = 0;
+    for (; (bits & 1u) == 0; bits >>= 1) {
+        ++index;
+    }
+    return index;
+}
+
+/**
+ * @brief Element-wise kernels written against a vector-traits type
+ *
+ * V provides: Scalar (the element type), Reg, Mask, width, load, store,
+ * set1, add, sub, mul, div, min / max (NaN in the first operand yields the
+ * second), absLess (|x| < y per lane), select (mask ? a : b) and bits (mask -> int).
+ */
+template <typename V>
+struct BatchKernels {
+    using T = typename V::Scalar;
+
+    template <typename Op, typename ScalarOp>
+    static void binary(const T* a, const T* b, T* out, std::size_t n,
+                       Op op, ScalarOp scalarOp) {
+        std::size_t i = 0;
+        for (; i + V::width <= n; i += V::width) {
+            V::store(out + i, op(V::load(a + i), V::load(b + i)));
+        }
+        for (; i < n; ++i) {
+            out[i] = scalarOp(a[i], b[i]);
+        }
+    }
+
+    template <typename Op, typename ScalarOp>
+    static void binaryScalar(const T* a, T b, T* out, std::size_t n,
+                             Op op, ScalarOp scalarOp) {
+        const auto vb = V::set1(b);
+        std::size_t i = 0;
+        for (; i + V::width <= n; i += V::width) {
+            V::store(out + i, op(V::load(a + i), vb));
+        }
+        for (; i < n; ++i) {
+            out[i] = scalarOp(a[i], b);
+        }
+    }
+
+    static void add(const T* a, const T* b, T* out, std::size_t n) {
+        binary(a, b, out, n, [](auto x, auto y) { return V::add(x, y); },
+               [](T x, T y) { return x + y; });
+    }
+
+    static void subtract(const T* a, const T* b, T* out, std::size_t n) {
+        binary(a, b, out, n, [](auto x, auto y) { return V::sub(x, y); },
+               [](T x, T y) { return x - y; });
+    }
+
+    static void multiply(const T* a, const T* b, T* out, std::size_t n) {
+        binary(a, b, out, n, [](auto x, auto y) { return V::mul(x, y); },
+               [](T x, T y) { return x * y; });
+    }
+
+    static void addScalar(const T* a, T b, T* out, std::size_t n) {
+        binaryScalar(a, b, out, n, [](auto x, auto y) { return V::add(x, y); },
+                     [](T x, T y) { return x + y; });
+    }
+
+    static void subtractScalar(const T* a, T b, T* out, std::size_t n) {
+        binaryScalar(a, b, out, n, [](auto x, auto y) { return V::sub(x, y); },
+                     [](T x, T y) { return x - y; });
+    }
+
+    static void multiplyScalar(const T* a, T b, T* out, std::size_t n) {
+        binaryScalar(a, b, out, n, [](auto x, auto y) { return V::mul(x, y); },
+                     [](T x, T y) { return x * y; });
+    }
+
+    static void divideScalar(const T* a, T b, T* out, std::size_t n) {
+        binaryScalar(a, b, out, n, [](auto x, auto y) { return V::div(x, y); },
+                     [](T x, T y) { return x / y; });
+    }
+
+    static std::size_t divide(const T* a, const T* b, T* out, std::size_t n,
+                              std::size_t* firstError) {
+        constexpr T threshold = static_cast<T>(Calculator::kZeroThreshold);
+        constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+        const auto vThreshold = V::set1(threshold);
+        const auto vNan = V::set1(nan);
+
+        std::size_t errors = 0;
+        std::size_t first = kNoError;
+
+        std::size_t i = 0;
+        for (; i + V::width <= n; i += V::width) {
+            const auto denominator = V::load(b + i);
+            const auto zero = V::absLess(denominator, vThreshold);
+            const auto quotient = V::div(V::load(a + i), denominator);
+            V::store(out + i, V::select(zero, vNan, quotient));
+
+            const unsigned bits = V::bits(zero);
+            if (bits != 0) {
+                if (first == kNoError) {
+                    first = i + lowestMaskBit(bits);
+                }
+                errors += countMaskBits(bits);
+            }
+        }
+        for (; i < n; ++i) {
+            const T denominator = b[i];
+            const bool zero = denominator < threshold && denominator > -threshold;
+            if (zero) {
+                if (first == kNoError) {
+                    first = i;
+                }
+                ++errors;
+                out[i] = nan;
+            } else {
+                out[i] = a[i] / denominator;
+            }
+        }
+
+        *firstError = first;
+        return errors;
+    }
+
+    /**
+     * @brief Same bit walk as Calculator::integerPower, one vector at a time
+     */
+    static void power(const T* base, std::int32_t exp, T* out, std::size_t n) {
+        const std::uint32_t magnitude = exp < 0
+            ? 0u - static_cast<std::uint32_t>(exp)
+            : static_cast<std::uint32_t>(exp);
+        std::uint32_t highest = 0;
+        for (std::uint32_t probe = 1; probe != 0 && probe <= magnitude; probe <<= 1) {
+            highest = probe;
+        }
+
+        const auto vOne = V::set1(T{1});
+        std::size_t i = 0;
+        for (; i + V::width <= n; i += V::width) {
+            const auto x = V::load(base + i);
+            auto result = vOne;
+            for (std::uint32_t bit = highest; bit != 0; bit >>= 1) {
+                result = V::mul(result, result);
+                if ((magnitude & bit) != 0) {
+                    result = V::mul(result, x);
+                }
+            }
+            V::store(out + i, exp < 0 ? V::div(vOne, result) : result);
+        }
+        for (; i < n; ++i) {
+            T result = 1;
+            for (std::uint32_t bit = highest; bit != 0; bit >>= 1) {
+                result *= result;
+                if ((magnitude & bit) != 0) {
+                    result *= base[i];
+                }
+            }
+            out[i] = exp < 0 ? T{1} / result : result;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Reductions
+    // ------------------------------------------------------------------------
+    // Element i always lands in lane i % kReductionLanes<T> and the lanes are
+    // combined in one fixed pairwise order, whatever the register width.
+    // ------------------------------------------------------------------------
+
+    static_assert(kReductionLanes<T> % V::width == 0, "Tier width must divide the lane count");
+
+    template <typename Load, typename ScalarLoad, typename Op, typename ScalarOp>
+    static T reduceDeterministic(std::size_t n, T identity, Load load,
+                                      ScalarLoad scalarLoad, Op op, ScalarOp scalarOp) {
+        constexpr std::size_t regs = kReductionLanes<T> / V::width;
+        typename V::Reg acc[regs];
+        for (std::size_t r = 0; r < regs; ++r) {
+            acc[r] = V::set1(identity);
+        }
+
+        std::size_t i = 0;
+        for (; i + kReductionLanes<T> <= n; i += kReductionLanes<T>) {
+            for (std::size_t r = 0; r < regs; ++r) {
+                acc[r] = op(acc[r], load(i + r * V::width));
+            }
+        }
+
+        T lanes[kReductionLanes<T>];
+        for (std::size_t r = 0; r < regs; ++r) {
+            V::store(lanes + r * V::width, acc[r]);
+        }
+        for (std::size_t lane = 0; i < n; ++i, ++lane) {
+            lanes[lane] = scalarOp(lanes[lane], scalarLoad(i));
+        }
+
+        for (std::size_t stride = 1; stride < kReductionLanes<T>; stride *= 2) {
+            for (std::size_t lane = 0; lane < kReductionLanes<T>; lane += 2 * stride) {
+                lanes[lane] = scalarOp(lanes[lane], lanes[lane + stride]);
+            }
+        }
+        return lanes[0];
+    }
+
+    template <typename Load, typename ScalarLoad, typename Op, typename ScalarOp>
+    static T reduceFast(std::size_t n, T identity, Load load,
+                             ScalarLoad scalarLoad, Op op, ScalarOp scalarOp) {
+        // Four independent chains hide the add/mul latency
+        constexpr std::size_t regs = 4;
+        typename V::Reg acc[regs];
+        for (std::size_t r = 0; r < regs; ++r) {
+            acc[r] = V::set1(identity);
+        }
+
+        std::size_t i = 0;
+        for (; i + regs * V::width <= n; i += regs * V::width) {
+            for (std::size_t r = 0; r < regs; ++r) {
+                acc[r] = op(acc[r], load(i + r * V::width));
+            }
+        }
+        for (; i + V::width <= n; i += V::width) {
+            acc[0] = op(acc[0], load(i));
+        }
+
+        const auto combined = op(op(acc[0], acc[1]), op(acc[2], acc[3]));
+        T lanes[V::width];
+        V::store(lanes, combined);
+
+        T result = identity;
+        for (T lane : lanes) {
+            result = scalarOp(result, lane);
+        }
+        for (; i < n; ++i) {
+            result = scalarOp(result, scalarLoad(i));
+        }
+        return result;
+    }
+
+    static T sum(const T* a, std::size_t n) {
+        return reduceDeterministic(n, T{0}, [a](std::size_t i) { return V::load(a + i); },
+                                   [a](std::size_t i) { return a[i]; },
+                                   [](auto x, auto y) { return V::add(x, y); },
+                                   [](T x, T y) { return x + y; });
+    }
+
+    static T sumFast(const T* a, std::size_t n) {
+        return reduceFast(n, T{0}, [a](std::size_t i) { return V::load(a + i); },
+                          [a](std::size_t i) { return a[i]; },
+                          [](auto x, auto y) { return V::add(x, y); },
+                          [](T x, T y) { return x + y; });
+    }
+
+    static T product(const T* a, std::size_t n) {
+        return reduceDeterministic(n, T{1}, [a](std::size_t i) { return V::load(a + i); },
+                                   [a](std::size_t i) { return a[i]; },
+                                   [](auto x, auto y) { return V::mul(x, y); },
+                                   [](T x, T y) { return x * y; });
+    }
+
+    static T productFast(const T* a, std::size_t n) {
+        return reduceFast(n, T{1}, [a](std::size_t i) { return V::load(a + i); },
+                          [a](std::size_t i) { return a[i]; },
+                          [](auto x, auto y) { return V::mul(x, y); },
+                          [](T x, T y) { return x * y; });
+    }
+
+    static T dot(const T* a, const T* b, std::size_t n) {
+        return reduceDeterministic(n, T{0},
+                                   [a, b](std::size_t i) { return V::mul(V::load(a + i), V::load(b + i)); },
+                                   [a, b](std::size_t i) { return a[i] * b[i]; },
+                                   [](auto x, auto y) { return V::add(x, y); },
+                                   [](T x, T y) { return x + y; });
+    }
+
+    static T dotFast(const T* a, const T* b, std::size_t n) {
+        return reduceFast(n, T{0},
+                          [a, b](std::size_t i) { return V::mul(V::load(a + i), V::load(b + i)); },
+                          [a, b](std::size_t i) { return a[i] * b[i]; },
+                          [](auto x, auto y) { return V::add(x, y); },
+                          [](T x, T y) { return x + y; });
+    }
+
+    static T min(const T* a, std::size_t n) {
+        return reduceDeterministic(n, std::numeric_limits<T>::infinity(),
+                                   [a](std::size_t i) { return V::load(a + i); },
+                                   [a](std::size_t i) { return a[i]; },
+                                   [](auto acc, auto x) { return V::min(x, acc); },
+                                   [](T acc, T x) { return x < acc ? x : acc; });
+    }
+
+    static T max(const T* a, std::size_t n) {
+        return reduceDeterministic(n, -std::numeric_limits<T>::infinity(),
+                                   [a](std::size_t i) { return V::load(a + i); },
+                                   [a](std::size_t i) { return a[i]; },
+                                   [](auto acc, auto x) { return V::max(x, acc); },
+                                   [](T acc, T x) { return x > acc ? x : acc; });
+    }
+
+    static ElementKernels<T> table() {
+        return ElementKernels<T>{
+            &add, &subtract, &multiply, &divide,
+            &addScalar, &subtractScalar, &multiplyScalar, &divideScalar,
+            &power,
+            &sum, &sumFast, &product, &productFast, &dot, &dotFast, &min, &max,
+        };
+    }
+};
+
+/**
+ * @brief Conversions of the 16-bit storage formats, vectorized by the compiler
+ */
+struct StorageKernels {
+    static void widenFloat16(const Float16* in, float* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = halfBitsToFloat(in[i].bits);
+        }
+    }
+
+    static void narrowFloat16(const float* in, Float16* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i].bits = floatToHalfBits(in[i]);
+        }
+    }
+
+    static void widenBFloat16(const BFloat16* in, float* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = bfloat16BitsToFloat(in[i].bits);
+        }
+    }
+
+    static void narrowBFloat16(const float* in, BFloat16* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i].bits = floatToBFloat16Bits(in[i]);
+        }
+    }
+};
+
+/**
+ * @brief Fixed-point loops over FixedArithmetic, vectorized by the compiler
+ *
+ * FixedArithmetic<R> is instantiated here but defined before the target
+ * region, so its out-of-line members are baseline code like everywhere
+ * else in the library; inlined into these loops, it is vectorized for the
+ * tier.
+ *
+ * The overflow flags are stored rather than reduced to a first index, which
+ * would keep the loops from vectorizing.
+ */
+template <typename R>
+struct FixedBatchKernels {
+    using Arithmetic = FixedArithmetic<R>;
+
+    template <typename Op>
+    static std::size_t apply(R* out, std::size_t n, std::uint8_t* overflow, Op op) {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const FixedOutcome<R> result = op(i);
+            out[i] = result.value;
+            overflow[i] = result.overflow;
+            count += result.overflow;
+        }
+        return count;
+    }
+
+    static std::size_t add(const R* a, const R* b, R* out, std::size_t n, std::uint8_t* overflow) {
+        return apply(out, n, overflow, [=](std::size_t i) { return Arithmetic::add(a[i], b[i]); });
+    }
+
+    static std::size_t subtract(const R* a, const R* b, R* out, std::size_t n, std::uint8_t* overflow) {
+        return apply(out, n, overflow, [=](std::size_t i) { return Arithmetic::subtract(a[i], b[i]); });
+    }
+
+    static std::size_t addScalar(const R* a, R b, R* out, std::size_t n, std::uint8_t* overflow) {
+        return apply(out, n, overflow, [=](std::size_t i) { return Arithmetic::add(a[i], b); });
+    }
+
+    static std::size_t subtractScalar(const R* a, R b, R* out, std::size_t n, std::uint8_t* overflow) {
+        return apply(out, n, overflow, [=](std::size_t i) { return Arithmetic::subtract(a[i], b); });
+    }
+
+    /// The Q formats' scales get a loop of their own, with a shift the
+    /// compiler can vectorize
+    template <typename Op>
+    static std::size_t scaled(R* out, std::size_t n, std::uint8_t* overflow,
+                              const Reciprocal& scale, Op op) {
+        if (scale.isPowerOfTwo()) {
+            const PowerOfTwo s{scale.shift()};
+            return apply(out, n, overflow, [=](std::size_t i) { return op(i, s); });
+        }
+        const Reciprocal s = scale;
+        return apply(out, n, overflow, [=](std::size_t i) { return op(i, s); });
+    }
+
+    static std::size_t multiply(const R* a, const R* b, R* out, std::size_t n,
+                                const Reciprocal& scale, std::uint8_t* overflow) {
+        return scaled(out, n, overflow, scale, [=](std::size_t i, const auto& s) {
+            return Arithmetic::multiply(a[i], b[i], s);
+        });
+    }
+
+    static std::size_t multiplyScalar(const R* a, R b, R* out, std::size_t n,
+                                      const Reciprocal& scale, std::uint8_t* overflow) {
+        return scaled(out, n, overflow, scale, [=](std::size_t i, const auto& s) {
+            return Arithmetic::multiply(a[i], b, s);
+        });
+    }
+
+    static std::size_t divide(const R* a, const R* b, R* out, std::size_t n,
+                              const Reciprocal& scale, std::uint8_t* overflow) {
+        const Reciprocal s = scale;
+        return apply(out, n, overflow, [=](std::size_t i) {
+            if (b[i] == 0) {
+                return FixedOutcome<R>{a[i] == 0 ? R{0} : Arithmetic::saturated(a[i] < 0), 1};
+            }
+            return Arithmetic::divide(a[i], b[i], s);
+        });
+    }
+
+    static std::size_t divideScalar(const R* a, const Reciprocal& divisor, bool negative, R* out,
+                                    std::size_t n, const Reciprocal& scale, std::uint8_t* overflow) {
+        const Reciprocal d = divisor;
+        const Reciprocal s = scale;
+        return apply(out, n, overflow,
+                     [=](std::size_t i) { return Arithmetic::divide(a[i], d, negative, s); });
+    }
+
+    static FixedKernels<R> table() {
+        return FixedKernels<R>{
+            &add, &subtract, &addScalar, &subtractScalar,
+            &multiply, &multiplyScalar, &divide, &divideScalar,
+        };
+    }
+};
+
+/**
+ * @brief Table of a tier from its double and float vector traits
+ */
+template <typename V64, typename V32>
+KernelTable makeKernelTable(const char* name) {
+    return KernelTable{
+        name,
+        BatchKernels<V64>::table(),
+        BatchKernels<V32>::table(),
+        &StorageKernels::widenFloat16, &StorageKernels::narrowFloat16,
+        &StorageKernels::widenBFloat16, &StorageKernels::narrowBFloat16,
+        FixedBatchKernels<std::int32_t>::table(),
+#if MATHENGINE_FIXED_INT128
+        FixedBatchKernels<std::int64_t>::table(),
+#endif
+    };
+}
+
+} // namespace
+} // namespace MathEngine::detail
+
+#endif // MATH_SIMD_BATCH_KERNELS_IMPL_HPP
@@ -0,0 +1,192 @@
+#include "simd/batch_kernels.hpp"
+#include "math/kernel_dispatch.hpp"
+#include "logger/logger.hpp"
+
+#include <array>
+#include <cstdlib>
+
+#if defined(MATHENGINE_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace MathEngine::detail {
+namespace {
+
+#if defined(MATHENGINE_SIMD_X86)
+
+struct X86Features {
+    bool avx2 = false;
+    bool avx512 = false;  // F and BW, the set the AVX-512 tier is compiled for
+};
+
+X86Features detectX86Features() {
+    X86Features features;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if (!osxsave || !avx || maxLeaf < 7) {
+        return features;
+    }
+
+    // The OS must save the wider register state on context switches
+    const unsigned long long xcr0 = _xgetbv(0);
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+    __cpuidex(info, 7, 0);
+    features.avx2 = ymmState && fma && (info[1] & (1 << 5)) != 0;
+    features.avx512 = zmmState && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0;
+#else
+    // libgcc/compiler-rt also verify OS support via XGETBV
+    __builtin_cpu_init();
+    features.avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    features.avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+    return features;
+}
+
+#endif // MATHENGINE_SIMD_X86
+
+/// Tiers built for this target, ascending
+#if defined(MATHENGINE_SIMD_X86)
+constexpr std::array kCompiledTiers = {KernelTier::Scalar, KernelTier::SSE2, KernelTier::AVX2,
+                                       KernelTier::AVX512};
+#elif defined(MATHENGINE_SIMD_NEON)
+constexpr std::array kCompiledTiers = {KernelTier::Scalar, KernelTier::NEON};
+#else
+constexpr std::array kCompiledTiers = {KernelTier::Scalar};
+#endif
+
+KernelTier detectBestTier() {
+#if defined(MATHENGINE_SIMD_X86)
+    const X86Features features = detectX86Features();
+    if (features.avx512) {
+        return KernelTier::AVX512;
+    }
+    if (features.avx2) {
+        return KernelTier::AVX2;
+    }
+    return KernelTier::SSE2;
+#elif defined(MATHENGINE_SIMD_NEON)
+    return KernelTier::NEON;
+#else
+    return KernelTier::Scalar;
+#endif
+}
+
+/// Built tiers below the best one run too: each tier's CPU has the ones before it
+bool runs(KernelTier tier, KernelTier best) {
+    for (KernelTier compiled : kCompiledTiers) {
+        if (compiled == tier) {
+            return tier <= best;
+        }
+    }
+    return false;
+}
+
+const KernelTable& tableFor(KernelTier tier) {
+    switch (tier) {
+#if defined(MATHENGINE_SIMD_X86)
+        case KernelTier::SSE2: return sse2KernelTable();
+        case KernelTier::AVX2: return avx2KernelTable();
+        case KernelTier::AVX512: return avx512KernelTable();
+#endif
+#if defined(MATHENGINE_SIMD_NEON)
+        case KernelTier::NEON: return neonKernelTable();
+#endif
+        default: return scalarKernelTable();
+    }
+}
+
+/**
+ * @brief What was detected and chosen, fixed for the life of the process
+ */
+struct Selection {
+    KernelTier best;
+    KernelTier active;
+    std::optional<KernelTier> requested;
+    const KernelTable* table;
+};
+
+Selection select() {
+    Selection selection{};
+    selection.best = detectBestTier();
+    selection.active = selection.best;
+
+    if (const char* name = std::getenv(KernelDispatch::kEnvironmentVariable); name != nullptr && *name != '\0') {
+        selection.requested = KernelDispatch::parse(name);
+        if (!selection.requested) {
+            MATHENGINE_LOG_WARNING("{}={}: unknown kernel tier, using {}", KernelDispatch::kEnvironmentVariable,
+                                   name, toString(selection.best));
+        } else if (!runs(*selection.requested, selection.best)) {
+            MATHENGINE_LOG_WARNING("{}={}: tier not available on this CPU, using {}",
+                                   KernelDispatch::kEnvironmentVariable, name, toString(selection.best));
+        } else {
+            selection.active = *selection.requested;
+        }
+    }
+    selection.table = &tableFor(selection.active);
+    return selection;
+}
+
+const Selection& selection() {
+    static const Selection selected = select();
+    return selected;
+}
+
+// Detect at load time, not inside the first (possibly timed) batch
+[[maybe_unused]] const Selection& loadTimeSelection = selection();
+
+} // namespace
+
+const KernelTable& kernels() {
+    static const KernelTable& table = *selection().table;
+    return table;
+}
+
+} // namespace MathEngine::detail
+
+namespace MathEngine {
+
+// ============================================================================
+// KernelDispatch
+// ============================================================================
+
+KernelTier KernelDispatch::active() {
+    return detail::selection().active;
+}
+
+KernelTier KernelDispatch::best() {
+    return detail::selection().best;
+}
+
+std::optional<KernelTier> KernelDispatch::requested() {
+    return detail::selection().requested;
+}
+
+std::span<const KernelTier> KernelDispatch::compiled() {
+    return detail::kCompiledTiers;
+}
+
+bool KernelDispatch::supported(KernelTier tier) {
+    return detail::runs(tier, detail::selection().best);
+}
+
+std::optional<KernelTier> KernelDispatch::parse(std::string_view name) {
+    for (KernelTier tier : {KernelTier::Scalar, KernelTier::SSE2, KernelTier::AVX2, KernelTier::AVX512,
+                            KernelTier::NEON}) {
+        if (toString(tier) == name) {
+            return tier;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace MathEngine
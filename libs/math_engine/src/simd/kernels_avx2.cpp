@@ -0,0 +1,76 @@
+// AVX2 tier: 4 doubles or 8 floats per register (kernels compiled for AVX2 and FMA)
+#include <immintrin.h>
+
+#define MATHENGINE_KERNEL_TARGET "avx2,fma"
+#include "simd/batch_kernels_impl.hpp"
+
+namespace MathEngine::detail {
+namespace {
+
+struct Avx2Vec {
+    using Scalar = double;
+    using Reg = __m256d;
+    using Mask = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static Reg load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Reg v) { _mm256_storeu_pd(p, v); }
+    static Reg set1(double v) { return _mm256_set1_pd(v); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm256_div_pd(a, b); }
+    // NaN in a yields b: callers pass the accumulator as b
+    static Reg min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+
+    static Mask absLess(Reg v, Reg limit) {
+        const Reg magnitude = _mm256_andnot_pd(_mm256_set1_pd(-0.0), v);
+        return _mm256_cmp_pd(magnitude, limit, _CMP_LT_OQ);
+    }
+
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) {
+        return _mm256_blendv_pd(ifFalse, ifTrue, m);
+    }
+
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+};
+
+struct Avx2VecF {
+    using Scalar = float;
+    using Reg = __m256;
+    using Mask = __m256;
+    static constexpr std::size_t width = 8;
+
+    static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Reg v) { _mm256_storeu_ps(p, v); }
+    static Reg set1(float v) { return _mm256_set1_ps(v); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+    static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+
+    static Mask absLess(Reg v, Reg limit) {
+        const Reg magnitude = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+        return _mm256_cmp_ps(magnitude, limit, _CMP_LT_OQ);
+    }
+
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) {
+        return _mm256_blendv_ps(ifFalse, ifTrue, m);
+    }
+
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+};
+
+} // namespace
+
+const KernelTable& avx2KernelTable() {
+    static const KernelTable table = makeKernelTable<Avx2Vec, Avx2VecF>("avx2");
+    return table;
+}
+
+} // namespace MathEngine::detail
+
+MATHENGINE_KERNEL_TARGET_END
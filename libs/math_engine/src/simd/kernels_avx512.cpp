@@ -0,0 +1,84 @@
+// AVX-512 tier: 8 doubles or 16 floats per register (kernels compiled for AVX-512F and AVX-512BW)
+#include <immintrin.h>
+
+#define MATHENGINE_KERNEL_TARGET "avx512f,avx512bw"
+#include "simd/batch_kernels_impl.hpp"
+
+namespace MathEngine::detail {
+namespace {
+
+struct Avx512Vec {
+    using Scalar = double;
+    using Reg = __m512d;
+    using Mask = __mmask8;
+    static constexpr std::size_t width = 8;
+
+    static Reg load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, Reg v) { _mm512_storeu_pd(p, v); }
+    static Reg set1(double v) { return _mm512_set1_pd(v); }
+    static Reg add(Reg a, Reg b) { return _mm512_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm512_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm512_div_pd(a, b); }
+    // NaN in a yields b: callers pass the accumulator as b. Spelled as
+    // compare + blend because GCC 12 flags _mm512_min_pd's undefined
+    // passthrough as maybe-uninitialized at -O3.
+    static Reg min(Reg a, Reg b) {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_LT_OQ), b, a);
+    }
+    static Reg max(Reg a, Reg b) {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_GT_OQ), b, a);
+    }
+
+    static Mask absLess(Reg v, Reg limit) {
+        return _mm512_cmp_pd_mask(_mm512_abs_pd(v), limit, _CMP_LT_OQ);
+    }
+
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) {
+        return _mm512_mask_blend_pd(m, ifFalse, ifTrue);
+    }
+
+    static unsigned bits(Mask m) { return static_cast<unsigned>(m); }
+};
+
+struct Avx512VecF {
+    using Scalar = float;
+    using Reg = __m512;
+    using Mask = __mmask16;
+    static constexpr std::size_t width = 16;
+
+    static Reg load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, Reg v) { _mm512_storeu_ps(p, v); }
+    static Reg set1(float v) { return _mm512_set1_ps(v); }
+    static Reg add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm512_div_ps(a, b); }
+    static Reg min(Reg a, Reg b) {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ), b, a);
+    }
+    static Reg max(Reg a, Reg b) {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ), b, a);
+    }
+
+    static Mask absLess(Reg v, Reg limit) {
+        return _mm512_cmp_ps_mask(_mm512_abs_ps(v), limit, _CMP_LT_OQ);
+    }
+
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) {
+        return _mm512_mask_blend_ps(m, ifFalse, ifTrue);
+    }
+
+    static unsigned bits(Mask m) { return static_cast<unsigned>(m); }
+};
+
+} // namespace
+
+const KernelTable& avx512KernelTable() {
+    static const KernelTable table = makeKernelTable<Avx512Vec, Avx512VecF>("avx512");
+    return table;
+}
+
+} // namespace MathEngine::detail
+
+MATHENGINE_KERNEL_TARGET_END
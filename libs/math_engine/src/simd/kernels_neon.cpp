@@ -0,0 +1,71 @@
+// NEON tier: 2 doubles or 4 floats per register (AArch64 Advanced SIMD, always present)
+#include "simd/batch_kernels_impl.hpp"
+
+#include <arm_neon.h>
+
+namespace MathEngine::detail {
+namespace {
+
+struct NeonVec {
+    using Scalar = double;
+    using Reg = float64x2_t;
+    using Mask = uint64x2_t;
+    static constexpr std::size_t width = 2;
+
+    static Reg load(const double* p) { return vld1q_f64(p); }
+    static void store(double* p, Reg v) { vst1q_f64(p, v); }
+    static Reg set1(double v) { return vdupq_n_f64(v); }
+    static Reg add(Reg a, Reg b) { return vaddq_f64(a, b); }
+    static Reg sub(Reg a, Reg b) { return vsubq_f64(a, b); }
+    static Reg mul(Reg a, Reg b) { return vmulq_f64(a, b); }
+    static Reg div(Reg a, Reg b) { return vdivq_f64(a, b); }
+    // NaN in a yields b: callers pass the accumulator as b
+    static Reg min(Reg a, Reg b) { return vminnmq_f64(a, b); }
+    static Reg max(Reg a, Reg b) { return vmaxnmq_f64(a, b); }
+
+    // |v| < |limit|; limit is always positive here
+    static Mask absLess(Reg v, Reg limit) { return vcaltq_f64(v, limit); }
+
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) { return vbslq_f64(m, ifTrue, ifFalse); }
+
+    static unsigned bits(Mask m) {
+        return static_cast<unsigned>((vgetq_lane_u64(m, 0) & 1u) |
+                                     ((vgetq_lane_u64(m, 1) & 1u) << 1));
+    }
+};
+
+struct NeonVecF {
+    using Scalar = float;
+    using Reg = float32x4_t;
+    using Mask = uint32x4_t;
+    static constexpr std::size_t width = 4;
+
+    static Reg load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, Reg v) { vst1q_f32(p, v); }
+    static Reg set1(float v) { return vdupq_n_f32(v); }
+    static Reg add(Reg a, Reg b) { return vaddq_f32(a, b); }
+    static Reg sub(Reg a, Reg b) { return vsubq_f32(a, b); }
+    static Reg mul(Reg a, Reg b) { return vmulq_f32(a, b); }
+    static Reg div(Reg a, Reg b) { return vdivq_f32(a, b); }
+    static Reg min(Reg a, Reg b) { return vminnmq_f32(a, b); }
+    static Reg max(Reg a, Reg b) { return vmaxnmq_f32(a, b); }
+
+    static Mask absLess(Reg v, Reg limit) { return vcaltq_f32(v, limit); }
+
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) { return vbslq_f32(m, ifTrue, ifFalse); }
+
+    static unsigned bits(Mask m) {
+        // Lane i contributes bit i
+        const uint32x4_t weights = {1u, 2u, 4u, 8u};
+        return vaddvq_u32(vandq_u32(m, weights));
+    }
+};
+
+} // namespace
+
+const KernelTable& neonKernelTable() {
+    static const KernelTable table = makeKernelTable<NeonVec, NeonVecF>("neon");
+    return table;
+}
+
+} // namespace MathEngine::detail
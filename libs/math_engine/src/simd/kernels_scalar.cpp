@@ -0,0 +1,35 @@
+// Portable fallback tier: one element per "vector"
+#include "simd/batch_kernels_impl.hpp"
+
+namespace MathEngine::detail {
+namespace {
+
+template <typename T>
+struct ScalarVec {
+    using Scalar = T;
+    using Reg = T;
+    using Mask = bool;
+    static constexpr std::size_t width = 1;
+
+    static Reg load(const T* p) { return *p; }
+    static void store(T* p, Reg v) { *p = v; }
+    static Reg set1(T v) { return v; }
+    static Reg add(Reg a, Reg b) { return a + b; }
+    static Reg sub(Reg a, Reg b) { return a - b; }
+    static Reg mul(Reg a, Reg b) { return a * b; }
+    static Reg div(Reg a, Reg b) { return a / b; }
+    static Reg min(Reg a, Reg b) { return a < b ? a : b; }
+    static Reg max(Reg a, Reg b) { return a > b ? a : b; }
+    static Mask absLess(Reg v, Reg limit) { return v < limit && v > -limit; }
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) { return m ? ifTrue : ifFalse; }
+    static unsigned bits(Mask m) { return m ? 1u : 0u; }
+};
+
+} // namespace
+
+const KernelTable& scalarKernelTable() {
+    static const KernelTable table = makeKernelTable<ScalarVec<double>, ScalarVec<float>>("scalar");
+    return table;
+}
+
+} // namespace MathEngine::detail
@@ -0,0 +1,74 @@
+// SSE2 tier: 2 doubles or 4 floats per register (baseline for every x86-64 CPU)
+#include "simd/batch_kernels_impl.hpp"
+
+#include <emmintrin.h>
+
+namespace MathEngine::detail {
+namespace {
+
+struct Sse2Vec {
+    using Scalar = double;
+    using Reg = __m128d;
+    using Mask = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static Reg load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, Reg v) { _mm_storeu_pd(p, v); }
+    static Reg set1(double v) { return _mm_set1_pd(v); }
+    static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_pd(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm_div_pd(a, b); }
+    // NaN in a yields b: callers pass the accumulator as b
+    static Reg min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+
+    static Mask absLess(Reg v, Reg limit) {
+        const Reg magnitude = _mm_andnot_pd(_mm_set1_pd(-0.0), v);
+        return _mm_cmplt_pd(magnitude, limit);
+    }
+
+    // SSE2 has no blendv: combine with and/andnot/or
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) {
+        return _mm_or_pd(_mm_and_pd(m, ifTrue), _mm_andnot_pd(m, ifFalse));
+    }
+
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+};
+
+struct Sse2VecF {
+    using Scalar = float;
+    using Reg = __m128;
+    using Mask = __m128;
+    static constexpr std::size_t width = 4;
+
+    static Reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, Reg v) { _mm_storeu_ps(p, v); }
+    static Reg set1(float v) { return _mm_set1_ps(v); }
+    static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+    static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+    static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+
+    static Mask absLess(Reg v, Reg limit) {
+        const Reg magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+        return _mm_cmplt_ps(magnitude, limit);
+    }
+
+    static Reg select(Mask m, Reg ifTrue, Reg ifFalse) {
+        return _mm_or_ps(_mm_and_ps(m, ifTrue), _mm_andnot_ps(m, ifFalse));
+    }
+
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+};
+
+} // namespace
+
+const KernelTable& sse2KernelTable() {
+    static const KernelTable table = makeKernelTable<Sse2Vec, Sse2VecF>("sse2");
+    return table;
+}
+
+} // namespace MathEngine::detail
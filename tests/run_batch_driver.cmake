@@ -0,0 +1,24 @@
+# ============================================================================
+# End-to-End Test - main_app Batch Driver
+# ============================================================================
+# Runs main_app in driver mode and compares what it wrote with a reference
+# file byte for byte. Invoked by ctest as:
+#   cmake -DMAIN_APP=<exe> -DARGS=<;-list> -DOUTPUT=<file> -DEXPECTED=<file>
+#         -P run_batch_driver.cmake
+# ============================================================================
+execute_process(
+    COMMAND ${MAIN_APP} ${ARGS} --output ${OUTPUT}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "main_app failed (${result}):\n${errors}")
+endif()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${OUTPUT} ${EXPECTED}
+    RESULT_VARIABLE different
+)
+if(different)
+    message(FATAL_ERROR "${OUTPUT} differs from ${EXPECTED}")
+endif()
@@ -0,0 +1,51 @@
+# ============================================================================
+# End-to-End Test - main_app Coordinator/Worker Mode
+# ============================================================================
+# Starts two workers on localhost, runs the coordinator over them and checks
+# that it wrote the reference file byte for byte and reduced the results
+# exactly as a single-node run does. Invoked by ctest as:
+#   cmake -DMAIN_APP=<exe> -DARGS=<;-list> -DOUTPUT=<file> -DEXPECTED=<file>
+#         -DPORT=<first of two free ports> -DROOT=<worker --root>
+#         -P run_distributed.cmake
+# ============================================================================
+math(EXPR SECOND_PORT "${PORT} + 1")
+set(WORKERS "127.0.0.1:${PORT},127.0.0.1:${SECOND_PORT}")
+
+execute_process(
+    COMMAND ${MAIN_APP} ${ARGS} --output ${OUTPUT}.single
+    RESULT_VARIABLE result
+    ERROR_VARIABLE single
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "single-node main_app failed (${result}):\n${single}")
+endif()
+
+# The commands of one execute_process run concurrently; --once makes each
+# worker exit when the coordinator disconnects
+execute_process(
+    COMMAND ${MAIN_APP} --worker 127.0.0.1:${PORT} --root ${ROOT} --once
+    COMMAND ${MAIN_APP} --worker 127.0.0.1:${SECOND_PORT} --root ${ROOT} --once
+    COMMAND ${MAIN_APP} ${ARGS} --output ${OUTPUT} --workers ${WORKERS} --shards 3
+    RESULTS_VARIABLE results
+    ERROR_VARIABLE distributed
+    TIMEOUT 60
+)
+foreach(result IN LISTS results)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "distributed main_app failed (${results}):\n${distributed}")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${OUTPUT} ${EXPECTED}
+    RESULT_VARIABLE different
+)
+if(different)
+    message(FATAL_ERROR "${OUTPUT} differs from ${EXPECTED}")
+endif()
+
+string(REGEX MATCH "[a-z]+ of results: [^\n]*" expected_reduction "${single}")
+string(REGEX MATCH "[a-z]+ of results: [^\n]*" reduction "${distributed}")
+if(NOT expected_reduction OR NOT reduction STREQUAL expected_reduction)
+    message(FATAL_ERROR "distributed '${reduction}' != single-node '${expected_reduction}'")
+endif()
@@ -0,0 +1,27 @@
+# ============================================================================
+# End-to-End Test - main_app Worker --root
+# ============================================================================
+# Starts a worker whose --root does not contain the input and checks that
+# the coordinator's run fails with the worker's refusal, while the worker
+# itself keeps serving and exits normally. Invoked by ctest as:
+#   cmake -DMAIN_APP=<exe> -DARGS=<;-list> -DOUTPUT=<file> -DPORT=<free port>
+#         -DROOT=<directory without the input> -P run_distributed_root.cmake
+# ============================================================================
+execute_process(
+    COMMAND ${MAIN_APP} --worker 127.0.0.1:${PORT} --root ${ROOT} --once
+    COMMAND ${MAIN_APP} ${ARGS} --output ${OUTPUT} --workers 127.0.0.1:${PORT}
+    RESULTS_VARIABLE results
+    ERROR_VARIABLE errors
+    TIMEOUT 60
+)
+list(GET results 0 worker_result)
+list(GET results 1 coordinator_result)
+if(NOT worker_result EQUAL 0)
+    message(FATAL_ERROR "worker failed (${worker_result}):\n${errors}")
+endif()
+if(coordinator_result EQUAL 0)
+    message(FATAL_ERROR "coordinator read an input outside the worker's root:\n${errors}")
+endif()
+if(NOT errors MATCHES "outside the worker's root")
+    message(FATAL_ERROR "coordinator failed for another reason (${coordinator_result}):\n${errors}")
+endif()
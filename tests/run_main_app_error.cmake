@@ -0,0 +1,21 @@
+# ============================================================================
+# End-to-End Test - main_app Usage Errors
+# ============================================================================
+# Runs main_app with arguments it must refuse and checks that it exits with
+# status 2 and a "main_app: " message matching ERROR_MATCH, rather than
+# crashing. Invoked by ctest as:
+#   cmake -DMAIN_APP=<exe> -DARGS=<;-list> -DERROR_MATCH=<regex>
+#         -P run_main_app_error.cmake
+# ============================================================================
+execute_process(
+    COMMAND ${MAIN_APP} ${ARGS}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors
+    TIMEOUT 60
+)
+if(NOT result STREQUAL "2")
+    message(FATAL_ERROR "main_app exited with ${result}, expected 2:\n${errors}")
+endif()
+if(NOT errors MATCHES "main_app: ${ERROR_MATCH}")
+    message(FATAL_ERROR "main_app failed with an unexpected message:\n${errors}")
+endif()
@@ -0,0 +1,260 @@
+#include "math/arrow.hpp"
+#include "math/calculator.hpp"
+#include "math/reduction.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+/**
+ * @brief Upstream resource that counts what it hands out
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t outstanding = 0;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        ++outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        --outstanding;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief float64 array exported the way an Arrow producer would
+ *
+ * valid[i] false marks slot i null; its value is left as given. The
+ * exported array starts offset slots into the buffers.
+ */
+struct Producer {
+    std::vector<double> values;
+    std::vector<std::uint8_t> bitmap;
+    const void* buffers[2] = {nullptr, nullptr};
+    ArrowArray array{};
+    ArrowSchema schema{};
+
+    Producer(std::vector<double> data, const std::vector<bool>& valid = {}, std::size_t offset = 0,
+             std::int64_t nullCount = -1)
+        : values(std::move(data)) {
+        buffers[1] = values.data();
+        if (!valid.empty()) {
+            bitmap.assign((values.size() + 7) / 8, 0);
+            for (std::size_t i = 0; i < valid.size(); ++i) {
+                if (valid[i]) {
+                    bitmap[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+                }
+            }
+            buffers[0] = bitmap.data();
+        }
+        array.length = static_cast<std::int64_t>(values.size() - offset);
+        array.offset = static_cast<std::int64_t>(offset);
+        array.null_count = valid.empty() ? 0 : nullCount;
+        array.n_buffers = 2;
+        array.buffers = buffers;
+        array.release = [](ArrowArray* self) { self->release = nullptr; };
+
+        schema.format = "g";
+        schema.name = "x";
+        schema.flags = ARROW_FLAG_NULLABLE;
+        schema.release = [](ArrowSchema* self) { self->release = nullptr; };
+    }
+
+    ArrowColumn column() const { return {array, schema}; }
+};
+
+std::vector<double> ramp(std::size_t n, double scale, double offset) {
+    std::vector<double> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = scale * static_cast<double>(i % 1000) + offset;
+    }
+    return values;
+}
+
+bool resultValid(ArrowResult& result, std::size_t i) {
+    const auto* bits = static_cast<const std::uint8_t*>(result.array()->buffers[0]);
+    return bits == nullptr || ((bits[i / 8] >> (i % 8)) & 1) != 0;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Batch Operations
+// ============================================================================
+
+TEST_CASE("ArrowCompute - batch operations read the producer's buffers in place", "[arrow]") {
+    constexpr std::size_t kSize = 70'001;
+    const Producer a(ramp(kSize, 0.5, -3.0));
+    const Producer b(ramp(kSize, 0.25, 1.0));
+    REQUIRE(a.column().values().data() == a.values.data());
+
+    ArrowResult sum = ArrowCompute::add(a.column(), b.column());
+    std::vector<double> expected(kSize);
+    Calculator::add(a.values, b.values, expected);
+
+    ArrowArray& array = *sum.array();
+    REQUIRE(array.length == static_cast<std::int64_t>(kSize));
+    REQUIRE(array.null_count == 0);
+    REQUIRE(array.buffers[0] == nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(array.buffers[1]) % 64 == 0);
+    REQUIRE(std::string(sum.schema()->format) == "g");
+
+    const auto* values = static_cast<const double*>(array.buffers[1]);
+    REQUIRE(std::vector<double>(values, values + kSize) == expected);
+
+    // A result is an input like any other
+    ArrowResult cubed = ArrowCompute::power(sum.column(), 3);
+    Calculator::power(std::vector<double>(expected), 3, expected);
+    REQUIRE(cubed.column().values()[12'345] == expected[12'345]);
+}
+
+TEST_CASE("ArrowCompute - result validity is the AND of the inputs", "[arrow]") {
+    // Offset 3 puts slot 0 at bit 3 of the input bitmaps
+    std::vector<bool> validA(23, true), validB(23, true);
+    validA[4] = false;   // slot 1
+    validB[13] = false;  // slot 10
+    validB[20] = false;  // slot 17
+    const Producer a(ramp(23, 1.0, 0.0), validA, 3);
+    const Producer b(ramp(23, 2.0, 0.0), validB, 3, 2);
+    REQUIRE(a.column().nullCount() == 1);
+
+    ArrowResult product = ArrowCompute::multiply(a.column(), b.column());
+    REQUIRE(product.array()->null_count == 3);
+    for (std::size_t i = 0; i < 20; ++i) {
+        REQUIRE(resultValid(product, i) == (i != 1 && i != 10 && i != 17));
+    }
+    REQUIRE(product.column().values()[5] == 8.0 * 16.0);
+
+    ArrowResult shifted = ArrowCompute::subtract(b.column(), 1.0);
+    REQUIRE(shifted.array()->null_count == 2);
+    REQUIRE_FALSE(resultValid(shifted, 10));
+    REQUIRE(resultValid(shifted, 1));
+}
+
+TEST_CASE("ArrowCompute - zero denominators become nulls", "[arrow]") {
+    std::vector<double> denominators = {2.0, 0.0, 4.0, 0.0, 5.0, 0.0};
+    std::vector<bool> valid = {true, true, true, false, true, true};
+    const Producer a({1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+    const Producer b(denominators, valid);
+
+    Calculator::BatchStatus status;
+    ArrowResult quotient = ArrowCompute::divide(a.column(), b.column(), &status);
+    // Slot 3 was null already: not a division error
+    REQUIRE(status.errorCount == 2);
+    REQUIRE(status.firstError == 1);
+    REQUIRE(quotient.array()->null_count == 3);
+    REQUIRE_FALSE(resultValid(quotient, 1));
+    REQUIRE_FALSE(resultValid(quotient, 5));
+    REQUIRE(quotient.column().values()[4] == 1.0);
+
+    ArrowResult scaled = ArrowCompute::divide(a.column(), 4.0, &status);
+    REQUIRE(status.ok());
+    REQUIRE(scaled.array()->buffers[0] == nullptr);
+
+    ArrowResult none = ArrowCompute::divide(b.column(), 0.0, &status);
+    REQUIRE(status.errorCount == 5);
+    REQUIRE(status.firstError == 0);
+    REQUIRE(none.array()->null_count == 6);
+}
+
+// ============================================================================
+// Test Suite: Reductions
+// ============================================================================
+
+TEST_CASE("ArrowCompute - reductions skip null slots", "[arrow]") {
+    constexpr std::size_t kSize = 100'000;
+    auto values = ramp(kSize, 0.01, -2.0);
+    std::vector<bool> valid(kSize, true);
+    std::vector<double> packed;
+    for (std::size_t i = 0; i < kSize; ++i) {
+        if (i % 7 == 3) {
+            valid[i] = false;
+            values[i] = 1e300;  // Garbage a null slot may hold
+        } else {
+            packed.push_back(values[i]);
+        }
+    }
+    const Producer column(values, valid);
+    const Producer dense(packed);
+
+    REQUIRE(ArrowCompute::sum(column.column()) == Reduction::sum(packed));
+    REQUIRE(ArrowCompute::max(column.column()) == Reduction::max(packed));
+    REQUIRE(ArrowCompute::min(column.column(), {ReductionMode::Fast}) ==
+            Reduction::min(packed, {ReductionMode::Fast}));
+    REQUIRE(ArrowCompute::sum(dense.column()) == Reduction::sum(packed));
+
+    // dot keeps the slots valid in both
+    const Producer ones(std::vector<double>(kSize, 1.0));
+    REQUIRE(ArrowCompute::dot(column.column(), ones.column()) == Reduction::sum(packed));
+
+    const Producer allNull({1.0, 2.0}, {false, false});
+    REQUIRE(ArrowCompute::sum(allNull.column()) == 0.0);
+    REQUIRE(ArrowCompute::product(allNull.column()) == 1.0);
+    REQUIRE_THROWS_AS(ArrowCompute::min(allNull.column()), std::invalid_argument);
+}
+
+// ============================================================================
+// Test Suite: Ownership and Validation
+// ============================================================================
+
+TEST_CASE("ArrowCompute - results live in the caller's memory resource", "[arrow]") {
+    CountingResource memory;
+    const Producer a({1.0, 2.0, 3.0}, {true, false, true});
+    const Producer b({1.0, 0.0, 1.0});
+
+    {
+        ArrowResult result = ArrowCompute::divide(a.column(), b.column(), nullptr, &memory);
+        REQUIRE(memory.outstanding == 3);  // private data, values, validity
+        ArrowResult moved = std::move(result);
+        REQUIRE(result.array()->release == nullptr);
+        REQUIRE(memory.outstanding == 3);
+    }
+    REQUIRE(memory.outstanding == 0);
+
+    // A consumer that takes the structs over releases them itself
+    std::optional<ArrowArray> imported;
+    {
+        ArrowResult result = ArrowCompute::add(a.column(), 1.0, &memory);
+        imported = *result.array();
+        result.array()->release = nullptr;
+    }
+    REQUIRE(memory.outstanding == 3);
+    imported->release(&*imported);
+    REQUIRE(imported->release == nullptr);
+    REQUIRE(memory.outstanding == 0);
+}
+
+TEST_CASE("ArrowCompute - rejects arrays it cannot read", "[arrow]") {
+    Producer a({1.0, 2.0});
+    const Producer b({1.0, 2.0, 3.0});
+    REQUIRE_THROWS_AS(ArrowCompute::add(a.column(), b.column()), std::invalid_argument);
+
+    a.schema.format = "f";
+    REQUIRE_THROWS_AS(a.column(), std::invalid_argument);
+    a.schema.format = "g";
+
+    a.array.release(&a.array);
+    REQUIRE_THROWS_AS(a.column(), std::invalid_argument);
+}
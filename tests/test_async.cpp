@@ -0,0 +1,280 @@
+#include "math/async.hpp"
+#include "math/calculator.hpp"
+#include "math/executor.hpp"
+#include "math/expression.hpp"
+#include "math/reduction.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+/**
+ * @brief Coroutine that starts at once and cleans up after itself
+ */
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/**
+ * @brief What one coroutine saw: its result and the thread it resumed on
+ */
+template <typename Result>
+struct Outcome {
+    Result result;
+    std::thread::id resumedOn;
+};
+
+/**
+ * @brief co_await make() in a coroutine; the future gets its outcome
+ */
+template <typename Make>
+auto spawn(Make make) {
+    using Result = decltype(make().await_resume());
+    std::promise<Outcome<Result>> promise;
+    auto future = promise.get_future();
+    [](Make make, std::promise<Outcome<Result>> promise) -> Detached {
+        try {
+            Result result = co_await make();
+            promise.set_value({std::move(result), std::this_thread::get_id()});
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }(std::move(make), std::move(promise));
+    return future;
+}
+
+template <typename Make>
+auto syncWait(Make make) {
+    return spawn(std::move(make)).get().result;
+}
+
+std::vector<double> ramp(std::size_t n, double scale, double offset) {
+    std::vector<double> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = scale * static_cast<double>(i % 1000) + offset;
+    }
+    return values;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Results
+// ============================================================================
+
+TEST_CASE("AsyncCalculator - batches match the synchronous operations", "[async]") {
+    Executor executor(ExecutorOptions{3, false});
+    AsyncCalculator engine({.executor = &executor, .chunkSize = 1000});
+
+    constexpr std::size_t kSize = 100'003;
+    const auto a = ramp(kSize, 0.5, -7.0);
+    auto b = ramp(kSize, 0.25, 1.0);
+    b[5'000] = 0.0;
+    b[70'000] = 0.0;
+
+    std::vector<double> expected(kSize), out(kSize);
+    Calculator::add(a, b, expected);
+    auto added = spawn([&] { return engine.add(a, b, out); }).get();
+    REQUIRE(added.result.has_value());
+    REQUIRE(added.result->ok());
+    REQUIRE(added.resumedOn != std::this_thread::get_id());
+    REQUIRE(out == expected);
+
+    Calculator::power(a, 3, expected);
+    REQUIRE(syncWait([&] { return engine.power(a, 3, out); }).has_value());
+    REQUIRE(out == expected);
+
+    // Statuses of the chunks add up to one over the whole batch
+    const auto divided = syncWait([&] { return engine.divide(a, b, out); });
+    REQUIRE(divided.has_value());
+    REQUIRE(divided->errorCount == 2);
+    REQUIRE(divided->firstError == 5'000);
+    REQUIRE(std::isnan(out[70'000]));
+    REQUIRE(out[1] == Calculator::divide(a[1], b[1]));
+    REQUIRE(engine.inFlight() == 0);
+}
+
+TEST_CASE("AsyncCalculator - expressions and reductions", "[async]") {
+    Executor executor(ExecutorOptions{2, false});
+    AsyncCalculator engine({.executor = &executor, .chunkSize = 777});
+
+    constexpr std::size_t kSize = 20'000;
+    const auto x = ramp(kSize, 0.01, 1.0);
+    auto y = ramp(kSize, 0.02, 0.5);
+    y[12'345] = 0.0;
+
+    const Expression expression("x * 2 + x / y");
+    const std::vector<std::span<const double>> columns = {x, y};
+    std::vector<double> expected(kSize), out(kSize);
+    const auto expectedStatus = expression.evaluate(columns, expected);
+
+    const auto status = syncWait([&] { return engine.evaluate(expression, columns, out); });
+    REQUIRE(status.has_value());
+    REQUIRE(status->errorCount == expectedStatus.errorCount);
+    REQUIRE(status->firstError == 12'345);
+    for (std::size_t i = 0; i < kSize; i += 113) {
+        REQUIRE(out[i] == expected[i]);
+    }
+
+    REQUIRE(*syncWait([&] { return engine.sum(x); }) == Reduction::sum(x));
+    REQUIRE(*syncWait([&] { return engine.dot(x, y); }) == Reduction::dot(x, y));
+    REQUIRE(*syncWait([&] { return engine.max(y); }) == Reduction::max(y));
+}
+
+TEST_CASE("AsyncCalculator - runs inline without an executor", "[async]") {
+    REQUIRE(Executor::global() == nullptr);
+    AsyncCalculator engine;
+
+    const std::vector<double> a{1.0, 2.0, 3.0};
+    std::vector<double> out(a.size());
+    auto outcome = spawn([&] { return engine.multiply(a, 2.0, out); });
+    // Never suspended, so the future is ready before spawn() returns
+    REQUIRE(outcome.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    const auto result = outcome.get();
+    REQUIRE(result.result.has_value());
+    REQUIRE(result.resumedOn == std::this_thread::get_id());
+    REQUIRE(out == std::vector<double>{2.0, 4.0, 6.0});
+}
+
+TEST_CASE("AsyncCalculator - errors surface like the synchronous API", "[async]") {
+    Executor executor(ExecutorOptions{2, false});
+    AsyncCalculator engine({.executor = &executor});
+
+    // Size mismatches throw from the call, before anything runs
+    const std::vector<double> a(10, 1.0);
+    std::vector<double> out(9);
+    REQUIRE_THROWS_AS(engine.add(a, a, out), std::invalid_argument);
+
+    const Expression expression("x + y");
+    const std::vector<std::span<const double>> oneColumn = {a};
+    REQUIRE_THROWS_AS(engine.evaluate(expression, oneColumn, out), std::invalid_argument);
+
+    // What the work throws comes out of co_await
+    const std::vector<double> empty;
+    REQUIRE_THROWS_AS(syncWait([&] { return engine.min(empty); }), std::invalid_argument);
+    REQUIRE(engine.inFlight() == 0);
+}
+
+// ============================================================================
+// Test Suite: Cancellation and Back-Pressure
+// ============================================================================
+
+TEST_CASE("AsyncCalculator - a stop requested before co_await cancels", "[async]") {
+    Executor executor(ExecutorOptions{2, false});
+    AsyncCalculator engine({.executor = &executor});
+
+    std::stop_source stop;
+    stop.request_stop();
+    const std::vector<double> a(5000, 1.0);
+    std::vector<double> out(a.size(), -1.0);
+
+    const auto result = syncWait([&] { return engine.add(a, a, out, stop.get_token()); });
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == MathError::Cancelled);
+    REQUIRE(out[0] == -1.0);
+
+    const auto sum = syncWait([&] { return engine.sum(a, {}, stop.get_token()); });
+    REQUIRE(sum.error() == MathError::Cancelled);
+}
+
+TEST_CASE("AsyncCalculator - maxInFlight queues operations without blocking", "[async]") {
+    // One worker, kept busy until the test lets it go
+    Executor executor(ExecutorOptions{1, false});
+    AsyncCalculator engine({.executor = &executor, .maxInFlight = 1});
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> blocking{false};
+    auto block = [&](std::size_t, std::size_t) {
+        blocking.store(true);
+        released.wait();
+    };
+    auto ignore = [](std::exception_ptr) {};
+    executor.parallelForAsync(1, 1, block, ignore);
+    while (!blocking.load()) {
+        std::this_thread::yield();
+    }
+
+    const std::vector<double> a(10'000, 2.0);
+    std::vector<double> first(a.size()), second(a.size(), -1.0), third(a.size());
+    std::stop_source stop;
+
+    auto running = spawn([&] { return engine.multiply(a, a, first); });
+    auto cancelled = spawn([&] { return engine.add(a, a, second, stop.get_token()); });
+    auto queued = spawn([&] { return engine.subtract(a, 0.5, third); });
+    REQUIRE(engine.inFlight() == 1);
+    REQUIRE(engine.waiting() == 2);
+
+    // A waiter cancelled in the queue still takes its turn, but skips its work
+    stop.request_stop();
+    release.set_value();
+
+    REQUIRE(running.get().result.has_value());
+    REQUIRE(cancelled.get().result.error() == MathError::Cancelled);
+    REQUIRE(queued.get().result.has_value());
+    REQUIRE(first[0] == 4.0);
+    REQUIRE(second[0] == -1.0);
+    REQUIRE(third[9'999] == 1.5);
+    REQUIRE(engine.waiting() == 0);
+}
+
+TEST_CASE("AsyncCalculator - the resume hook hands coroutines back to their loop", "[async]") {
+    Executor executor(ExecutorOptions{2, false});
+
+    // A minimal event loop: resumption is posted here and run by this thread
+    std::mutex mutex;
+    std::deque<std::coroutine_handle<>> posted;
+    AsyncCalculator engine({.executor = &executor,
+                            .resume = [&](std::coroutine_handle<> handle) {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                posted.push_back(handle);
+                            }});
+
+    const auto a = ramp(50'000, 1.0, 0.0);
+    std::vector<double> out(a.size());
+    auto outcome = spawn([&] { return engine.add(a, 1.0, out); });
+
+    while (outcome.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        std::coroutine_handle<> handle;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!posted.empty()) {
+                handle = posted.front();
+                posted.pop_front();
+            }
+        }
+        if (handle) {
+            handle.resume();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    const auto result = outcome.get();
+    REQUIRE(result.result.has_value());
+    REQUIRE(result.resumedOn == std::this_thread::get_id());
+    REQUIRE(out[999] == 1000.0);
+}
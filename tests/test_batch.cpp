@@ -0,0 +1,163 @@
+#include "math/calculator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+// Sizes chosen to hit empty input, pure tails and every vector width
+const std::vector<std::size_t> kSizes = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 64, 1000};
+
+std::vector<double> makeInput(std::size_t n, double start, double step) {
+    std::vector<double> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = start + step * static_cast<double>(i);
+    }
+    return values;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Element-wise Batch Operations
+// ============================================================================
+
+TEST_CASE("Calculator batch - element-wise operations match scalar results", "[math][batch]") {
+    for (const std::size_t n : kSizes) {
+        const auto a = makeInput(n, -3.5, 0.75);
+        const auto b = makeInput(n, 1.25, 0.5);
+        std::vector<double> out(n);
+
+        Calculator::add(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] + b[i]);
+        }
+
+        Calculator::subtract(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] - b[i]);
+        }
+
+        Calculator::multiply(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] * b[i]);
+        }
+
+        const auto status = Calculator::divide(a, b, out);
+        REQUIRE(status.ok());
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] / b[i]);
+        }
+    }
+}
+
+TEST_CASE("Calculator batch - scalar broadcast variants", "[math][batch]") {
+    for (const std::size_t n : kSizes) {
+        const auto a = makeInput(n, 2.0, 1.5);
+        std::vector<double> out(n);
+
+        Calculator::add(a, 10.0, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] + 10.0);
+        }
+
+        Calculator::subtract(a, 0.5, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] - 0.5);
+        }
+
+        Calculator::multiply(a, -3.0, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] * -3.0);
+        }
+
+        REQUIRE(Calculator::divide(a, 4.0, out).ok());
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] / 4.0);
+        }
+    }
+}
+
+TEST_CASE("Calculator batch - in-place operation", "[math][batch]") {
+    std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0};
+    Calculator::multiply(values, values, values);
+    REQUIRE(values == std::vector<double>{1.0, 4.0, 9.0, 16.0, 25.0});
+    REQUIRE(Calculator::getLastResult() == 25.0);
+}
+
+TEST_CASE("Calculator batch - power matches the scalar fast path", "[math][batch][power]") {
+    for (const std::size_t n : kSizes) {
+        const auto base = makeInput(n, -1.75, 0.125);
+        std::vector<double> out(n);
+        for (const std::int32_t exp : {0, 1, 2, 7, 32, 63, -1, -5}) {
+            Calculator::power(base, exp, out);
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(out[i] == Calculator::integerPower(base[i], exp));
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Test Suite: Batch Division Error Reporting
+// ============================================================================
+
+TEST_CASE("Calculator batch - zero denominators are reported, not thrown", "[math][batch][divide]") {
+    SECTION("Zeros at several positions") {
+        for (const std::size_t n : kSizes) {
+            if (n < 4) {
+                continue;
+            }
+            const auto a = makeInput(n, 1.0, 1.0);
+            auto b = makeInput(n, 1.0, 1.0);
+            b[1] = 0.0;
+            b[n - 1] = -1e-12;  // Below the zero threshold
+
+            std::vector<double> out(n);
+            Calculator::BatchStatus status;
+            REQUIRE_NOTHROW(status = Calculator::divide(a, b, out));
+
+            REQUIRE_FALSE(status.ok());
+            REQUIRE(status.errorCount == 2);
+            REQUIRE(status.firstError == 1);
+            REQUIRE(std::isnan(out[1]));
+            REQUIRE(std::isnan(out[n - 1]));
+            REQUIRE(out[0] == a[0] / b[0]);
+            REQUIRE(out[2] == a[2] / b[2]);
+        }
+    }
+
+    SECTION("Zero scalar divisor flags every element") {
+        const auto a = makeInput(10, 1.0, 1.0);
+        std::vector<double> out(10);
+        const auto status = Calculator::divide(a, 0.0, out);
+        REQUIRE(status.errorCount == 10);
+        REQUIRE(status.firstError == 0);
+        for (const double value : out) {
+            REQUIRE(std::isnan(value));
+        }
+    }
+
+    SECTION("Empty batch with zero divisor") {
+        std::vector<double> empty;
+        const auto status = Calculator::divide(empty, 0.0, empty);
+        REQUIRE(status.ok());
+        REQUIRE(status.firstError == Calculator::BatchStatus::npos);
+    }
+}
+
+TEST_CASE("Calculator batch - mismatched sizes throw", "[math][batch]") {
+    const std::vector<double> a(4, 1.0);
+    const std::vector<double> b(3, 1.0);
+    std::vector<double> out(4);
+    REQUIRE_THROWS_AS(Calculator::add(a, b, out), std::invalid_argument);
+    REQUIRE_THROWS_AS(Calculator::multiply(b, 2.0, out), std::invalid_argument);
+}
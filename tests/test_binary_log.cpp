@@ -0,0 +1,250 @@
+#include "logger/binary_log_reader.hpp"
+#include "logger/logger.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MathEngine;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+/**
+ * @brief Opens a binary log under the temp directory and removes its
+ *        segments afterwards
+ */
+class ScopedBinaryLog {
+public:
+    explicit ScopedBinaryLog(std::size_t segmentSize = std::size_t{1} << 20,
+                             std::size_t maxSegments = 0,
+                             BinaryLog::Clock clock = BinaryLog::Clock::Steady) {
+        options_.path = (std::filesystem::temp_directory_path() /
+                         ("mathengine_test_" + processTag() + "_" + std::to_string(counter_++) + ".blog"))
+                            .string();
+        options_.segmentSize = segmentSize;
+        options_.maxSegments = maxSegments;
+        options_.clock = clock;
+        BinaryLog::open(options_);
+    }
+
+    ~ScopedBinaryLog() {
+        BinaryLog::close();
+        for (std::size_t i = 0; i < 1000; ++i) {
+            std::remove(BinaryLog::segmentPath(options_.path, i).c_str());
+        }
+    }
+
+    std::string segment(std::size_t index) const {
+        return BinaryLog::segmentPath(options_.path, index);
+    }
+
+    bool exists(std::size_t index) const {
+        return std::filesystem::exists(segment(index));
+    }
+
+    /// Close the log and decode every segment that is left, in order
+    std::vector<BinaryLogReader::Entry> readAll() const {
+        BinaryLog::close();
+        std::vector<BinaryLogReader::Entry> entries;
+        for (std::size_t i = 0; i < 1000; ++i) {
+            if (!exists(i)) {
+                continue;
+            }
+            BinaryLogReader reader(segment(i));
+            BinaryLogReader::Entry entry;
+            while (reader.next(entry)) {
+                entries.push_back(entry);
+            }
+        }
+        return entries;
+    }
+
+private:
+    /// Tells apart test_math processes run concurrently (ctest -j, per-tier runs)
+    static const std::string& processTag() {
+        static const std::string tag = std::to_string(std::random_device{}());
+        return tag;
+    }
+
+    static inline int counter_ = 0;
+    BinaryLog::Options options_;
+};
+
+} // namespace
+
+// The output checks below need every level compiled in
+#if MATHENGINE_LOG_LEVEL == 0
+
+// ============================================================================
+// Test Suite: Round Trip
+// ============================================================================
+
+TEST_CASE("BinaryLog - macros record and decode to the text they would print", "[logger][binary]") {
+    ScopedBinaryLog log;
+    REQUIRE(BinaryLog::isOpen());
+
+    const std::string name = "dot";
+    MATHENGINE_LOG_INFO("Calculating: {} + {}", 1.5, 2.25);
+    MATHENGINE_LOG_WARNING("{} of {} ({:.1f}%) {} {}", std::size_t{3}, -7, 42.5f, name, true);
+    MATHENGINE_LOG_ERROR("Division by zero attempted!");
+    MATHENGINE_LOG_DEBUG([] { return std::string("lazy ") + "message"; });
+    MATHENGINE_LOG_INFO("{:>6}|{:x}|{}", 'c', 255u, std::int64_t{-1} << 40);
+
+    const auto entries = log.readAll();
+    REQUIRE(entries.size() == 5);
+    REQUIRE(entries[0].message == "Calculating: 1.5 + 2.25");
+    REQUIRE(entries[0].level == Logger::Level::INFO);
+    REQUIRE(entries[1].message == "3 of -7 (42.5%) dot true");
+    REQUIRE(entries[1].level == Logger::Level::WARNING);
+    REQUIRE(entries[2].message == "Division by zero attempted!");
+    REQUIRE(entries[3].message == "lazy message");
+    REQUIRE(entries[3].level == Logger::Level::DEBUG);
+    REQUIRE(entries[4].message == fmt::format("{:>6}|{:x}|{}", 'c', 255u, std::int64_t{-1} << 40));
+
+    REQUIRE_THAT(entries[0].file, ContainsSubstring("test_binary_log.cpp"));
+    REQUIRE(entries[0].line > 0);
+}
+
+TEST_CASE("BinaryLog - decoded lines carry wall-clock time and level", "[logger][binary]") {
+    const auto before = std::chrono::system_clock::now();
+    ScopedBinaryLog log(std::size_t{1} << 20, 0, BinaryLog::Clock::Tsc);
+    MATHENGINE_LOG_INFO("Result: {}", 42);
+    const auto entries = log.readAll();
+    const auto after = std::chrono::system_clock::now();
+
+    REQUIRE(entries.size() == 1);
+    const auto toNs = [](auto time) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    };
+    // Generous slack: TSC calibration over a few milliseconds is approximate
+    REQUIRE(entries[0].timeNs >= toNs(before) - 50'000'000);
+    REQUIRE(entries[0].timeNs <= toNs(after) + 50'000'000);
+
+    const std::string line = BinaryLogReader::formatLine(entries[0], true);
+    REQUIRE_THAT(line, ContainsSubstring("[INFO] Result: 42 ("));
+    REQUIRE_THAT(line, ContainsSubstring("test_binary_log.cpp:"));
+}
+
+TEST_CASE("BinaryLog - runtime level still filters", "[logger][binary]") {
+    const auto previous = Logger::getLevel();
+    ScopedBinaryLog log;
+    Logger::setLevel(Logger::Level::WARNING);
+    MATHENGINE_LOG_INFO("filtered {}", 1);
+    MATHENGINE_LOG_WARNING("kept {}", 2);
+    Logger::setLevel(previous);
+
+    const auto entries = log.readAll();
+    REQUIRE(entries.size() == 1);
+    REQUIRE(entries[0].message == "kept 2");
+}
+
+// ============================================================================
+// Test Suite: Segments
+// ============================================================================
+
+TEST_CASE("BinaryLog - rotation keeps every segment decodable", "[logger][binary]") {
+    ScopedBinaryLog log(4096);
+    for (int i = 0; i < 1000; ++i) {
+        MATHENGINE_LOG_INFO("record {} of {}", i, "many");
+    }
+    REQUIRE(log.exists(1));
+
+    // Each segment repeats the format definitions it needs
+    BinaryLog::close();
+    BinaryLogReader second(log.segment(1));
+    BinaryLogReader::Entry entry;
+    REQUIRE(second.next(entry));
+    REQUIRE_THAT(entry.message, ContainsSubstring(" of many"));
+
+    const auto entries = log.readAll();
+    REQUIRE(entries.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(entries[i].message == fmt::format("record {} of many", i));
+    }
+}
+
+TEST_CASE("BinaryLog - only the newest maxSegments are kept", "[logger][binary]") {
+    ScopedBinaryLog log(4096, 2);
+    for (int i = 0; i < 2000; ++i) {
+        MATHENGINE_LOG_INFO("record {}", i);
+    }
+    BinaryLog::close();
+
+    REQUIRE_FALSE(log.exists(0));
+    std::size_t newest = 0;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        newest = log.exists(i) ? i : newest;
+    }
+    REQUIRE(newest >= 2);
+    REQUIRE(log.exists(newest - 1));
+    REQUIRE_FALSE(log.exists(newest - 2));
+
+    // The last record survives in the newest segment
+    const auto entries = log.readAll();
+    REQUIRE(entries.back().message == "record 1999");
+}
+
+TEST_CASE("BinaryLog - records larger than a segment are dropped and counted", "[logger][binary]") {
+    ScopedBinaryLog log(4096);
+    const auto dropped = BinaryLog::droppedCount();
+    MATHENGINE_LOG_INFO("{}", std::string(8192, 'x'));
+    MATHENGINE_LOG_INFO("small {}", 1);
+
+    REQUIRE(BinaryLog::droppedCount() == dropped + 1);
+    const auto entries = log.readAll();
+    REQUIRE(entries.size() == 1);
+    REQUIRE(entries[0].message == "small 1");
+}
+
+TEST_CASE("BinaryLog - concurrent writers lose no records", "[logger][binary]") {
+    ScopedBinaryLog log(std::size_t{64} << 10);
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                MATHENGINE_LOG_INFO("thread {} record {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto entries = log.readAll();
+    REQUIRE(entries.size() == kThreads * kPerThread);
+}
+
+TEST_CASE("BinaryLog - closing returns the macros to text output", "[logger][binary]") {
+    {
+        ScopedBinaryLog log;
+    }
+    REQUIRE_FALSE(BinaryLog::isOpen());
+}
+
+#endif // MATHENGINE_LOG_LEVEL == 0
+
+TEST_CASE("BinaryLogReader - rejects files that are not binary logs", "[logger][binary]") {
+    const auto path = (std::filesystem::temp_directory_path() / "mathengine_not_a_log.txt").string();
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        REQUIRE(file != nullptr);
+        std::fputs("plain text, not a binary log", file);
+        std::fclose(file);
+    }
+    REQUIRE_THROWS_AS(BinaryLogReader(path), std::runtime_error);
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS_AS(BinaryLogReader(path), std::runtime_error);
+}
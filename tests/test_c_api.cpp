@@ -0,0 +1,113 @@
+#include "math/c_api.h"
+#include "math/calculator.hpp"
+#include "math/reduction.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace MathEngine;
+
+// ============================================================================
+// Test Suite: Batch Operations
+// ============================================================================
+
+TEST_CASE("C API - batch operations work on the caller's arrays", "[c_api]") {
+    std::vector<double> a(1000), b(1000);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = 0.5 * static_cast<double>(i) - 100.0;
+        b[i] = 1.0 + static_cast<double>(i % 17);
+    }
+    std::vector<double> out(a.size()), expected(a.size());
+
+    REQUIRE(mathengine_add(a.data(), b.data(), out.data(), a.size()) == MATHENGINE_OK);
+    Calculator::add(a, b, expected);
+    REQUIRE(out == expected);
+
+    REQUIRE(mathengine_multiply_scalar(a.data(), 3.0, out.data(), a.size()) == MATHENGINE_OK);
+    Calculator::multiply(a, 3.0, expected);
+    REQUIRE(out == expected);
+
+    REQUIRE(mathengine_power(a.data(), -3, out.data(), a.size()) == MATHENGINE_OK);
+    Calculator::power(a, -3, expected);
+    REQUIRE(out == expected);
+
+    // In place, as with the C++ batch operations
+    std::vector<double> inPlace = a;
+    REQUIRE(mathengine_subtract(inPlace.data(), b.data(), inPlace.data(), a.size()) == MATHENGINE_OK);
+    Calculator::subtract(a, b, expected);
+    REQUIRE(inPlace == expected);
+}
+
+TEST_CASE("C API - division reports zero denominators", "[c_api]") {
+    const double a[] = {1.0, 2.0, 3.0, 4.0};
+    const double b[] = {2.0, 0.0, 4.0, 0.0};
+    double out[4];
+
+    mathengine_batch_status status{};
+    REQUIRE(mathengine_divide(a, b, out, 4, &status) == MATHENGINE_OK);
+    REQUIRE(status.error_count == 2);
+    REQUIRE(status.first_error == 1);
+    REQUIRE(out[0] == 0.5);
+    REQUIRE(std::isnan(out[3]));
+
+    REQUIRE(mathengine_divide_scalar(a, 4.0, out, 4, &status) == MATHENGINE_OK);
+    REQUIRE(status.error_count == 0);
+    REQUIRE(status.first_error == SIZE_MAX);
+    REQUIRE(out[2] == 0.75);
+
+    // The status is optional
+    REQUIRE(mathengine_divide_scalar(a, 0.0, out, 4, nullptr) == MATHENGINE_OK);
+    REQUIRE(std::isnan(out[0]));
+}
+
+// ============================================================================
+// Test Suite: Reductions and Errors
+// ============================================================================
+
+TEST_CASE("C API - reductions match Reduction", "[c_api]") {
+    std::vector<double> values(50'000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::sin(static_cast<double>(i));
+    }
+
+    double result = 0.0;
+    REQUIRE(mathengine_sum(values.data(), values.size(), MATHENGINE_REDUCTION_DETERMINISTIC, &result) ==
+            MATHENGINE_OK);
+    REQUIRE(result == Reduction::sum(values));
+
+    REQUIRE(mathengine_dot(values.data(), values.data(), values.size(), MATHENGINE_REDUCTION_FAST, &result) ==
+            MATHENGINE_OK);
+    REQUIRE(result == Reduction::dot(values, values, {ReductionMode::Fast}));
+
+    REQUIRE(mathengine_max(values.data(), values.size(), MATHENGINE_REDUCTION_DETERMINISTIC, &result) ==
+            MATHENGINE_OK);
+    REQUIRE(result == Reduction::max(values));
+}
+
+TEST_CASE("C API - errors come back as statuses, never as exceptions", "[c_api]") {
+    double out[2];
+    double result = 0.0;
+
+    REQUIRE(mathengine_add(nullptr, nullptr, out, 2) == MATHENGINE_ERROR_INVALID_ARGUMENT);
+    REQUIRE(std::string(mathengine_last_error()).find("NULL") != std::string::npos);
+
+    // NULL is fine for an empty range
+    REQUIRE(mathengine_add(nullptr, nullptr, nullptr, 0) == MATHENGINE_OK);
+
+    REQUIRE(mathengine_min(nullptr, 0, MATHENGINE_REDUCTION_DETERMINISTIC, &result) ==
+            MATHENGINE_ERROR_INVALID_ARGUMENT);
+    REQUIRE(std::string(mathengine_last_error()) == "Cannot reduce an empty span");
+
+    const double values[] = {1.0, 2.0};
+    REQUIRE(mathengine_sum(values, 2, 7, &result) == MATHENGINE_ERROR_INVALID_ARGUMENT);
+    REQUIRE(mathengine_sum(values, 2, MATHENGINE_REDUCTION_FAST, nullptr) == MATHENGINE_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_CASE("C API - version and kernel tier", "[c_api]") {
+    REQUIRE(std::string(mathengine_version()) == "1.0.0");
+    REQUIRE(std::string(mathengine_kernel_tier()).size() > 0);
+}
@@ -0,0 +1,175 @@
+#include "math/calculator.hpp"
+#include "math/executor.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+
+// ============================================================================
+// Test Suite: Scalar Chains
+// ============================================================================
+
+TEST_CASE("Calculator chain - matches the static operations step by step", "[chain]") {
+    const double x = 1.1;
+    Calculator c{x};
+    c.add(2.3).multiply(0.7).subtract(0.05).divide(3.0).power(5);
+    REQUIRE(c.steps() == 5);
+
+    const double expected = Calculator::power(
+        Calculator::divide(Calculator::subtract(Calculator::multiply(Calculator::add(x, 2.3), 0.7), 0.05),
+                           3.0),
+        5);
+    REQUIRE(c.value() == expected);
+}
+
+TEST_CASE("Calculator chain - steps are recorded lazily and run incrementally", "[chain]") {
+    Calculator c{2.0};
+    REQUIRE(c.value() == 2.0);
+
+    c.add(1.0);
+    REQUIRE(c.value() == 3.0);
+    c.power(2).subtract(1.0);
+    REQUIRE(c.value() == 8.0);
+    REQUIRE(c.value() == 8.0);
+
+    c.reset(-1.0);
+    REQUIRE(c.steps() == 0);
+    REQUIRE(c.multiply(4.0).value() == -4.0);
+
+    Calculator zero;
+    REQUIRE(zero.add(1.5).value() == 1.5);
+}
+
+TEST_CASE("Calculator chain - does not touch the last result", "[chain]") {
+    Calculator::add(40.0, 2.0);
+    Calculator c{1.0};
+    c.add(1.0).multiply(10.0);
+    REQUIRE(c.value() == 20.0);
+    REQUIRE(Calculator::getLastResult() == 42.0);
+}
+
+TEST_CASE("Calculator chain - division by zero", "[chain]") {
+    Calculator c{6.0};
+    c.add(2.0).divide(0.0).add(1.0);
+    REQUIRE_THROWS_AS(c.value(), std::invalid_argument);
+
+    const auto result = c.tryValue();
+    REQUIRE_FALSE(result.has_value());
+    REQUIRE(result.error() == MathError::DivisionByZero);
+
+    Calculator ok{6.0};
+    const auto value = ok.divide(4.0).tryValue();
+    REQUIRE(value.has_value());
+    REQUIRE(*value == 1.5);
+}
+
+TEST_CASE("Calculator chain - long chains spill past the inline steps", "[chain]") {
+    Calculator c{1.0};
+    double expected = 1.0;
+    for (int i = 0; i < 40; ++i) {
+        c.add(0.25).multiply(1.01);
+        expected = Calculator::multiply(Calculator::add(expected, 0.25), 1.01);
+        if (i % 7 == 0) {
+            REQUIRE(c.value() == expected);
+        }
+    }
+    REQUIRE(c.steps() == 80);
+    REQUIRE(c.value() == expected);
+
+    const std::vector<double> in{1.0, 2.0};
+    std::vector<double> out(in.size());
+    REQUIRE(c.evaluate(in, out).ok());
+    REQUIRE(out[0] == expected);
+
+    Calculator copy = c;
+    copy.reset(1.0);
+    REQUIRE(copy.steps() == 0);
+    REQUIRE(c.steps() == 80);
+}
+
+TEST_CASE("Calculator chain - copies are independent", "[chain]") {
+    Calculator a{3.0};
+    a.multiply(2.0);
+    Calculator b = a;
+    b.add(1.0);
+    REQUIRE(a.value() == 6.0);
+    REQUIRE(b.value() == 7.0);
+}
+
+// ============================================================================
+// Test Suite: Span Chains
+// ============================================================================
+
+TEST_CASE("Calculator chain - evaluate runs the chain per element", "[chain]") {
+    // Not a multiple of the tile size, so the last tile is partial
+    std::vector<double> in(1000);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = 0.01 * static_cast<double>(i) - 3.0;
+    }
+
+    Calculator c;
+    c.add(0.5).multiply(1.25).power(3).divide(7.0).subtract(2.0).power(-1);
+
+    std::vector<double> out(in.size());
+    const auto status = c.evaluate(in, out);
+    REQUIRE(status.ok());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        Calculator scalar{in[i]};
+        scalar.add(0.5).multiply(1.25).power(3).divide(7.0).subtract(2.0).power(-1);
+        REQUIRE(out[i] == scalar.value());
+    }
+
+    // In place gives the same results
+    c.evaluate(in, in);
+    REQUIRE(in == out);
+}
+
+TEST_CASE("Calculator chain - evaluate with no steps copies the input", "[chain]") {
+    const std::vector<double> in{1.0, -2.0, 3.5};
+    std::vector<double> out(in.size());
+    REQUIRE(Calculator{}.evaluate(in, out).ok());
+    REQUIRE(out == in);
+}
+
+TEST_CASE("Calculator chain - evaluate reports zero divisors", "[chain]") {
+    const std::vector<double> in{1.0, 2.0, 3.0, 4.0};
+    std::vector<double> out(in.size());
+
+    Calculator c;
+    c.add(1.0).divide(0.0).divide(1e-12);
+    const auto status = c.evaluate(in, out);
+    REQUIRE(status.errorCount == 2 * in.size());
+    REQUIRE(status.firstError == 0);
+    for (const double value : out) {
+        REQUIRE(std::isnan(value));
+    }
+
+    std::vector<double> wrong(3);
+    REQUIRE_THROWS_AS(c.evaluate(in, wrong), std::invalid_argument);
+}
+
+TEST_CASE("Calculator chain - evaluate splits large spans over the Executor", "[chain]") {
+    Executor executor(ExecutorOptions{3, false});
+    Executor::setGlobal(&executor);
+
+    std::vector<double> in(300'000);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<double>(i % 1000) * 0.5;
+    }
+    std::vector<double> out(in.size());
+
+    Calculator c;
+    c.multiply(2.0).add(1.0).power(2);
+    REQUIRE(c.evaluate(in, out).ok());
+    Executor::setGlobal(nullptr);
+
+    for (std::size_t i = 0; i < in.size(); i += 997) {
+        const double expected = Calculator::power(in[i] * 2.0 + 1.0, 2);
+        REQUIRE(out[i] == expected);
+    }
+}
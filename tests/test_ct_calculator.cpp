@@ -0,0 +1,112 @@
+#include "math/calculator.hpp"
+#include "math/ct_calculator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+using Ct = ct::Calculator;
+
+// ============================================================================
+// Test Suite: Compile-Time Evaluation
+// ============================================================================
+
+// Constant inputs give constant results: these are checked by the compiler
+static_assert(Ct::evaluate(Ct::add(1.5, 2.25)) == 3.75);
+static_assert(Ct::evaluate(Ct::subtract(10, 3)) == 7.0);
+static_assert(Ct::evaluate(Ct::add(Ct::multiply(2.0, 3.0), 1.0)) == 7.0);
+static_assert(Ct::evaluate(Ct::divide(Ct::power<10>(2.0), 4.0)) == 256.0);
+static_assert(Ct::evaluate(Ct::power(2.0, -2)) == 0.25);
+static_assert(Ct::evaluate(Ct::power<3>(Ct::subtract(5.0, 3.0))) == 8.0);
+
+// Expressions are plain values, not heap-allocated trees
+static_assert(sizeof(Ct::add(Ct::multiply(1.0, 2.0), 3.0)) == 3 * sizeof(double));
+
+TEST_CASE("ct::Calculator - scalar chains match the out-of-line Calculator", "[ct]") {
+    const double x = 1.1;
+    const double y = 2.3;
+    REQUIRE(Ct::evaluate(Ct::add(x, y)) == Calculator::add(x, y));
+    REQUIRE(Ct::evaluate(Ct::subtract(x, y)) == Calculator::subtract(x, y));
+    REQUIRE(Ct::evaluate(Ct::multiply(x, y)) == Calculator::multiply(x, y));
+    REQUIRE(Ct::evaluate(Ct::divide(x, y)) == Calculator::divide(x, y));
+    REQUIRE(Ct::evaluate(Ct::power(x, 7)) == Calculator::power(x, 7));
+    REQUIRE(Ct::evaluate(Ct::power<-3>(y)) == Calculator::power(y, -3));
+}
+
+TEST_CASE("ct::Calculator - multiply-add is fused where the target has an FMA", "[ct]") {
+    // 0.1 * 10 - 1 rounds to exactly 0 unfused, but not fused
+    const double a = 0.1;
+    const double b = 10.0;
+    const double c = -1.0;
+    const double left = Ct::evaluate(Ct::add(Ct::multiply(a, b), c));
+    const double right = Ct::evaluate(Ct::add(c, Ct::multiply(a, b)));
+#if MATHENGINE_CT_FMA
+    REQUIRE(left == std::fma(a, b, c));
+    REQUIRE(left != 0.0);
+#else
+    REQUIRE(left == a * b + c);
+#endif
+    REQUIRE(right == left);
+}
+
+TEST_CASE("ct::Calculator - scalar division by zero throws like Calculator::divide", "[ct]") {
+    REQUIRE_THROWS_AS(Ct::evaluate(Ct::divide(1.0, 0.0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(Ct::evaluate(Ct::add(1.0, Ct::divide(1.0, 1e-12))), std::invalid_argument);
+}
+
+// ============================================================================
+// Test Suite: Columns
+// ============================================================================
+
+TEST_CASE("ct::Calculator - column chains are evaluated in one pass", "[ct]") {
+    const std::vector<double> x = {1.0, 2.0, 3.0, 4.0};
+    const std::array<double, 4> y = {0.5, 0.25, 2.0, -1.0};
+    std::vector<double> out(x.size());
+
+    // (x * y + 1) / x^2, mixing columns and numbers
+    const auto expression = Ct::divide(Ct::add(Ct::multiply(x, y), 1.0), Ct::power<2>(x));
+    REQUIRE(Ct::evaluate(expression, out) == 0);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        const double expected = Ct::evaluate(
+            Ct::divide(Ct::add(Ct::multiply(x[i], y[i]), 1.0), Ct::power<2>(x[i])));
+        REQUIRE(out[i] == expected);
+    }
+}
+
+TEST_CASE("ct::Calculator - column division by zero gives NaN and is counted", "[ct]") {
+    const std::vector<double> a = {1.0, 2.0, 3.0, 4.0};
+    const std::vector<double> b = {1.0, 0.0, 0.0, 4.0};
+    std::vector<double> out(a.size());
+
+    REQUIRE(Ct::evaluate(Ct::divide(a, b), out) == 2);
+    REQUIRE(out[0] == 1.0);
+    REQUIRE(std::isnan(out[1]));
+    REQUIRE(std::isnan(out[2]));
+    REQUIRE(out[3] == 1.0);
+}
+
+TEST_CASE("ct::Calculator - sizes are checked", "[ct]") {
+    const std::vector<double> a(4, 1.0);
+    const std::vector<double> b(3, 1.0);
+    std::vector<double> out(4);
+
+    REQUIRE_THROWS_AS(Ct::evaluate(Ct::add(a, b), out), std::invalid_argument);
+    REQUIRE_THROWS_AS(Ct::evaluate(Ct::add(a, 1.0), std::span<double>(out).first(2)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(Ct::evaluate(Ct::add(a, 1.0)), std::invalid_argument);
+
+    // A scalar-only expression fills the output
+    REQUIRE(Ct::evaluate(Ct::multiply(2.0, 3.0), out) == 0);
+    REQUIRE(out == std::vector<double>(4, 6.0));
+}
+
+TEST_CASE("ct::Calculator - does not touch the last result", "[ct]") {
+    Calculator::add(40.0, 2.0);
+    REQUIRE(Ct::evaluate(Ct::add(1.0, 2.0)) == 3.0);
+    REQUIRE(Calculator::getLastResult() == 42.0);
+}
@@ -0,0 +1,172 @@
+#include "math/calculator.hpp"
+#include "math/executor.hpp"
+#include "math/expression.hpp"
+#include "math/reduction.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+/**
+ * @brief Installs an executor as the global pool for the lifetime of the object
+ */
+class ScopedGlobalExecutor {
+public:
+    explicit ScopedGlobalExecutor(std::size_t workers)
+        : executor_(ExecutorOptions{workers, false}) {
+        Executor::setGlobal(&executor_);
+    }
+    ~ScopedGlobalExecutor() { Executor::setGlobal(nullptr); }
+
+    Executor& get() { return executor_; }
+
+private:
+    Executor executor_;
+};
+
+} // namespace
+
+// ============================================================================
+// Test Suite: parallelFor
+// ============================================================================
+
+TEST_CASE("Executor - parallelFor visits every index exactly once", "[executor]") {
+    Executor executor(ExecutorOptions{3, false});
+    REQUIRE(executor.concurrency() == 4);
+
+    constexpr std::size_t kSize = 100'000;
+    std::vector<std::atomic<int>> visits(kSize);
+    executor.parallelFor(kSize, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::size_t wrong = 0;
+    for (const auto& count : visits) {
+        wrong += count.load() != 1 ? 1 : 0;
+    }
+    REQUIRE(wrong == 0);
+
+    bool called = false;
+    executor.parallelFor(0, 1, [&](std::size_t, std::size_t) { called = true; });
+    REQUIRE_FALSE(called);
+}
+
+TEST_CASE("Executor - nested parallelFor completes", "[executor]") {
+    Executor executor(ExecutorOptions{2, false});
+    std::atomic<std::size_t> total{0};
+
+    executor.parallelFor(64, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            executor.parallelFor(1000, 10, [&](std::size_t b, std::size_t e) {
+                total.fetch_add(e - b, std::memory_order_relaxed);
+            });
+        }
+    });
+
+    REQUIRE(total.load() == 64 * 1000);
+}
+
+TEST_CASE("Executor - exceptions reach the caller after all ranges ran", "[executor]") {
+    Executor executor(ExecutorOptions{2, false});
+    std::atomic<std::size_t> processed{0};
+
+    REQUIRE_THROWS_AS(executor.parallelFor(1000, 1, [&](std::size_t begin, std::size_t end) {
+        processed.fetch_add(end - begin);
+        if (begin == 0) {
+            throw std::runtime_error("first range failed");
+        }
+    }), std::runtime_error);
+    REQUIRE(processed.load() == 1000);
+}
+
+TEST_CASE("Executor - parallelForAsync calls done once, after every range", "[executor]") {
+    Executor executor(ExecutorOptions{3, false});
+    std::atomic<std::size_t> processed{0};
+    std::promise<std::size_t> seen;
+    std::promise<std::exception_ptr> failure;
+
+    auto body = [&](std::size_t begin, std::size_t end) {
+        processed.fetch_add(end - begin);
+        if (begin == 0) {
+            throw std::runtime_error("first range failed");
+        }
+    };
+    auto done = [&](std::exception_ptr error) {
+        seen.set_value(processed.load());
+        failure.set_value(std::move(error));
+    };
+    executor.parallelForAsync(10'000, 1, body, done);
+
+    REQUIRE(seen.get_future().get() == 10'000);
+    REQUIRE_THROWS_AS(std::rethrow_exception(failure.get_future().get()), std::runtime_error);
+
+    // An empty range is done before parallelForAsync returns
+    bool finished = false;
+    auto none = [](std::size_t, std::size_t) {};
+    auto mark = [&](std::exception_ptr error) { finished = error == nullptr; };
+    executor.parallelForAsync(0, 1, none, mark);
+    REQUIRE(finished);
+}
+
+TEST_CASE("Executor - a destroyed global pool uninstalls itself", "[executor]") {
+    {
+        auto executor = std::make_unique<Executor>(ExecutorOptions{1, true});
+        Executor::setGlobal(executor.get());
+        REQUIRE(Executor::global() == executor.get());
+    }
+    REQUIRE(Executor::global() == nullptr);
+}
+
+// ============================================================================
+// Test Suite: Library Paths on the Global Pool
+// ============================================================================
+
+TEST_CASE("Executor - library results do not depend on the pool", "[executor][batch]") {
+    // Large enough to be split into several tasks
+    constexpr std::size_t kSize = 300'001;
+    std::vector<double> a(kSize), b(kSize);
+    for (std::size_t i = 0; i < kSize; ++i) {
+        a[i] = std::sin(static_cast<double>(i)) * 100.0;
+        b[i] = (i % 1000 == 999) ? 0.0 : std::cos(static_cast<double>(i)) + 2.0;
+    }
+
+    const Expression expression("a * b - a / b");
+    const std::vector<std::span<const double>> columns = {a, b};
+
+    std::vector<double> serialAdd(kSize), serialDivide(kSize), serialExpression(kSize);
+    Calculator::add(a, b, serialAdd);
+    const auto serialStatus = Calculator::divide(a, b, serialDivide);
+    const auto serialExprStatus = expression.evaluate(columns, serialExpression);
+    const double serialSum = Reduction::sum(a);
+
+    ScopedGlobalExecutor pool(3);
+    std::vector<double> parallelAdd(kSize), parallelDivide(kSize), parallelExpression(kSize);
+    Calculator::add(a, b, parallelAdd);
+    const auto status = Calculator::divide(a, b, parallelDivide);
+    const auto exprStatus = expression.evaluate(columns, parallelExpression);
+
+    REQUIRE(parallelAdd == serialAdd);
+    REQUIRE(status.errorCount == serialStatus.errorCount);
+    REQUIRE(status.firstError == 999);
+    REQUIRE(exprStatus.errorCount == serialExprStatus.errorCount);
+    REQUIRE(exprStatus.firstError == 999);
+    for (std::size_t i = 0; i < kSize; i += 997) {
+        REQUIRE((parallelDivide[i] == serialDivide[i] ||
+                 (std::isnan(parallelDivide[i]) && std::isnan(serialDivide[i]))));
+    }
+    REQUIRE(Reduction::sum(a) == serialSum);
+}
@@ -0,0 +1,168 @@
+#include "math/expression.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace MathEngine;
+using Catch::Matchers::ContainsSubstring;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+double eval(std::string_view source, std::vector<double> values = {}) {
+    return Expression(source).evaluate(values);
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Parsing and Single Evaluation
+// ============================================================================
+
+TEST_CASE("Expression - operator precedence and associativity", "[math][expression]") {
+    REQUIRE(eval("1 + 2 * 3") == 7.0);
+    REQUIRE(eval("(1 + 2) * 3") == 9.0);
+    REQUIRE(eval("10 - 4 - 3") == 3.0);
+    REQUIRE(eval("24 / 4 / 2") == 3.0);
+    REQUIRE(eval("2 ^ 3 ^ 2") == 512.0);
+    REQUIRE(eval("-2 ^ 2") == -4.0);
+    REQUIRE(eval("2 ^ -2") == 0.25);
+    REQUIRE(eval("- -3 + +1") == 4.0);
+    REQUIRE(eval("1.5e2 + .5") == 150.5);
+}
+
+TEST_CASE("Expression - variables bind in order of first appearance", "[math][expression]") {
+    const Expression expr("y * 2 + x - y");
+    REQUIRE(expr.variables() == std::vector<std::string>{"y", "x"});
+    REQUIRE(expr.variableIndex("x") == 1);
+    REQUIRE_THROWS_AS(expr.variableIndex("z"), std::invalid_argument);
+
+    const std::vector<double> values = {3.0, 10.0};
+    REQUIRE(expr.evaluate(values) == 13.0);
+    REQUIRE(Expression("x ^ 3").evaluate(std::vector<double>{-2.0}) ==
+            Calculator::integerPower(-2.0, 3));
+}
+
+TEST_CASE("Expression - constant sub-expressions are folded", "[math][expression]") {
+    REQUIRE(Expression("2 * 3 + 4 ^ 2").instructionCount() == 1);
+    REQUIRE(Expression("x * (2 + 3)").instructionCount() == 3);
+    // Division by a zero constant is kept so it is reported at evaluation
+    REQUIRE(Expression("1 / 0").instructionCount() == 3);
+}
+
+TEST_CASE("Expression - syntax errors are reported", "[math][expression]") {
+    REQUIRE_THROWS_AS(Expression(""), std::invalid_argument);
+    REQUIRE_THROWS_AS(Expression("1 +"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Expression("(x + 1"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Expression("x $ y"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Expression("x ^ y"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Expression("x ^ 1.5"), std::invalid_argument);
+}
+
+TEST_CASE("Expression - deep nesting fails instead of overflowing the stack", "[math][expression]") {
+    const std::string signs(300'000, '-');
+    std::string powers = "2";
+    for (int i = 0; i < 300'000; ++i) {
+        powers += "^2";
+    }
+    const std::string parens = std::string(300'000, '(') + "x" + std::string(300'000, ')');
+    for (const std::string& source : {signs + "x", powers, parens}) {
+        REQUIRE_THROWS_WITH(Expression(source), ContainsSubstring("nested too deeply"));
+    }
+
+    // Moderate nesting is still fine
+    REQUIRE(eval(std::string(100, '-') + "3") == 3.0);
+    REQUIRE(eval(std::string(100, '(') + "3" + std::string(100, ')')) == 3.0);
+}
+
+TEST_CASE("Expression - single evaluation validates its input", "[math][expression]") {
+    const Expression expr("x / y");
+    REQUIRE_THROWS_AS(expr.evaluate(std::vector<double>{1.0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(expr.evaluate(std::vector<double>{1.0, 0.0}), std::invalid_argument);
+    REQUIRE(expr.evaluate(std::vector<double>{1.0, 4.0}) == 0.25);
+}
+
+// ============================================================================
+// Test Suite: Columnar Evaluation
+// ============================================================================
+
+TEST_CASE("Expression batch - matches single evaluation row by row", "[math][expression]") {
+    const Expression expr("(x + 1) * y ^ 2 - 3 / (x - y) + 2 * -x");
+
+    // Spans several tiles plus a partial one
+    constexpr std::size_t kRows = 1000;
+    std::vector<double> x(kRows), y(kRows), out(kRows);
+    for (std::size_t i = 0; i < kRows; ++i) {
+        x[i] = 0.25 * static_cast<double>(i) - 40.0;
+        y[i] = 0.5 * static_cast<double>(i % 17) + 0.125;
+    }
+
+    const std::vector<std::span<const double>> columns = {x, y};
+    const auto status = expr.evaluate(columns, out);
+    REQUIRE(status.ok());
+
+    for (std::size_t i = 0; i < kRows; ++i) {
+        const std::vector<double> row = {x[i], y[i]};
+        REQUIRE_THAT(out[i], WithinRel(expr.evaluate(row), 1e-15));
+    }
+}
+
+TEST_CASE("Expression batch - zero denominators become NaN", "[math][expression]") {
+    constexpr std::size_t kRows = 300;
+    std::vector<double> x(kRows, 1.0), out(kRows);
+    x[5] = 0.0;
+    x[200] = 0.0;
+
+    SECTION("Column denominator") {
+        const Expression expr("2 / x");
+        const std::vector<std::span<const double>> columns = {x};
+        const auto status = expr.evaluate(columns, out);
+
+        REQUIRE(status.errorCount == 2);
+        REQUIRE(status.firstError == 5);
+        REQUIRE(std::isnan(out[5]));
+        REQUIRE(std::isnan(out[200]));
+        REQUIRE(out[6] == 2.0);
+    }
+
+    SECTION("Constant denominator") {
+        const Expression expr("x / 0");
+        const std::vector<std::span<const double>> columns = {x};
+        const auto status = expr.evaluate(columns, out);
+
+        REQUIRE(status.errorCount == kRows);
+        REQUIRE(status.firstError == 0);
+        REQUIRE(std::isnan(out[kRows - 1]));
+    }
+}
+
+TEST_CASE("Expression batch - constant and pass-through results", "[math][expression]") {
+    std::vector<double> x = {1.0, 2.0, 3.0}, out(3);
+    const std::vector<std::span<const double>> columns = {x};
+
+    REQUIRE(Expression("x").evaluate(columns, out).ok());
+    REQUIRE(out == x);
+
+    std::vector<double> constantOut(4);
+    REQUIRE(Expression("6 * 7").evaluate({}, constantOut).ok());
+    REQUIRE(constantOut == std::vector<double>(4, 42.0));
+}
+
+TEST_CASE("Expression batch - mismatched columns throw", "[math][expression]") {
+    const Expression expr("x + y");
+    std::vector<double> x(4), y(3), out(4);
+
+    const std::vector<std::span<const double>> oneColumn = {x};
+    REQUIRE_THROWS_AS(expr.evaluate(oneColumn, out), std::invalid_argument);
+
+    const std::vector<std::span<const double>> shortColumn = {x, y};
+    REQUIRE_THROWS_AS(expr.evaluate(shortColumn, out), std::invalid_argument);
+}
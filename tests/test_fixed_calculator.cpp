@@ -0,0 +1,347 @@
+#include "math/executor.hpp"
+#include "math/fixed_calculator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+using Q16 = QFormat<16>;
+using Milli = DecimalFormat<3>;
+using Q32 = QFormat<32, std::int64_t>;
+using Cents = DecimalFormat<2, std::int64_t>;
+
+OverflowPolicy overflow(bool strict) {
+    return strict ? OverflowPolicy::Throw : OverflowPolicy::Saturate;
+}
+
+DivisionPolicy division(bool strict) {
+    return strict ? DivisionPolicy::Throw : DivisionPolicy::Saturate;
+}
+
+template <typename Format>
+Fixed<Format> fx(double value) {
+    return Fixed<Format>::fromDouble(value);
+}
+
+/// Deterministic pseudo-random 64-bit values (splitmix64)
+class Bits {
+public:
+    std::uint64_t next() {
+        std::uint64_t z = (state_ += 0x9e3779b97f4a7c15u);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+        return z ^ (z >> 31);
+    }
+
+private:
+    std::uint64_t state_ = 42;
+};
+
+/// Raw values spread over the whole range, with small ones and the extremes mixed in
+template <typename Format>
+std::vector<Fixed<Format>> makeValues(std::size_t n, Bits& bits) {
+    using Raw = typename Format::RawType;
+    std::vector<Fixed<Format>> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint64_t r = bits.next();
+        const unsigned width = 1 + static_cast<unsigned>(r % std::numeric_limits<Raw>::digits);
+        const auto magnitude = static_cast<Raw>((r >> 8) & ((std::uint64_t{1} << width) - 1));
+        values[i].raw = (r & 0x80) != 0 ? static_cast<Raw>(-magnitude) : magnitude;
+    }
+    if (n > 3) {
+        values[1].raw = std::numeric_limits<Raw>::max();
+        values[2].raw = std::numeric_limits<Raw>::min();
+        values[3].raw = 0;
+    }
+    return values;
+}
+
+/**
+ * @brief Every batch operation against the scalar one, element by element
+ */
+template <typename Format>
+void checkBatchesMatchScalar() {
+    using Calc = FixedCalculator<Format>;
+    using Value = typename Calc::Value;
+    Bits bits;
+
+    for (const std::size_t n : {0u, 1u, 7u, 64u, 511u, 512u, 513u, 2000u}) {
+        const auto a = makeValues<Format>(n, bits);
+        const auto b = makeValues<Format>(n, bits);
+        const Value c = Value::fromRaw(b.empty() ? 3 : b[0].raw | 1);
+        std::vector<Value> out(n);
+
+        // scalar(i, strict): strict throws where the batch saturates and counts
+        const auto check = [&](const Calculator::BatchStatus& status, auto scalar) {
+            std::size_t errors = 0;
+            std::size_t first = Calculator::BatchStatus::npos;
+            for (std::size_t i = 0; i < n; ++i) {
+                bool failed = false;
+                Value expected;
+                try {
+                    expected = scalar(i, true);
+                } catch (const std::exception&) {
+                    failed = true;
+                    expected = scalar(i, false);
+                }
+                REQUIRE(out[i] == expected);
+                if (failed) {
+                    ++errors;
+                    first = std::min(first, i);
+                }
+            }
+            REQUIRE(status.errorCount == errors);
+            REQUIRE(status.firstError == first);
+        };
+
+        check(Calc::add(a, b, out),
+              [&](std::size_t i, bool strict) { return Calc::add(a[i], b[i], overflow(strict)); });
+        check(Calc::add(a, c, out),
+              [&](std::size_t i, bool strict) { return Calc::add(a[i], c, overflow(strict)); });
+        check(Calc::subtract(a, b, out),
+              [&](std::size_t i, bool strict) { return Calc::subtract(a[i], b[i], overflow(strict)); });
+        check(Calc::subtract(a, c, out),
+              [&](std::size_t i, bool strict) { return Calc::subtract(a[i], c, overflow(strict)); });
+        check(Calc::multiply(a, b, out),
+              [&](std::size_t i, bool strict) { return Calc::multiply(a[i], b[i], overflow(strict)); });
+        check(Calc::multiply(a, c, out),
+              [&](std::size_t i, bool strict) { return Calc::multiply(a[i], c, overflow(strict)); });
+        check(Calc::divide(a, b, out), [&](std::size_t i, bool strict) {
+            return Calc::divide(a[i], b[i], division(strict), overflow(strict));
+        });
+        check(Calc::divide(a, c, out), [&](std::size_t i, bool strict) {
+            return Calc::divide(a[i], c, division(strict), overflow(strict));
+        });
+        check(Calc::power(a, 3, out),
+              [&](std::size_t i, bool strict) { return Calc::power(a[i], 3, overflow(strict)); });
+        check(Calc::power(a, -2, out),
+              [&](std::size_t i, bool strict) { return Calc::power(a[i], -2, overflow(strict)); });
+
+        const FixedDivisor<Format> divisor(c);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(divisor.divide(a[i]) == Calc::divide(a[i], c));
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Values
+// ============================================================================
+
+static_assert(Q16::scale == 65536 && Milli::scale == 1000 && Cents::scale == 100);
+static_assert(Fixed<Q16>::fromDouble(1.5).raw == 98304);
+static_assert(Fixed<Cents>::fromDouble(19.99).raw == 1999);
+static_assert(FixedCalculator<Q16>::multiply(Fixed<Q16>::fromDouble(1.5), Fixed<Q16>::fromInteger(2)) ==
+              Fixed<Q16>::fromInteger(3));
+static_assert(FixedCalculator<Cents>::multiply(Fixed<Cents>::fromDouble(19.99),
+                                               Fixed<Cents>::fromInteger(3)).raw == 5997);
+
+TEST_CASE("Fixed - conversions round half away from zero and saturate", "[fixed]") {
+    REQUIRE(fx<Milli>(0.0005).raw == 1);
+    REQUIRE(fx<Milli>(-0.0005).raw == -1);
+    REQUIRE(fx<Milli>(0.00049).raw == 0);
+    REQUIRE(fx<Cents>(-12.345).raw == -1235);  // the scaled double is exactly -1234.5
+    REQUIRE(fx<Q16>(1e9).raw == std::numeric_limits<std::int32_t>::max());
+    REQUIRE(fx<Q16>(-1e9).raw == std::numeric_limits<std::int32_t>::min());
+    REQUIRE(fx<Q16>(std::numeric_limits<double>::quiet_NaN()).raw == 0);
+    REQUIRE(fx<Q32>(1e300).raw == std::numeric_limits<std::int64_t>::max());
+    REQUIRE(fx<Q16>(-2.25).toDouble() == -2.25);
+    REQUIRE(Fixed<Q16>::fromInteger(40000).raw == std::numeric_limits<std::int32_t>::max());
+    REQUIRE(Fixed<Cents>::fromInteger(-7).raw == -700);
+    REQUIRE(fx<Q16>(1.0) < fx<Q16>(1.5));
+}
+
+// ============================================================================
+// Test Suite: Scalar Operations
+// ============================================================================
+
+TEST_CASE("FixedCalculator - products and quotients round half away from zero", "[fixed]") {
+    using Calc = FixedCalculator<Q16>;
+    const auto half = Fixed<Q16>::fromRaw(32768);
+    REQUIRE(Calc::multiply(Fixed<Q16>::fromRaw(1), half).raw == 1);
+    REQUIRE(Calc::multiply(Fixed<Q16>::fromRaw(-1), half).raw == -1);
+    REQUIRE(Calc::multiply(Fixed<Q16>::fromRaw(1), Fixed<Q16>::fromRaw(32767)).raw == 0);
+    REQUIRE(Calc::divide(fx<Q16>(1.0), fx<Q16>(3.0)).raw == 21845);
+    REQUIRE(Calc::divide(fx<Q16>(2.0), fx<Q16>(3.0)).raw == 43691);
+    REQUIRE(Calc::divide(fx<Q16>(-2.0), fx<Q16>(3.0)).raw == -43691);
+
+    using Money = FixedCalculator<Milli>;
+    REQUIRE(Money::multiply(fx<Milli>(0.005), fx<Milli>(0.1)).raw == 1);
+    REQUIRE(Money::multiply(fx<Milli>(0.005), fx<Milli>(-0.1)).raw == -1);
+    REQUIRE(Money::divide(fx<Milli>(10.0), fx<Milli>(3.0)).raw == 3333);
+    REQUIRE(Money::divide(fx<Milli>(0.001), fx<Milli>(0.008)).raw == 125);
+    REQUIRE(Money::divide(fx<Milli>(0.001), fx<Milli>(-0.016)).raw == -63);  // -62.5
+}
+
+TEST_CASE("FixedCalculator - overflow saturates, throws, or is reported", "[fixed]") {
+    using Calc = FixedCalculator<Q16>;
+    constexpr std::int32_t kMax = std::numeric_limits<std::int32_t>::max();
+    constexpr std::int32_t kMin = std::numeric_limits<std::int32_t>::min();
+
+    REQUIRE(Calc::add(fx<Q16>(30000.0), fx<Q16>(10000.0)).raw == kMax);
+    REQUIRE(Calc::subtract(fx<Q16>(-30000.0), fx<Q16>(10000.0)).raw == kMin);
+    REQUIRE(Calc::multiply(fx<Q16>(200.0), fx<Q16>(200.0)).raw == kMax);
+    REQUIRE(Calc::multiply(fx<Q16>(-200.0), fx<Q16>(200.0)).raw == kMin);
+    REQUIRE(Calc::divide(fx<Q16>(30000.0), fx<Q16>(0.5)).raw == kMax);
+    REQUIRE(Calc::add(fx<Q16>(1.0), fx<Q16>(2.0), OverflowPolicy::Throw) == fx<Q16>(3.0));
+    REQUIRE_THROWS_AS(Calc::add(fx<Q16>(30000.0), fx<Q16>(10000.0), OverflowPolicy::Throw),
+                      std::overflow_error);
+    REQUIRE_THROWS_AS(Calc::multiply(fx<Q16>(-200.0), fx<Q16>(200.0), OverflowPolicy::Throw),
+                      std::overflow_error);
+
+    const auto result = Calc::tryMultiply(fx<Q16>(200.0), fx<Q16>(200.0));
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error() == MathError::Overflow);
+    REQUIRE(toString(result.error()) == "Result out of range");
+    REQUIRE(*Calc::trySubtract(fx<Q16>(1.0), fx<Q16>(3.0)) == fx<Q16>(-2.0));
+
+    // The most negative value has no positive counterpart
+    REQUIRE(Calc::subtract(Fixed<Q16>::fromRaw(0), Fixed<Q16>::fromRaw(kMin)).raw == kMax);
+    REQUIRE(Calc::multiply(Fixed<Q16>::fromRaw(kMin), fx<Q16>(-1.0)).raw == kMax);
+    REQUIRE(Calc::multiply(Fixed<Q16>::fromRaw(kMin), fx<Q16>(1.0)).raw == kMin);
+}
+
+TEST_CASE("FixedCalculator - division by zero follows the DivisionPolicy", "[fixed]") {
+    using Calc = FixedCalculator<Cents>;
+    constexpr std::int64_t kMax = std::numeric_limits<std::int64_t>::max();
+    const auto zero = Fixed<Cents>{};
+
+    REQUIRE_THROWS_AS(Calc::divide(fx<Cents>(1.0), zero), std::invalid_argument);
+    REQUIRE(Calc::divide(fx<Cents>(1.0), zero, DivisionPolicy::Saturate).raw == kMax);
+    REQUIRE(Calc::divide(fx<Cents>(-1.0), zero, DivisionPolicy::ReturnInf).raw == -kMax - 1);
+    REQUIRE(Calc::divide(zero, zero, DivisionPolicy::ReturnNaN).raw == 0);
+
+    const auto result = Calc::tryDivide(fx<Cents>(1.0), zero);
+    REQUIRE_FALSE(result);
+    REQUIRE(result.error() == MathError::DivisionByZero);
+    REQUIRE_THROWS_AS(FixedDivisor<Cents>(zero), std::invalid_argument);
+}
+
+TEST_CASE("FixedCalculator - power by squaring", "[fixed]") {
+    using Calc = FixedCalculator<Q16>;
+    REQUIRE(Calc::power(fx<Q16>(1.5), 3) == fx<Q16>(3.375));
+    REQUIRE(Calc::power(fx<Q16>(7.25), 0) == fx<Q16>(1.0));
+    REQUIRE(Calc::power(fx<Q16>(2.0), -2) == fx<Q16>(0.25));
+    REQUIRE(Calc::power(fx<Q16>(-2.0), 14) == fx<Q16>(16384.0));
+    REQUIRE(Calc::power(fx<Q16>(2.0), 15).raw == std::numeric_limits<std::int32_t>::max());
+    REQUIRE(Calc::power(fx<Q16>(-2.0), 15).raw == std::numeric_limits<std::int32_t>::min());
+    REQUIRE(Calc::power(fx<Q16>(300.0), -3).raw == 0);
+    REQUIRE(Calc::tryPower(Fixed<Q16>{}, -1).error() == MathError::Overflow);
+    REQUIRE_THROWS_AS(Calc::power(fx<Q16>(2.0), 20, OverflowPolicy::Throw), std::overflow_error);
+
+    // Same steps as Calculator::integerPower: b^5 = ((b * b) * (b * b)) * b
+    const auto b = fx<Q16>(1.0001);
+    const auto square = Calc::multiply(b, b);
+    REQUIRE(Calc::power(b, 5) == Calc::multiply(Calc::multiply(square, square), b));
+}
+
+TEST_CASE("FixedCalculator - 64-bit formats", "[fixed]") {
+    using Calc = FixedCalculator<Q32>;
+    REQUIRE(Calc::multiply(fx<Q32>(1e6), fx<Q32>(1e3)) == fx<Q32>(1e9));
+    REQUIRE(Calc::divide(fx<Q32>(1.0), fx<Q32>(1024.0)) == fx<Q32>(1.0 / 1024.0));
+    REQUIRE(Calc::multiply(fx<Q32>(3e6), fx<Q32>(3e6)).raw == std::numeric_limits<std::int64_t>::max());
+
+    using Money = FixedCalculator<Cents>;
+    const auto price = fx<Cents>(0.10);
+    auto total = Fixed<Cents>{};
+    for (int i = 0; i < 10; ++i) {
+        total = Money::add(total, price);
+    }
+    REQUIRE(total == fx<Cents>(1.0));  // where double gives 0.9999999999999999
+    REQUIRE(Money::divide(fx<Cents>(100.0), fx<Cents>(3.0)) == fx<Cents>(33.33));
+}
+
+// ============================================================================
+// Test Suite: Reciprocal
+// ============================================================================
+
+static_assert(detail::Reciprocal(7).divide(100) == 14);
+static_assert(detail::Reciprocal(1024).divide(5000) == 4);
+
+TEST_CASE("Reciprocal - matches hardware division", "[fixed]") {
+    std::vector<std::uint64_t> divisors = {1, 2, 3, 5, 7, 10, 100, 641, 1000, 1'000'000'000,
+                                           1'000'000'000'000'000'000u, 0xffffffffu, 0x100000001u,
+                                           std::uint64_t{1} << 63, (std::uint64_t{1} << 63) + 1,
+                                           std::numeric_limits<std::uint64_t>::max()};
+    Bits bits;
+    for (int i = 0; i < 200; ++i) {
+        const std::uint64_t r = bits.next();
+        divisors.push_back(std::max<std::uint64_t>(r >> (r % 64), 1));
+    }
+    for (const std::uint64_t d : divisors) {
+        const detail::Reciprocal reciprocal(d);
+        std::vector<std::uint64_t> dividends = {0, 1, d - 1, d, d + 1, 2 * d - 1, 2 * d,
+                                                std::numeric_limits<std::uint64_t>::max(),
+                                                std::numeric_limits<std::uint64_t>::max() - 1,
+                                                std::uint64_t{1} << 63};
+        for (int i = 0; i < 50; ++i) {
+            dividends.push_back(bits.next() >> (i % 64));
+        }
+        for (const std::uint64_t n : dividends) {
+            REQUIRE(reciprocal.divide(n) == n / d);
+        }
+    }
+}
+
+// ============================================================================
+// Test Suite: Batches
+// ============================================================================
+
+TEST_CASE("FixedCalculator batch - matches the scalar operations", "[fixed][batch]") {
+    checkBatchesMatchScalar<Q16>();
+    checkBatchesMatchScalar<Milli>();
+    checkBatchesMatchScalar<Q32>();
+    checkBatchesMatchScalar<Cents>();
+}
+
+TEST_CASE("FixedCalculator batch - zero divisors and in-place operation", "[fixed][batch]") {
+    using Calc = FixedCalculator<Q16>;
+    std::vector<Fixed<Q16>> a(1000, fx<Q16>(3.0));
+    std::vector<Fixed<Q16>> b(1000, fx<Q16>(2.0));
+    b[600] = Fixed<Q16>{};
+    a[601] = fx<Q16>(-1.0);
+    b[601] = Fixed<Q16>{};
+
+    auto status = Calc::divide(a, b, a);
+    REQUIRE(status.errorCount == 2);
+    REQUIRE(status.firstError == 600);
+    REQUIRE(a[0] == fx<Q16>(1.5));
+    REQUIRE(a[600].raw == std::numeric_limits<std::int32_t>::max());
+    REQUIRE(a[601].raw == std::numeric_limits<std::int32_t>::min());
+
+    status = Calc::divide(b, Fixed<Q16>{}, b);
+    REQUIRE(status.errorCount == 1000);
+    REQUIRE(status.firstError == 0);
+    REQUIRE(b[600].raw == 0);
+
+    std::vector<Fixed<Q16>> out(3);
+    REQUIRE_THROWS_AS(Calc::add(a, a, out), std::invalid_argument);
+}
+
+TEST_CASE("FixedCalculator batch - status is exact across executor tasks", "[fixed][batch][threads]") {
+    Executor executor(ExecutorOptions{4, false});
+    Executor::setGlobal(&executor);
+
+    using Calc = FixedCalculator<Milli>;
+    const std::size_t n = 200'000;
+    std::vector<Fixed<Milli>> a(n, fx<Milli>(1.5));
+    a[150'000] = Fixed<Milli>::fromRaw(std::numeric_limits<std::int32_t>::max());
+    a[70'001] = Fixed<Milli>::fromRaw(std::numeric_limits<std::int32_t>::max());
+    std::vector<Fixed<Milli>> out(n);
+
+    const auto status = Calc::add(a, fx<Milli>(1.0), out);
+    Executor::setGlobal(nullptr);
+    REQUIRE(status.errorCount == 2);
+    REQUIRE(status.firstError == 70'001);
+    REQUIRE(out[n - 1] == fx<Milli>(2.5));
+}
@@ -0,0 +1,95 @@
+#include "math/calculator.hpp"
+#include "math/kernel_dispatch.hpp"
+#include "math/reduction.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace MathEngine;
+
+// ============================================================================
+// Test Suite: Selection
+// ============================================================================
+// CTest runs the kernel-facing test cases once per built tier with
+// MATHENGINE_KERNEL_TIER set (MathTests_<tier>), so they cover each tier
+// the CPU supports as well.
+// ============================================================================
+
+TEST_CASE("KernelDispatch - the active tier is built and supported", "[dispatch]") {
+    const auto compiled = KernelDispatch::compiled();
+    REQUIRE(compiled.front() == KernelTier::Scalar);
+    REQUIRE(std::is_sorted(compiled.begin(), compiled.end()));
+    REQUIRE(std::find(compiled.begin(), compiled.end(), KernelDispatch::active()) != compiled.end());
+
+    REQUIRE(KernelDispatch::supported(KernelDispatch::active()));
+    REQUIRE(KernelDispatch::supported(KernelDispatch::best()));
+    REQUIRE(KernelDispatch::supported(KernelTier::Scalar));
+    REQUIRE(KernelDispatch::active() <= KernelDispatch::best());
+}
+
+TEST_CASE("KernelDispatch - the environment variable selects the tier", "[dispatch]") {
+    const auto requested = KernelDispatch::requested();
+    if (requested && KernelDispatch::supported(*requested)) {
+        REQUIRE(KernelDispatch::active() == *requested);
+    } else {
+        if (requested) {
+            WARN(toString(*requested) << " is not supported here; ran on " << toString(KernelDispatch::best()));
+        }
+        REQUIRE(KernelDispatch::active() == KernelDispatch::best());
+    }
+}
+
+TEST_CASE("KernelDispatch - tier names", "[dispatch]") {
+    for (KernelTier tier : {KernelTier::Scalar, KernelTier::SSE2, KernelTier::AVX2, KernelTier::AVX512,
+                            KernelTier::NEON}) {
+        REQUIRE(KernelDispatch::parse(toString(tier)) == tier);
+    }
+    REQUIRE_FALSE(KernelDispatch::parse("avx3").has_value());
+    REQUIRE_FALSE(KernelDispatch::parse("").has_value());
+}
+
+// ============================================================================
+// Test Suite: Results on the Active Tier
+// ============================================================================
+
+TEST_CASE("KernelDispatch - every kernel family matches the scalar definition", "[dispatch]") {
+    // Odd size: full vectors plus a tail on every tier
+    constexpr std::size_t kSize = 1037;
+    std::vector<double> a(kSize), b(kSize), out(kSize);
+    for (std::size_t i = 0; i < kSize; ++i) {
+        a[i] = 0.37 * static_cast<double>(i) - 150.0;
+        b[i] = 1.0 + static_cast<double>(i % 13);
+    }
+
+    Calculator::add(a, b, out);
+    for (std::size_t i = 0; i < kSize; ++i) {
+        REQUIRE(out[i] == a[i] + b[i]);
+    }
+
+    Calculator::multiply(a, b, out);
+    for (std::size_t i = 0; i < kSize; ++i) {
+        REQUIRE(out[i] == a[i] * b[i]);
+    }
+
+    REQUIRE(Calculator::divide(a, b, out).ok());
+    for (std::size_t i = 0; i < kSize; ++i) {
+        REQUIRE(out[i] == a[i] / b[i]);
+    }
+
+    Calculator::power(b, 3, out);
+    for (std::size_t i = 0; i < kSize; ++i) {
+        REQUIRE(out[i] == b[i] * b[i] * b[i]);
+    }
+
+    // Small integers sum exactly in any order, on every tier
+    double reference = 0.0;
+    for (double x : b) {
+        reference += x;
+    }
+    REQUIRE(Reduction::sum(b) == reference);
+    REQUIRE(Reduction::max(a) == a.back());
+}
@@ -0,0 +1,208 @@
+#include "logger/logger.hpp"
+#include "math/calculator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+// The output checks below need every level compiled in
+#if MATHENGINE_LOG_LEVEL == 0
+
+/**
+ * @brief Sends log lines to a MemorySink for the lifetime of the object
+ *
+ * Periodic summaries are turned off so that only reportAll() writes them.
+ */
+class CapturedLog {
+public:
+    CapturedLog() : previousInterval_(LogSampler::summaryInterval()) {
+        LogSampler::setSummaryInterval(std::chrono::milliseconds(0));
+        Logger::setSink(sink_);
+    }
+
+    ~CapturedLog() {
+        Logger::setSink(nullptr);
+        LogSampler::setSummaryInterval(previousInterval_);
+    }
+
+    std::size_t count(const std::string& text, const std::string& more = {}) const {
+        const auto lines = sink_->lines();
+        return static_cast<std::size_t>(std::count_if(lines.begin(), lines.end(), [&](const std::string& line) {
+            const std::size_t at = line.find(text);
+            return at != std::string::npos && line.find(more, at + text.size()) != std::string::npos;
+        }));
+    }
+
+private:
+    std::shared_ptr<MemorySink> sink_ = std::make_shared<MemorySink>();
+    std::chrono::milliseconds previousInterval_;
+};
+
+// Summaries are named after the enclosing function and the site's line
+
+void everyHundred(int i) {
+    MATHENGINE_LOG_INFO_EVERY_N(100, "every {}", i);
+}
+
+void everyMillion(int i) {
+    MATHENGINE_LOG_DEBUG_EVERY_N(1'234'567, "sparse {}", i);
+}
+
+void firstThree(int i) {
+    MATHENGINE_LOG_WARNING_FIRST_N(3, "first {}", i);
+}
+
+void firstFive(int i) {
+    MATHENGINE_LOG_INFO_FIRST_N(5, "shared {}", i);
+}
+
+void rateLimited(int i) {
+    MATHENGINE_LOG_ERROR_RATE_LIMITED("limited {}", i);
+}
+
+void twoSites(int i) {
+    MATHENGINE_LOG_INFO_EVERY_N(10, "first site {}", i);
+    MATHENGINE_LOG_INFO_EVERY_N(10, "second site {}", i);
+}
+
+#endif // MATHENGINE_LOG_LEVEL == 0
+
+} // namespace
+
+#if MATHENGINE_LOG_LEVEL == 0
+
+// ============================================================================
+// Test Suite: Sampling Policies
+// ============================================================================
+
+TEST_CASE("Log sampling - every N writes the first of each N", "[logger][sampling]") {
+    CapturedLog log;
+    // Ends on a written call, so every call has been published
+    for (int i = 0; i <= 900; ++i) {
+        everyHundred(i);
+    }
+
+    REQUIRE(log.count("every ") == 10);
+    REQUIRE(log.count("every 0") == 1);
+    REQUIRE(log.count("every 900") == 1);
+    REQUIRE(log.count("every 150") == 0);
+
+    LogSampler::reportAll();
+    REQUIRE(log.count("[INFO] everyHundred:", " called 901 times, 10 logged") == 1);
+
+    // Nothing new to report
+    LogSampler::reportAll();
+    REQUIRE(log.count("everyHundred:", " called") == 1);
+}
+
+TEST_CASE("Log sampling - summary counts use thousands separators", "[logger][sampling]") {
+    CapturedLog log;
+    for (int i = 0; i <= 1'234'567; ++i) {
+        everyMillion(i);
+    }
+    LogSampler::reportAll();
+    REQUIRE(log.count("sparse ") == 2);
+    REQUIRE(log.count("everyMillion:", " called 1,234,568 times, 2 logged") == 1);
+}
+
+TEST_CASE("Log sampling - sites in one function get their own summaries", "[logger][sampling]") {
+    CapturedLog log;
+    for (int i = 0; i <= 90; ++i) {
+        twoSites(i);
+    }
+    LogSampler::reportAll();
+    REQUIRE(log.count("twoSites:", " called 91 times, 10 logged") == 2);
+}
+
+TEST_CASE("Log sampling - first N is shared by all threads", "[logger][sampling]") {
+    CapturedLog log;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                firstFive(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(log.count("shared ") == 5);
+}
+
+TEST_CASE("Log sampling - periodic summary after the first N", "[logger][sampling]") {
+    CapturedLog log;
+    for (int i = 0; i < 3; ++i) {
+        firstThree(i);
+    }
+    REQUIRE(log.count("first ") == 3);
+
+    LogSampler::setSummaryInterval(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    // The batch that publishes these counts also checks the interval
+    for (std::uint32_t i = 0; i < LogSampler::kPublishInterval; ++i) {
+        firstThree(3);
+    }
+    REQUIRE(log.count("first ") == 3);
+    REQUIRE(log.count("[WARN] firstThree:", " called 259 times, 3 logged") == 1);
+}
+
+// ============================================================================
+// Test Suite: Rate Limits
+// ============================================================================
+
+TEST_CASE("Log sampling - rate limit allows a burst then suppresses", "[logger][sampling]") {
+    CapturedLog log;
+    Logger::setRateLimit(Logger::Level::ERROR, {0.01, 3});
+    for (int i = 0; i < 1000; ++i) {
+        rateLimited(i);
+    }
+    REQUIRE(log.count("limited ") == 3);
+
+    // A refused thread rechecks the bucket every kRateRecheckInterval calls
+    Logger::setRateLimit(Logger::Level::ERROR, {});
+    for (std::uint32_t i = 0; i < LogSampler::kRateRecheckInterval; ++i) {
+        rateLimited(-1);
+    }
+    REQUIRE(log.count("limited -1") >= 1);
+}
+
+TEST_CASE("Log sampling - Calculator sites follow the level's rate limit", "[logger][sampling]") {
+    CapturedLog log;
+    Logger::setRateLimit(Logger::Level::INFO, {0.01, 2});
+    Logger::setRateLimit(Logger::Level::DEBUG, {0.01, 1});
+
+    Calculator calc;
+    for (int i = 0; i < 10'000; ++i) {
+        REQUIRE_THAT(calc.add(i, 1.0), Catch::Matchers::WithinAbs(i + 1.0, 0.0));
+    }
+    Logger::setRateLimit(Logger::Level::INFO, {});
+    Logger::setRateLimit(Logger::Level::DEBUG, {});
+
+    REQUIRE(log.count("Calculating: ") == 2);
+    REQUIRE(log.count("Result: ") == 1);
+}
+
+#endif // MATHENGINE_LOG_LEVEL == 0
+
+TEST_CASE("Log sampling - rate limit settings round-trip", "[logger][sampling]") {
+    Logger::setRateLimit(Logger::Level::WARNING, {250.0, 8});
+    const Logger::RateLimit limit = Logger::getRateLimit(Logger::Level::WARNING);
+    REQUIRE(limit.perSecond > 249.9);
+    REQUIRE(limit.perSecond < 250.1);
+    REQUIRE(limit.burst == 8);
+
+    Logger::setRateLimit(Logger::Level::WARNING, {});
+    REQUIRE(Logger::getRateLimit(Logger::Level::WARNING).perSecond == 0.0);
+    REQUIRE(Logger::acquireRateToken(Logger::Level::WARNING));
+}
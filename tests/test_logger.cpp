@@ -0,0 +1,421 @@
+#include "logger/logger.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MathEngine;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+/**
+ * @brief Redirects std::cerr into a string for the lifetime of the object
+ */
+class CerrCapture {
+public:
+    CerrCapture() : previous_(std::cerr.rdbuf(buffer_.rdbuf())) {}
+    ~CerrCapture() { std::cerr.rdbuf(previous_); }
+
+    std::string text() const { return buffer_.str(); }
+
+    std::size_t lineCount() const {
+        const std::string s = buffer_.str();
+        return static_cast<std::size_t>(std::count(s.begin(), s.end(), '\n'));
+    }
+
+private:
+    std::ostringstream buffer_;
+    std::streambuf* previous_;
+};
+
+#if MATHENGINE_LOG_LEVEL == 0
+
+/**
+ * @brief Installs a sink for the lifetime of the object, then restores std::cerr
+ */
+class ScopedSink {
+public:
+    explicit ScopedSink(std::shared_ptr<LogSink> sink) { Logger::setSink(std::move(sink)); }
+    ~ScopedSink() { Logger::setSink(nullptr); }
+};
+
+/**
+ * @brief Message text after the "[LEVEL] " tag, or empty if the line is malformed
+ */
+std::string messageOf(const std::string& line) {
+    // "YYYY-mm-dd HH:MM:SS.mmm [LEVEL] message"
+    if (line.size() < 25 || line[4] != '-' || line[10] != ' ' || line[19] != '.' || line[23] != ' ' ||
+        line[24] != '[') {
+        return {};
+    }
+    const auto close = line.find("] ", 24);
+    return close == std::string::npos ? std::string{} : line.substr(close + 2);
+}
+
+/**
+ * @brief Checks that every line is whole and each thread's lines kept their order
+ */
+void requireOrderedWorkerLines(const std::vector<std::string>& lines, int threads, int perThread) {
+    REQUIRE(lines.size() == static_cast<std::size_t>(threads * perThread));
+    std::vector<int> next(static_cast<std::size_t>(threads), 0);
+    for (const auto& line : lines) {
+        int thread = -1;
+        int index = -1;
+        REQUIRE(std::sscanf(messageOf(line).c_str(), "worker %d line %d", &thread, &index) == 2);
+        REQUIRE(thread >= 0);
+        REQUIRE(thread < threads);
+        REQUIRE(index == next[static_cast<std::size_t>(thread)]++);
+    }
+}
+
+void logFromWorkers(int threads, int perThread) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t, perThread] {
+            for (int i = 0; i < perThread; ++i) {
+                Logger::info("worker {} line {}", t, i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // MATHENGINE_LOG_LEVEL == 0
+
+} // namespace
+
+// The output checks below need every level compiled in
+#if MATHENGINE_LOG_LEVEL == 0
+
+// ============================================================================
+// Test Suite: Asynchronous Backend
+// ============================================================================
+
+TEST_CASE("Logger async - flush writes every queued line", "[logger][async]") {
+    CerrCapture capture;
+    Logger::enableAsync();
+    REQUIRE(Logger::isAsync());
+
+    for (int i = 0; i < 100; ++i) {
+        Logger::info("message " + std::to_string(i));
+    }
+    Logger::flush();
+
+    REQUIRE(capture.lineCount() == 100);
+    REQUIRE_THAT(capture.text(), ContainsSubstring("[INFO] message 99"));
+
+    Logger::shutdown();
+    REQUIRE_FALSE(Logger::isAsync());
+}
+
+TEST_CASE("Logger async - shutdown drains concurrent producers", "[logger][async]") {
+    CerrCapture capture;
+    Logger::AsyncOptions options;
+    options.capacity = 64;
+    options.overflow = Logger::OverflowPolicy::Block;
+    Logger::enableAsync(options);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kPerThread; ++i) {
+                Logger::debug("worker line");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Logger::shutdown();
+
+    REQUIRE(capture.lineCount() == kThreads * kPerThread);
+}
+
+TEST_CASE("Logger async - overflow policies account for every message", "[logger][async]") {
+    constexpr std::size_t kMessages = 2000;
+
+    SECTION("Drop") {
+        CerrCapture capture;
+        const auto droppedBefore = Logger::droppedCount();
+        Logger::enableAsync({4, Logger::OverflowPolicy::Drop, 256});
+        for (std::size_t i = 0; i < kMessages; ++i) {
+            Logger::info("drop test");
+        }
+        Logger::shutdown();
+
+        const auto dropped = Logger::droppedCount() - droppedBefore;
+        REQUIRE(capture.lineCount() + dropped == kMessages);
+    }
+
+    SECTION("OverwriteOldest") {
+        CerrCapture capture;
+        const auto droppedBefore = Logger::droppedCount();
+        Logger::enableAsync({4, Logger::OverflowPolicy::OverwriteOldest, 256});
+        for (std::size_t i = 0; i < kMessages; ++i) {
+            Logger::info("overwrite test " + std::to_string(i));
+        }
+        Logger::shutdown();
+
+        const auto dropped = Logger::droppedCount() - droppedBefore;
+        REQUIRE(capture.lineCount() + dropped == kMessages);
+        // The newest message always survives when older ones are overwritten
+        REQUIRE_THAT(capture.text(), ContainsSubstring("overwrite test 1999"));
+    }
+}
+
+TEST_CASE("Logger async - long messages are truncated", "[logger][async]") {
+    CerrCapture capture;
+    Logger::enableAsync();
+    Logger::warning(std::string(Logger::kMaxAsyncMessageSize * 2, 'x'));
+    Logger::shutdown();
+
+    const std::string text = capture.text();
+    REQUIRE_THAT(text, ContainsSubstring("[WARN] "));
+    REQUIRE_THAT(text, ContainsSubstring("x..."));
+    REQUIRE(text.find(std::string(Logger::kMaxAsyncMessageSize, 'x')) == std::string::npos);
+}
+
+// ============================================================================
+// Test Suite: Level Filtering
+// ============================================================================
+
+TEST_CASE("Logger level - runtime minimum level filters messages", "[logger][level]") {
+    const auto previous = Logger::getLevel();
+    CerrCapture capture;
+
+    Logger::setLevel(Logger::Level::WARNING);
+    REQUIRE_FALSE(Logger::isEnabled(Logger::Level::INFO));
+    REQUIRE(Logger::isEnabled(Logger::Level::ERROR));
+
+    Logger::info("hidden info");
+    Logger::error("visible error");
+
+    Logger::setLevel(Logger::Level::OFF);
+    Logger::error("hidden error");
+
+    Logger::setLevel(previous);
+
+    REQUIRE(capture.lineCount() == 1);
+    REQUIRE_THAT(capture.text(), ContainsSubstring("visible error"));
+}
+
+TEST_CASE("Logger level - filtered calls never build their message", "[logger][level]") {
+    const auto previous = Logger::getLevel();
+    CerrCapture capture;
+    Logger::setLevel(Logger::Level::ERROR);
+
+    int evaluations = 0;
+    auto makeMessage = [&] {
+        ++evaluations;
+        return std::string("expensive");
+    };
+
+    SECTION("Callable overloads") {
+        Logger::debug(makeMessage);
+        Logger::info(makeMessage);
+        Logger::warning(makeMessage);
+        REQUIRE(evaluations == 0);
+
+        Logger::error(makeMessage);
+        REQUIRE(evaluations == 1);
+    }
+
+    SECTION("Macros") {
+        MATHENGINE_LOG_DEBUG(makeMessage());
+        MATHENGINE_LOG_INFO(makeMessage());
+        REQUIRE(evaluations == 0);
+
+        MATHENGINE_LOG_ERROR(makeMessage());
+        REQUIRE(evaluations == 1);
+    }
+
+    Logger::setLevel(previous);
+}
+
+// ============================================================================
+// Test Suite: fmt Formatting
+// ============================================================================
+
+TEST_CASE("Logger format - fmt-style overloads", "[logger][format]") {
+    CerrCapture capture;
+
+    Logger::info("{} + {} = {}", 2, 3.5, 5.5);
+    Logger::log(Logger::Level::WARNING, "{:>5}|{:.2f}", "ab", 1.0 / 3.0);
+    MATHENGINE_LOG_ERROR("code {}", 42);
+
+    const std::string text = capture.text();
+    REQUIRE_THAT(text, ContainsSubstring("[INFO] 2 + 3.5 = 5.5"));
+    REQUIRE_THAT(text, ContainsSubstring("[WARN]    ab|0.33"));
+    REQUIRE_THAT(text, ContainsSubstring("[ERROR] code 42"));
+}
+
+TEST_CASE("Logger format - braces in plain messages are not interpreted", "[logger][format]") {
+    CerrCapture capture;
+    Logger::info("literal {} braces");
+    REQUIRE_THAT(capture.text(), ContainsSubstring("literal {} braces"));
+}
+
+TEST_CASE("Logger format - timestamp prefix layout", "[logger][format]") {
+    CerrCapture capture;
+    Logger::debug("stamp");
+    Logger::debug("stamp");
+
+    // "YYYY-mm-dd HH:MM:SS.mmm [DEBUG] stamp", possibly wrapped in color codes
+    const std::string text = capture.text();
+    const auto pos = text.find(" [DEBUG] stamp");
+    REQUIRE(pos != std::string::npos);
+    REQUIRE(pos >= 23);
+    const std::string stamp = text.substr(pos - 23, 23);
+    REQUIRE(stamp[4] == '-');
+    REQUIRE(stamp[10] == ' ');
+    REQUIRE(stamp[19] == '.');
+}
+
+// ============================================================================
+// Test Suite: Sinks
+// ============================================================================
+
+TEST_CASE("Logger sink - memory sink receives plain whole lines", "[logger][sink]") {
+    auto sink = std::make_shared<MemorySink>();
+    CerrCapture capture;
+    {
+        ScopedSink scoped(sink);
+        Logger::warning("to memory {}", 1);
+        MATHENGINE_LOG_ERROR("macro {}", 2);
+    }
+    Logger::info("back on stderr");
+
+    const auto lines = sink->lines();
+    REQUIRE(lines.size() == 2);
+    REQUIRE(messageOf(lines[0]) == "to memory 1");
+    REQUIRE(messageOf(lines[1]) == "macro 2");
+    REQUIRE(lines[0].find('\033') == std::string::npos);
+
+    REQUIRE(capture.lineCount() == 1);
+    REQUIRE_THAT(capture.text(), ContainsSubstring("back on stderr"));
+}
+
+TEST_CASE("Logger sink - concurrent synchronous lines never interleave", "[logger][sink]") {
+    auto sink = std::make_shared<MemorySink>();
+    ScopedSink scoped(sink);
+    logFromWorkers(8, 300);
+    requireOrderedWorkerLines(sink->lines(), 8, 300);
+}
+
+TEST_CASE("Logger sink - async per-thread queues merge every line", "[logger][sink][async]") {
+    auto sink = std::make_shared<MemorySink>();
+    ScopedSink scoped(sink);
+    Logger::AsyncOptions options;
+    options.capacity = 32;
+    Logger::enableAsync(options);
+
+    // Workers exit before the flush; their queues must still drain
+    logFromWorkers(6, 400);
+    Logger::flush();
+    requireOrderedWorkerLines(sink->lines(), 6, 400);
+
+    Logger::shutdown();
+}
+
+TEST_CASE("Logger sink - async lines come out in timestamp order", "[logger][sink][async]") {
+    auto sink = std::make_shared<MemorySink>();
+    ScopedSink scoped(sink);
+    Logger::enableAsync();
+
+    // Each thread logs strictly after the previous one finished
+    for (int t = 0; t < 4; ++t) {
+        std::thread([t] {
+            for (int i = 0; i < 50; ++i) {
+                Logger::info("step {}", t * 50 + i);
+            }
+        }).join();
+    }
+    Logger::shutdown();
+
+    const auto lines = sink->lines();
+    REQUIRE(lines.size() == 200);
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        REQUIRE(messageOf(lines[i]) == "step " + std::to_string(i));
+    }
+}
+
+TEST_CASE("Logger sink - switching sinks keeps the async backend", "[logger][sink][async]") {
+    auto first = std::make_shared<MemorySink>();
+    auto second = std::make_shared<MemorySink>();
+    ScopedSink scoped(first);
+    Logger::enableAsync();
+    Logger::info("first");
+
+    Logger::setSink(second);
+    REQUIRE(Logger::isAsync());
+    Logger::info("second");
+    Logger::flush();
+
+    REQUIRE(first->lines().size() == 1);
+    REQUIRE(messageOf(first->lines()[0]) == "first");
+    REQUIRE(second->lines().size() == 1);
+    REQUIRE(messageOf(second->lines()[0]) == "second");
+
+    Logger::shutdown();
+}
+
+TEST_CASE("Logger sink - file and null sinks", "[logger][sink]") {
+    SECTION("File") {
+        const auto path = (std::filesystem::temp_directory_path() / "mathengine_test_sink.log").string();
+        {
+            ScopedSink scoped(std::make_shared<FileSink>(path, false));
+            Logger::info("into the file");
+            Logger::error("second line");
+        }
+
+        std::ifstream in(path);
+        std::string line;
+        std::vector<std::string> lines;
+        while (std::getline(in, line)) {
+            lines.push_back(line);
+        }
+        in.close();
+        std::remove(path.c_str());
+
+        REQUIRE(lines.size() == 2);
+        REQUIRE(messageOf(lines[0]) == "into the file");
+        REQUIRE(messageOf(lines[1]) == "second line");
+    }
+
+    SECTION("Unwritable path") {
+        REQUIRE_THROWS_AS(FileSink("/nonexistent-dir/mathengine.log"), std::runtime_error);
+    }
+
+    SECTION("Null") {
+        CerrCapture capture;
+        {
+            ScopedSink scoped(std::make_shared<NullSink>());
+            Logger::error("discarded");
+            Logger::flush();
+        }
+        REQUIRE(capture.lineCount() == 0);
+    }
+}
+
+#endif // MATHENGINE_LOG_LEVEL == 0
+
+TEST_CASE("Logger level - compile-time floor", "[logger][level]") {
+    STATIC_REQUIRE(Logger::isCompiledIn(Logger::Level::ERROR) ==
+                   (Logger::kCompileTimeLevel <= Logger::Level::ERROR));
+    STATIC_REQUIRE_FALSE(Logger::isCompiledIn(Logger::Level::OFF));
+}
@@ -4,6 +4,14 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <latch>
+#include <limits>
+#include <thread>
+#include <vector>
+
 using namespace MathEngine;
 using Catch::Matchers::WithinAbsMatcher;
 using Catch::Matchers::ContainsSubstring;
@@ -75,6 +83,60 @@ TEST_CASE("Calculator::divide - Basic division", "[math][divide]") {
     }
 }
 
+TEST_CASE("Calculator::tryDivide - Non-throwing division", "[math][divide]") {
+    SECTION("Normal division returns the quotient") {
+        const auto result = Calculator::tryDivide(10.0, 4.0);
+        REQUIRE(result.has_value());
+        REQUIRE(*result == 2.5);
+        REQUIRE(Calculator::getLastResult() == 2.5);
+    }
+
+    SECTION("Division by zero returns an error") {
+        Calculator::add(1.0, 1.0);
+        const auto result = Calculator::tryDivide(5.0, 1e-12);
+        REQUIRE_FALSE(result);
+        REQUIRE(result.error() == MathError::DivisionByZero);
+        REQUIRE(toString(result.error()) == "Cannot divide by zero");
+        REQUIRE(result.value_or(-1.0) == -1.0);
+        REQUIRE_THROWS_AS(result.value(), BadExpectedAccess<MathError>);
+        // A failed division is not a result
+        REQUIRE(Calculator::getLastResult() == 2.0);
+    }
+}
+
+TEST_CASE("Calculator::divide - Division-by-zero policies", "[math][divide]") {
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+    constexpr double kMax = std::numeric_limits<double>::max();
+
+    SECTION("Non-zero denominators ignore the policy") {
+        REQUIRE(Calculator::divide(9.0, 3.0, DivisionPolicy::ReturnNaN) == 3.0);
+        REQUIRE(Calculator::divide(9.0, 3.0, DivisionPolicy::Saturate) == 3.0);
+    }
+
+    SECTION("Throw") {
+        REQUIRE_THROWS_AS(Calculator::divide(5.0, 0.0, DivisionPolicy::Throw),
+                          std::invalid_argument);
+    }
+
+    SECTION("ReturnNaN") {
+        REQUIRE(std::isnan(Calculator::divide(5.0, 0.0, DivisionPolicy::ReturnNaN)));
+        REQUIRE(std::isnan(Calculator::getLastResult()));
+    }
+
+    SECTION("ReturnInf follows the signs of both operands") {
+        REQUIRE(Calculator::divide(5.0, 0.0, DivisionPolicy::ReturnInf) == kInf);
+        REQUIRE(Calculator::divide(-5.0, 0.0, DivisionPolicy::ReturnInf) == -kInf);
+        REQUIRE(Calculator::divide(5.0, -1e-12, DivisionPolicy::ReturnInf) == -kInf);
+        REQUIRE(std::isnan(Calculator::divide(0.0, 0.0, DivisionPolicy::ReturnInf)));
+    }
+
+    SECTION("Saturate clamps to the largest finite value") {
+        REQUIRE(Calculator::divide(5.0, 1e-12, DivisionPolicy::Saturate) == kMax);
+        REQUIRE(Calculator::divide(-5.0, 1e-12, DivisionPolicy::Saturate) == -kMax);
+        REQUIRE(Calculator::divide(0.0, 0.0, DivisionPolicy::Saturate) == 0.0);
+    }
+}
+
 TEST_CASE("Calculator::power - Power operation", "[math][power]") {
     SECTION("Positive exponent") {
         REQUIRE(Calculator::power(2.0, 0) == 1.0);
@@ -91,6 +153,43 @@ TEST_CASE("Calculator::power - Power operation", "[math][power]") {
         REQUIRE_THAT(Calculator::power(1.5, 2),
             WithinAbsMatcher(2.25, 1e-10));
     }
+
+    SECTION("Negative exponent") {
+        REQUIRE(Calculator::power(2.0, -1) == 0.5);
+        REQUIRE(Calculator::power(2.0, -10) == 1.0 / 1024.0);
+        REQUIRE(Calculator::power(-2.0, -3) == -0.125);
+    }
+
+    SECTION("Extreme exponents") {
+        REQUIRE(Calculator::power(1.0, std::numeric_limits<std::int32_t>::min()) == 1.0);
+        REQUIRE(Calculator::power(-1.0, std::numeric_limits<std::int32_t>::max()) == -1.0);
+        REQUIRE(std::isinf(Calculator::power(0.0, -1)));
+    }
+}
+
+TEST_CASE("Calculator::power - Compile-time exponent", "[math][power]") {
+    STATIC_REQUIRE(Calculator::power<0>(3.0) == 1.0);
+    STATIC_REQUIRE(Calculator::power<10>(2.0) == 1024.0);
+    STATIC_REQUIRE(Calculator::power<-2>(4.0) == 0.0625);
+    STATIC_REQUIRE(Calculator::integerPower(3.0, 5) == 243.0);
+
+    // Same multiplications in the same order as the runtime path
+    const double x = 1.0 + 1.0 / 3.0;
+    REQUIRE(Calculator::power<7>(x) == Calculator::power(x, 7));
+    REQUIRE(Calculator::power<64>(x) == Calculator::power(x, 64));
+    REQUIRE(Calculator::power<-13>(x) == Calculator::power(x, -13));
+}
+
+TEST_CASE("Calculator::power - Accuracy against std::pow", "[math][power]") {
+    // Documented bound: error grows roughly linearly with |exp|
+    for (std::int32_t exp = -64; exp <= 64; ++exp) {
+        for (double base : {0.5, 0.9, 1.1, 1.7, 2.3, -1.3}) {
+            const double expected = std::pow(base, static_cast<double>(exp));
+            const double tolerance = 2.0 * std::abs(exp) * std::numeric_limits<double>::epsilon();
+            REQUIRE_THAT(Calculator::integerPower(base, exp),
+                Catch::Matchers::WithinRelMatcher(expected, tolerance));
+        }
+    }
 }
 
 // ============================================================================
@@ -106,6 +205,40 @@ TEST_CASE("Calculator::getLastResult - State tracking", "[math][state]") {
     REQUIRE(Calculator::getLastResult() == 21.0);
 }
 
+TEST_CASE("Calculator::getLastResult - Per-thread state", "[math][state][threads]") {
+    constexpr int kThreads = 4;
+    std::latch computed(kThreads);
+    std::latch release(1);
+    std::vector<int> mismatches(kThreads, 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            const double value = 100.0 + t;
+            for (int i = 0; i < 1000; ++i) {
+                Calculator::add(value, 0.0);
+                if (Calculator::getLastResult() != value) {
+                    ++mismatches[t];
+                }
+            }
+            computed.count_down();
+            release.wait();  // Stay alive while the main thread takes a snapshot
+        });
+    }
+
+    computed.wait();
+    const auto snapshot = Calculator::getLastResults();
+    release.count_down();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < kThreads; ++t) {
+        REQUIRE(mismatches[t] == 0);
+        REQUIRE(std::count(snapshot.begin(), snapshot.end(), 100.0 + t) == 1);
+    }
+}
+
 // ============================================================================
 // Test Suite: Integration Tests
 // ============================================================================
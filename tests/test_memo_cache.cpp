@@ -0,0 +1,257 @@
+#include "math/calculator.hpp"
+#include "math/expression.hpp"
+#include "math/memo_cache.hpp"
+#include "math/metrics.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+/**
+ * @brief Enables an empty cache for one test and restores the defaults
+ */
+class MemoFixture {
+public:
+    explicit MemoFixture(MemoCacheOptions options = {}) {
+        options.enabled = true;
+        MemoCache::configure(options);
+        Metrics::reset();
+    }
+
+    ~MemoFixture() { MemoCache::configure(MemoCacheOptions{}); }
+};
+
+std::uint64_t bits(double value) {
+    return std::bit_cast<std::uint64_t>(value);
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Configuration
+// ============================================================================
+
+TEST_CASE("MemoCache - is off by default", "[memo]") {
+    REQUIRE_FALSE(MemoCache::isEnabled());
+    REQUIRE_FALSE(MemoCacheOptions{}.enabled);
+}
+
+TEST_CASE("MemoCache - options are kept, the thread tier rounded to a power of two", "[memo]") {
+    MemoCacheOptions options;
+    options.localEntries = 100;
+    options.sharedEntries = 64;
+    options.shards = 4;
+    MemoFixture fixture(options);
+
+    const MemoCacheOptions current = MemoCache::options();
+    REQUIRE(current.enabled);
+    REQUIRE(current.localEntries == 128);
+    REQUIRE(current.sharedEntries == 64);
+    REQUIRE(current.shards == 4);
+}
+
+// ============================================================================
+// Test Suite: Calculator::power
+// ============================================================================
+
+TEST_CASE("MemoCache - cached powers are bit-identical to computed ones", "[memo]") {
+    MemoFixture fixture;
+    for (double base : {1.0000001, -2.5, 0.5, 3.0}) {
+        for (std::int32_t exp : {0, 1, 7, 100, -3, -40}) {
+            const double expected = Calculator::integerPower(base, exp);
+            REQUIRE(bits(Calculator::power(base, exp)) == bits(expected));  // computed
+            REQUIRE(bits(Calculator::power(base, exp)) == bits(expected));  // cached
+            REQUIRE(bits(Calculator::getLastResult()) == bits(expected));
+        }
+    }
+}
+
+TEST_CASE("MemoCache - keys are exact bit patterns", "[memo]") {
+    MemoFixture fixture;
+    REQUIRE(Calculator::power(0.0, -1) == std::numeric_limits<double>::infinity());
+    REQUIRE(Calculator::power(-0.0, -1) == -std::numeric_limits<double>::infinity());
+    REQUIRE(Calculator::power(2.0, 3) == 8.0);
+    REQUIRE(Calculator::power(2.0, -3) == 0.125);
+    REQUIRE(Calculator::power(std::nextafter(2.0, 3.0), 3) != 8.0);
+    REQUIRE(std::isnan(Calculator::power(std::numeric_limits<double>::quiet_NaN(), 2)));
+}
+
+TEST_CASE("MemoCache - disabling keeps entries, clearing drops them", "[memo]") {
+    MemoFixture fixture;
+    Calculator::power(1.5, 9);
+    REQUIRE(MemoCache::sharedSize() == 1);
+
+    MemoCache::setEnabled(false);
+    Calculator::power(1.5, 10);
+    REQUIRE(MemoCache::sharedSize() == 1);
+
+    MemoCache::setEnabled(true);
+    MemoCache::clear();
+    REQUIRE(MemoCache::sharedSize() == 0);
+    REQUIRE(Calculator::power(1.5, 9) == Calculator::integerPower(1.5, 9));
+}
+
+TEST_CASE("MemoCache - the shared tier stays within its size", "[memo]") {
+    MemoCacheOptions options;
+    options.localEntries = 8;
+    options.sharedEntries = 32;
+    options.shards = 4;
+    MemoFixture fixture(options);
+
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(Calculator::power(1.0 + i * 1e-3, 5) == Calculator::integerPower(1.0 + i * 1e-3, 5));
+    }
+    REQUIRE(MemoCache::sharedSize() <= 32);
+    REQUIRE(MemoCache::sharedSize() > 0);
+}
+
+TEST_CASE("MemoCache - both tiers can be turned off by size", "[memo]") {
+    MemoCacheOptions options;
+    options.localEntries = 0;
+    options.sharedEntries = 0;
+    MemoFixture fixture(options);
+
+    REQUIRE(Calculator::power(3.0, 4) == 81.0);
+    REQUIRE(Calculator::power(3.0, 4) == 81.0);
+    REQUIRE(MemoCache::sharedSize() == 0);
+}
+
+TEST_CASE("MemoCache - concurrent callers all get the computed value", "[memo]") {
+    MemoCacheOptions options;
+    options.enabled = true;
+    options.localEntries = 16;
+    options.sharedEntries = 64;
+    options.shards = 2;
+    MemoFixture fixture(options);
+
+    std::vector<std::thread> threads;
+    std::array<bool, 4> correct{};
+    for (std::size_t t = 0; t < correct.size(); ++t) {
+        threads.emplace_back([&correct, &options, t] {
+            bool ok = true;
+            for (int round = 0; round < 20; ++round) {
+                for (int i = 0; i < 100; ++i) {
+                    const double base = 1.0 + i * 1e-2;
+                    ok = ok && bits(Calculator::power(base, 17)) ==
+                                   bits(Calculator::integerPower(base, 17));
+                }
+                if (t == 0 && round % 5 == 0) {
+                    MemoCache::clear();
+                } else if (t == 0 && round % 5 == 2) {
+                    // Replaces the shards under the other threads' lookups
+                    MemoCache::configure(options);
+                }
+            }
+            correct[t] = ok;
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (bool ok : correct) {
+        REQUIRE(ok);
+    }
+    REQUIRE(MemoCache::sharedSize() <= 64);
+}
+
+// ============================================================================
+// Test Suite: Expression::evaluate
+// ============================================================================
+
+TEST_CASE("MemoCache - expressions are cached per expression and binding", "[memo]") {
+    MemoFixture fixture;
+    const Expression sum("a + b");
+    const Expression difference("a - b");
+    const std::array<double, 2> values = {5.0, 3.0};
+
+    REQUIRE(sum.evaluate(values) == 8.0);
+    REQUIRE(sum.evaluate(values) == 8.0);
+    REQUIRE(difference.evaluate(values) == 2.0);  // same values, different expression
+    REQUIRE(sum.evaluate(std::array<double, 2>{5.0, 4.0}) == 9.0);
+
+    // A copy is the same compiled expression
+    const Expression copy = sum;
+    REQUIRE(copy.evaluate(values) == 8.0);
+}
+
+TEST_CASE("MemoCache - errors are not cached", "[memo]") {
+    MemoFixture fixture;
+    const Expression ratio("a / b");
+    const std::array<double, 2> values = {1.0, 0.0};
+    REQUIRE_THROWS_AS(ratio.evaluate(values), std::invalid_argument);
+    REQUIRE_THROWS_AS(ratio.evaluate(values), std::invalid_argument);
+    REQUIRE(MemoCache::sharedSize() == 0);
+}
+
+TEST_CASE("MemoCache - wide expressions are evaluated uncached", "[memo]") {
+    MemoFixture fixture;
+    const Expression wide("a + b + c + d + e");
+    const std::array<double, 5> values = {1.0, 2.0, 3.0, 4.0, 5.0};
+    REQUIRE(wide.evaluate(values) == 15.0);
+    REQUIRE(wide.evaluate(values) == 15.0);
+    REQUIRE(MemoCache::sharedSize() == 0);
+}
+
+#if MATHENGINE_METRICS
+
+// ============================================================================
+// Test Suite: Hit and Miss Counters
+// ============================================================================
+
+TEST_CASE("MemoCache - hits and misses are counted as metric events", "[memo]") {
+    MemoFixture fixture;
+    Calculator::power(1.25, 11);
+    Calculator::power(1.25, 11);
+    Calculator::power(1.25, 11);
+
+    const Expression product("x * y");
+    const std::array<double, 2> values = {2.0, 4.0};
+    product.evaluate(values);
+    product.evaluate(values);
+
+    const MetricsSnapshot snapshot = Metrics::snapshot();
+    REQUIRE(snapshot.count(MetricEvent::PowerCacheMiss) == 1);
+    REQUIRE(snapshot.count(MetricEvent::PowerCacheHit) == 2);
+    REQUIRE(snapshot.count(MetricEvent::ExpressionCacheMiss) == 1);
+    REQUIRE(snapshot.count(MetricEvent::ExpressionCacheHit) == 1);
+
+    // Hits are still counted as calls
+    REQUIRE(snapshot[Operation::Power].calls == 3);
+}
+
+TEST_CASE("MemoCache - a bypassing call site never touches the cache", "[memo]") {
+    MemoFixture fixture;
+    Calculator::power(1.25, 11, CachePolicy::Bypass);
+    Calculator::power(1.25, 11, CachePolicy::Bypass);
+
+    const Expression product("x * y");
+    product.evaluate(std::array<double, 2>{2.0, 4.0}, CachePolicy::Bypass);
+
+    const MetricsSnapshot snapshot = Metrics::snapshot();
+    REQUIRE(snapshot.count(MetricEvent::PowerCacheHit) == 0);
+    REQUIRE(snapshot.count(MetricEvent::PowerCacheMiss) == 0);
+    REQUIRE(snapshot.count(MetricEvent::ExpressionCacheMiss) == 0);
+    REQUIRE(MemoCache::sharedSize() == 0);
+}
+
+TEST_CASE("MemoCache - nothing is counted while disabled", "[memo]") {
+    MemoFixture fixture;
+    MemoCache::setEnabled(false);
+    Calculator::power(1.25, 11);
+    const MetricsSnapshot snapshot = Metrics::snapshot();
+    REQUIRE(snapshot.count(MetricEvent::PowerCacheHit) == 0);
+    REQUIRE(snapshot.count(MetricEvent::PowerCacheMiss) == 0);
+}
+
+#endif // MATHENGINE_METRICS
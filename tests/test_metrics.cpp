@@ -0,0 +1,243 @@
+#include "math/calculator.hpp"
+#include "math/metrics.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace MathEngine;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+/**
+ * @brief Starts every test from zero and restores the runtime switches
+ */
+class MetricsFixture {
+public:
+    MetricsFixture() { Metrics::reset(); }
+
+    ~MetricsFixture() {
+        Metrics::setEnabled(true);
+        Metrics::setLatencySampleRate(Metrics::kDefaultLatencySampleRate);
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// Test Suite: LatencyHistogram
+// ============================================================================
+
+TEST_CASE("LatencyHistogram - buckets cover every value within 12.5%", "[metrics]") {
+    using H = LatencyHistogram;
+    for (std::uint64_t ns : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 1000ull, 123456789ull}) {
+        const std::size_t index = H::bucketIndex(ns);
+        REQUIRE(H::bucketLowerBound(index) <= ns);
+        REQUIRE(ns <= H::bucketUpperBound(index));
+        REQUIRE(H::bucketUpperBound(index) - H::bucketLowerBound(index) <= ns / H::kSubBuckets);
+    }
+
+    // Adjacent buckets tile the range without gaps
+    for (std::size_t b = 1; b + 1 < H::kBucketCount; ++b) {
+        REQUIRE(H::bucketLowerBound(b) == H::bucketUpperBound(b - 1) + 1);
+    }
+    REQUIRE(H::bucketIndex(std::uint64_t{1} << 50) == H::kBucketCount - 1);
+}
+
+TEST_CASE("LatencyHistogram - percentiles report bucket upper bounds", "[metrics]") {
+    LatencyHistogram histogram;
+    REQUIRE(histogram.percentile(0.5) == 0);
+    REQUIRE(histogram.max() == 0);
+
+    histogram.record(100, 90);
+    histogram.record(10'000, 10);
+    REQUIRE(histogram.count == 100);
+    REQUIRE(histogram.meanNs() == 1090.0);
+
+    const std::uint64_t p50 = histogram.percentile(0.5);
+    REQUIRE(p50 >= 100);
+    REQUIRE(p50 < 100 + 100 / LatencyHistogram::kSubBuckets);
+    REQUIRE(histogram.percentile(0.9) == p50);
+    REQUIRE(histogram.percentile(0.95) >= 10'000);
+    REQUIRE(histogram.percentile(1.0) == histogram.max());
+}
+
+#if MATHENGINE_METRICS
+
+// ============================================================================
+// Test Suite: Counters and Events
+// ============================================================================
+
+TEST_CASE("Metrics - counts every scalar and batch call", "[metrics]") {
+    MetricsFixture fixture;
+    Calculator::add(1.0, 2.0);
+    Calculator::add(3.0, 4.0);
+    Calculator::multiply(2.0, 3.0);
+    Calculator::power(2.0, 3);
+
+    const std::vector<double> a(100, 1.0);
+    std::vector<double> out(a.size());
+    Calculator::add(a, 1.0, out);
+    Calculator::subtract(a, a, out);
+
+    const MetricsSnapshot snapshot = Metrics::snapshot();
+    REQUIRE(snapshot[Operation::Add].calls == 2);
+    REQUIRE(snapshot[Operation::Add].elements == 2);
+    REQUIRE(snapshot[Operation::Multiply].calls == 1);
+    REQUIRE(snapshot[Operation::Power].calls == 1);
+    REQUIRE(snapshot[Operation::Subtract].calls == 0);
+    REQUIRE(snapshot[Operation::BatchAdd].calls == 1);
+    REQUIRE(snapshot[Operation::BatchAdd].elements == 100);
+    REQUIRE(snapshot[Operation::BatchSubtract].elements == 100);
+}
+
+TEST_CASE("Metrics - division by zero and negative exponents are events", "[metrics]") {
+    MetricsFixture fixture;
+    REQUIRE_THROWS_AS(Calculator::divide(1.0, 0.0), std::invalid_argument);
+    REQUIRE_FALSE(Calculator::tryDivide(1.0, 0.0).has_value());
+    Calculator::divide(1.0, 2.0);
+    Calculator::power(2.0, -2);
+
+    const std::vector<double> a = {1.0, 2.0, 3.0, 4.0};
+    const std::vector<double> b = {1.0, 0.0, 0.0, 4.0};
+    std::vector<double> out(a.size());
+    Calculator::divide(a, b, out);
+    Calculator::power(a, -1, out);
+
+    const MetricsSnapshot snapshot = Metrics::snapshot();
+    REQUIRE(snapshot[Operation::Divide].calls == 3);  // The throwing call counts too
+    REQUIRE(snapshot[Operation::BatchDivide].calls == 1);
+    REQUIRE(snapshot.count(MetricEvent::DivisionByZero) == 2 + 2);
+    REQUIRE(snapshot.count(MetricEvent::NegativeExponent) == 2);
+}
+
+TEST_CASE("Metrics - reset starts from zero again", "[metrics]") {
+    MetricsFixture fixture;
+    Calculator::add(1.0, 2.0);
+    REQUIRE(Metrics::snapshot()[Operation::Add].calls == 1);
+
+    Metrics::reset();
+    REQUIRE(Metrics::snapshot()[Operation::Add].calls == 0);
+    Calculator::add(1.0, 2.0);
+    REQUIRE(Metrics::snapshot()[Operation::Add].calls == 1);
+}
+
+TEST_CASE("Metrics - disabled at runtime records nothing", "[metrics]") {
+    MetricsFixture fixture;
+    Metrics::setEnabled(false);
+    REQUIRE_FALSE(Metrics::isEnabled());
+    Calculator::add(1.0, 2.0);
+    REQUIRE_THROWS(Calculator::divide(1.0, 0.0));
+
+    const MetricsSnapshot snapshot = Metrics::snapshot();
+    REQUIRE(snapshot[Operation::Add].calls == 0);
+    REQUIRE(snapshot.count(MetricEvent::DivisionByZero) == 0);
+
+    Metrics::setEnabled(true);
+    Calculator::add(1.0, 2.0);
+    REQUIRE(Metrics::snapshot()[Operation::Add].calls == 1);
+}
+
+// ============================================================================
+// Test Suite: Latency Sampling
+// ============================================================================
+
+TEST_CASE("Metrics - sample rate decides how many calls are timed", "[metrics]") {
+    MetricsFixture fixture;
+
+    SECTION("every call") {
+        Metrics::setLatencySampleRate(1);
+        for (int i = 0; i < 10; ++i) {
+            Calculator::multiply(2.0, 3.0);
+        }
+        const LatencyHistogram latency = Metrics::snapshot()[Operation::Multiply].latency;
+        REQUIRE(latency.count == 10);
+        REQUIRE(latency.percentile(0.5) <= latency.max());
+    }
+
+    SECTION("one in four") {
+        Metrics::setLatencySampleRate(4);
+        for (int i = 0; i < 40; ++i) {
+            Calculator::multiply(2.0, 3.0);
+        }
+        const OperationStats stats = Metrics::snapshot()[Operation::Multiply];
+        REQUIRE(stats.calls == 40);
+        REQUIRE(stats.latency.count == 10);
+    }
+
+    SECTION("never") {
+        Metrics::setLatencySampleRate(0);
+        Calculator::multiply(2.0, 3.0);
+        REQUIRE(Metrics::snapshot()[Operation::Multiply].latency.count == 0);
+    }
+}
+
+// ============================================================================
+// Test Suite: Threads
+// ============================================================================
+
+TEST_CASE("Metrics - snapshot merges live and exited threads", "[metrics]") {
+    MetricsFixture fixture;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kPerThread; ++i) {
+                Calculator::subtract(5.0, 3.0);
+            }
+        });
+    }
+    // Snapshots taken while the threads run are consistent enough to bound
+    REQUIRE(Metrics::snapshot()[Operation::Subtract].calls <= kThreads * kPerThread);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Calculator::subtract(5.0, 3.0);
+    REQUIRE(Metrics::snapshot()[Operation::Subtract].calls == kThreads * kPerThread + 1);
+
+    // Counts of exited threads are kept, and reset still clears them
+    Metrics::reset();
+    REQUIRE(Metrics::snapshot()[Operation::Subtract].calls == 0);
+}
+
+// ============================================================================
+// Test Suite: Prometheus Export
+// ============================================================================
+
+TEST_CASE("Metrics - Prometheus text exposition", "[metrics]") {
+    MetricsFixture fixture;
+    Metrics::setLatencySampleRate(1);
+    Calculator::add(1.0, 2.0);
+    REQUIRE_THROWS(Calculator::divide(1.0, 0.0));
+
+    const std::string text = Metrics::toPrometheus();
+    REQUIRE_THAT(text, ContainsSubstring("# TYPE mathengine_operations_total counter\n"));
+    REQUIRE_THAT(text, ContainsSubstring("mathengine_operations_total{op=\"add\"} 1\n"));
+    REQUIRE_THAT(text, ContainsSubstring("mathengine_operations_total{op=\"batch_power\"} 0\n"));
+    REQUIRE_THAT(text, ContainsSubstring("mathengine_events_total{event=\"division_by_zero\"} 1\n"));
+    REQUIRE_THAT(text, ContainsSubstring("# TYPE mathengine_operation_latency_seconds histogram\n"));
+    REQUIRE_THAT(text, ContainsSubstring(
+        "mathengine_operation_latency_seconds_bucket{op=\"add\",le=\"+Inf\"} 1\n"));
+    REQUIRE_THAT(text, ContainsSubstring("mathengine_operation_latency_seconds_count{op=\"add\"} 1\n"));
+    REQUIRE_THAT(text, ContainsSubstring(
+        "mathengine_operation_latency_seconds_bucket{op=\"add\",le=\"1.6e-08\"}"));
+}
+
+#else
+
+TEST_CASE("Metrics - compiled out records nothing", "[metrics]") {
+    Calculator::add(1.0, 2.0);
+    REQUIRE_FALSE(Metrics::isEnabled());
+    REQUIRE(Metrics::snapshot()[Operation::Add].calls == 0);
+}
+
+#endif // MATHENGINE_METRICS
@@ -0,0 +1,235 @@
+#include "math/calculator.hpp"
+#include "math/float16.hpp"
+#include "math/reduction.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+std::vector<float> makeInput(std::size_t n, float offset = 0.0f) {
+    std::vector<float> values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = offset + static_cast<float>(i % 17) * 0.375f - 2.5f;
+    }
+    return values;
+}
+
+template <typename T>
+std::vector<T> convert(const std::vector<float>& values) {
+    std::vector<T> result;
+    result.reserve(values.size());
+    for (float value : values) {
+        result.push_back(T(value));
+    }
+    return result;
+}
+
+// Sizes around every vector width and the 16-bit conversion tile
+const std::vector<std::size_t> kSizes = {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 511, 512, 513, 1500};
+
+} // namespace
+
+// ============================================================================
+// Test Suite: 16-bit Conversions
+// ============================================================================
+
+static_assert(Float16(1.0f).bits == 0x3c00);
+static_assert(Float16(-2.0f).bits == 0xc000);
+static_assert(static_cast<float>(Float16::fromBits(0x3555)) == 0.333251953125f);
+static_assert(BFloat16(1.0f).bits == 0x3f80);
+
+TEST_CASE("Float16 - every finite value round-trips through float", "[float16]") {
+    for (std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+        const Float16 half = Float16::fromBits(static_cast<std::uint16_t>(bits));
+        const float value = static_cast<float>(half);
+        if (std::isnan(value)) {
+            REQUIRE((bits & 0x7c00u) == 0x7c00u);
+            REQUIRE(std::isnan(static_cast<float>(Float16(value))));
+        } else {
+            REQUIRE(Float16(value).bits == bits);
+        }
+    }
+}
+
+TEST_CASE("Float16 - rounds to nearest even, overflows to infinity", "[float16]") {
+    REQUIRE(static_cast<float>(Float16(65504.0f)) == 65504.0f);
+    REQUIRE(std::isinf(static_cast<float>(Float16(65520.0f))));        // halfway, rounds up
+    REQUIRE(static_cast<float>(Float16(65519.0f)) == 65504.0f);
+    REQUIRE(static_cast<float>(Float16(0x1p-24f)) == 0x1p-24f);         // smallest subnormal
+    REQUIRE(Float16(0x1p-25f).bits == 0);                                 // halfway, to even
+    REQUIRE(Float16(-0.0f).bits == 0x8000);
+    REQUIRE(Float16(1.0f + 0x1p-11f).bits == 0x3c00);                     // tie to even
+    REQUIRE(Float16(1.0f + 0x1p-11f + 0x1p-20f).bits == 0x3c01);
+}
+
+TEST_CASE("BFloat16 - rounds to nearest even and keeps NaN", "[float16]") {
+    REQUIRE(BFloat16(1.0f + 0x1p-8f).bits == 0x3f80);                     // tie to even
+    REQUIRE(BFloat16(1.0f + 0x1p-8f + 0x1p-12f).bits == 0x3f81);
+    REQUIRE(static_cast<float>(BFloat16(3.0e38f)) > 2.9e38f);
+    REQUIRE(std::isnan(static_cast<float>(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+    REQUIRE(std::isinf(static_cast<float>(BFloat16(std::numeric_limits<float>::infinity()))));
+}
+
+// ============================================================================
+// Test Suite: Reduced-Precision Batches
+// ============================================================================
+
+TEST_CASE("Calculator batch - float operations match scalar float results", "[batch][float]") {
+    for (const std::size_t n : kSizes) {
+        const auto a = makeInput(n);
+        const auto b = makeInput(n, 4.0f);
+        std::vector<float> out(n);
+
+        Calculator::add(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] + b[i]);
+        }
+        Calculator::subtract(a, 1.5f, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] - 1.5f);
+        }
+        Calculator::multiply(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == a[i] * b[i]);
+        }
+        Calculator::power(b, 3, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == b[i] * b[i] * b[i]);
+        }
+    }
+}
+
+TEST_CASE("Calculator batch - float division reports zero denominators", "[batch][float]") {
+    const std::vector<float> a(20, 3.0f);
+    std::vector<float> b(20, 2.0f);
+    b[5] = 0.0f;
+    b[17] = -0.0f;
+    std::vector<float> out(20);
+
+    const auto status = Calculator::divide(a, b, out);
+    REQUIRE(status.errorCount == 2);
+    REQUIRE(status.firstError == 5);
+    REQUIRE(std::isnan(out[5]));
+    REQUIRE(std::isnan(out[17]));
+    REQUIRE(out[0] == 1.5f);
+
+    REQUIRE(Calculator::divide(a, 0.0f, out).errorCount == 20);
+    REQUIRE(Calculator::divide(a, 4.0f, out).ok());
+    REQUIRE(out[19] == 0.75f);
+    REQUIRE(Calculator::getLastResult() == 0.75);
+}
+
+TEST_CASE("Calculator batch - 16-bit formats are computed in float, rounded once", "[batch][float16]") {
+    for (const std::size_t n : kSizes) {
+        const auto a = convert<Float16>(makeInput(n));
+        const auto b = convert<Float16>(makeInput(n, 4.0f));
+        std::vector<Float16> out(n);
+
+        Calculator::multiply(a, b, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i].bits == Float16(static_cast<float>(a[i]) * static_cast<float>(b[i])).bits);
+        }
+
+        const auto x = convert<BFloat16>(makeInput(n));
+        std::vector<BFloat16> y(n);
+        Calculator::add(x, 0.1f, y);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(y[i].bits == BFloat16(static_cast<float>(x[i]) + 0.1f).bits);
+        }
+    }
+}
+
+TEST_CASE("Calculator batch - 16-bit division and in-place operation", "[batch][float16]") {
+    auto a = convert<Float16>(makeInput(1200, 1.0f));
+    auto b = convert<Float16>(makeInput(1200, 8.0f));
+    b[700] = Float16(0.0f);
+
+    const auto status = Calculator::divide(a, b, a);
+    REQUIRE(status.errorCount == 1);
+    REQUIRE(status.firstError == 700);
+    REQUIRE(std::isnan(static_cast<float>(a[700])));
+
+    std::vector<BFloat16> c = convert<BFloat16>({1.0f, 2.0f, 3.0f});
+    Calculator::power(c, 2, c);
+    REQUIRE(static_cast<float>(c[2]) == 9.0f);
+    REQUIRE(Calculator::getLastResult() == 9.0);
+}
+
+TEST_CASE("Calculator batch - reduced-precision sizes are checked", "[batch][float]") {
+    const std::vector<float> a(4);
+    std::vector<float> out(3);
+    REQUIRE_THROWS_AS(Calculator::add(a, a, out), std::invalid_argument);
+    const std::vector<Float16> h(4);
+    std::vector<Float16> hout(5);
+    REQUIRE_THROWS_AS(Calculator::multiply(h, 2.0f, hout), std::invalid_argument);
+}
+
+// ============================================================================
+// Test Suite: Reduced-Precision Reductions
+// ============================================================================
+
+TEST_CASE("Reduction - float inputs", "[reduction][float]") {
+    const std::vector<float> values = {1.0f, -2.0f, 4.5f, std::numeric_limits<float>::quiet_NaN(), 8.0f};
+    const std::vector<float> finite = {1.0f, -2.0f, 4.5f, 8.0f};
+    REQUIRE(Reduction::sum(finite) == 11.5f);
+    REQUIRE(Reduction::product(finite) == -72.0f);
+    REQUIRE(Reduction::dot(finite, finite) == 1.0f + 4.0f + 20.25f + 64.0f);
+    REQUIRE(Reduction::min(values) == -2.0f);
+    REQUIRE(Reduction::max(values) == 8.0f);
+    REQUIRE(Reduction::sum(std::span<const float>()) == 0.0f);
+    REQUIRE_THROWS_AS(Reduction::min(std::span<const float>()), std::invalid_argument);
+}
+
+TEST_CASE("Reduction - 16-bit inputs accumulate in float", "[reduction][float16]") {
+    // Float16 itself cannot count past 2048 in steps of one
+    const std::vector<Float16> ones(10'000, Float16(1.0f));
+    REQUIRE(Reduction::sum(ones) == 10'000.0f);
+    REQUIRE(Reduction::dot(ones, ones) == 10'000.0f);
+
+    const std::vector<BFloat16> small(50'000, BFloat16(0.5f));
+    REQUIRE(Reduction::sum(small) == 25'000.0f);
+
+    std::vector<Float16> mixed = convert<Float16>(makeInput(3000));
+    mixed[1234] = Float16(-1000.0f);
+    mixed[2345] = Float16(std::numeric_limits<float>::quiet_NaN());
+    REQUIRE(Reduction::min(mixed) == -1000.0f);
+    REQUIRE(Reduction::max(mixed) == static_cast<float>(Float16(16 * 0.375f - 2.5f)));
+
+    const std::vector<Float16> nans(10, Float16(std::numeric_limits<float>::quiet_NaN()));
+    REQUIRE(std::isnan(Reduction::max(nans)));
+}
+
+TEST_CASE("Reduction - reduced-precision results ignore the thread count", "[reduction][float16][threads]") {
+    const auto input = makeInput(Reduction::kMinElementsPerThread * 4 + 777);
+    const auto halves = convert<Float16>(input);
+
+    ReductionOptions reference;
+    reference.maxThreads = 1;
+    const float floatSum = Reduction::sum(input, reference);
+    const float halfSum = Reduction::sum(halves, reference);
+    const float halfDot = Reduction::dot(halves, halves, reference);
+
+    for (const std::size_t threads : {2u, 3u, 8u}) {
+        ReductionOptions parallel;
+        parallel.maxThreads = threads;
+        REQUIRE(Reduction::sum(input, parallel) == floatSum);
+        REQUIRE(Reduction::sum(halves, parallel) == halfSum);
+        REQUIRE(Reduction::dot(halves, halves, parallel) == halfDot);
+    }
+
+    ReductionOptions fast;
+    fast.mode = ReductionMode::Fast;
+    REQUIRE_THAT(Reduction::sum(halves, fast), WithinRel(halfSum, 1e-4f));
+    REQUIRE_THAT(static_cast<double>(floatSum), WithinRel(static_cast<double>(halfSum), 1e-6));
+}
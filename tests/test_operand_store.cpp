@@ -0,0 +1,205 @@
+#include "math/calculator.hpp"
+#include "math/executor.hpp"
+#include "math/operand_store.hpp"
+#include "math/scratch_arena.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+struct Record {
+    BatchOp op;
+    double a;
+    double b;
+};
+
+/// A mixed workload: every operation, several exponents, no zero divisors
+std::vector<Record> makeRecords(std::size_t n) {
+    std::vector<Record> records(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto op = static_cast<BatchOp>((i * 7 + i / 3) % kBatchOpCount);
+        const double a = 0.25 * static_cast<double>(i % 101) - 12.0;
+        const double b = op == BatchOp::Power ? static_cast<double>(static_cast<int>(i % 9) - 3)
+                                              : 1.5 + static_cast<double>(i % 13);
+        records[i] = {op, a, b};
+    }
+    return records;
+}
+
+double scalarResult(const Record& record) {
+    switch (record.op) {
+        case BatchOp::Add:      return Calculator::add(record.a, record.b);
+        case BatchOp::Subtract: return Calculator::subtract(record.a, record.b);
+        case BatchOp::Multiply: return Calculator::multiply(record.a, record.b);
+        case BatchOp::Divide:   return Calculator::divide(record.a, record.b);
+        case BatchOp::Power:
+            return Calculator::power(record.a, static_cast<std::int32_t>(record.b), CachePolicy::Bypass);
+    }
+    return NAN;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Storage
+// ============================================================================
+
+TEST_CASE("OperandStore - groups records by operation and exponent", "[operand_store]") {
+    OperandStore store;
+    store.push(BatchOp::Add, 1.0, 2.0);
+    store.push(BatchOp::Power, 2.0, 3.0);
+    store.push(BatchOp::Add, 3.0, 4.0);
+    store.push(BatchOp::Power, 2.0, -1.0);
+    store.push(BatchOp::Power, 5.0, 3.0);
+    REQUIRE(store.size() == 5);
+
+    const auto groups = store.groups();
+    REQUIRE(groups.size() == 3);
+    REQUIRE(groups[0].op == BatchOp::Add);
+    REQUIRE(groups[0].size == 2);
+    REQUIRE(groups[1].op == BatchOp::Power);
+    REQUIRE(groups[1].exponent == 3);
+    REQUIRE(groups[1].size == 2);
+    REQUIRE(groups[2].exponent == -1);
+
+    const OperandStore::Block& block = *groups[1].blocks[0];
+    REQUIRE(reinterpret_cast<std::uintptr_t>(&block) % 64 == 0);
+    REQUIRE(block.position[0] == 1);
+    REQUIRE(block.position[1] == 4);
+    REQUIRE(block.a[1] == 5.0);
+}
+
+TEST_CASE("OperandStore - rejects non-integral exponents and mismatched columns", "[operand_store]") {
+    OperandStore store;
+    REQUIRE_THROWS_AS(store.push(BatchOp::Power, 2.0, 0.5), std::invalid_argument);
+    REQUIRE_THROWS_AS(store.push(BatchOp::Power, 2.0, 1e10), std::invalid_argument);
+    REQUIRE(store.empty());
+
+    const BatchOp ops[] = {BatchOp::Add, BatchOp::Multiply};
+    const std::vector<double> a{1.0, 2.0, 3.0};
+    REQUIRE_THROWS_AS(store.append(ops, a, a), std::invalid_argument);
+}
+
+TEST_CASE("OperandStore - exponents past kMaxPowerGroups share one group", "[operand_store]") {
+    std::vector<Record> records;
+    for (int round = 0; round < 2; ++round) {
+        for (int exponent = -40; exponent < 40; ++exponent) {
+            records.push_back({BatchOp::Power, 1.0 + 0.01 * exponent, static_cast<double>(exponent)});
+        }
+    }
+    OperandStore store;
+    for (const Record& record : records) {
+        store.push(record.op, record.a, record.b);
+    }
+
+    const auto groups = store.groups();
+    REQUIRE(groups.size() == OperandStore::kMaxPowerGroups + 1);
+    REQUIRE(groups[0].exponent == -40);
+    REQUIRE(groups[0].size == 2);
+    REQUIRE_FALSE(groups[0].mixedExponents);
+    REQUIRE(groups.back().mixedExponents);
+    REQUIRE(groups.back().size == 2 * (80 - OperandStore::kMaxPowerGroups));
+
+    std::vector<double> out(records.size());
+    REQUIRE(Calculator::evaluate(store, out).ok());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        REQUIRE(out[i] == scalarResult(records[i]));
+    }
+
+    store.clear();
+    store.push(BatchOp::Power, 2.0, 39.0);
+    REQUIRE(store.groups().size() == 1);
+    REQUIRE_FALSE(store.groups()[0].mixedExponents);
+}
+
+TEST_CASE("OperandStore - clear reuses the blocks", "[operand_store]") {
+    ScratchArena arena;
+    OperandStore store(&arena);
+    const auto records = makeRecords(3000);
+    for (const Record& record : records) {
+        store.push(record.op, record.a, record.b);
+    }
+    const std::size_t capacity = arena.capacity();
+
+    for (int round = 0; round < 3; ++round) {
+        store.clear();
+        REQUIRE(store.empty());
+        REQUIRE(store.groups().empty());
+        for (const Record& record : records) {
+            store.push(record.op, record.a, record.b);
+        }
+    }
+    REQUIRE(arena.capacity() == capacity);
+}
+
+// ============================================================================
+// Test Suite: Evaluation
+// ============================================================================
+
+TEST_CASE("OperandStore - evaluate matches one scalar call per record", "[operand_store]") {
+    for (const std::size_t n : {std::size_t{0}, std::size_t{1}, std::size_t{17},
+                                OperandStore::kBlockSize * 3 + 5}) {
+        const auto records = makeRecords(n);
+        OperandStore store;
+        for (const Record& record : records) {
+            store.push(record.op, record.a, record.b);
+        }
+
+        std::vector<double> out(n);
+        REQUIRE(Calculator::evaluate(store, out).ok());
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == scalarResult(records[i]));
+        }
+        if (n != 0) {
+            REQUIRE(Calculator::getLastResult() == out.back());
+        }
+    }
+}
+
+TEST_CASE("OperandStore - evaluate reports the first zero divisor in record order", "[operand_store]") {
+    OperandStore store;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        store.push(BatchOp::Add, 1.0, 1.0);
+        // Zero divisors at records 601 and 901, behind a full block of divisions
+        store.push(BatchOp::Divide, 1.0, i == 300 || i == 450 ? 0.0 : 2.0);
+    }
+
+    std::vector<double> out(store.size());
+    const auto status = Calculator::evaluate(store, out);
+    REQUIRE(status.errorCount == 2);
+    REQUIRE(status.firstError == 601);
+    REQUIRE(std::isnan(out[601]));
+    REQUIRE(std::isnan(out[901]));
+    REQUIRE(out[600] == 2.0);
+    REQUIRE(out[603] == 0.5);
+
+    std::vector<double> wrong(3);
+    REQUIRE_THROWS_AS(Calculator::evaluate(store, wrong), std::invalid_argument);
+}
+
+TEST_CASE("OperandStore - evaluate splits large groups over the Executor", "[operand_store]") {
+    Executor executor(ExecutorOptions{3, false});
+    Executor::setGlobal(&executor);
+
+    const auto records = makeRecords(400'000);
+    OperandStore store;
+    for (const Record& record : records) {
+        store.push(record.op, record.a, record.b);
+    }
+    std::vector<double> out(records.size());
+    const auto status = Calculator::evaluate(store, out);
+    Executor::setGlobal(nullptr);
+
+    REQUIRE(status.ok());
+    for (std::size_t i = 0; i < records.size(); i += 991) {
+        REQUIRE(out[i] == scalarResult(records[i]));
+    }
+}
@@ -0,0 +1,178 @@
+#include "math/reduction.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace MathEngine;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+// Values with wildly different magnitudes, so the summation order shows
+std::vector<double> makeInput(std::size_t n) {
+    std::vector<double> values(n);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const double unit = static_cast<double>(state >> 11) * 0x1.0p-53;
+        values[i] = (unit - 0.5) * std::ldexp(1.0, static_cast<int>(i % 40) - 20);
+    }
+    return values;
+}
+
+ReductionOptions options(ReductionMode mode, std::size_t threads) {
+    ReductionOptions result;
+    result.mode = mode;
+    result.maxThreads = threads;
+    return result;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Basic Results
+// ============================================================================
+
+TEST_CASE("Reduction - small inputs give exact results", "[math][reduction]") {
+    const std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0, -6.0, 7.0, 8.0, 9.0, 10.0, 11.0};
+    const std::vector<double> weights(values.size(), 2.0);
+
+    for (const auto mode : {ReductionMode::Deterministic, ReductionMode::Fast}) {
+        REQUIRE(Reduction::sum(values, options(mode, 1)) == 54.0);
+        REQUIRE(Reduction::dot(values, weights, options(mode, 1)) == 108.0);
+        REQUIRE(Reduction::product(std::vector<double>{1.5, -2.0, 4.0}, options(mode, 1)) == -12.0);
+        REQUIRE(Reduction::min(values, options(mode, 1)) == -6.0);
+        REQUIRE(Reduction::max(values, options(mode, 1)) == 11.0);
+    }
+}
+
+TEST_CASE("Reduction - empty and degenerate inputs", "[math][reduction]") {
+    const std::vector<double> empty;
+    REQUIRE(Reduction::sum(empty) == 0.0);
+    REQUIRE(Reduction::product(empty) == 1.0);
+    REQUIRE(Reduction::dot(empty, empty) == 0.0);
+    REQUIRE_THROWS_AS(Reduction::min(empty), std::invalid_argument);
+    REQUIRE_THROWS_AS(Reduction::max(empty), std::invalid_argument);
+
+    const std::vector<double> three(3, 1.0);
+    const std::vector<double> four(4, 1.0);
+    REQUIRE_THROWS_AS(Reduction::dot(three, four), std::invalid_argument);
+}
+
+TEST_CASE("Reduction - min and max skip NaN", "[math][reduction]") {
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    constexpr double inf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> values(37, 3.0);
+    values[0] = nan;
+    values[9] = -2.0;
+    values[20] = nan;
+    values[36] = 8.0;
+    REQUIRE(Reduction::min(values) == -2.0);
+    REQUIRE(Reduction::max(values) == 8.0);
+
+    REQUIRE(std::isnan(Reduction::min(std::vector<double>(10, nan))));
+    REQUIRE(std::isnan(Reduction::max(std::vector<double>(10, nan))));
+    REQUIRE(Reduction::min(std::vector<double>{nan, inf}) == inf);
+    REQUIRE(Reduction::max(std::vector<double>{-inf, nan}) == -inf);
+}
+
+// ============================================================================
+// Test Suite: Parallel Determinism
+// ============================================================================
+
+TEST_CASE("Reduction - deterministic mode ignores the thread count", "[math][reduction][threads]") {
+    // Several blocks per thread plus a ragged final block
+    const auto values = makeInput(Reduction::kMinElementsPerThread * 8 + 1013);
+    const auto weights = makeInput(values.size() + 7);
+    const std::span<const double> b(weights.data(), values.size());
+
+    const auto reference = options(ReductionMode::Deterministic, 1);
+    const double sum = Reduction::sum(values, reference);
+    const double dot = Reduction::dot(values, b, reference);
+    const double min = Reduction::min(values, reference);
+
+    for (const std::size_t threads : {2u, 3u, 4u, 7u, 8u}) {
+        const auto parallel = options(ReductionMode::Deterministic, threads);
+        REQUIRE(Reduction::sum(values, parallel) == sum);
+        REQUIRE(Reduction::dot(values, b, parallel) == dot);
+        REQUIRE(Reduction::min(values, parallel) == min);
+    }
+
+    SECTION("Fast mode agrees to rounding") {
+        for (const std::size_t threads : {1u, 4u}) {
+            const auto fast = options(ReductionMode::Fast, threads);
+            REQUIRE_THAT(Reduction::sum(values, fast), WithinRel(sum, 1e-9));
+            REQUIRE_THAT(Reduction::dot(values, b, fast), WithinRel(dot, 1e-9));
+            REQUIRE(Reduction::min(values, fast) == min);
+        }
+    }
+}
+
+TEST_CASE("Reduction - pairwise summation stays accurate", "[math][reduction]") {
+    const std::vector<double> values(1'000'000, 0.1);
+    REQUIRE_THAT(Reduction::sum(values), WithinRel(100'000.0, 1e-13));
+}
+
+// ============================================================================
+// Test Suite: Reductions in Pieces
+// ============================================================================
+
+TEST_CASE("Reduction - partials of block-aligned slices combine to the whole", "[math][reduction]") {
+    const auto values = makeInput(Reduction::kBlockSize * 11 + 517);
+    const std::span<const double> all(values);
+
+    // Three slices, cut at multiples of kBlockSize, as three nodes would see them
+    const std::size_t cuts[] = {0, Reduction::kBlockSize * 3, Reduction::kBlockSize * 4, values.size()};
+    for (const ReductionOp op : {ReductionOp::Sum, ReductionOp::Product, ReductionOp::Min, ReductionOp::Max}) {
+        std::vector<double> partials;
+        for (std::size_t s = 0; s + 1 < std::size(cuts); ++s) {
+            const auto slice = all.subspan(cuts[s], cuts[s + 1] - cuts[s]);
+            std::vector<double> slicePartials(Reduction::blockCount(slice.size()));
+            Reduction::partials(op, slice, slicePartials);
+            partials.insert(partials.end(), slicePartials.begin(), slicePartials.end());
+        }
+        REQUIRE(partials.size() == Reduction::blockCount(values.size()));
+
+        const double combined = Reduction::combine(op, partials);
+        switch (op) {
+            case ReductionOp::Sum: REQUIRE(combined == Reduction::sum(values)); break;
+            case ReductionOp::Product: REQUIRE(combined == Reduction::product(values)); break;
+            case ReductionOp::Min: REQUIRE(combined == Reduction::min(values)); break;
+            case ReductionOp::Max: REQUIRE(combined == Reduction::max(values)); break;
+        }
+    }
+}
+
+TEST_CASE("Reduction - combining partials of edge cases", "[math][reduction]") {
+    std::vector<double> none;
+    REQUIRE(Reduction::combine(ReductionOp::Sum, none) == 0.0);
+    REQUIRE(Reduction::combine(ReductionOp::Product, none) == 1.0);
+    REQUIRE_THROWS_AS(Reduction::combine(ReductionOp::Min, none), std::invalid_argument);
+
+    std::vector<double> wrongSize(1);
+    REQUIRE_THROWS_AS(Reduction::partials(ReductionOp::Sum, std::vector<double>(Reduction::kBlockSize + 1),
+                                          wrongSize),
+                      std::invalid_argument);
+
+    // An all-NaN block yields NaN, which the other blocks then win against
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> values(Reduction::kBlockSize * 2, nan);
+    values.back() = -3.0;
+    std::vector<double> partials(2);
+    Reduction::partials(ReductionOp::Max, values, partials);
+    REQUIRE(std::isnan(partials[0]));
+    REQUIRE(Reduction::combine(ReductionOp::Max, partials) == -3.0);
+
+    values.back() = nan;
+    Reduction::partials(ReductionOp::Min, values, partials);
+    REQUIRE(std::isnan(Reduction::combine(ReductionOp::Min, partials)));
+}
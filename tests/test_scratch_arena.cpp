@@ -0,0 +1,137 @@
+#include "math/expression.hpp"
+#include "math/reduction.hpp"
+#include "math/scratch_arena.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+using namespace MathEngine;
+
+namespace {
+
+/**
+ * @brief Upstream resource that counts what it hands out
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t outstanding = 0;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        ++outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        --outstanding;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+bool isAligned(const void* p, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: ScratchArena
+// ============================================================================
+
+TEST_CASE("ScratchArena - allocations honor alignment", "[scratch]") {
+    CountingResource upstream;
+    ScratchArena arena(1024, &upstream);
+
+    for (std::size_t alignment : {1, 2, 8, 16, 64, 256}) {
+        static_cast<void>(arena.allocate(3, 1));
+        REQUIRE(isAligned(arena.allocate(40, alignment), alignment));
+    }
+
+    // Larger than the first block: a new block is fetched and still aligned
+    void* big = arena.allocate(10'000, 128);
+    REQUIRE(isAligned(big, 128));
+    REQUIRE(arena.capacity() >= 10'000);
+}
+
+TEST_CASE("ScratchArena - nested scopes rewind and reuse memory", "[scratch]") {
+    CountingResource upstream;
+    ScratchArena arena(1024, &upstream);
+
+    void* outer = nullptr;
+    void* inner = nullptr;
+    {
+        ScratchScope outerScope(arena);
+        outer = arena.allocate(100, 8);
+        {
+            ScratchScope innerScope(arena);
+            inner = arena.allocate(100, 8);
+            REQUIRE(inner != outer);
+        }
+        // The inner scope's memory is handed out again
+        REQUIRE(arena.allocate(100, 8) == inner);
+    }
+    REQUIRE(arena.allocate(100, 8) == outer);
+
+    // Rewinding across blocks keeps them for later
+    arena.reset();
+    static_cast<void>(arena.allocate(4096, 8));
+    const std::size_t blocks = upstream.allocations;
+    arena.reset();
+    static_cast<void>(arena.allocate(4096, 8));
+    REQUIRE(upstream.allocations == blocks);
+}
+
+TEST_CASE("ScratchArena - blocks go back upstream on destruction", "[scratch]") {
+    CountingResource upstream;
+    {
+        ScratchArena arena(256, &upstream);
+        for (int i = 0; i < 10; ++i) {
+            static_cast<void>(arena.allocate(1000, 16));
+        }
+        REQUIRE(upstream.outstanding > 0);
+    }
+    REQUIRE(upstream.outstanding == 0);
+}
+
+// ============================================================================
+// Test Suite: Library Paths Without Heap Traffic
+// ============================================================================
+
+TEST_CASE("ScratchArena - warm evaluations make no upstream allocations", "[scratch]") {
+    constexpr std::size_t kSize = 100'000;
+    std::vector<double> a(kSize, 1.5), b(kSize, 2.0), out(kSize);
+    const std::vector<std::span<const double>> columns = {a, b};
+    const Expression expression("(a + b) * (a - b) / (b * b + 1)");
+
+    CountingResource upstream;
+    ScratchArena arena(1024, &upstream);
+    ReductionOptions options;
+    options.scratch = &arena;
+
+    auto run = [&] {
+        ScratchScope scope(arena);
+        const auto status = expression.evaluate(columns, out, &arena);
+        REQUIRE(status.ok());
+        return Reduction::sum(out, options);
+    };
+
+    const double expected = run();
+    const std::size_t warm = upstream.allocations;
+    REQUIRE(warm > 0);
+
+    for (int i = 0; i < 20; ++i) {
+        REQUIRE(run() == expected);
+    }
+    REQUIRE(upstream.allocations == warm);
+}
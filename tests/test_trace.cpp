@@ -0,0 +1,171 @@
+#include "logger/log_sink.hpp"
+#include "logger/logger.hpp"
+#include "logger/trace.hpp"
+#include "math/calculator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MathEngine;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+/**
+ * @brief Starts every test with empty buffers and recording on
+ */
+class TraceFixture {
+public:
+    TraceFixture() { Trace::clear(); }
+
+    ~TraceFixture() {
+        Trace::setEnabled(true);
+        Trace::clear();
+    }
+};
+
+std::string chromeTrace() {
+    std::ostringstream out;
+    Trace::writeChromeTrace(out);
+    return out.str();
+}
+
+std::size_t occurrences(const std::string& text, const std::string& needle) {
+    std::size_t count = 0;
+    for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+// ============================================================================
+// Test Suite: Recording
+// ============================================================================
+
+TEST_CASE("Trace - zones record per thread and export as Chrome trace events", "[trace]") {
+    TraceFixture fixture;
+    {
+        Trace::Zone outer("test", "outer");
+        const Trace::Zone inner("test", "inner \"quoted\"");
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10; ++i) {
+                const Trace::Zone zone("test", "worker");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Exited threads' zones are kept
+    REQUIRE(Trace::eventCount() == 32);
+    const std::string json = chromeTrace();
+    REQUIRE_THAT(json, ContainsSubstring("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    REQUIRE_THAT(json, ContainsSubstring("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\""));
+    REQUIRE_THAT(json, ContainsSubstring("\"name\":\"inner \\\"quoted\\\"\""));
+    REQUIRE(occurrences(json, "\"name\":\"worker\"") == 30);
+    REQUIRE(occurrences(json, "\"ph\":\"X\"") == 32);
+    REQUIRE_THAT(json, ContainsSubstring("\"ph\":\"M\""));
+}
+
+TEST_CASE("Trace - paused recording and full buffers", "[trace]") {
+    TraceFixture fixture;
+    Trace::setEnabled(false);
+    {
+        const Trace::Zone zone("test", "paused");
+    }
+    REQUIRE(Trace::eventCount() == 0);
+    Trace::setEnabled(true);
+
+    // A fresh thread, so its buffer starts empty
+    std::thread([] {
+        for (std::size_t i = 0; i < Trace::kEventsPerThread + 5; ++i) {
+            Trace::record("test", "filler", Trace::now(), Trace::now());
+        }
+    }).join();
+    REQUIRE(Trace::eventCount() == Trace::kEventsPerThread);
+    REQUIRE(Trace::droppedCount() == 5);
+
+    Trace::clear();
+    REQUIRE(Trace::eventCount() == 0);
+    REQUIRE(Trace::droppedCount() == 0);
+}
+
+TEST_CASE("Trace - exited threads' buffers are bounded and reused", "[trace]") {
+    TraceFixture fixture;
+    const auto zoneOnNewThread = [] {
+        std::thread([] { const Trace::Zone zone("test", "short-lived"); }).join();
+    };
+
+    // Past the retained threads, the oldest ones' events are dropped
+    for (std::size_t i = 0; i < Trace::kRetainedExitedThreads + 3; ++i) {
+        zoneOnNewThread();
+    }
+    REQUIRE(Trace::eventCount() == Trace::kRetainedExitedThreads);
+    REQUIRE(Trace::droppedCount() == 3);
+    const std::string json = chromeTrace();
+    REQUIRE(occurrences(json, "\"name\":\"short-lived\"") == Trace::kRetainedExitedThreads);
+
+    // clear() frees them; new threads record as before
+    Trace::clear();
+    REQUIRE(Trace::eventCount() == 0);
+    REQUIRE(Trace::droppedCount() == 0);
+    for (int i = 0; i < 3; ++i) {
+        zoneOnNewThread();
+    }
+    REQUIRE(Trace::eventCount() == 3);
+    REQUIRE(Trace::droppedCount() == 0);
+}
+
+// ============================================================================
+// Test Suite: Library Zones
+// ============================================================================
+
+#if MATHENGINE_TRACING
+
+TEST_CASE("Trace - Calculator operations and Logger stages are zones", "[trace]") {
+    TraceFixture fixture;
+    Logger::setSink(std::make_shared<NullSink>());
+    Calculator::power(2.0, 10);
+    REQUIRE_THROWS_AS(Calculator::divide(1.0, 0.0), std::invalid_argument);
+    Logger::log(Logger::Level::ERROR, "traced {}", 42);
+    Logger::setSink(nullptr);
+
+    const std::string json = chromeTrace();
+    REQUIRE_THAT(json, ContainsSubstring("\"name\":\"power\",\"cat\":\"calculator\""));
+    // The zone closes as the exception unwinds it
+    REQUIRE_THAT(json, ContainsSubstring("\"name\":\"divide\",\"cat\":\"calculator\""));
+    // Only if MATHENGINE_LOG_LEVEL kept the line
+    if constexpr (Logger::isCompiledIn(Logger::Level::ERROR)) {
+        REQUIRE_THAT(json, ContainsSubstring("\"name\":\"format\",\"cat\":\"logger\""));
+        REQUIRE_THAT(json, ContainsSubstring("\"name\":\"write\",\"cat\":\"logger\""));
+    }
+}
+
+#else
+
+TEST_CASE("Trace - compiled out, the library records nothing", "[trace]") {
+    TraceFixture fixture;
+    REQUIRE_FALSE(Trace::kCompiledIn);
+    Calculator::add(1.0, 2.0);
+    Logger::setSink(std::make_shared<NullSink>());
+    Logger::log(Logger::Level::ERROR, "untraced {}", 42);
+    Logger::setSink(nullptr);
+    REQUIRE(Trace::eventCount() == 0);
+}
+
+#endif // MATHENGINE_TRACING